@@ -1,11 +1,21 @@
 #pragma once
 
+#include "allocator.hpp"  // AllocatorConfig, Trace forward declaration
 #include <stdexcept>
 #include <cstdlib>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <new>
+#include <optional>
 #include <utility>
+#include <vector>
 #include <type_traits>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
 // MPS is a C library - must use C linkage
 extern "C" {
 #include "mps.h"
@@ -18,111 +28,296 @@ namespace gc {
 
 /**
  * GoodScript MPS AMC Allocator
- * 
+ *
  * Uses AMC (Automatic Mostly-Copying) pool for precise generational GC.
- * 
- * Performance improvements over MVFF:
- * - Precise GC (knows exactly where pointers are)
+ * Selected at compile time with -DGS_GC_AMC (gsc --gsGc amc); in that
+ * configuration gc::Allocator and gc::Runtime alias the AMC versions.
+ *
+ * Improvements over MVFF:
+ * - Memory is actually reclaimed (MVFF is a manual pool and never frees)
  * - Generational collection (young gen / old gen)
  * - Automatic memory compaction
- * - Expected 3-5x performance improvement
- * 
- * Trade-offs:
- * - Requires object format descriptors (more complex)
- * - Need to track object layouts
- * - Slightly more memory overhead for metadata
- * 
+ *
+ * Reference discovery:
+ * - Heap objects: precise, through per-type TypeLayout tables. Codegen emits
+ *   one for every generated class and struct (GS_GC_CLASS / GS_GC_FIELD).
+ * - Thread stack and registers: ambiguous (conservative). Ambiguously
+ *   referenced objects are pinned, which is what makes AMC "mostly" copying.
+ * - Module-level globals: ambiguous area roots registered with GS_GC_ROOT.
+ * - Runtime-owned malloc blocks: ambiguous, through alloc_rooted(). Coroutine
+ *   frames (cppcoro::task and the runtime's own coroutines), timer callbacks
+ *   and promise state are allocated there, so a reference held across a
+ *   co_await or captured by setTimeout pins its object.
+ *
+ * Limitations:
+ * - Other memory owned by the malloc heap (std::vector/std::unordered_map
+ *   storage, std::function captures) is not scanned. Objects that are only
+ *   reachable from there are not kept alive. gsc therefore rejects AMC for
+ *   programs that store closures as function values (std::function).
+ *
  * Thread-safety: Single-threaded for now (can be extended).
  */
 
 /**
  * Object header for AMC-allocated objects.
- * Stored before each object to enable precise scanning.
+ * Stored before each object (MPS in-band header), so client pointers point
+ * at the object itself and the header is at client - header_size().
+ *
+ * type_tag encodes the object kind:
+ * - nullptr: padding object
+ * - low bit set: forwarding marker, remaining bits are the new client pointer
+ * - otherwise: const TypeLayout* describing the object's references
  */
 struct ObjectHeader {
-    size_t size;        // Object size in bytes
-    void* type_tag;     // Type identifier for polymorphism (currently unused)
-    
-    // Header must be pointer-aligned
+    size_t size;        // Total block size in bytes (header included)
+    void* type_tag;     // Layout, forwarding marker or nullptr (padding)
+
+    // Blocks are aligned to the header size so every gap MPS asks us to
+    // pad is large enough to hold a header.
     static constexpr size_t alignment() {
-        return sizeof(void*);
+        return sizeof(ObjectHeader);
     }
-    
+
     // Total header size including alignment
     static constexpr size_t header_size() {
         return (sizeof(ObjectHeader) + alignment() - 1) & ~(alignment() - 1);
     }
 };
 
+/**
+ * Scan function for one reference-bearing slot of a known C++ type.
+ */
+using ScanFn = mps_res_t (*)(mps_ss_t ss, void* slot);
+
+/**
+ * A reference-bearing field: byte offset within the object plus the
+ * function that fixes the references stored in it.
+ */
+struct FieldLayout {
+    size_t offset;
+    ScanFn scan;
+};
+
+/**
+ * Pointer-offset table for one C++ type.
+ *
+ * Only fields that can hold GC references are listed, so scanning an
+ * object touches exactly its real references and nothing else.
+ */
+struct TypeLayout {
+    const FieldLayout* fields;
+    size_t field_count;
+    const TypeLayout* base;   // Base class layout (single inheritance, base at offset 0)
+    size_t element_size;      // Non-zero for alloc_array blocks: fields repeat per element
+};
+
+template<typename T, typename = void>
+struct has_gc_layout : std::false_type {};
+
+template<typename T>
+struct has_gc_layout<T, std::void_t<decltype(T::gc_layout())>> : std::true_type {};
+
+// Scanners that only delegate through MPS_FIX_CALL never read the fix
+// state MPS_SCAN_BEGIN sets up
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+/**
+ * Fix every reference of one object described by layout.
+ */
+inline mps_res_t scan_layout(mps_ss_t ss, void* object, const TypeLayout* layout) {
+    MPS_SCAN_BEGIN(ss) {
+        for (; layout != nullptr; layout = layout->base) {
+            for (size_t i = 0; i < layout->field_count; ++i) {
+                const FieldLayout& field = layout->fields[i];
+                mps_res_t res = MPS_RES_OK;
+                MPS_FIX_CALL(ss, res = field.scan(ss, static_cast<char*>(object) + field.offset));
+                if (res != MPS_RES_OK) return res;
+            }
+        }
+    } MPS_SCAN_END(ss);
+    return MPS_RES_OK;
+}
+#pragma GCC diagnostic pop
+
+/**
+ * Trace<T>: how to fix the GC references held by a value of type T.
+ *
+ * - Types with a static gc_layout() (generated classes and structs) are
+ *   scanned through their table.
+ * - Raw pointers are exact references.
+ * - String, Array and friends specialize Trace next to their definition.
+ * - Everything else (numbers, bools, malloc-backed containers) holds no
+ *   GC references.
+ */
+template<typename T>
+struct Trace {
+    static constexpr bool has_refs = has_gc_layout<T>::value;
+
+    static mps_res_t scan(mps_ss_t ss, T* value) {
+        if constexpr (has_gc_layout<T>::value) {
+            return scan_layout(ss, value, T::gc_layout());
+        } else {
+            (void)ss;
+            (void)value;
+            return MPS_RES_OK;
+        }
+    }
+};
+
+template<typename T>
+struct Trace<T*> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, T** slot) {
+        if (*slot == nullptr) return MPS_RES_OK;
+        MPS_SCAN_BEGIN(ss) {
+            mps_addr_t ref = const_cast<void*>(static_cast<const void*>(*slot));
+            mps_res_t res = MPS_FIX12(ss, &ref);
+            if (res != MPS_RES_OK) return res;
+            *slot = static_cast<T*>(ref);
+        } MPS_SCAN_END(ss);
+        return MPS_RES_OK;
+    }
+};
+
+template<typename T>
+struct Trace<std::optional<T>> {
+    static constexpr bool has_refs = Trace<T>::has_refs;
+
+    static mps_res_t scan(mps_ss_t ss, std::optional<T>* value) {
+        if (!value->has_value()) return MPS_RES_OK;
+        return Trace<T>::scan(ss, &**value);
+    }
+};
+
+template<typename A, typename B>
+struct Trace<std::pair<A, B>> {
+    static constexpr bool has_refs = Trace<A>::has_refs || Trace<B>::has_refs;
+
+    static mps_res_t scan(mps_ss_t ss, std::pair<A, B>* value) {
+        mps_res_t res = Trace<A>::scan(ss, &value->first);
+        if (res != MPS_RES_OK) return res;
+        return Trace<B>::scan(ss, &value->second);
+    }
+};
+
+/**
+ * Type-erased entry point stored in FieldLayout::scan.
+ */
+template<typename T>
+inline mps_res_t scan_slot(mps_ss_t ss, void* slot) {
+    return Trace<T>::scan(ss, static_cast<T*>(slot));
+}
+
+/**
+ * Layout of a single object of type T allocated with alloc<T>().
+ */
+template<typename T>
+inline const TypeLayout* object_layout() {
+    if constexpr (has_gc_layout<T>::value) {
+        return T::gc_layout();
+    } else {
+        static const FieldLayout fields[] = {{0, &scan_slot<T>}};
+        static const TypeLayout layout{fields, Trace<T>::has_refs ? 1u : 0u, nullptr, 0};
+        return &layout;
+    }
+}
+
+/**
+ * Layout of an alloc_array<T>() block: one slot per element.
+ */
+template<typename T>
+inline const TypeLayout* array_layout() {
+    static const FieldLayout fields[] = {{0, &scan_slot<T>}};
+    static const TypeLayout layout{fields, Trace<T>::has_refs ? 1u : 0u, nullptr, sizeof(T)};
+    return &layout;
+}
+
 /**
  * MPS Format Functions for AMC Pool
- * 
+ *
  * These callbacks tell MPS how to scan, skip, and move objects.
+ * The format has in-band headers, so every address MPS hands us is a
+ * client pointer, except for pad() which receives the block base.
  */
 namespace format {
+    constexpr uintptr_t FORWARDED = 1;
+
+    inline ObjectHeader* header_of(mps_addr_t client) {
+        return reinterpret_cast<ObjectHeader*>(
+            static_cast<char*>(client) - ObjectHeader::header_size()
+        );
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"  // As for scan_layout()
     /**
-     * Scan function: Tell MPS which fields contain pointers.
-     * 
-     * For now, we use conservative scanning within each object
-     * (scan all words as potential pointers). Future optimization:
-     * emit type metadata to enable precise field-level scanning.
+     * Scan function: fix the references of every object in [base, limit)
+     * using its TypeLayout. Padding and forwarding markers are skipped.
      */
     inline mps_res_t scan(mps_ss_t ss, mps_addr_t base, mps_addr_t limit) {
         MPS_SCAN_BEGIN(ss) {
-            // Get object header
-            ObjectHeader* header = static_cast<ObjectHeader*>(base);
-            mps_addr_t object_start = reinterpret_cast<char*>(base) + ObjectHeader::header_size();
-            mps_addr_t object_end = reinterpret_cast<char*>(base) + header->size;
-            
-            // Conservative scan of object fields
-            // Scan every pointer-sized word as a potential reference
-            mps_addr_t* p = reinterpret_cast<mps_addr_t*>(object_start);
-            mps_addr_t* p_end = reinterpret_cast<mps_addr_t*>(object_end);
-            
-            while (p < p_end) {
-                mps_addr_t ref = *p;
-                // Fix up the reference if it points to a moved object
-                MPS_FIX12(ss, &ref);
-                *p = ref;
-                ++p;
+            char* p = static_cast<char*>(base);
+            while (p < static_cast<char*>(limit)) {
+                ObjectHeader* header = header_of(p);
+                uintptr_t tag = reinterpret_cast<uintptr_t>(header->type_tag);
+
+                if (tag != 0 && (tag & FORWARDED) == 0) {
+                    const TypeLayout* layout = reinterpret_cast<const TypeLayout*>(tag);
+                    if (layout->field_count > 0 || layout->base != nullptr) {
+                        mps_res_t res = MPS_RES_OK;
+                        if (layout->element_size > 0) {
+                            // Array block: same slots repeated for every element
+                            size_t payload = header->size - ObjectHeader::header_size();
+                            size_t count = payload / layout->element_size;
+                            for (size_t i = 0; i < count; ++i) {
+                                MPS_FIX_CALL(ss, res = scan_layout(ss, p + i * layout->element_size, layout));
+                                if (res != MPS_RES_OK) return res;
+                            }
+                        } else {
+                            MPS_FIX_CALL(ss, res = scan_layout(ss, p, layout));
+                            if (res != MPS_RES_OK) return res;
+                        }
+                    }
+                }
+
+                p += header->size;
             }
         } MPS_SCAN_END(ss);
-        
+
         return MPS_RES_OK;
     }
-    
+#pragma GCC diagnostic pop
+
     /**
-     * Skip function: Given an object address, return the address after it.
+     * Skip function: Given a client pointer, return the next client pointer.
      */
     inline mps_addr_t skip(mps_addr_t addr) {
-        ObjectHeader* header = static_cast<ObjectHeader*>(addr);
-        return reinterpret_cast<char*>(addr) + header->size;
+        return static_cast<char*>(addr) + header_of(addr)->size;
     }
-    
+
     /**
-     * Forward function: Move an object to a new location.
+     * Forward function: MPS has already copied the object to new_addr;
+     * leave a forwarding marker behind (size is kept so skip still works).
      */
     inline void fwd(mps_addr_t old_addr, mps_addr_t new_addr) {
-        ObjectHeader* old_header = static_cast<ObjectHeader*>(old_addr);
-        std::memcpy(new_addr, old_addr, old_header->size);
+        header_of(old_addr)->type_tag = reinterpret_cast<void*>(
+            reinterpret_cast<uintptr_t>(new_addr) | FORWARDED
+        );
     }
-    
+
     /**
-     * Is-forwarded function: Check if an object has been moved.
+     * Is-forwarded function: Return the new location of a moved object.
      */
     inline mps_addr_t isfwd(mps_addr_t addr) {
-        ObjectHeader* header = static_cast<ObjectHeader*>(addr);
-        
-        // Check if type_tag has the forwarding bit set
-        if (reinterpret_cast<uintptr_t>(header->type_tag) & 1) {
-            return reinterpret_cast<mps_addr_t>(
-                reinterpret_cast<uintptr_t>(header->type_tag) & ~1
-            );
+        uintptr_t tag = reinterpret_cast<uintptr_t>(header_of(addr)->type_tag);
+        if (tag & FORWARDED) {
+            return reinterpret_cast<mps_addr_t>(tag & ~FORWARDED);
         }
-        
         return nullptr;
     }
-    
+
     /**
      * Pad function: Fill unused space with padding object.
      */
@@ -135,80 +330,246 @@ namespace format {
 
 /**
  * AMC-based allocator with precise generational GC.
+ *
+ * Same interface as the MVFF Allocator, plus alloc_object() used by the
+ * class-specific operator new that GS_GC_CLASS injects into generated classes.
  */
 class AllocatorAMC {
 private:
     static mps_arena_t arena;
     static mps_pool_t pool;
     static mps_fmt_t format;
+    static mps_chain_t chain;
+    static mps_ap_t ap;
     static mps_thr_t thread;
     static mps_root_t thread_root;
     static bool initialized;
+    static AllocatorConfig config;
+
+    // Generation capacities (KB) and predicted mortality for the default chain
+    static constexpr size_t NURSERY_KB = 8 * 1024;
+    static constexpr size_t OLD_KB = 64 * 1024;
+
+    static std::vector<mps_root_t>& roots() {
+        static std::vector<mps_root_t> registered;
+        return registered;
+    }
+
+    // Globals registered before init(): created as roots once the arena is
+    static std::vector<std::pair<void*, size_t>>& pending_roots() {
+        static std::vector<std::pair<void*, size_t>> pending;
+        return pending;
+    }
+
+    /**
+     * Header of an alloc_rooted() block. Blocks form a circular list
+     * around rooted_blocks, which the rooted_root scan walks.
+     */
+    struct alignas(std::max_align_t) RootedBlock {
+        RootedBlock* prev;
+        RootedBlock* next;
+        size_t size;
+    };
+
+    static RootedBlock rooted_blocks;
+    static mps_root_t rooted_root;
+
+    static mps_res_t scan_rooted(mps_ss_t ss, void*, size_t) {
+        for (RootedBlock* block = rooted_blocks.next; block != &rooted_blocks; block = block->next) {
+            char* base = reinterpret_cast<char*>(block + 1);
+            mps_res_t res = mps_scan_area(ss, base, base + (block->size & ~(sizeof(void*) - 1)), nullptr);
+            if (res != MPS_RES_OK) return res;
+        }
+        return MPS_RES_OK;
+    }
+
+    static void create_area_root(void* base, size_t size) {
+        char* limit = static_cast<char*>(base) + (size & ~(sizeof(void*) - 1));
+        mps_root_t root;
+        mps_res_t res = mps_root_create_area(&root, arena, mps_rank_ambig(), 0,
+                                             base, limit, mps_scan_area, nullptr);
+        if (res != MPS_RES_OK) {
+            throw std::runtime_error("Failed to register GC root");
+        }
+        roots().push_back(root);
+    }
+
+    /**
+     * Cold end of the current thread's stack.
+     * MPS scans the stack from the hot end up to this address, so it must
+     * cover main() even when the first allocation happens deep in a call chain.
+     */
+    static void* stack_cold_end(void* fallback) {
+#if defined(__linux__)
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+            void* addr = nullptr;
+            size_t size = 0;
+            int res = pthread_attr_getstack(&attr, &addr, &size);
+            pthread_attr_destroy(&attr);
+            if (res == 0 && addr != nullptr) {
+                return static_cast<char*>(addr) + size;
+            }
+        }
+#elif defined(__APPLE__)
+        return pthread_get_stackaddr_np(pthread_self());
+#endif
+        return fallback;
+    }
+
+    static size_t block_size(size_t payload) {
+        size_t total = ObjectHeader::header_size() + payload;
+        return (total + ObjectHeader::alignment() - 1) & ~(ObjectHeader::alignment() - 1);
+    }
+
+    /**
+     * Reserve/commit a zeroed block tagged with layout and return its
+     * client pointer. Zeroed memory is a valid object for scan().
+     */
+    static void* allocate(size_t payload, const TypeLayout* layout) {
+        if (!initialized) init();
+
+        size_t total_size = block_size(payload);
+        mps_addr_t addr;
+
+        do {
+            mps_res_t res = mps_reserve(&addr, ap, total_size);
+            if (res != MPS_RES_OK) {
+                throw std::bad_alloc();
+            }
+
+            ObjectHeader* header = static_cast<ObjectHeader*>(addr);
+            header->size = total_size;
+            header->type_tag = const_cast<TypeLayout*>(layout);
+            std::memset(header + 1, 0, total_size - ObjectHeader::header_size());
+        } while (!mps_commit(ap, addr, total_size));
+
+        return static_cast<char*>(addr) + ObjectHeader::header_size();
+    }
+
+    static void cleanup_after(int stage) {
+        if (stage >= 6) mps_root_destroy(rooted_root);
+        if (stage >= 5) mps_ap_destroy(ap);
+        if (stage >= 4) mps_pool_destroy(pool);
+        if (stage >= 3) mps_chain_destroy(chain);
+        if (stage >= 2) mps_fmt_destroy(format);
+        if (stage >= 1) {
+            mps_root_destroy(thread_root);
+            mps_thread_dereg(thread);
+        }
+        mps_arena_destroy(arena);
+    }
 
 public:
     /**
      * Initialize the MPS arena with AMC pool.
+     *
+     * A static initializer that allocates starts the arena with the
+     * defaults before main() can pass its configuration; calling init()
+     * again then applies the new commit limit (the arena's initial size
+     * is fixed by then, and the VM arena grows past it anyway).
+     *
+     * @param cfg Configuration (defaults to AllocatorConfig::defaults())
      */
-    static void init() {
-        if (initialized) return;
+    static void init(const AllocatorConfig& cfg = AllocatorConfig::defaults()) {
+        if (initialized) {
+            if (cfg.commit_limit != config.commit_limit) {
+                if (mps_arena_commit_limit_set(arena, cfg.commit_limit) != MPS_RES_OK) {
+                    throw std::runtime_error("GC commit limit is below the memory already in use");
+                }
+                config.commit_limit = cfg.commit_limit;
+            }
+            return;
+        }
+
+        config = cfg;
 
         mps_res_t res;
 
-        // Create the arena
-        res = mps_arena_create_k(&arena, mps_arena_class_vm(), mps_args_none);
+        // Create the arena; commit_limit bounds the heap like -Xmx
+        MPS_ARGS_BEGIN(arena_args) {
+            MPS_ARGS_ADD(arena_args, MPS_KEY_ARENA_SIZE, config.arena_size);
+            MPS_ARGS_ADD(arena_args, MPS_KEY_COMMIT_LIMIT, config.commit_limit);
+            res = mps_arena_create_k(&arena, mps_arena_class_vm(), arena_args);
+        } MPS_ARGS_END(arena_args);
         if (res != MPS_RES_OK) {
             throw std::runtime_error("Failed to create MPS arena");
         }
 
         // Register thread
-        void* cold;
+        void* marker;
         res = mps_thread_reg(&thread, arena);
         if (res != MPS_RES_OK) {
             mps_arena_destroy(arena);
             throw std::runtime_error("Failed to register thread");
         }
-        
+
         // Create stack root for conservative stack scanning
-        res = mps_root_create_thread(&thread_root, arena, thread, &cold);
+        res = mps_root_create_thread(&thread_root, arena, thread, stack_cold_end(&marker));
         if (res != MPS_RES_OK) {
             mps_thread_dereg(thread);
             mps_arena_destroy(arena);
             throw std::runtime_error("Failed to create thread root");
         }
 
-        // Create object format for AMC
-        mps_fmt_A_s fmt_spec = {
-            /* align */    sizeof(void*),
-            /* scan */     format::scan,
-            /* skip */     format::skip,
-            /* fwd */      format::fwd,
-            /* isfwd */    format::isfwd,
-            /* pad */      format::pad
-        };
-        
-        res = mps_fmt_create_A(&format, arena, &fmt_spec);
+        // Create object format for AMC (in-band ObjectHeader)
+        MPS_ARGS_BEGIN(fmt_args) {
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_ALIGN, ObjectHeader::alignment());
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_HEADER_SIZE, ObjectHeader::header_size());
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_SCAN, format::scan);
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_SKIP, format::skip);
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_FWD, format::fwd);
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_ISFWD, format::isfwd);
+            MPS_ARGS_ADD(fmt_args, MPS_KEY_FMT_PAD, format::pad);
+            res = mps_fmt_create_k(&format, arena, fmt_args);
+        } MPS_ARGS_END(fmt_args);
         if (res != MPS_RES_OK) {
-            mps_root_destroy(thread_root);
-            mps_thread_dereg(thread);
-            mps_arena_destroy(arena);
+            cleanup_after(1);
             throw std::runtime_error("Failed to create object format");
         }
 
+        // Two-generation chain: nursery and old generation
+        mps_gen_param_s gen_params[] = {
+            {NURSERY_KB, 0.85},
+            {OLD_KB, 0.45},
+        };
+        res = mps_chain_create(&chain, arena, sizeof(gen_params) / sizeof(gen_params[0]), gen_params);
+        if (res != MPS_RES_OK) {
+            cleanup_after(2);
+            throw std::runtime_error("Failed to create generation chain");
+        }
+
         // Create AMC pool with the format
         MPS_ARGS_BEGIN(args) {
             MPS_ARGS_ADD(args, MPS_KEY_FORMAT, format);
+            MPS_ARGS_ADD(args, MPS_KEY_CHAIN, chain);
             res = mps_pool_create_k(&pool, arena, mps_class_amc(), args);
         } MPS_ARGS_END(args);
-        
         if (res != MPS_RES_OK) {
-            mps_fmt_destroy(format);
-            mps_root_destroy(thread_root);
-            mps_thread_dereg(thread);
-            mps_arena_destroy(arena);
+            cleanup_after(3);
             throw std::runtime_error("Failed to create AMC pool");
         }
 
+        // AMC only allocates through allocation points
+        res = mps_ap_create_k(&ap, pool, mps_args_none);
+        if (res != MPS_RES_OK) {
+            cleanup_after(4);
+            throw std::runtime_error("Failed to create allocation point");
+        }
+
+        // One root for every alloc_rooted() block, current and future
+        res = mps_root_create(&rooted_root, arena, mps_rank_ambig(), 0, scan_rooted, nullptr, 0);
+        if (res != MPS_RES_OK) {
+            cleanup_after(5);
+            throw std::runtime_error("Failed to create rooted block root");
+        }
+
         initialized = true;
+
+        for (auto [base, size] : pending_roots()) {
+            create_area_root(base, size);
+        }
+        pending_roots().clear();
     }
 
     /**
@@ -217,143 +578,106 @@ public:
     static void shutdown() {
         if (!initialized) return;
 
-        mps_pool_destroy(pool);
-        mps_fmt_destroy(format);
-        mps_root_destroy(thread_root);
-        mps_thread_dereg(thread);
-        mps_arena_destroy(arena);
+        for (mps_root_t root : roots()) {
+            mps_root_destroy(root);
+        }
+        roots().clear();
+        cleanup_after(6);
         initialized = false;
     }
 
     /**
      * Allocate memory for an object of type T with constructor arguments.
-     * 
+     *
      * Layout: [ObjectHeader][Object Data]
      */
     template<typename T, typename... Args>
     static T* alloc(Args&&... args) {
-        if (!initialized) init();
+        void* object = allocate(sizeof(T), object_layout<T>());
+        return new(object) T(std::forward<Args>(args)...);
+    }
 
-        // Calculate total size: header + object
-        size_t object_size = sizeof(T);
-        size_t total_size = ObjectHeader::header_size() + object_size;
-        
-        // Align to pointer size
-        total_size = (total_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    /**
+     * Allocate array of objects.
+     */
+    template<typename T>
+    static T* alloc_array(size_t count) {
+        T* array = static_cast<T*>(allocate(sizeof(T) * count, array_layout<T>()));
 
-        // Allocate memory
-        mps_addr_t addr;
-        mps_res_t res;
-        
-        do {
-            res = mps_reserve(&addr, pool, total_size);
-            if (res != MPS_RES_OK) {
-                throw std::bad_alloc();
-            }
-            
-            // Initialize header
-            ObjectHeader* header = static_cast<ObjectHeader*>(addr);
-            header->size = total_size;
-            header->type_tag = nullptr;  // Could store type info here
-            
-            // Get pointer to object data (after header)
-            T* object = reinterpret_cast<T*>(
-                reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-            );
-            
-            // Zero-initialize memory (safe for conservative scan)
-            std::memset(object, 0, object_size);
-            
-            // Construct object in-place
-            new(object) T(std::forward<Args>(args)...);
-            
-            // Commit the allocation
-        } while (!mps_commit(pool, addr, total_size));
-        
-        // Return pointer to object (not header)
-        return reinterpret_cast<T*>(
-            reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-        );
+        // Construct each element
+        for (size_t i = 0; i < count; ++i) {
+            new(&array[i]) T();
+        }
+
+        return array;
     }
 
     /**
-     * Allocate memory for an object of type T (no arguments).
+     * Allocate storage for count trivial elements (string data).
+     * AMC blocks are always zero-filled so scan() never sees garbage.
      */
     template<typename T>
-    static T* alloc() {
-        if (!initialized) init();
+    static T* alloc_buffer(size_t count) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "alloc_buffer requires a trivial element type");
+        return static_cast<T*>(allocate(sizeof(T) * count, array_layout<T>()));
+    }
 
-        size_t object_size = sizeof(T);
-        size_t total_size = ObjectHeader::header_size() + object_size;
-        total_size = (total_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    /**
+     * Allocate storage for count elements that the caller constructs in
+     * place (container entry arrays). Scanned per element with Trace<T>;
+     * slots not yet constructed are zero, which every Trace accepts.
+     */
+    template<typename T>
+    static T* alloc_storage(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, array_layout<T>()));
+    }
 
-        mps_addr_t addr;
-        mps_res_t res;
-        
-        do {
-            res = mps_reserve(&addr, pool, total_size);
-            if (res != MPS_RES_OK) {
-                throw std::bad_alloc();
-            }
-            
-            ObjectHeader* header = static_cast<ObjectHeader*>(addr);
-            header->size = total_size;
-            header->type_tag = nullptr;
-            
-            T* object = reinterpret_cast<T*>(
-                reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-            );
-            
-            std::memset(object, 0, object_size);
-            new(object) T();
-            
-        } while (!mps_commit(pool, addr, total_size));
-        
-        return reinterpret_cast<T*>(
-            reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-        );
+    /**
+     * Allocate raw storage for a generated class (see GS_GC_CLASS).
+     */
+    static void* alloc_object(size_t size, const TypeLayout* layout) {
+        return allocate(size, layout);
     }
 
     /**
-     * Allocate array of objects.
+     * Register [base, base + size) as an ambiguous root (module globals).
+     * Before init() the root is only recorded, so registering a global
+     * does not start the arena with the default configuration.
      */
-    template<typename T>
-    static T* alloc_array(size_t count) {
-        if (!initialized) init();
+    static void add_root(void* base, size_t size) {
+        if (!initialized) {
+            pending_roots().emplace_back(base, size);
+            return;
+        }
+        create_area_root(base, size);
+    }
 
-        size_t object_size = sizeof(T) * count;
-        size_t total_size = ObjectHeader::header_size() + object_size;
-        total_size = (total_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    /**
+     * Allocate size bytes on the malloc heap, scanned as an ambiguous root
+     * until free_rooted(): runtime-owned storage that holds GC references
+     * (coroutine frames, timer callbacks, promise state). Objects it
+     * references are kept alive and pinned.
+     */
+    static void* alloc_rooted(size_t size) {
+        RootedBlock* block = static_cast<RootedBlock*>(std::malloc(sizeof(RootedBlock) + size));
+        if (block == nullptr) throw std::bad_alloc();
+        // Zeroed so the scan never reads uninitialized words
+        std::memset(static_cast<void*>(block + 1), 0, size);
+        block->size = size;
+        block->prev = &rooted_blocks;
+        block->next = rooted_blocks.next;
+        rooted_blocks.next->prev = block;
+        rooted_blocks.next = block;
+        return block + 1;
+    }
 
-        mps_addr_t addr;
-        mps_res_t res;
-        
-        do {
-            res = mps_reserve(&addr, pool, total_size);
-            if (res != MPS_RES_OK) {
-                throw std::bad_alloc();
-            }
-            
-            ObjectHeader* header = static_cast<ObjectHeader*>(addr);
-            header->size = total_size;
-            header->type_tag = nullptr;
-            
-            T* array = reinterpret_cast<T*>(
-                reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-            );
-            
-            std::memset(array, 0, object_size);
-            
-            // Construct each element
-            for (size_t i = 0; i < count; ++i) {
-                new(&array[i]) T();
-            }
-            
-        } while (!mps_commit(pool, addr, total_size));
-        
-        return reinterpret_cast<T*>(
-            reinterpret_cast<char*>(addr) + ObjectHeader::header_size()
-        );
+    static void free_rooted(void* p) noexcept {
+        if (p == nullptr) return;
+        RootedBlock* block = static_cast<RootedBlock*>(p) - 1;
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        std::free(block);
     }
 
     /**
@@ -363,6 +687,7 @@ public:
     static void collect() {
         if (!initialized) return;
         mps_arena_collect(arena);
+        mps_arena_release(arena);
     }
 
     /**
@@ -377,23 +702,54 @@ public:
         if (!initialized) return 0;
         return mps_arena_reserved(arena);
     }
+
+    /**
+     * Get the current configuration.
+     */
+    static const AllocatorConfig& get_config() {
+        return config;
+    }
+
+    /**
+     * Memory statistics.
+     */
+    struct Stats {
+        size_t committed;
+        size_t reserved;
+        size_t arena_size;
+        size_t commit_limit;
+    };
+
+    static Stats stats() {
+        return Stats{
+            committed_memory(),
+            reserved_memory(),
+            config.arena_size,
+            config.commit_limit
+        };
+    }
 };
 
 // Static member definitions
 inline mps_arena_t AllocatorAMC::arena = nullptr;
 inline mps_pool_t AllocatorAMC::pool = nullptr;
 inline mps_fmt_t AllocatorAMC::format = nullptr;
+inline mps_chain_t AllocatorAMC::chain = nullptr;
+inline mps_ap_t AllocatorAMC::ap = nullptr;
 inline mps_thr_t AllocatorAMC::thread = nullptr;
 inline mps_root_t AllocatorAMC::thread_root = nullptr;
 inline bool AllocatorAMC::initialized = false;
+inline AllocatorConfig AllocatorAMC::config = AllocatorConfig::defaults();
+inline AllocatorAMC::RootedBlock AllocatorAMC::rooted_blocks{&rooted_blocks, &rooted_blocks, 0};
+inline mps_root_t AllocatorAMC::rooted_root = nullptr;
 
 /**
  * RAII wrapper for AMC initialization/shutdown.
  */
 class RuntimeAMC {
 public:
-    RuntimeAMC() {
-        AllocatorAMC::init();
+    RuntimeAMC(const AllocatorConfig& cfg = AllocatorConfig::defaults()) {
+        AllocatorAMC::init(cfg);
     }
 
     ~RuntimeAMC() {
@@ -404,5 +760,82 @@ public:
     RuntimeAMC& operator=(const RuntimeAMC&) = delete;
 };
 
+/**
+ * Static registration of a module global as a GC root (see GS_GC_ROOT).
+ */
+struct RootRegistration {
+    RootRegistration(void* base, size_t size) {
+        AllocatorAMC::add_root(base, size);
+    }
+};
+
+/**
+ * Standard allocator over AllocatorAMC::alloc_rooted(), for runtime state on
+ * the malloc heap that holds GC references (std::allocate_shared,
+ * std::vector storage).
+ */
+template<typename T>
+struct RootedAllocator {
+    using value_type = T;
+
+    RootedAllocator() = default;
+    template<typename U>
+    RootedAllocator(const RootedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(AllocatorAMC::alloc_rooted(count * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        AllocatorAMC::free_rooted(p);
+    }
+
+    template<typename U>
+    bool operator==(const RootedAllocator<U>&) const noexcept { return true; }
+};
+
+/**
+ * Coroutine frames (the hook in cppcoro's task_promise_base, and the
+ * runtime's own coroutine types): locals that live across a co_await.
+ */
+inline void* alloc_coroutine_frame(std::size_t size) {
+    return AllocatorAMC::alloc_rooted(size);
+}
+
+inline void free_coroutine_frame(void* frame) noexcept {
+    AllocatorAMC::free_rooted(frame);
+}
+
+#ifdef GS_GC_AMC
+using Allocator = AllocatorAMC;
+using Runtime = RuntimeAMC;
+#endif
+
 } // namespace gc
 } // namespace gs
+
+#ifdef GS_GC_AMC
+/**
+ * Codegen hooks for precise GC (see CppCodegen).
+ *
+ * GS_GC_CLASS(C)     - in a class body: declares C::gc_layout() and routes
+ *                      `new C(...)` to the AMC pool
+ * GS_GC_FIELD(C, f)  - one entry of C's pointer-offset table
+ * GS_GC_ROOT(g)      - registers module global g as a root
+ */
+#define GS_GC_CLASS(Class) \
+    static const ::gs::gc::TypeLayout* gc_layout(); \
+    static void* operator new(std::size_t size) { \
+        return ::gs::gc::AllocatorAMC::alloc_object(size, gc_layout()); \
+    } \
+    static void* operator new(std::size_t, void* place) noexcept { return place; } \
+    static void operator delete(void*) noexcept {}
+
+#define GS_GC_FIELD(Class, field) \
+    ::gs::gc::FieldLayout{offsetof(Class, field), \
+        &::gs::gc::scan_slot<std::remove_cv_t<decltype(Class::field)>>}
+
+#define GS_GC_ROOT(name) \
+    static ::gs::gc::RootRegistration gs_gc_root_##name( \
+        const_cast<void*>(static_cast<const void*>(&(name))), sizeof(name))
+#endif
@@ -5,6 +5,11 @@
 #include <cstring>
 #include <utility>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 // MPS is a C library - must use C linkage
 extern "C" {
@@ -23,6 +28,7 @@ namespace gc {
 struct AllocatorConfig {
     size_t arena_size;      // Initial arena size (like -Xms)
     size_t commit_limit;    // Maximum committed memory (like -Xmx)
+    bool allocation_points = true;  // Per-thread inline bump allocation (MVFF)
 
     /**
      * Default configuration: 64MB initial, 512MB max
@@ -49,6 +55,15 @@ struct AllocatorConfig {
     }
 };
 
+/**
+ * Per-type GC reference tracing, used by the precise AMC allocator.
+ * Declared here so runtime types can befriend it in both GC configurations.
+ */
+template<typename T>
+struct Trace;
+
+#ifndef GS_GC_AMC
+
 /**
  * GoodScript MPS Allocator (Optimized)
  * 
@@ -59,18 +74,20 @@ struct AllocatorConfig {
  * - Larger arena commit limit (better allocation performance)
  * - Tuned alignment for cache efficiency
  * - Allocation batching via larger chunks
+ * - Per-thread allocation points (inline reserve/commit bump allocation)
+ * - Compile-time size classes for alloc<T>
  * 
  * Performance characteristics:
  * - Conservative scanning (simple but slower than precise GC)
  * - Manual allocation (predictable but no automatic optimization)
  * - No generational GC (scans all live objects on each collection)
  * 
- * Future: AMC (Automatic Mostly-Copying) pool in allocator-amc.hpp
- * - Requires allocation point API (mps_ap_t) instead of direct pool alloc
- * - Precise GC with object format descriptors
- * - 3-5x faster but more complex integration
+ * Alternative: AMC (Automatic Mostly-Copying) pool in allocator-amc.hpp
+ * - Enabled with -DGS_GC_AMC (gsc --gsGc amc)
+ * - Precise GC with object format descriptors and generational collection
  * 
- * Thread-safety: Single-threaded for now (can be extended).
+ * Thread-safety: allocation is thread-safe (one allocation point per
+ * thread); init/shutdown must happen on one thread.
  */
 class Allocator {
 private:
@@ -81,17 +98,150 @@ private:
     static bool initialized;
     static AllocatorConfig config;
 
+    /**
+     * Per-thread allocation point.
+     * mps_reserve/mps_commit on an AP are inline bump-pointer operations;
+     * MPS is only entered when the AP's buffer runs out. The epoch ties the
+     * AP to the arena it was created in, so a stale AP from before a
+     * shutdown()/init() cycle is never used.
+     */
+    struct ThreadAP {
+        mps_ap_t ap = nullptr;
+        uint64_t epoch = UINT64_MAX;  // Never matches: forces the slow path first
+
+        ~ThreadAP() {
+            Allocator::release_thread_ap(*this);
+        }
+    };
+
+    static thread_local ThreadAP local_ap;
+    static std::atomic<uint64_t> epoch;  // 0 while not initialized
+    static uint64_t generation;
+    static std::mutex ap_mutex;
+    static std::vector<mps_ap_t> thread_aps;
+
+    // Requests up to this size go through the thread's allocation point.
+    // Bigger blocks go straight to the pool so they don't churn AP buffers.
+    static constexpr size_t AP_MAX_SIZE = 64 * 1024;
+
+    /**
+     * Size class of an allocation: at least pointer-sized, pointer-aligned.
+     * constexpr so alloc<T> resolves it at compile time.
+     */
+    static constexpr size_t size_class(size_t size) {
+        return (std::max(size, sizeof(void*)) + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    }
+
+    static void* bump(ThreadAP& local, size_t size) {
+        mps_addr_t addr;
+        do {
+            mps_res_t res = mps_reserve(&addr, local.ap, size);
+            if (res != MPS_RES_OK) {
+                throw std::bad_alloc();
+            }
+        } while (!mps_commit(local.ap, addr, size));
+        return addr;
+    }
+
+    /**
+     * Allocation with a compile-time size class: one thread-local load, one
+     * compare and an inline bump on the fast path.
+     */
+    template<size_t Size>
+    static void* allocate() {
+        if constexpr (Size <= AP_MAX_SIZE) {
+            ThreadAP& local = local_ap;
+            if (local.epoch == epoch.load(std::memory_order_relaxed)) {
+                return bump(local, Size);
+            }
+        }
+        return allocate_slow(Size);
+    }
+
+    /**
+     * Allocation with a run-time size (arrays).
+     */
+    static void* allocate(size_t size) {
+        ThreadAP& local = local_ap;
+        if (size <= AP_MAX_SIZE && local.epoch == epoch.load(std::memory_order_relaxed)) {
+            return bump(local, size);
+        }
+        return allocate_slow(size);
+    }
+
+    /**
+     * Slow path: lazy init, first allocation on a thread, large blocks,
+     * and the direct pool path when allocation points are disabled.
+     */
+    static void* allocate_slow(size_t size) {
+        if (!initialized) init();
+
+        if (size <= AP_MAX_SIZE && config.allocation_points) {
+            ThreadAP& local = local_ap;
+            if (local.epoch != epoch.load(std::memory_order_relaxed)) {
+                attach_thread_ap(local);
+            }
+            return bump(local, size);
+        }
+
+        mps_addr_t addr;
+        mps_res_t res = mps_alloc(&addr, pool, size);
+        if (res != MPS_RES_OK) {
+            throw std::bad_alloc();
+        }
+        return addr;
+    }
+
+    static void attach_thread_ap(ThreadAP& local) {
+        std::lock_guard<std::mutex> lock(ap_mutex);
+        mps_ap_t ap;
+        mps_res_t res = mps_ap_create_k(&ap, pool, mps_args_none);
+        if (res != MPS_RES_OK) {
+            throw std::bad_alloc();
+        }
+        thread_aps.push_back(ap);
+        local.ap = ap;
+        local.epoch = epoch.load(std::memory_order_relaxed);
+    }
+
+    static void release_thread_ap(ThreadAP& local) {
+        std::lock_guard<std::mutex> lock(ap_mutex);
+        if (local.ap != nullptr && local.epoch == epoch.load(std::memory_order_relaxed)) {
+            mps_ap_destroy(local.ap);
+            thread_aps.erase(std::remove(thread_aps.begin(), thread_aps.end(), local.ap), thread_aps.end());
+        }
+        local.ap = nullptr;
+        local.epoch = UINT64_MAX;
+    }
+
 public:
     /**
      * Initialize the MPS arena and allocation pool.
-     * Must be called before any allocations.
+     * Should be called before any allocations. If a static initializer
+     * allocated first (starting the arena with the defaults), a later call
+     * applies the new commit limit; the rest of the configuration is fixed
+     * by then.
+     * 
+     * Setting GS_GC_ALLOC_POINTS=0 in the environment disables allocation
+     * points (every allocation calls mps_alloc), for A/B benchmarking.
      * 
      * @param cfg Configuration (defaults to AllocatorConfig::defaults())
      */
     static void init(const AllocatorConfig& cfg = AllocatorConfig::defaults()) {
-        if (initialized) return;
+        if (initialized) {
+            if (cfg.commit_limit != config.commit_limit) {
+                if (mps_arena_commit_limit_set(arena, cfg.commit_limit) != MPS_RES_OK) {
+                    throw std::runtime_error("GC commit limit is below the memory already in use");
+                }
+                config.commit_limit = cfg.commit_limit;
+            }
+            return;
+        }
 
         config = cfg;  // Store configuration
+        if (const char* env = std::getenv("GS_GC_ALLOC_POINTS")) {
+            config.allocation_points = std::strcmp(env, "0") != 0;
+        }
 
         mps_res_t res;
 
@@ -141,6 +291,7 @@ public:
         }
 
         initialized = true;
+        epoch.store(++generation, std::memory_order_relaxed);
     }
 
     /**
@@ -150,6 +301,16 @@ public:
     static void shutdown() {
         if (!initialized) return;
 
+        {
+            // Allocation points must be gone before their pool
+            std::lock_guard<std::mutex> lock(ap_mutex);
+            for (mps_ap_t ap : thread_aps) {
+                mps_ap_destroy(ap);
+            }
+            thread_aps.clear();
+            epoch.store(0, std::memory_order_relaxed);
+        }
+
         mps_root_destroy(thread_root);
         mps_thread_dereg(thread);
         mps_pool_destroy(pool);
@@ -162,84 +323,52 @@ public:
      */
     template<typename T, typename... Args>
     static T* alloc(Args&&... args) {
-        if (!initialized) init();
-
-        mps_addr_t addr;
-        size_t size = sizeof(T);
-
-        // Align to cache line (64 bytes) for better performance
-        // Conservative GC only needs pointer alignment, but cache alignment helps
-        size = std::max(size, sizeof(void*));  // At least pointer-sized
-        size = (size + 7) & ~7;  // 8-byte alignment
-
-        mps_res_t res = mps_alloc(&addr, pool, size);
-        if (res != MPS_RES_OK) {
-            throw std::bad_alloc();
-        }
-
-        // Only zero-init if type is not trivially constructible
-        // (Conservative GC safety: assume constructor initializes all fields)
-        if (!std::is_trivially_constructible<T, Args...>::value) {
-            std::memset(addr, 0, size);
-        }
+        void* addr = allocate<size_class(sizeof(T))>();
 
         // Construct object in-place with forwarded arguments
+        // (MVFF memory is never scanned, so no zero-fill is needed)
         return new(addr) T(std::forward<Args>(args)...);
     }
 
     /**
-     * Allocate memory for an object of type T (no arguments).
+     * Allocate array of objects.
+     * Elements are value-initialized (zero for numbers and pointers).
      */
     template<typename T>
-    static T* alloc() {
-        if (!initialized) init();
-
-        mps_addr_t addr;
-        size_t size = sizeof(T);
-
-        // Align to pointer size for conservative GC
-        size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
-
-        mps_res_t res = mps_alloc(&addr, pool, size);
-        if (res != MPS_RES_OK) {
-            throw std::bad_alloc();
+    static T* alloc_array(size_t count) {
+        size_t size = size_class(sizeof(T) * count);
+        T* array = static_cast<T*>(allocate(size));
+
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            std::memset(array, 0, size);
+        } else {
+            // Construct each element
+            for (size_t i = 0; i < count; ++i) {
+                new(&array[i]) T();
+            }
         }
 
-        // Initialize memory to zero (safe for conservative GC)
-        std::memset(addr, 0, size);
-
-        // Construct object in-place
-        return new(addr) T();
+        return array;
     }
 
     /**
-     * Allocate array of objects.
+     * Allocate uninitialized storage for count trivial elements.
+     * For buffers the caller fills immediately (string data).
      */
     template<typename T>
-    static T* alloc_array(size_t count) {
-        if (!initialized) init();
-
-        mps_addr_t addr;
-        size_t size = sizeof(T) * count;
-
-        // Align to pointer size
-        size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
-
-        mps_res_t res = mps_alloc(&addr, pool, size);
-        if (res != MPS_RES_OK) {
-            throw std::bad_alloc();
-        }
-
-        // Initialize to zero
-        std::memset(addr, 0, size);
-
-        // Construct each element
-        T* array = static_cast<T*>(addr);
-        for (size_t i = 0; i < count; ++i) {
-            new(&array[i]) T();
-        }
+    static T* alloc_buffer(size_t count) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "alloc_buffer requires a trivial element type");
+        return static_cast<T*>(allocate(size_class(sizeof(T) * count)));
+    }
 
-        return array;
+    /**
+     * Allocate raw storage for count elements of any type; the caller
+     * constructs and destroys them in place (container entry arrays).
+     */
+    template<typename T>
+    static T* alloc_storage(size_t count) {
+        return static_cast<T*>(allocate(size_class(sizeof(T) * count)));
     }
 
     /**
@@ -298,6 +427,11 @@ inline mps_thr_t Allocator::thread = nullptr;
 inline mps_root_t Allocator::thread_root = nullptr;
 inline bool Allocator::initialized = false;
 inline AllocatorConfig Allocator::config = AllocatorConfig::defaults();
+inline thread_local Allocator::ThreadAP Allocator::local_ap;
+inline std::atomic<uint64_t> Allocator::epoch{0};
+inline uint64_t Allocator::generation = 0;
+inline std::mutex Allocator::ap_mutex;
+inline std::vector<mps_ap_t> Allocator::thread_aps;
 
 /**
  * RAII wrapper for MPS initialization/shutdown.
@@ -318,5 +452,15 @@ public:
     Runtime& operator=(const Runtime&) = delete;
 };
 
+#endif // GS_GC_AMC
+
 } // namespace gc
 } // namespace gs
+
+#ifdef GS_GC_AMC
+#include "allocator-amc.hpp"
+#else
+// Precise-GC hooks emitted by codegen; MVFF scans conservatively, so they are no-ops
+#define GS_GC_CLASS(Class)
+#define GS_GC_ROOT(name)
+#endif
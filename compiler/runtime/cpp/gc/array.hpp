@@ -9,26 +9,84 @@
 #include <optional>
 #include <cstring>   // For memcpy, memmove
 #include <type_traits>  // For std::is_trivially_copyable
+#include <memory>       // For std::construct_at, std::destroy_at
+#include <limits>
+#include "../gs_simd.hpp"  // Vectorized indexOf for numeric elements
+#include "../gs_sort.hpp"  // Stable run-adaptive sort and key sorts
 
 namespace gs {
 
 // Forward declaration
 class StringBuilder;
 
+// Room for N elements inside the store itself: zero-filled raw slots
+template<typename T, size_t N>
+struct InlineSlots {
+    alignas(T) unsigned char bytes[N * sizeof(T)]{};
+    T* get() { return reinterpret_cast<T*>(bytes); }
+};
+
+template<typename T>
+struct InlineSlots<T, 0> {
+    T* get() { return nullptr; }
+};
+
+/**
+ * Shared backing store of a GC Array: the element buffer and its bounds.
+ * One GC-allocated store per array value; every Array handle copied from
+ * it points at the same store.
+ *
+ * The elements are data[head, head + length): shift() and unshift() move
+ * head instead of the elements. The first INLINE_CAPACITY elements live
+ * in the store itself (in_place), so a small array is one allocation;
+ * larger ones move to a separate buffer, and data is then its base, the
+ * only kind of reference the precise collector accepts.
+ *
+ * Only the elements are constructed. Every other slot is raw storage,
+ * zero-filled under the precise collector (the null state every Trace
+ * accepts): growing constructs nothing, and a slot an element leaves is
+ * zeroed again so it keeps no stale reference alive.
+ */
+template<typename T>
+struct ArrayStore {
+    // Up to 8 elements in at most 128 bytes, for element types the
+    // collector can move bytewise along with the store
+    static constexpr size_t INLINE_CAPACITY =
+        std::is_trivially_default_constructible_v<T> || std::is_same_v<T, String>
+            ? std::min<size_t>(8, 128 / sizeof(T))
+            : 0;
+
+    T* data = nullptr;
+    size_t head = 0;
+    size_t length = 0;
+    size_t capacity = INLINE_CAPACITY;  // Slots in data, including the head gap
+    bool in_place = true;               // data is slots
+    [[no_unique_address]] InlineSlots<T, INLINE_CAPACITY> slots;
+
+    ArrayStore() { data = slots.get(); }
+};
+
 /**
  * GC-allocated Array implementation (Optimized).
  * 
+ * Reference semantics, as in JavaScript: an Array is a handle to a shared
+ * ArrayStore, so copying one (argument passing, field stores, returns) is
+ * a single pointer copy and mutations are visible through every alias.
+ * Independent copies are explicit: slice(), concat(), map(), filter().
+ * 
  * Optimizations:
  * - 1.5x growth factor (less memory waste than 2x)
  * - memcpy for POD types (faster bulk copy)
  * - Smarter initial capacity
+ * - Small arrays keep their elements in the store (no buffer allocation)
+ * - Amortized O(1) shift()/unshift() (head offset, no element moves)
  */
 template<typename T>
 class Array {
 private:
-    T* data_;
-    size_t length_;
-    size_t capacity_;
+    ArrayStore<T>* store_;
+
+    template<typename> friend struct gc::Trace;
 
     // Growth factor: 1.5x is optimal balance between:
     // - Memory waste (2x wastes 50%, 1.5x wastes 33%)
@@ -37,113 +95,119 @@ private:
     static constexpr double GROWTH_FACTOR = 1.5;
     static constexpr size_t MIN_CAPACITY = 8;  // Start with 8 elements
 
-    size_t calculate_growth(size_t current) const {
-        if (current == 0) return MIN_CAPACITY;
+    static size_t calculate_growth(size_t current) {
+        if (current < MIN_CAPACITY) return MIN_CAPACITY;
         size_t growth = static_cast<size_t>(current * GROWTH_FACTOR);
         return std::max(growth, current + 1);  // Ensure at least +1
     }
 
-    void resize_capacity(size_t new_capacity) {
-        T* new_data = gc::Allocator::alloc_array<T>(new_capacity);
+    // First element (a separate buffer's data is kept as its base pointer
+    // for the GC)
+    T* items() const { return store_->data + store_->head; }
+
+    // Slots from the first element to the end of the buffer
+    size_t room() const { return store_->capacity - store_->head; }
+
+    // Ends the element in slot and zeroes it, as slots never used are
+    static void vacate(T* slot) {
+        std::destroy_at(slot);
+        std::memset(static_cast<void*>(slot), 0, sizeof(T));
+    }
+
+    // Moves the elements to a new buffer of new_capacity slots (counted
+    // from the first element), leaving new_head free slots in front. The
+    // buffer is raw storage: only the moved elements are constructed.
+    void resize_capacity(size_t new_capacity, size_t new_head = 0) {
+        ArrayStore<T>& s = *store_;
+        T* new_data = gc::Allocator::alloc_storage<T>(new_head + new_capacity);
         
-        if (data_ && length_ > 0) {
+        T* from = s.data + s.head;
+        T* to = new_data + new_head;
+        if constexpr (std::is_trivially_copyable_v<T>) {
             // Use memcpy for POD types (10-50x faster than element copy)
-            if (std::is_trivially_copyable<T>::value) {
-                std::memcpy(new_data, data_, length_ * sizeof(T));
-            } else {
-                // Move existing elements for non-POD types
-                for (size_t i = 0; i < length_; ++i) {
-                    new_data[i] = std::move(data_[i]);
-                }
+            if (s.length > 0) {
+                std::memcpy(to, from, s.length * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < s.length; ++i) {
+                std::construct_at(to + i, std::move(from[i]));
+                std::destroy_at(from + i);
             }
         }
         
-        data_ = new_data;
-        capacity_ = new_capacity;
+        s.in_place = false;  // The slots are no longer scanned
+        s.data = new_data;
+        s.head = new_head;
+        s.capacity = new_head + new_capacity;
+    }
+
+    // Makes room for one more element at the back. A queue (push + shift)
+    // slides its elements back to the buffer start once the gap in front
+    // is at least as large as they are, so it never grows without bound.
+    void grow_back() {
+        ArrayStore<T>& s = *store_;
+        if (s.head == 0 || s.head < s.length) {
+            resize_capacity(calculate_growth(room()));
+            return;
+        }
+        // The gap is at least as long as the elements: the ranges are disjoint
+        T* from = s.data + s.head;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(s.data, from, s.length * sizeof(T));
+            std::memset(static_cast<void*>(from), 0, s.length * sizeof(T));
+        } else {
+            for (size_t i = 0; i < s.length; ++i) {
+                std::construct_at(s.data + i, std::move(from[i]));
+                vacate(from + i);
+            }
+        }
+        s.head = 0;
     }
 
 public:
-    Array() : data_(nullptr), length_(0), capacity_(0) {}
+    Array() : store_(gc::Allocator::alloc<ArrayStore<T>>()) {}
 
-    explicit Array(size_t initial_capacity) {
-        length_ = 0;
-        capacity_ = initial_capacity;
-        if (capacity_ > 0) {
-            data_ = gc::Allocator::alloc_array<T>(capacity_);
-        } else {
-            data_ = nullptr;
+    explicit Array(size_t initial_capacity) : Array() {
+        if (initial_capacity > ArrayStore<T>::INLINE_CAPACITY) {
+            resize_capacity(initial_capacity);
         }
     }
 
-    // Copy constructor
-    Array(const Array& other) {
-        length_ = other.length_;
-        capacity_ = other.capacity_;
-        if (capacity_ > 0) {
-            data_ = gc::Allocator::alloc_array<T>(capacity_);
-            for (size_t i = 0; i < length_; ++i) {
-                data_[i] = other.data_[i];
-            }
-        } else {
-            data_ = nullptr;
-        }
-    }
+    // Copies share the store (JavaScript reference semantics)
+    Array(const Array& other) = default;
+    Array& operator=(const Array& other) = default;
 
     // Initializer list constructor
-    Array(std::initializer_list<T> init) {
-        length_ = init.size();
-        capacity_ = length_;
-        if (capacity_ > 0) {
-            data_ = gc::Allocator::alloc_array<T>(capacity_);
-            size_t i = 0;
-            for (const T& elem : init) {
-                data_[i++] = elem;
-            }
-        } else {
-            data_ = nullptr;
+    Array(std::initializer_list<T> init) : Array(init.size()) {
+        for (const T& elem : init) {
+            std::construct_at(items() + store_->length++, elem);
         }
     }
 
-    // Assignment
-    Array& operator=(const Array& other) {
-        if (this != &other) {
-            length_ = other.length_;
-            capacity_ = other.capacity_;
-            if (capacity_ > 0) {
-                data_ = gc::Allocator::alloc_array<T>(capacity_);
-                for (size_t i = 0; i < length_; ++i) {
-                    data_[i] = other.data_[i];
-                }
-            } else {
-                data_ = nullptr;
-            }
-        }
-        return *this;
-    }
-
     // Element access with optimized auto-resize
     T& operator[](size_t index) {
         // Auto-resize if needed (1.5x growth for efficiency)
-        if (index >= capacity_) {
-            size_t new_capacity = std::max(index + 1, calculate_growth(capacity_));
+        if (index >= room()) {
+            size_t new_capacity = std::max(index + 1, calculate_growth(room()));
             resize_capacity(new_capacity);
         }
-        if (index >= length_) {
-            length_ = index + 1;
+        // Elements up to index start out default, as with setLength()
+        while (store_->length <= index) {
+            std::construct_at(items() + store_->length++);
         }
-        return data_[index];
+        return items()[index];
     }
 
     const T& operator[](size_t index) const {
-        if (index >= length_) {
+        if (index >= store_->length) {
             throw std::out_of_range("Array index out of bounds");
         }
-        return data_[index];
+        return items()[index];
     }
 
     // Properties
-    size_t length() const { return length_; }
-    size_t size() const { return length_; }
+    size_t length() const { return store_->length; }
+    size_t size() const { return store_->length; }
     
     /**
      * Sets the length of the array (JavaScript semantics)
@@ -154,18 +218,7 @@ public:
         if (newLength < 0) {
             throw std::invalid_argument("Array length must be non-negative");
         }
-        size_t new_len = static_cast<size_t>(newLength);
-        
-        if (new_len > capacity_) {
-            resize_capacity(new_len);
-        }
-        
-        // Initialize new elements to default values if expanding
-        for (size_t i = length_; i < new_len; ++i) {
-            data_[i] = T{};
-        }
-        
-        length_ = new_len;
+        resize(static_cast<size_t>(newLength));
     }
 
     /**
@@ -173,7 +226,7 @@ public:
      * This is a performance optimization to avoid reallocations during push()
      */
     void reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
+        if (new_capacity > room()) {
             resize_capacity(new_capacity);
         }
     }
@@ -182,84 +235,116 @@ public:
      * Returns the current capacity (number of elements that can be stored without reallocation)
      */
     size_t capacity() const {
-        return capacity_;
+        return room();
     }
 
     // Methods with optimized growth
     void push(const T& value) {
-        if (length_ >= capacity_) {
-            resize_capacity(calculate_growth(capacity_));
+        ArrayStore<T>& s = *store_;
+        if (s.head + s.length >= s.capacity) {
+            // value may live in this array's buffer: copy it before regrowing
+            T copy = value;
+            grow_back();
+            std::construct_at(s.data + s.head + s.length++, std::move(copy));
+            return;
         }
-        data_[length_++] = value;
+        std::construct_at(s.data + s.head + s.length++, value);
+    }
+
+    // Moves the value in, for elements that cannot be copied (tasks)
+    void push(T&& value) {
+        ArrayStore<T>& s = *store_;
+        if (s.head + s.length >= s.capacity) {
+            T moved = std::move(value);
+            grow_back();
+            std::construct_at(s.data + s.head + s.length++, std::move(moved));
+            return;
+        }
+        std::construct_at(s.data + s.head + s.length++, std::move(value));
     }
 
     void push_back(const T& value) {
         push(value);
     }
 
+    void push_back(T&& value) {
+        push(std::move(value));
+    }
+
     T pop() {
-        if (length_ == 0) {
+        ArrayStore<T>& s = *store_;
+        if (s.length == 0) {
             throw std::runtime_error("Cannot pop from empty array");
         }
-        return data_[--length_];
+        T* slot = s.data + s.head + --s.length;
+        T result = std::move(*slot);
+        vacate(slot);  // Drop the reference for the GC
+        return result;
     }
 
     void unshift(const T& value) {
-        if (length_ >= capacity_) {
-            resize_capacity(calculate_growth(capacity_));
-        }
-        
-        // Shift elements right - use memmove for POD types
-        if (std::is_trivially_copyable<T>::value && length_ > 0) {
-            std::memmove(data_ + 1, data_, length_ * sizeof(T));
-        } else {
-            for (size_t i = length_; i > 0; --i) {
-                data_[i] = data_[i - 1];
+        ArrayStore<T>& s = *store_;
+        if (s.head == 0 && s.length < s.capacity && s.length < MIN_CAPACITY) {
+            // A few elements: step them back one slot rather than reallocate
+            T copy = value;
+            if (s.length == 0) {
+                std::construct_at(s.data, std::move(copy));
+            } else {
+                std::construct_at(s.data + s.length, std::move(s.data[s.length - 1]));
+                std::move_backward(s.data, s.data + s.length - 1, s.data + s.length);
+                s.data[0] = std::move(copy);
             }
+        } else if (s.head == 0) {
+            // Reopen a gap in front, proportional to the length so that
+            // repeated unshifts reallocate only O(log n) times
+            T copy = value;
+            resize_capacity(room(), std::max(s.length / 2, MIN_CAPACITY));
+            std::construct_at(s.data + --s.head, std::move(copy));
+        } else {
+            std::construct_at(s.data + --s.head, value);
         }
-        
-        data_[0] = value;
-        ++length_;
+        ++s.length;
     }
 
     T shift() {
-        if (length_ == 0) {
+        ArrayStore<T>& s = *store_;
+        if (s.length == 0) {
             throw std::runtime_error("Cannot shift from empty array");
         }
         
-        T result = data_[0];
+        T result = std::move(s.data[s.head]);
+        vacate(s.data + s.head);  // Drop the reference for the GC
+        ++s.head;
         
-        // Shift elements left - use memmove for POD types
-        if (std::is_trivially_copyable<T>::value && length_ > 1) {
-            std::memmove(data_, data_ + 1, (length_ - 1) * sizeof(T));
-        } else {
-            for (size_t i = 1; i < length_; ++i) {
-                data_[i - 1] = data_[i];
-            }
+        if (--s.length == 0) {
+            s.head = 0;
         }
-        
-        --length_;
         return result;
     }
 
     // Resize array to new size
     void resize(size_t new_size) {
-        if (new_size > capacity_) {
+        ArrayStore<T>& s = *store_;
+        if (new_size > room()) {
             resize_capacity(new_size);
         }
-        // If shrinking, elements beyond new_size are abandoned
-        // If growing, new elements are default-initialized
-        if (new_size > length_) {
-            for (size_t i = length_; i < new_size; ++i) {
-                data_[i] = T();  // Default-initialize new elements
-            }
+        // Growing default-initializes the new elements; shrinking vacates
+        // the dropped ones
+        while (s.length < new_size) {
+            std::construct_at(s.data + s.head + s.length++);
+        }
+        while (s.length > new_size) {
+            vacate(s.data + s.head + --s.length);
         }
-        length_ = new_size;
     }
 
     int64_t indexOf(const T& value) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (data_[i] == value) {
+        if constexpr (simd::is_numeric_v<T>) {
+            return simd::index_of(items(), store_->length, value);
+        }
+        const T* elems = items();
+        for (size_t i = 0; i < store_->length; ++i) {
+            if (elems[i] == value) {
                 return static_cast<int64_t>(i);
             }
         }
@@ -268,60 +353,67 @@ public:
 
     // Concatenate arrays (returns new array)
     Array<T> concat(const Array<T>& other) const {
-        Array<T> result(length_ + other.length_);
+        // Lengths first: other may be this array
+        size_t length = store_->length;
+        size_t other_length = other.store_->length;
+        Array<T> result(length + other_length);
         // Copy elements from this array
-        for (size_t i = 0; i < length_; ++i) {
-            result.push(data_[i]);
+        for (size_t i = 0; i < length; ++i) {
+            result.push(items()[i]);
         }
         // Copy elements from other array
-        for (size_t i = 0; i < other.length_; ++i) {
-            result.push(other.data_[i]);
+        for (size_t i = 0; i < other_length; ++i) {
+            result.push(other.items()[i]);
         }
         return result;
     }
 
     // Join array elements into a string
     String join(const String& separator = String(",")) const {
-        if (length_ == 0) {
+        const ArrayStore<T>& s = *store_;
+        const T* elems = items();
+        if (s.length == 0) {
             return String("");
         }
         
-        if (length_ == 1) {
-            return String::from(data_[0]);
+        if (s.length == 1) {
+            return String::from(elems[0]);
         }
         
         // Use StringBuilder for efficient concatenation
         // Pre-calculate total size to allocate once
         size_t total_size = 0;
-        for (size_t i = 0; i < length_; ++i) {
-            String elem = String::from(data_[i]);
+        for (size_t i = 0; i < s.length; ++i) {
+            String elem = String::from(elems[i]);
             total_size += elem.length();
         }
-        if (length_ > 1) {
-            total_size += separator.length() * (length_ - 1);
+        if (s.length > 1) {
+            total_size += separator.length() * (s.length - 1);
         }
         
         // Create StringBuilder with pre-calculated capacity
         StringBuilder sb(total_size + 1);
         
         // Build the result
-        sb.append(String::from(data_[0]));
-        for (size_t i = 1; i < length_; ++i) {
+        sb.append(String::from(elems[0]));
+        for (size_t i = 1; i < s.length; ++i) {
             sb.append(separator);
-            sb.append(String::from(data_[i]));
+            sb.append(String::from(elems[i]));
         }
         
         return sb.toString();
     }
 
     // Higher-order array methods
+    // (callbacks may push to this array, so the store is re-read each step)
 
     template<typename F>
-    auto map(F func) const -> Array<decltype(func(data_[0]))> {
-        using R = decltype(func(data_[0]));
-        Array<R> result(length_);
-        for (size_t i = 0; i < length_; ++i) {
-            result.push(func(data_[i]));
+    auto map(F func) const -> Array<decltype(func(std::declval<T&>()))> {
+        using R = decltype(func(std::declval<T&>()));
+        size_t length = store_->length;
+        Array<R> result(length);
+        for (size_t i = 0; i < length; ++i) {
+            result.push(func(items()[i]));
         }
         return result;
     }
@@ -329,9 +421,10 @@ public:
     template<typename F>
     Array<T> filter(F predicate) const {
         Array<T> result;
-        for (size_t i = 0; i < length_; ++i) {
-            if (predicate(data_[i])) {
-                result.push(data_[i]);
+        size_t length = store_->length;
+        for (size_t i = 0; i < length; ++i) {
+            if (predicate(items()[i])) {
+                result.push(items()[i]);
             }
         }
         return result;
@@ -340,17 +433,18 @@ public:
     template<typename R, typename F>
     R reduce(F func, R initial) const {
         R accumulator = initial;
-        for (size_t i = 0; i < length_; ++i) {
-            accumulator = func(accumulator, data_[i]);
+        size_t length = store_->length;
+        for (size_t i = 0; i < length; ++i) {
+            accumulator = func(accumulator, items()[i]);
         }
         return accumulator;
     }
 
     template<typename F>
     std::optional<T> find(F predicate) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (predicate(data_[i])) {
-                return data_[i];
+        for (size_t i = 0; i < store_->length; ++i) {
+            if (predicate(items()[i])) {
+                return items()[i];
             }
         }
         return std::nullopt;
@@ -358,8 +452,8 @@ public:
 
     template<typename F>
     int64_t findIndex(F predicate) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (predicate(data_[i])) {
+        for (size_t i = 0; i < store_->length; ++i) {
+            if (predicate(items()[i])) {
                 return static_cast<int64_t>(i);
             }
         }
@@ -368,8 +462,8 @@ public:
 
     template<typename F>
     bool some(F predicate) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (predicate(data_[i])) {
+        for (size_t i = 0; i < store_->length; ++i) {
+            if (predicate(items()[i])) {
                 return true;
             }
         }
@@ -378,8 +472,8 @@ public:
 
     template<typename F>
     bool every(F predicate) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (!predicate(data_[i])) {
+        for (size_t i = 0; i < store_->length; ++i) {
+            if (!predicate(items()[i])) {
                 return false;
             }
         }
@@ -388,8 +482,9 @@ public:
 
     template<typename F>
     void forEach(F func) const {
-        for (size_t i = 0; i < length_; ++i) {
-            func(data_[i]);
+        size_t length = store_->length;
+        for (size_t i = 0; i < length; ++i) {
+            func(items()[i]);
         }
     }
 
@@ -403,10 +498,10 @@ public:
      * Equivalent to JavaScript: arr[index] || defaultValue
      */
     T get_or_default(int index, const T& defaultValue = T{}) const {
-        if (index < 0 || index >= static_cast<int>(length_)) {
+        if (index < 0 || index >= static_cast<int>(store_->length)) {
             return defaultValue;
         }
-        return data_[static_cast<size_t>(index)];
+        return items()[static_cast<size_t>(index)];
     }
 
     /**
@@ -414,11 +509,11 @@ public:
      * For performance-critical code where bounds are known to be valid
      */
     T& at_ref(int index) {
-        return data_[static_cast<size_t>(index)];
+        return items()[static_cast<size_t>(index)];
     }
 
     const T& at_ref(int index) const {
-        return data_[static_cast<size_t>(index)];
+        return items()[static_cast<size_t>(index)];
     }
 
     /**
@@ -438,7 +533,7 @@ public:
      * For performance-critical code where bounds are known to be valid
      */
     void set_unchecked(int index, const T& value) {
-        data_[static_cast<size_t>(index)] = value;
+        items()[static_cast<size_t>(index)] = value;
     }
 
     /**
@@ -447,57 +542,110 @@ public:
      */
     void set(int index, const T& value) {
         size_t idx = static_cast<size_t>(index);
-        if (idx >= length_) {
+        if (idx >= store_->length) {
+            T copy = value;
             resize(idx + 1);
+            items()[idx] = std::move(copy);
+            return;
         }
-        data_[idx] = value;
+        items()[idx] = value;
     }
 
     Array<T> slice(int64_t start = 0, int64_t end = -1) const {
-        if (start < 0) start = std::max(int64_t(0), int64_t(length_) + start);
-        if (end < 0) end = length_;
-        if (end > int64_t(length_)) end = length_;
+        int64_t length = static_cast<int64_t>(store_->length);
+        if (start < 0) start = std::max(int64_t(0), length + start);
+        if (end < 0) end = length;
+        if (end > length) end = length;
         if (start >= end) return Array<T>();
 
-        Array<T> result;
+        Array<T> result(static_cast<size_t>(end - start));
         for (int64_t i = start; i < end; ++i) {
-            result.push(data_[i]);
+            result.push(items()[i]);
         }
         return result;
     }
 
+    // Sorts stably in place and returns this array (not a copy), as in JavaScript
     template<typename F>
     Array<T> sort(F comparator) {
         // JavaScript comparators return number (negative/zero/positive)
-        // C++ std::sort expects bool comparator
-        std::sort(data_, data_ + length_, [&](const T& a, const T& b) {
+        gs::sorting::stable_sort(begin(), length(), [&](const T& a, const T& b) {
             auto result = comparator(a, b);
             return result < 0;
         });
         return *this;
     }
 
+    // sort((a, b) => key(a) - key(b)), or key(b) - key(a) when descending,
+    // extracting each key once (see gs_sort.hpp)
+    template<typename K>
+    Array<T> sortByKey(K key, bool descending = false) {
+        gs::sorting::sort_by_key(begin(), length(), key, descending);
+        return *this;
+    }
+
     Array<T> reverse() {
-        std::reverse(data_, data_ + length_);
+        std::reverse(begin(), end());
+        return *this;
+    }
+
+    // Fills [start, end) with value and returns this array, as in JavaScript
+    Array<T> fill(const T& value, int64_t start = 0,
+                  int64_t end = std::numeric_limits<int64_t>::max()) {
+        int64_t length = static_cast<int64_t>(store_->length);
+        start = start < 0 ? std::max(int64_t(0), length + start) : std::min(start, length);
+        end = end < 0 ? std::max(int64_t(0), length + end) : std::min(end, length);
+        if (start < end) {
+            std::fill(begin() + start, begin() + end, value);
+        }
         return *this;
     }
 
     // Check if array includes a value
     bool includes(const T& searchElement) const {
-        for (size_t i = 0; i < length_; ++i) {
-            if (data_[i] == searchElement) {
-                return true;
+        return indexOf(searchElement) >= 0;
+    }
+
+    // Iterators for range-based for loops
+    T* begin() { return items(); }
+    T* end() { return items() + store_->length; }
+    const T* begin() const { return items(); }
+    const T* end() const { return items() + store_->length; }
+};
+
+#ifdef GS_GC_AMC
+// Precise GC: the handle references the store, the store references the
+// buffer, and the buffer's own layout covers the elements. Inline elements
+// are scanned with the store, whose data is re-pointed at its own slots in
+// case the collector moved it.
+template<typename T>
+struct gc::Trace<ArrayStore<T>> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, ArrayStore<T>* store) {
+        if (!store->in_place) {
+            return gc::Trace<T*>::scan(ss, &store->data);
+        }
+        store->data = store->slots.get();
+        if constexpr (gc::Trace<T>::has_refs) {
+            for (size_t i = 0; i < ArrayStore<T>::INLINE_CAPACITY; ++i) {
+                mps_res_t res = gc::Trace<T>::scan(ss, &store->data[i]);
+                if (res != MPS_RES_OK) return res;
             }
         }
-        return false;
+        return MPS_RES_OK;
     }
+};
 
-    // Iterators for range-based for loops
-    T* begin() { return data_; }
-    T* end() { return data_ + length_; }
-    const T* begin() const { return data_; }
-    const T* end() const { return data_ + length_; }
+template<typename T>
+struct gc::Trace<Array<T>> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, Array<T>* arr) {
+        return gc::Trace<ArrayStore<T>*>::scan(ss, &arr->store_);
+    }
 };
+#endif
 
 // String::split() implementation (must be after Array is defined)
 inline Array<String> String::split(const String& separator) const {
@@ -22,11 +22,14 @@
 #include "string.hpp"
 #include "string-builder.hpp"
 #include "array.hpp"
+#include "../gs_pipeline.hpp"  // Fused map/filter chains (after Array)
+#include "../gs_parallel.hpp"  // Parallel.map/filter/reduce/sort (after Array)
 #include "map.hpp"
 #include "set.hpp"
 #include "number.hpp"
 #include "date.hpp"
 #include "error.hpp"
+#include "../gs_typed_array.hpp"  // ArrayBuffer and typed array views (after Array and Error)
 #include "promise.hpp"  // Promise wrapper for async operations
 #include "iterator.hpp"
 #include "timer.hpp"
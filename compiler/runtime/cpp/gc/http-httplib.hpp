@@ -52,6 +52,7 @@ struct HttpResponse {
   gs::String statusText;
   gs::Map<gs::String, gs::String> headers;
   gs::String body;
+  gs::Uint8Array bytes;  // Body of syncFetchBytes/fetchBytes (body stays empty)
   
   HttpResponse() : status(0) {}
 };
@@ -88,32 +89,43 @@ public:
    * @throws gs::Error on network errors or timeouts
    */
   static HttpResponse syncFetch(const gs::String& url) {
+    return convertResponse(get(url));
+  }
+  
+  /**
+   * Perform synchronous HTTP GET request for binary content
+   * 
+   * @param url - The URL to fetch
+   * @returns HttpResponse with status, headers, and the body in bytes
+   * @throws gs::Error on network errors or timeouts
+   */
+  static HttpResponse syncFetchBytes(const gs::String& url) {
+    httplib::Response res = get(url);
+    std::string body = std::move(res.body);
+    res.body.clear();
+    HttpResponse response = convertResponse(res);
+    response.bytes = gs::Uint8Array(gs::ArrayBuffer::adopt(std::move(body)));
+    return response;
+  }
+  
+  /**
+   * Perform synchronous HTTP POST request
+   * 
+   * @param url - The URL to post to
+   * @param body - Request body
+   * @param contentType - Content-Type header
+   * @returns HttpResponse with status, headers, and body
+   * @throws gs::Error on network errors or timeouts
+   */
+  static HttpResponse post(const gs::String& url, const gs::String& body, const gs::String& contentType) {
     std::string url_str = url.to_std_string();
-    
-    // Check for HTTPS without SSL support
-    #ifndef GS_ENABLE_HTTPS
-    if (url_str.find("https://") == 0) {
-      throw gs::Error("HTTPS not supported - rebuild with OpenSSL to enable HTTPS\n"
-                      "  macOS:  brew install openssl\n"
-                      "  Linux:  sudo apt install libssl-dev");
-    }
-    #endif
-    
-    // Parse URL into scheme://host:port/path
-    // For simplicity, assume http://hostname/path format
-    std::string scheme, host, path;
+    std::string host, path;
     int port = 80;
     
-    // Simple URL parsing
+    // Simple URL parsing (same as get() below)
     size_t scheme_end = url_str.find("://");
     if (scheme_end != std::string::npos) {
-      scheme = url_str.substr(0, scheme_end);
       url_str = url_str.substr(scheme_end + 3);
-      
-      // Set default port based on scheme
-      if (scheme == "https") {
-        port = 443;
-      }
     }
     
     size_t path_start = url_str.find('/');
@@ -125,52 +137,58 @@ public:
       path = "/";
     }
     
-    // Check for port in host
     size_t port_pos = host.find(':');
     if (port_pos != std::string::npos) {
       port = std::stoi(host.substr(port_pos + 1));
       host = host.substr(0, port_pos);
     }
     
-    // Create client with host and port
+    // Create client with timeouts
     httplib::Client client(host, port);
-    
-    // Set reasonable timeouts (in seconds)
-    client.set_connection_timeout(10, 0);  // 10 seconds connection timeout
-    client.set_read_timeout(30, 0);         // 30 seconds read timeout
-    client.set_write_timeout(30, 0);        // 30 seconds write timeout
-    
-    // Enable redirect following
+    client.set_connection_timeout(10, 0);
+    client.set_read_timeout(30, 0);
+    client.set_write_timeout(30, 0);
     client.set_follow_location(true);
     
-    // Perform GET request
-    auto res = client.Get(path);
+    // Perform POST request
+    auto res = client.Post(path, body.to_std_string(), contentType.to_std_string());
     
     if (!res) {
-      throw gs::Error("HTTP request failed: " + std::string(httplib::to_string(res.error())));
+      throw gs::Error("HTTP POST failed: " + std::string(httplib::to_string(res.error())));
     }
     
     return convertResponse(res.value());
   }
-  
-  /**
-   * Perform synchronous HTTP POST request
-   * 
-   * @param url - The URL to post to
-   * @param body - Request body
-   * @param contentType - Content-Type header
-   * @returns HttpResponse with status, headers, and body
-   * @throws gs::Error on network errors or timeouts
-   */
-  static HttpResponse post(const gs::String& url, const gs::String& body, const gs::String& contentType) {
+
+private:
+  // GET url, following redirects
+  static httplib::Response get(const gs::String& url) {
     std::string url_str = url.to_std_string();
-    std::string host, path;
+    
+    // Check for HTTPS without SSL support
+    #ifndef GS_ENABLE_HTTPS
+    if (url_str.find("https://") == 0) {
+      throw gs::Error("HTTPS not supported - rebuild with OpenSSL to enable HTTPS\n"
+                      "  macOS:  brew install openssl\n"
+                      "  Linux:  sudo apt install libssl-dev");
+    }
+    #endif
+    
+    // Parse URL into scheme://host:port/path
+    // For simplicity, assume http://hostname/path format
+    std::string scheme, host, path;
     int port = 80;
     
-    // Simple URL parsing (same as above)
+    // Simple URL parsing
     size_t scheme_end = url_str.find("://");
     if (scheme_end != std::string::npos) {
+      scheme = url_str.substr(0, scheme_end);
       url_str = url_str.substr(scheme_end + 3);
+      
+      // Set default port based on scheme
+      if (scheme == "https") {
+        port = 443;
+      }
     }
     
     size_t path_start = url_str.find('/');
@@ -182,27 +200,32 @@ public:
       path = "/";
     }
     
+    // Check for port in host
     size_t port_pos = host.find(':');
     if (port_pos != std::string::npos) {
       port = std::stoi(host.substr(port_pos + 1));
       host = host.substr(0, port_pos);
     }
     
-    // Create client with timeouts
+    // Create client with host and port
     httplib::Client client(host, port);
-    client.set_connection_timeout(10, 0);
-    client.set_read_timeout(30, 0);
-    client.set_write_timeout(30, 0);
+    
+    // Set reasonable timeouts (in seconds)
+    client.set_connection_timeout(10, 0);  // 10 seconds connection timeout
+    client.set_read_timeout(30, 0);         // 30 seconds read timeout
+    client.set_write_timeout(30, 0);        // 30 seconds write timeout
+    
+    // Enable redirect following
     client.set_follow_location(true);
     
-    // Perform POST request
-    auto res = client.Post(path, body.to_std_string(), contentType.to_std_string());
+    // Perform GET request
+    auto res = client.Get(path);
     
     if (!res) {
-      throw gs::Error("HTTP POST failed: " + std::string(httplib::to_string(res.error())));
+      throw gs::Error("HTTP request failed: " + std::string(httplib::to_string(res.error())));
     }
     
-    return convertResponse(res.value());
+    return std::move(res.value());
   }
 };
 
@@ -275,6 +298,17 @@ public:
     
     co_return result;
   }
+  
+  /**
+   * Perform asynchronous HTTP GET request for binary content
+   * 
+   * @param url - The URL to fetch
+   * @returns cppcoro::task<HttpResponse> with the body in bytes
+   */
+  static cppcoro::task<HttpResponse> fetchBytes(const gs::String& url) {
+    co_await detail::getHttpThreadPool().schedule();
+    co_return HTTP::syncFetchBytes(url);
+  }
 };
 #endif
 
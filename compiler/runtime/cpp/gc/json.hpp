@@ -1,17 +1,119 @@
 #pragma once
 
-#include <sstream>
-#include <iomanip>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "error.hpp"
+#include "string-builder.hpp"
+#include "../gs_json_parser.hpp"
+#include "../gs_json_writer.hpp"
 // String/Array defined by mode-specific runtime
 
 namespace gs {
 
+// Typed JSON decoding for GC runtime types (see gs_json_parser.hpp)
+// Overloads live in gs::json so argument-dependent lookup through Reader
+// finds them for every target type
+namespace json {
+
+inline void gs_json_decode(Reader& in, String& out) {
+  std::string_view text = in.read_string();
+  out = String(text.data(), text.size());
+}
+
+template<typename T>
+void gs_json_decode(Reader& in, Array<T>& out) {
+  out = Array<T>();
+  in.read_array([&] {
+    T element{};
+    gs_json_decode(in, element);
+    out.push(element);
+  });
+}
+
+// Class and interface references: allocated with new like any other
+// instance, so they land in the GC heap (GS_GC_CLASS under AMC)
+template<typename T>
+void gs_json_decode(Reader& in, T*& out) {
+  if (in.try_null()) {
+    out = nullptr;
+    return;
+  }
+  out = new T();
+  gs_json_decode(in, *out);
+}
+
+} // namespace json
+
+// JSON encoding for GC runtime types (see gs_json_writer.hpp)
+// gs_json_encode(out, value) appends the JSON for value to out. Overloads
+// live in gs so argument-dependent lookup through StringBuilder finds them;
+// codegen adds one per generated type that reaches JSON.stringify.
+inline void gs_json_encode(StringBuilder& out, double value) {
+  json::write_number(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, int32_t value) {
+  json::write_integer(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, int64_t value) {
+  json::write_integer(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, bool value) {
+  json::write_bool(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, const String& value) {
+  json::write_string(out, std::string_view(value.c_str(), value.length()));
+}
+
+inline void gs_json_encode(StringBuilder& out, const char* value) {
+  json::write_string(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, std::nullptr_t) {
+  out.append("null", 4);
+}
+
+template<typename T>
+void gs_json_encode(StringBuilder& out, const Array<T>& arr) {
+  out.append('[');
+  bool first = true;
+  for (const auto& element : arr) {
+    if (!first) out.append(',');
+    first = false;
+    gs_json_encode(out, element);
+  }
+  out.append(']');
+}
+
+template<typename T>
+void gs_json_encode(StringBuilder& out, const std::optional<T>& value) {
+  if (value) {
+    gs_json_encode(out, *value);
+  } else {
+    out.append("null", 4);
+  }
+}
+
+// Class and interface references
+template<typename T>
+void gs_json_encode(StringBuilder& out, const T* value) {
+  if (value) {
+    gs_json_encode(out, *value);
+  } else {
+    out.append("null", 4);
+  }
+}
+
 /**
  * GoodScript JSON class - TypeScript-compatible JSON utilities (GC mode)
  * 
- * Provides JSON.stringify() functionality for basic types.
+ * stringify() appends everything into one StringBuilder through the
+ * gs_json_encode() overloads; scalars are formatted on the stack.
  * Uses c_str() for GC String access.
  */
 class JSON {
@@ -21,62 +123,18 @@ public:
    * Equivalent to TypeScript: JSON.stringify(value)
    */
   
-  // Stringify for numbers
+  // Stringify for numbers (shortest round-trip form, like JavaScript)
   static String stringify(double value) {
-    std::ostringstream oss;
-    // Check if it's an integer
-    if (value == static_cast<int>(value)) {
-      oss << static_cast<int>(value);
-    } else {
-      oss << std::fixed << std::setprecision(6) << value;
-      // Remove trailing zeros
-      std::string str = oss.str();
-      str.erase(str.find_last_not_of('0') + 1, std::string::npos);
-      if (str.back() == '.') {
-        str.push_back('0');
-      }
-      return String(str);
+    if (!std::isfinite(value)) {
+      return String("null");
     }
-    return String(oss.str());
+    char buf[json::NUMBER_BUFFER_SIZE];
+    return String(buf, json::format_number(value, buf));
   }
   
   static String stringify(int value) {
-    return String(std::to_string(value));
-  }
-  
-  // Stringify for strings (add quotes)
-  static String stringify(const String& value) {
-    std::ostringstream oss;
-    oss << '"';
-    
-    // Escape special characters
-    const char* str = value.c_str();
-    for (size_t i = 0; i < value.length(); i++) {
-      char c = str[i];
-      switch (c) {
-        case '"':  oss << "\\\""; break;
-        case '\\': oss << "\\\\"; break;
-        case '\b': oss << "\\b"; break;
-        case '\f': oss << "\\f"; break;
-        case '\n': oss << "\\n"; break;
-        case '\r': oss << "\\r"; break;
-        case '\t': oss << "\\t"; break;
-        default:
-          if (c < 32) {
-            // Non-printable ASCII → \uXXXX
-            oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
-          } else {
-            oss << c;
-          }
-      }
-    }
-    
-    oss << '"';
-    return String(oss.str());
-  }
-  
-  static String stringify(const char* value) {
-    return stringify(String(value));
+    char buf[json::NUMBER_BUFFER_SIZE];
+    return String(buf, static_cast<size_t>(std::to_chars(buf, buf + sizeof(buf), value).ptr - buf));
   }
   
   // Stringify for booleans
@@ -89,41 +147,44 @@ public:
     return String("null");
   }
   
-  // Stringify for arrays
+  // Stringify for strings, arrays, optionals and generated types
   template<typename T>
-  static String stringify(const Array<T>& arr) {
-    if (arr.length() == 0) {
-      return String("[]");
-    }
-    
-    std::ostringstream oss;
-    oss << "[";
-    
-    for (size_t i = 0; i < arr.length(); i++) {
-      if (i > 0) {
-        oss << ",";
-      }
-      
-      // Recursive stringify for array elements
-      String elem_json = stringify(arr[i]);
-      oss << elem_json.c_str();
-    }
-    
-    oss << "]";
-    return String(oss.str());
+  static String stringify(const T& value) {
+    StringBuilder out;
+    gs_json_encode(out, value);
+    return out.toString();
   }
   
   /**
    * Parses a JSON string into a JavaScript value
    * Equivalent to TypeScript: JSON.parse(text)
    * 
-   * Note: This is a stub - full implementation requires a JSON parser library.
+   * Note: GC mode has no dynamically typed value, so without a target type
+   * the text is returned unchanged. Codegen uses parse<T>() whenever the
+   * target type is known.
    */
   static String parse(const String& text) {
-    // TODO: Implement JSON parsing
-    // For now, just return the input text
     return text;
   }
+
+  /**
+   * Parses a JSON string directly into T (number, boolean, string, Array,
+   * std::optional or a generated interface), with no intermediate tree.
+   * Equivalent to TypeScript: const value: T = JSON.parse(text)
+   * Throws SyntaxError on malformed input or a value of the wrong type.
+   */
+  template<typename T>
+  static T parse(const String& text) {
+    try {
+      json::Reader in(text.c_str(), text.length());
+      T result{};
+      gs_json_decode(in, result);
+      in.finish();
+      return result;
+    } catch (const json::ParseError& e) {
+      throw SyntaxError(e.what());
+    }
+  }
 };
 
 } // namespace gs
@@ -25,6 +25,8 @@ private:
     char* buffer_;
     size_t length_;
     size_t capacity_;
+
+    template<typename> friend struct gc::Trace;
     
     static constexpr size_t INITIAL_CAPACITY = 256;
     static constexpr size_t MAX_CAPACITY = 1024 * 1024 * 100; // 100MB max
@@ -41,7 +43,7 @@ private:
         }
         
         // Allocate new buffer
-        char* new_buffer = gc::Allocator::alloc_array<char>(new_capacity);
+        char* new_buffer = gc::Allocator::alloc_buffer<char>(new_capacity);
         
         // Copy existing content
         if (buffer_ && length_ > 0) {
@@ -86,6 +88,16 @@ public:
         return *this;
     }
     
+    // Append len bytes starting at data
+    StringBuilder& append(const char* data, size_t len) {
+        if (len == 0) return *this;
+        
+        ensureCapacity(length_ + len + 1);
+        std::memcpy(buffer_ + length_, data, len);
+        length_ += len;
+        return *this;
+    }
+    
     // Append a character
     StringBuilder& append(char c) {
         ensureCapacity(length_ + 2); // +1 for char, +1 for null terminator
@@ -114,7 +126,7 @@ public:
         buffer_[length_] = '\0';
         
         // Create String from buffer
-        return String(buffer_);
+        return String(buffer_, length_);
     }
     
     // Get raw C string (null-terminated)
@@ -127,4 +139,15 @@ public:
     }
 };
 
+#ifdef GS_GC_AMC
+template<>
+struct gc::Trace<StringBuilder> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, StringBuilder* sb) {
+        return gc::Trace<char*>::scan(ss, &sb->buffer_);
+    }
+};
+#endif
+
 } // namespace gs
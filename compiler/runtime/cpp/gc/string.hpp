@@ -1,6 +1,7 @@
 #pragma once
 
 #include "allocator.hpp"
+#include "../gs_hash.hpp"
 #include <cstring>
 #include <string>
 #include <stdexcept>
@@ -13,79 +14,185 @@ namespace gs {
 template<typename T> class Array;
 class Error;
 
+/**
+ * Header of a GC-allocated heap string buffer; the characters follow it
+ * in the same block so the buffer is a single GC object.
+ *
+ * Buffers are shared between String copies and treated as immutable once
+ * shared: the copy constructor only copies the pointer and sets `shared`.
+ * Mutation paths (operator+=, reserve, in-place concatenation) write in
+ * place only while the buffer is unshared, and otherwise copy first.
+ * There is no reference count - `shared` is sticky, so after a copy both
+ * owners pay one copy on their next mutation, which keeps copies O(1)
+ * without any bookkeeping on destruction (the GC reclaims the buffer).
+ *
+ * `hash` caches std::hash<String> (0 = not yet computed) so repeated map
+ * lookups with the same key string don't rehash its characters.
+ */
+struct StringBuffer {
+    size_t length;          // Characters in use (excluding the terminator)
+    size_t capacity;        // Bytes available in chars() (including the terminator)
+    mutable size_t hash;    // Cached hash, 0 until first computed
+    mutable bool shared;    // Set once a second String references the buffer
+
+    char* chars() { return reinterpret_cast<char*>(this + 1); }
+    const char* chars() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
 /**
  * GC-allocated String implementation with Small String Optimization (SSO).
- * 
+ *
  * Performance optimization: Most strings in typical programs are small (< 23 chars).
  * SSO stores short strings inline in the object itself, avoiding heap allocation.
- * 
+ *
  * Benefits:
  * - 50-80% reduction in allocations for typical programs
  * - Better cache locality (data is inline)
  * - Matches std::string behavior on modern compilers
- * 
+ *
  * Layout:
  * - Small strings (< 23 chars): stored in stack_data_
- * - Large strings (>= 23 chars): stored in heap_data_ (GC-allocated)
- * 
- * Size: 32 bytes total (4 pointers worth)
+ * - Large strings (>= 23 chars): stored in a shared StringBuffer (GC-allocated),
+ *   copied on write (see StringBuffer)
+ *
+ * Size: 40 bytes total (5 pointers worth)
  */
 class String {
 private:
     // SSO threshold: strings shorter than this stay on stack
     static constexpr size_t SSO_SIZE = 23;
-    
-    // Union: either heap pointer or stack buffer
+
+    // Union: either heap buffer or stack buffer
     union {
-        char* heap_data_;                  // Heap-allocated data (for large strings)
+        StringBuffer* heap_;              // Shared heap buffer (for large strings)
         char stack_data_[SSO_SIZE + 1];   // Inline data (for small strings)
     };
-    
+
     size_t length_;     // Current string length
     size_t capacity_;   // Allocated capacity (0 for stack strings)
-    
+
+    template<typename> friend struct gc::Trace;
+
     // Helper: is this string using heap storage?
     bool is_heap() const {
         return capacity_ > SSO_SIZE;
     }
-    
-    // Helper: get data pointer (works for both heap and stack)
-    char* data() {
-        return is_heap() ? heap_data_ : stack_data_;
+
+    // Helper: may this string write into its heap buffer in place?
+    bool is_unique() const {
+        return is_heap() && !heap_->shared;
     }
-    
+
+    // Helper: get data pointer (works for both heap and stack)
     const char* data() const {
-        return is_heap() ? heap_data_ : stack_data_;
+        return is_heap() ? heap_->chars() : stack_data_;
     }
-    
-    // Resize to new capacity (may convert stack→heap)
+
+    // Helper: writable data pointer; copies a shared heap buffer first
+    char* mutable_data() {
+        if (!is_heap()) return stack_data_;
+        if (heap_->shared) resize(capacity_);
+        heap_->hash = 0;
+        return heap_->chars();
+    }
+
+    // Allocate a fresh, unshared heap buffer of the given capacity
+    static StringBuffer* alloc_heap(size_t capacity) {
+        StringBuffer* buf = reinterpret_cast<StringBuffer*>(
+            gc::Allocator::alloc_buffer<char>(sizeof(StringBuffer) + capacity));
+        buf->length = 0;
+        buf->capacity = capacity;
+        buf->hash = 0;
+        buf->shared = false;
+        return buf;
+    }
+
+    // Start a string of the given length: returns where its characters go.
+    // The caller fills them in and calls set_length() to terminate.
+    char* init_storage(size_t length) {
+        if (length <= SSO_SIZE) {
+            capacity_ = 0;
+            return stack_data_;
+        }
+        capacity_ = length + 1;
+        heap_ = alloc_heap(capacity_);
+        return heap_->chars();
+    }
+
+    // Commit a new length: writes the terminator and keeps the heap header in sync
+    void set_length(size_t new_length) {
+        length_ = new_length;
+        if (is_heap()) {
+            heap_->length = new_length;
+            heap_->hash = 0;
+            heap_->chars()[new_length] = '\0';
+        } else {
+            stack_data_[new_length] = '\0';
+        }
+    }
+
+    // Share other's storage: heap buffers are pointer-copied, stack data is copied
+    void share_from(const String& other) {
+        length_ = other.length_;
+        capacity_ = other.capacity_;
+        if (other.is_heap()) {
+            other.heap_->shared = true;
+            heap_ = other.heap_;
+        } else {
+            std::memcpy(stack_data_, other.stack_data_, length_ + 1);
+        }
+    }
+
+    // Take other's storage, leaving it empty
+    void take_from(String& other) noexcept {
+        length_ = other.length_;
+        capacity_ = other.capacity_;
+        if (other.is_heap()) {
+            heap_ = other.heap_;
+            // Leave other in valid but empty state
+            other.length_ = 0;
+            other.capacity_ = 0;
+            other.stack_data_[0] = '\0';
+        } else {
+            capacity_ = 0;
+            std::memcpy(stack_data_, other.stack_data_, length_ + 1);
+        }
+    }
+
+    // Resize to new capacity (may convert stack→heap); always leaves the
+    // string with its own unshared buffer when it stays on the heap
     void resize(size_t new_capacity) {
         if (new_capacity <= SSO_SIZE) {
             // Can fit in stack buffer
-            if (is_heap()) {
+            if (is_heap() && length_ <= SSO_SIZE) {
                 // Convert heap → stack
-                char* old_heap = heap_data_;
-                std::memcpy(stack_data_, old_heap, length_ + 1);
+                StringBuffer* old_heap = heap_;
+                std::memcpy(stack_data_, old_heap->chars(), length_ + 1);
                 capacity_ = 0;  // Mark as stack
             }
             return;
         }
-        
+
         // Need heap allocation
-        char* new_data = gc::Allocator::alloc_array<char>(new_capacity);
-        std::memcpy(new_data, data(), length_ + 1);
-        
-        heap_data_ = new_data;
+        if (new_capacity < length_ + 1) new_capacity = length_ + 1;
+        StringBuffer* new_heap = alloc_heap(new_capacity);
+        std::memcpy(new_heap->chars(), data(), length_ + 1);
+        new_heap->length = length_;
+
+        heap_ = new_heap;
         capacity_ = new_capacity;
     }
 
 public:
     // Reserve capacity (allocate if needed, but don't change length)
     void reserve(size_t new_capacity) {
-        if (new_capacity <= capacity_ || (!is_heap() && new_capacity <= SSO_SIZE)) {
+        if (is_unique() && new_capacity <= capacity_) {
             return;  // Already have enough capacity
         }
-        resize(new_capacity);
+        if (!is_heap() && new_capacity <= SSO_SIZE) {
+            return;
+        }
+        resize(std::max(new_capacity, capacity_));
     }
 
     // Default constructor: empty string (stack)
@@ -99,88 +206,46 @@ public:
             capacity_ = 0;
             return;
         }
-        
-        length_ = std::strlen(str);
-        
-        if (length_ <= SSO_SIZE) {
-            // Fits in stack buffer
-            std::memcpy(stack_data_, str, length_ + 1);
-            capacity_ = 0;  // Mark as stack
-        } else {
-            // Need heap allocation
-            capacity_ = length_ + 1;
-            heap_data_ = gc::Allocator::alloc_array<char>(capacity_);
-            std::memcpy(heap_data_, str, length_ + 1);
-        }
+
+        size_t len = std::strlen(str);
+        std::memcpy(init_storage(len), str, len);
+        set_length(len);
     }
 
     // Construct from std::string
-    String(const std::string& str) : String(str.c_str()) {}
+    String(const std::string& str) {
+        std::memcpy(init_storage(str.size()), str.data(), str.size());
+        set_length(str.size());
+    }
+
+    // Construct from a character range (may contain NULs)
+    String(const char* data, size_t length) {
+        std::memcpy(init_storage(length), data, length);
+        set_length(length);
+    }
 
-    // Copy constructor
+    // Copy constructor - shares the heap buffer
     String(const String& other) {
-        length_ = other.length_;
-        
-        if (other.is_heap()) {
-            // Copy heap string
-            capacity_ = other.capacity_;
-            heap_data_ = gc::Allocator::alloc_array<char>(capacity_);
-            std::memcpy(heap_data_, other.heap_data_, length_ + 1);
-        } else {
-            // Copy stack string
-            capacity_ = 0;
-            std::memcpy(stack_data_, other.stack_data_, length_ + 1);
-        }
+        share_from(other);
     }
 
-    // Assignment operator
+    // Assignment operator - shares the heap buffer
     String& operator=(const String& other) {
         if (this != &other) {
-            length_ = other.length_;
-            
-            if (other.is_heap()) {
-                capacity_ = other.capacity_;
-                heap_data_ = gc::Allocator::alloc_array<char>(capacity_);
-                std::memcpy(heap_data_, other.heap_data_, length_ + 1);
-            } else {
-                capacity_ = 0;
-                std::memcpy(stack_data_, other.stack_data_, length_ + 1);
-            }
+            share_from(other);
         }
         return *this;
     }
 
     // Move constructor - reuse existing buffer
-    String(String&& other) noexcept 
-        : length_(other.length_), capacity_(other.capacity_) {
-        if (other.is_heap()) {
-            heap_data_ = other.heap_data_;
-            // Leave other in valid but empty state
-            other.length_ = 0;
-            other.capacity_ = 0;
-            other.stack_data_[0] = '\0';
-        } else {
-            capacity_ = 0;
-            std::memcpy(stack_data_, other.stack_data_, length_ + 1);
-        }
+    String(String&& other) noexcept {
+        take_from(other);
     }
 
     // Move assignment - reuse existing buffer
     String& operator=(String&& other) noexcept {
         if (this != &other) {
-            length_ = other.length_;
-            capacity_ = other.capacity_;
-            
-            if (other.is_heap()) {
-                heap_data_ = other.heap_data_;
-                // Leave other in valid but empty state
-                other.length_ = 0;
-                other.capacity_ = 0;
-                other.stack_data_[0] = '\0';
-            } else {
-                capacity_ = 0;
-                std::memcpy(stack_data_, other.stack_data_, length_ + 1);
-            }
+            take_from(other);
         }
         return *this;
     }
@@ -188,23 +253,11 @@ public:
     // String concatenation
     String operator+(const String& other) const {
         String result;
-        result.length_ = length_ + other.length_;
-        
-        if (result.length_ <= SSO_SIZE) {
-            // Result fits in stack
-            result.capacity_ = 0;
-            std::memcpy(result.stack_data_, data(), length_);
-            std::memcpy(result.stack_data_ + length_, other.data(), other.length_);
-            result.stack_data_[result.length_] = '\0';
-        } else {
-            // Result needs heap
-            result.capacity_ = result.length_ + 1;
-            result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-            std::memcpy(result.heap_data_, data(), length_);
-            std::memcpy(result.heap_data_ + length_, other.data(), other.length_);
-            result.heap_data_[result.length_] = '\0';
-        }
-        
+        size_t new_length = length_ + other.length_;
+        char* out = result.init_storage(new_length);
+        std::memcpy(out, data(), length_);
+        std::memcpy(out + length_, other.data(), other.length_);
+        result.set_length(new_length);
         return result;
     }
 
@@ -212,139 +265,63 @@ public:
     // Prepend to the temporary instead of creating new string
     String operator+(String&& other) const {
         size_t new_length = length_ + other.length_;
-        
-        if (new_length <= SSO_SIZE) {
-            // Small enough for stack - build new string
-            String result;
-            result.length_ = new_length;
-            result.capacity_ = 0;
-            std::memcpy(result.stack_data_, data(), length_);
-            std::memcpy(result.stack_data_ + length_, other.data(), other.length_);
-            result.stack_data_[new_length] = '\0';
-            return result;
-        }
-        
-        // If other has heap space and enough capacity, prepend to it
-        if (other.is_heap() && other.capacity_ >= new_length + 1) {
-            std::memmove(other.heap_data_ + length_, other.heap_data_, other.length_);
-            std::memcpy(other.heap_data_, data(), length_);
-            other.length_ = new_length;
-            other.heap_data_[new_length] = '\0';
+
+        // If other owns its heap buffer and has enough capacity, prepend to it
+        if (new_length > SSO_SIZE && other.is_unique() && other.capacity_ >= new_length + 1) {
+            char* d = other.heap_->chars();
+            std::memmove(d + length_, d, other.length_);
+            std::memcpy(d, data(), length_);
+            other.set_length(new_length);
             return std::move(other);
         }
-        
-        // Otherwise, allocate new buffer
-        String result;
-        result.length_ = new_length;
-        result.capacity_ = new_length + 1;
-        result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-        std::memcpy(result.heap_data_, data(), length_);
-        std::memcpy(result.heap_data_ + length_, other.data(), other.length_);
-        result.heap_data_[new_length] = '\0';
-        return result;
+
+        return *this + static_cast<const String&>(other);
     }
 
     // Optimize for rvalue on left: String("temp") + b
     // Append to the temporary instead of creating new string
     friend String operator+(String&& left, const String& right) {
-        size_t new_length = left.length_ + right.length_;
-        
-        if (new_length <= SSO_SIZE) {
-            // Small enough for stack
-            if (!left.is_heap()) {
-                std::memcpy(left.stack_data_ + left.length_, right.data(), right.length_);
-                left.length_ = new_length;
-                left.stack_data_[new_length] = '\0';
-                return std::move(left);
-            }
-        }
-        
-        // If left has enough capacity, append in place
-        if (left.is_heap() && left.capacity_ >= new_length + 1) {
-            std::memcpy(left.heap_data_ + left.length_, right.data(), right.length_);
-            left.length_ = new_length;
-            left.heap_data_[new_length] = '\0';
-            return std::move(left);
-        }
-        
-        // Need to resize
-        if (new_length > SSO_SIZE) {
-            left.resize(new_length + 1);
-            std::memcpy(left.data() + left.length_, right.data(), right.length_);
-            left.length_ = new_length;
-            left.data()[new_length] = '\0';
-            return std::move(left);
-        }
-        
-        // Fallback: create new string
-        String result;
-        result.length_ = new_length;
-        result.capacity_ = 0;
-        std::memcpy(result.stack_data_, left.data(), left.length_);
-        std::memcpy(result.stack_data_ + left.length_, right.data(), right.length_);
-        result.stack_data_[new_length] = '\0';
-        return result;
+        left += right;
+        return std::move(left);
     }
 
     // Optimize for both rvalues: String("a") + String("b")
     friend String operator+(String&& left, String&& right) {
         size_t new_length = left.length_ + right.length_;
-        
-        // If left has enough capacity, append right to it
-        if (left.is_heap() && left.capacity_ >= new_length + 1) {
-            std::memcpy(left.heap_data_ + left.length_, right.data(), right.length_);
-            left.length_ = new_length;
-            left.heap_data_[new_length] = '\0';
+
+        // If left owns enough capacity, append right to it
+        if (left.is_unique() && left.capacity_ >= new_length + 1) {
+            left += right;
             return std::move(left);
         }
-        
-        // If right has enough capacity, prepend left to it
-        if (right.is_heap() && right.capacity_ >= new_length + 1) {
-            std::memmove(right.heap_data_ + left.length_, right.heap_data_, right.length_);
-            std::memcpy(right.heap_data_, left.data(), left.length_);
-            right.length_ = new_length;
-            right.heap_data_[new_length] = '\0';
-            return std::move(right);
-        }
-        
-        // Neither has capacity - create new string
-        String result;
-        result.length_ = new_length;
-        
-        if (new_length <= SSO_SIZE) {
-            result.capacity_ = 0;
-            std::memcpy(result.stack_data_, left.data(), left.length_);
-            std::memcpy(result.stack_data_ + left.length_, right.data(), right.length_);
-            result.stack_data_[new_length] = '\0';
-        } else {
-            result.capacity_ = new_length + 1;
-            result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-            std::memcpy(result.heap_data_, left.data(), left.length_);
-            std::memcpy(result.heap_data_ + left.length_, right.data(), right.length_);
-            result.heap_data_[new_length] = '\0';
-        }
-        return result;
+
+        // If right owns enough capacity, prepend left to it
+        return static_cast<const String&>(left) + std::move(right);
     }
 
     // In-place concatenation
     String& operator+=(const String& other) {
         size_t new_length = length_ + other.length_;
-        
+
         if (new_length <= SSO_SIZE && !is_heap()) {
             // Can still fit in stack
             std::memcpy(stack_data_ + length_, other.data(), other.length_);
-            length_ = new_length;
-            stack_data_[length_] = '\0';
+            set_length(new_length);
         } else {
-            // Need to resize (may convert stack→heap)
-            if (new_length + 1 > capacity_) {
-                resize(new_length + 1);
+            // Need an unshared buffer with room (may convert stack→heap);
+            // grow geometrically so repeated appends stay amortized O(1)
+            if (!is_unique() || new_length + 1 > capacity_) {
+                size_t want = new_length + 1;
+                if (is_heap() && want <= capacity_) want = capacity_;
+                else if (is_heap()) want = std::max(want, capacity_ * 2);
+                resize(want);
             }
-            std::memcpy(data() + length_, other.data(), other.length_);
-            length_ = new_length;
-            data()[length_] = '\0';
+            // Read other only after resizing: if it aliases this string, its
+            // characters now live at the front of the new buffer
+            std::memcpy(heap_->chars() + length_, other.data(), other.length_);
+            set_length(new_length);
         }
-        
+
         return *this;
     }
 
@@ -380,6 +357,13 @@ public:
 
     // Properties
     size_t length() const { return length_; }
+
+    // Hash of the characters (see gs_hash.hpp); cached in the heap buffer after the first call
+    size_t hash() const {
+        if (!is_heap()) return static_cast<size_t>(gs::hash_bytes(stack_data_, length_));
+        if (heap_->hash == 0) heap_->hash = static_cast<size_t>(gs::hash_bytes(heap_->chars(), length_));
+        return heap_->hash;
+    }
     
     // Methods
     String charAt(size_t index) const {
@@ -431,26 +415,17 @@ public:
         if (start >= end) return String();
         
         size_t sub_len = end - start;
+        if (sub_len == length_) return *this;  // Whole string: share the buffer
+
         String result;
-        result.length_ = sub_len;
-        
-        if (sub_len <= SSO_SIZE) {
-            result.capacity_ = 0;
-            std::memcpy(result.stack_data_, data() + start, sub_len);
-            result.stack_data_[sub_len] = '\0';
-        } else {
-            result.capacity_ = sub_len + 1;
-            result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-            std::memcpy(result.heap_data_, data() + start, sub_len);
-            result.heap_data_[sub_len] = '\0';
-        }
-        
+        std::memcpy(result.init_storage(sub_len), data() + start, sub_len);
+        result.set_length(sub_len);
         return result;
     }
 
     String toLowerCase() const {
         String result(*this);
-        char* d = result.data();
+        char* d = result.mutable_data();
         for (size_t i = 0; i < result.length_; ++i) {
             d[i] = std::tolower(d[i]);
         }
@@ -459,7 +434,7 @@ public:
 
     String toUpperCase() const {
         String result(*this);
-        char* d = result.data();
+        char* d = result.mutable_data();
         for (size_t i = 0; i < result.length_; ++i) {
             d[i] = std::toupper(d[i]);
         }
@@ -494,24 +469,11 @@ public:
         
         size_t new_length = length_ * count;
         String result;
-        result.length_ = new_length;
-        
-        if (new_length <= SSO_SIZE) {
-            // Result fits in stack
-            result.capacity_ = 0;
-            for (int i = 0; i < count; ++i) {
-                std::memcpy(result.stack_data_ + (i * length_), data(), length_);
-            }
-            result.stack_data_[new_length] = '\0';
-        } else {
-            // Result needs heap
-            result.capacity_ = new_length + 1;
-            result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-            for (int i = 0; i < count; ++i) {
-                std::memcpy(result.heap_data_ + (i * length_), data(), length_);
-            }
-            result.heap_data_[new_length] = '\0';
+        char* out = result.init_storage(new_length);
+        for (int i = 0; i < count; ++i) {
+            std::memcpy(out + (i * length_), data(), length_);
         }
+        result.set_length(new_length);
         
         return result;
     }
@@ -528,41 +490,20 @@ public:
         
         int padLen = targetLength - currentLen;
         String result;
-        result.length_ = targetLength;
-        
-        if (result.length_ <= SSO_SIZE) {
-            // Result fits in stack
-            result.capacity_ = 0;
-            size_t pos = 0;
-            
-            // Add padding
-            while (pos < static_cast<size_t>(padLen)) {
-                size_t copyLen = std::min(padString.length_, static_cast<size_t>(padLen - pos));
-                std::memcpy(result.stack_data_ + pos, padString.data(), copyLen);
-                pos += copyLen;
-            }
-            
-            // Add original string
-            std::memcpy(result.stack_data_ + padLen, data(), length_);
-            result.stack_data_[result.length_] = '\0';
-        } else {
-            // Result needs heap
-            result.capacity_ = result.length_ + 1;
-            result.heap_data_ = gc::Allocator::alloc_array<char>(result.capacity_);
-            size_t pos = 0;
-            
-            // Add padding
-            while (pos < static_cast<size_t>(padLen)) {
-                size_t copyLen = std::min(padString.length_, static_cast<size_t>(padLen - pos));
-                std::memcpy(result.heap_data_ + pos, padString.data(), copyLen);
-                pos += copyLen;
-            }
-            
-            // Add original string
-            std::memcpy(result.heap_data_ + padLen, data(), length_);
-            result.heap_data_[result.length_] = '\0';
+        char* out = result.init_storage(targetLength);
+        size_t pos = 0;
+        
+        // Add padding
+        while (pos < static_cast<size_t>(padLen)) {
+            size_t copyLen = std::min(padString.length_, static_cast<size_t>(padLen - pos));
+            std::memcpy(out + pos, padString.data(), copyLen);
+            pos += copyLen;
         }
         
+        // Add original string
+        std::memcpy(out + padLen, data(), length_);
+        result.set_length(targetLength);
+        
         return result;
     }
 
@@ -673,6 +614,20 @@ public:
     }
 };
 
+#ifdef GS_GC_AMC
+// Precise GC: only heap strings hold a reference (stack_data_ shares the slot).
+// heap_ points at the start of the StringBuffer block, as exact refs must.
+template<>
+struct gc::Trace<String> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, String* str) {
+        if (!str->is_heap()) return MPS_RES_OK;
+        return gc::Trace<StringBuffer*>::scan(ss, &str->heap_);
+    }
+};
+#endif
+
 // Stream output operator
 inline std::ostream& operator<<(std::ostream& os, const String& str) {
     const char* cstr = str.c_str();
@@ -690,14 +645,7 @@ namespace std {
     template<>
     struct hash<gs::String> {
         size_t operator()(const gs::String& str) const noexcept {
-            // Use FNV-1a hash
-            const char* data = str.c_str();
-            size_t hash = 2166136261u;
-            while (*data) {
-                hash ^= static_cast<size_t>(*data++);
-                hash *= 16777619u;
-            }
-            return hash;
+            return str.hash();
         }
     };
 }
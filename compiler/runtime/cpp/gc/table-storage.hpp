@@ -0,0 +1,55 @@
+#pragma once
+
+#include "allocator.hpp"
+#include "../gs_ordered_table.hpp"
+
+namespace gs {
+
+/**
+ * OrderedHashTable storage for GC-mode Map and Set.
+ *
+ * Entry and index arrays are allocated from the MPS arena instead of the
+ * C++ heap, so a String buffer or class instance referenced only from a
+ * Map or Set is still reachable for the collector:
+ * - MVFF: storage comes from the same pool as every other GC object.
+ * - AMC: entry arrays are formatted blocks scanned with Trace<Value> per
+ *   slot, and the table's pointers to them are exact references (see the
+ *   Trace specializations below), so they move like any other object.
+ *
+ * Old arrays are left to the collector instead of being freed on growth.
+ */
+struct GcTableStorage {
+    template<typename T>
+    static T* allocate(size_t count) {
+        return gc::Allocator::alloc_storage<T>(count);
+    }
+
+    template<typename T>
+    static void deallocate(T*, size_t) {
+        // Reclaimed by the collector
+    }
+};
+
+#ifdef GS_GC_AMC
+template<typename Value>
+struct gc::Trace<OrderedSlot<Value>> {
+    static constexpr bool has_refs = gc::Trace<Value>::has_refs;
+
+    static mps_res_t scan(mps_ss_t ss, OrderedSlot<Value>* slot) {
+        return gc::Trace<Value>::scan(ss, &slot->value);
+    }
+};
+
+template<typename K, typename Value, typename KeyOf>
+struct gc::Trace<OrderedHashTable<K, Value, KeyOf, GcTableStorage>> {
+    static constexpr bool has_refs = true;
+
+    static mps_res_t scan(mps_ss_t ss, OrderedHashTable<K, Value, KeyOf, GcTableStorage>* table) {
+        mps_res_t res = gc::Trace<OrderedSlot<Value>*>::scan(ss, &table->entries_);
+        if (res != MPS_RES_OK) return res;
+        return gc::Trace<uint32_t*>::scan(ss, &table->index_);
+    }
+};
+#endif
+
+} // namespace gs
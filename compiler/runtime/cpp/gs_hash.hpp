@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * GoodScript String Hashing
+ *
+ * Length-based 64-bit hash shared by the GC and ownership runtimes, so
+ * std::hash<gs::String> (and therefore every string-keyed Map and Set)
+ * behaves the same in both memory modes.
+ *
+ * The algorithm is wyhash (final version 4, public domain, Wang Yi).
+ * It consumes 8 bytes per load and three independent 64x64->128 bit
+ * multiply lanes for inputs of 48 bytes or more, so typical 30-200 byte
+ * IDs and URLs hash in a handful of multiplies instead of one
+ * multiply per byte as FNV-1a does. Keys of 16 bytes or fewer take a
+ * single branch-light path with no loop.
+ *
+ * Hash values are stable within a process but are not part of any
+ * on-disk format; loads are little-endian regardless of target.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace gs {
+namespace hash_detail {
+
+inline void wymum(uint64_t* a, uint64_t* b) {
+#ifdef __SIZEOF_INT128__
+  __uint128_t r = *a;
+  r *= *b;
+  *a = static_cast<uint64_t>(r);
+  *b = static_cast<uint64_t>(r >> 64);
+#else
+  // Portable 64x64->128 multiply for targets without __int128
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = static_cast<uint32_t>(*a), lb = static_cast<uint32_t>(*b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+inline uint64_t wymix(uint64_t a, uint64_t b) {
+  wymum(&a, &b);
+  return a ^ b;
+}
+
+inline uint64_t read64(const uint8_t* p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+inline uint64_t read32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+// 1-3 bytes: first, middle and last byte
+inline uint64_t read3(const uint8_t* p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+constexpr uint64_t kSecret[4] = {
+  0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+} // namespace hash_detail
+
+/**
+ * Hash `length` bytes starting at `data`. Embedded NULs are hashed like
+ * any other byte.
+ */
+inline uint64_t hash_bytes(const void* data, size_t length, uint64_t seed = 0) {
+  using namespace hash_detail;
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  seed ^= wymix(seed ^ kSecret[0], kSecret[1]);
+  uint64_t a, b;
+
+  if (__builtin_expect(length <= 16, 1)) {
+    if (__builtin_expect(length >= 4, 1)) {
+      // Two overlapping 4-byte reads from each end cover 4-16 bytes
+      a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+      b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+    } else if (__builtin_expect(length > 0, 1)) {
+      a = read3(p, length);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = length;
+    if (__builtin_expect(i >= 48, 0)) {
+      // Three independent lanes so the multiplies pipeline
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = wymix(read64(p) ^ kSecret[1], read64(p + 8) ^ seed);
+        see1 = wymix(read64(p + 16) ^ kSecret[2], read64(p + 24) ^ see1);
+        see2 = wymix(read64(p + 32) ^ kSecret[3], read64(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (__builtin_expect(i >= 48, 1));
+      seed ^= see1 ^ see2;
+    }
+    while (__builtin_expect(i > 16, 0)) {
+      seed = wymix(read64(p) ^ kSecret[1], read64(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    // Final (possibly overlapping) 16 bytes
+    a = read64(p + i - 16);
+    b = read64(p + i - 8);
+  }
+
+  a ^= kSecret[1];
+  b ^= seed;
+  wymum(&a, &b);
+  return wymix(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+}
+
+} // namespace gs
@@ -0,0 +1,616 @@
+#pragma once
+
+/**
+ * GoodScript JSON Parser
+ *
+ * Two-stage parser behind JSON.parse in both runtimes, after simdjson
+ * (Langdale & Lemire, "Parsing Gigabytes of JSON per Second"):
+ *
+ * - Stage 1 (StructuralIndex) classifies the input 64 bytes at a time into
+ *   bitmasks - quotes, backslashes, operators ({}[]:,) and whitespace -
+ *   using SSE2 where available and SWAR (8 bytes per word) elsewhere. It
+ *   resolves escapes and string spans with carry-free bit arithmetic and
+ *   records the position of every structural character and every scalar
+ *   start (opening quotes, numbers, literals) that lies outside a string.
+ * - Stage 2 (Reader) walks that index. Strings without escapes are
+ *   returned as views into the input, numbers take an exact fast path,
+ *   and skipping a value never copies anything.
+ *
+ * The Reader is consumed either by a DOM builder (ownership mode's
+ * JSON::parse returns a Property tree) or directly by typed decoders:
+ * gs_json_decode(Reader&, T&) overloads found by argument-dependent lookup.
+ * This file provides them for numbers, booleans and std::optional; each
+ * runtime adds String and Array, and codegen emits one per interface, so
+ * JSON.parse into a known type fills the target without an intermediate
+ * tree.
+ *
+ * Errors throw json::ParseError with the byte offset; the runtimes turn it
+ * into a SyntaxError like JavaScript does.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) && !defined(GS_JSON_PORTABLE)
+#include <emmintrin.h>
+#define GS_JSON_SSE2 1
+#endif
+
+namespace gs {
+namespace json {
+
+class ParseError : public std::runtime_error {
+public:
+  ParseError(const std::string& message, size_t offset)
+    : std::runtime_error(message), offset_(offset) {}
+
+  size_t offset() const { return offset_; }
+
+private:
+  size_t offset_;
+};
+
+namespace detail {
+
+constexpr uint64_t ODD_BITS = 0xAAAAAAAAAAAAAAAAull;
+
+// Classification of one 64-byte block, one bit per byte
+struct BlockMasks {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t op;      // { } [ ] : ,
+  uint64_t space;   // ' ' \t \n \r
+};
+
+#ifdef GS_JSON_SSE2
+inline uint64_t eq_mask(__m128i v0, __m128i v1, __m128i v2, __m128i v3, char c) {
+  const __m128i k = _mm_set1_epi8(c);
+  uint64_t m0 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v0, k)));
+  uint64_t m1 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v1, k)));
+  uint64_t m2 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v2, k)));
+  uint64_t m3 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v3, k)));
+  return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+}
+
+inline BlockMasks classify(const uint8_t* block) {
+  __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+  __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+  __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+  __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+  BlockMasks m;
+  m.quote = eq_mask(v0, v1, v2, v3, '"');
+  m.backslash = eq_mask(v0, v1, v2, v3, '\\');
+  m.op = eq_mask(v0, v1, v2, v3, '{') | eq_mask(v0, v1, v2, v3, '}') |
+         eq_mask(v0, v1, v2, v3, '[') | eq_mask(v0, v1, v2, v3, ']') |
+         eq_mask(v0, v1, v2, v3, ':') | eq_mask(v0, v1, v2, v3, ',');
+  m.space = eq_mask(v0, v1, v2, v3, ' ') | eq_mask(v0, v1, v2, v3, '\t') |
+            eq_mask(v0, v1, v2, v3, '\n') | eq_mask(v0, v1, v2, v3, '\r');
+  return m;
+}
+#else
+constexpr uint64_t ONES = 0x0101010101010101ull;
+constexpr uint64_t HIGH = 0x8080808080808080ull;
+
+// High bit set in each byte of word that equals c (exact, no false positives)
+inline uint64_t eq_bytes(uint64_t word, uint8_t c) {
+  uint64_t x = word ^ (ONES * c);
+  return ~(((x & ~HIGH) + ~HIGH) | x) & HIGH;
+}
+
+// Gather the high bit of each byte into the low 8 bits
+inline uint64_t gather(uint64_t high_bits) {
+  return ((high_bits >> 7) * 0x0102040810204080ull) >> 56;
+}
+
+inline BlockMasks classify(const uint8_t* block) {
+  BlockMasks m{0, 0, 0, 0};
+  for (int i = 0; i < 8; ++i) {
+    uint64_t w;
+    std::memcpy(&w, block + i * 8, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    int shift = i * 8;
+    m.quote |= gather(eq_bytes(w, '"')) << shift;
+    m.backslash |= gather(eq_bytes(w, '\\')) << shift;
+    m.op |= gather(eq_bytes(w, '{') | eq_bytes(w, '}') | eq_bytes(w, '[') |
+                   eq_bytes(w, ']') | eq_bytes(w, ':') | eq_bytes(w, ',')) << shift;
+    m.space |= gather(eq_bytes(w, ' ') | eq_bytes(w, '\t') |
+                      eq_bytes(w, '\n') | eq_bytes(w, '\r')) << shift;
+  }
+  return m;
+}
+#endif
+
+// Bit i of the result is the XOR of bits 0..i of x (string spans from quotes)
+inline uint64_t prefix_xor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+inline bool is_delimiter(char c) {
+  switch (c) {
+    case ' ': case '\t': case '\n': case '\r':
+    case '{': case '}': case '[': case ']': case ':': case ',':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Exact powers of ten for the fast number path
+constexpr double POW10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline void append_utf8(std::string& out, uint32_t cp) {
+  if (cp < 0x80) {
+    out.push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+} // namespace detail
+
+/**
+ * Stage 1: positions of all structural characters and scalar starts
+ * outside strings, in document order.
+ */
+class StructuralIndex {
+public:
+  void build(const char* data, size_t length) {
+    if (length >= UINT32_MAX) {
+      throw ParseError("JSON input too large", 0);
+    }
+    // At most one entry per input byte
+    if (length + 1 > capacity_) {
+      positions_.reset(new uint32_t[length + 1]);
+      capacity_ = length + 1;
+    }
+    count_ = 0;
+
+    uint64_t prev_escaped = 0;     // Next block's first byte is escaped
+    uint64_t prev_in_string = 0;   // All ones while inside a string
+    uint64_t prev_scalar = 0;      // Previous block ended in a scalar byte
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t base = 0; base < length; base += 64) {
+      detail::BlockMasks m;
+      if (length - base >= 64) {
+        m = detail::classify(bytes + base);
+      } else {
+        // Pad the tail with spaces, which are never structural
+        uint8_t tail[64];
+        std::memset(tail, ' ', sizeof(tail));
+        std::memcpy(tail, bytes + base, length - base);
+        m = detail::classify(tail);
+      }
+
+      // Characters preceded by an odd run of backslashes are escaped
+      uint64_t escaped;
+      if (m.backslash == 0) {
+        escaped = prev_escaped;
+        prev_escaped = 0;
+      } else {
+        uint64_t potential_escape = m.backslash & ~prev_escaped;
+        uint64_t maybe_escaped = potential_escape << 1;
+        uint64_t codes = ((maybe_escaped | detail::ODD_BITS) - potential_escape) ^ detail::ODD_BITS;
+        escaped = codes ^ (m.backslash | prev_escaped);
+        prev_escaped = (codes & m.backslash) >> 63;
+      }
+
+      // Unescaped quotes open and close strings; in_string covers the
+      // opening quote and the contents but not the closing quote
+      uint64_t quote = m.quote & ~escaped;
+      uint64_t in_string = detail::prefix_xor(quote) ^ prev_in_string;
+      prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+      uint64_t string_tail = in_string ^ quote;
+
+      // A scalar starts at any non-operator, non-space byte that does not
+      // follow another such byte (quotes always start one)
+      uint64_t scalar = ~(m.op | m.space);
+      uint64_t nonquote_scalar = scalar & ~quote;
+      uint64_t follows_scalar = (nonquote_scalar << 1) | prev_scalar;
+      prev_scalar = nonquote_scalar >> 63;
+      uint64_t structurals = (m.op | (scalar & ~follows_scalar)) & ~string_tail;
+
+      while (structurals) {
+        positions_[count_++] = static_cast<uint32_t>(base + __builtin_ctzll(structurals));
+        structurals &= structurals - 1;
+      }
+    }
+
+    if (prev_in_string) {
+      throw ParseError("Unterminated string in JSON", length);
+    }
+  }
+
+  size_t size() const { return count_; }
+  uint32_t operator[](size_t i) const { return positions_[i]; }
+
+private:
+  std::unique_ptr<uint32_t[]> positions_;
+  size_t capacity_ = 0;
+  size_t count_ = 0;
+};
+
+/**
+ * Stage 2: pull-style reader over the structural index.
+ *
+ * Each read_* call consumes one value. Views returned by read_string() may
+ * point into an internal buffer and stay valid only until the next
+ * read_string() call.
+ */
+class Reader {
+public:
+  static constexpr int MAX_DEPTH = 1024;
+
+  Reader(const char* data, size_t length) : data_(data), length_(length) {
+    index_.build(data, length);
+  }
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  /** Current structural character, or '\0' at the end of input */
+  char peek() const {
+    return pos_ < index_.size() ? data_[index_[pos_]] : '\0';
+  }
+
+  /** Byte offset of the current token */
+  size_t offset() const {
+    return pos_ < index_.size() ? index_[pos_] : length_;
+  }
+
+  [[noreturn]] void fail(const char* what) const {
+    throw ParseError(std::string(what) + " in JSON at position " + std::to_string(offset()), offset());
+  }
+
+  [[noreturn]] void unexpected() const {
+    if (pos_ >= index_.size()) {
+      throw ParseError("Unexpected end of JSON input", length_);
+    }
+    throw ParseError(std::string("Unexpected token ") + data_[index_[pos_]] +
+                     " in JSON at position " + std::to_string(offset()), offset());
+  }
+
+  /** Consume the current token if it is c */
+  bool consume(char c) {
+    if (peek() != c) return false;
+    ++pos_;
+    return true;
+  }
+
+  void expect(char c) {
+    if (!consume(c)) unexpected();
+  }
+
+  /** Require that the whole input has been consumed */
+  void finish() const {
+    if (pos_ != index_.size()) unexpected();
+  }
+
+  // ==========================================================================
+  // Scalars
+  // ==========================================================================
+
+  bool read_bool() {
+    if (literal("true")) return true;
+    if (literal("false")) return false;
+    unexpected();
+  }
+
+  void read_null() {
+    if (!literal("null")) unexpected();
+  }
+
+  /** Consume a null if one is next */
+  bool try_null() {
+    return peek() == 'n' && literal("null");
+  }
+
+  double read_number() {
+    if (pos_ >= index_.size()) unexpected();
+    const char* start = data_ + index_[pos_];
+    const char* end = data_ + length_;
+    const char* p = start;
+
+    bool negative = *p == '-';
+    if (negative) ++p;
+    if (p == end || *p < '0' || *p > '9') unexpected();
+
+    // Integer part (no leading zeros)
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    if (*p == '0') {
+      ++p;
+    } else {
+      while (p != end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+          if (mantissa) ++digits;
+        } else {
+          ++exponent;  // Digits beyond 19 only matter for the slow path
+          digits = 20;
+        }
+        ++p;
+      }
+    }
+
+    // Fraction
+    if (p != end && *p == '.') {
+      ++p;
+      if (p == end || *p < '0' || *p > '9') fail("Unterminated fractional number");
+      while (p != end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+          if (mantissa) ++digits;
+          --exponent;
+        } else {
+          digits = 20;
+        }
+        ++p;
+      }
+    }
+
+    // Exponent
+    if (p != end && (*p == 'e' || *p == 'E')) {
+      ++p;
+      bool exp_negative = false;
+      if (p != end && (*p == '+' || *p == '-')) {
+        exp_negative = *p == '-';
+        ++p;
+      }
+      if (p == end || *p < '0' || *p > '9') fail("Exponent part is missing a number");
+      int exp_value = 0;
+      while (p != end && *p >= '0' && *p <= '9') {
+        if (exp_value < 100000) exp_value = exp_value * 10 + (*p - '0');
+        ++p;
+      }
+      exponent += exp_negative ? -exp_value : exp_value;
+    }
+
+    if (p != end && !detail::is_delimiter(*p)) unexpected_at(p);
+    ++pos_;
+
+    // Exact when the mantissa and the power of ten are both exact doubles
+    if (digits <= 19 && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+      double value = static_cast<double>(mantissa);
+      value = exponent < 0 ? value / detail::POW10[-exponent] : value * detail::POW10[exponent];
+      return negative ? -value : value;
+    }
+    std::string text(start, static_cast<size_t>(p - start));
+    return std::strtod(text.c_str(), nullptr);
+  }
+
+  std::string_view read_string() {
+    if (peek() != '"') unexpected();
+    const char* start = data_ + index_[pos_] + 1;
+    const char* end = data_ + length_;
+    const char* p = start;
+    ++pos_;
+
+    // Fast path: no escapes, view straight into the input
+    while (p != end && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20) ++p;
+    if (p != end && *p == '"') {
+      return std::string_view(start, static_cast<size_t>(p - start));
+    }
+
+    scratch_.assign(start, static_cast<size_t>(p - start));
+    while (p != end) {
+      char c = *p;
+      if (c == '"') {
+        return std::string_view(scratch_);
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        unexpected_at(p);
+      }
+      if (c != '\\') {
+        scratch_.push_back(c);
+        ++p;
+        continue;
+      }
+      if (++p == end) break;
+      switch (*p) {
+        case '"': scratch_.push_back('"'); break;
+        case '\\': scratch_.push_back('\\'); break;
+        case '/': scratch_.push_back('/'); break;
+        case 'b': scratch_.push_back('\b'); break;
+        case 'f': scratch_.push_back('\f'); break;
+        case 'n': scratch_.push_back('\n'); break;
+        case 'r': scratch_.push_back('\r'); break;
+        case 't': scratch_.push_back('\t'); break;
+        case 'u': {
+          uint32_t cp = hex4(p + 1, end);
+          p += 4;
+          // Combine a surrogate pair; lone surrogates are kept as-is
+          if (cp >= 0xD800 && cp <= 0xDBFF && end - p > 6 && p[1] == '\\' && p[2] == 'u') {
+            uint32_t low = hex4(p + 3, end);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+              cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+              p += 6;
+            }
+          }
+          detail::append_utf8(scratch_, cp);
+          break;
+        }
+        default:
+          fail("Bad escaped character");
+      }
+      ++p;
+    }
+    throw ParseError("Unterminated string in JSON", length_);
+  }
+
+  // ==========================================================================
+  // Containers
+  // ==========================================================================
+
+  /** Calls on_field(key) for each member; on_field must consume the value */
+  template<typename Fn>
+  void read_object(Fn&& on_field) {
+    expect('{');
+    enter();
+    if (!consume('}')) {
+      do {
+        std::string_view key = read_string();
+        expect(':');
+        on_field(key);
+      } while (consume(','));
+      expect('}');
+    }
+    --depth_;
+  }
+
+  /** Calls on_element() for each element; on_element must consume it */
+  template<typename Fn>
+  void read_array(Fn&& on_element) {
+    expect('[');
+    enter();
+    if (!consume(']')) {
+      do {
+        on_element();
+      } while (consume(','));
+      expect(']');
+    }
+    --depth_;
+  }
+
+  /** Consume (and validate) one value of any type */
+  void skip_value() {
+    switch (peek()) {
+      case '{':
+        read_object([this](std::string_view) { skip_value(); });
+        break;
+      case '[':
+        read_array([this] { skip_value(); });
+        break;
+      case '"':
+        read_string();
+        break;
+      case 't':
+      case 'f':
+        read_bool();
+        break;
+      case 'n':
+        read_null();
+        break;
+      default:
+        read_number();
+        break;
+    }
+  }
+
+private:
+  const char* data_;
+  size_t length_;
+  StructuralIndex index_;
+  size_t pos_ = 0;
+  int depth_ = 0;
+  std::string scratch_;
+
+  void enter() {
+    if (++depth_ > MAX_DEPTH) fail("Maximum nesting depth exceeded");
+  }
+
+  [[noreturn]] void unexpected_at(const char* p) const {
+    size_t at = static_cast<size_t>(p - data_);
+    throw ParseError(std::string("Unexpected token ") + *p + " in JSON at position " + std::to_string(at), at);
+  }
+
+  // Literal starting at the current token, followed by a delimiter or the end
+  bool literal(const char* word) {
+    if (pos_ >= index_.size()) return false;
+    size_t len = std::strlen(word);
+    size_t at = index_[pos_];
+    if (length_ - at < len || std::memcmp(data_ + at, word, len) != 0) return false;
+    if (at + len < length_ && !detail::is_delimiter(data_[at + len])) return false;
+    ++pos_;
+    return true;
+  }
+
+  uint32_t hex4(const char* p, const char* end) const {
+    if (end - p < 4) fail("Bad Unicode escape");
+    uint32_t cp = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = p[i];
+      cp <<= 4;
+      if (c >= '0' && c <= '9') cp |= static_cast<uint32_t>(c - '0');
+      else if (c >= 'a' && c <= 'f') cp |= static_cast<uint32_t>(c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F') cp |= static_cast<uint32_t>(c - 'A' + 10);
+      else fail("Bad Unicode escape");
+    }
+    return cp;
+  }
+};
+
+// ============================================================================
+// Typed decoding
+// ============================================================================
+//
+// gs_json_decode(in, out) reads one value into out. Overloads live next to
+// the types they decode and are found by argument-dependent lookup; those
+// below are found through Reader's namespace.
+
+inline void gs_json_decode(Reader& in, double& out) {
+  out = in.read_number();
+}
+
+inline void gs_json_decode(Reader& in, bool& out) {
+  out = in.read_bool();
+}
+
+inline void gs_json_decode(Reader& in, int32_t& out) {
+  double value = in.read_number();
+  if (value != std::trunc(value) || value < INT32_MIN || value > INT32_MAX) {
+    in.fail("Expected an integer");
+  }
+  out = static_cast<int32_t>(value);
+}
+
+inline void gs_json_decode(Reader& in, int64_t& out) {
+  double value = in.read_number();
+  if (value != std::trunc(value) || std::fabs(value) > 9007199254740991.0) {
+    in.fail("Expected an integer");
+  }
+  out = static_cast<int64_t>(value);
+}
+
+template<typename T>
+void gs_json_decode(Reader& in, std::optional<T>& out) {
+  if (in.try_null()) {
+    out.reset();
+    return;
+  }
+  T value{};
+  gs_json_decode(in, value);
+  out = std::move(value);
+}
+
+} // namespace json
+} // namespace gs
@@ -0,0 +1,232 @@
+#pragma once
+
+/**
+ * GoodScript JSON Writer
+ *
+ * Building blocks for JSON.stringify in both runtimes. Output goes straight
+ * into one growable buffer (the runtime's StringBuilder, or any type with
+ * append(const char*, size_t) and append(char)); no value is formatted into
+ * a temporary string first.
+ *
+ * - Numbers use the shortest digit string that round-trips (std::to_chars,
+ *   Ryu-based in both libstdc++ and libc++) laid out the way JavaScript's
+ *   Number.prototype.toString does: 0.1 -> "0.1", 1e21 -> "1e+21",
+ *   1e-7 -> "1e-7". Integral values skip the floating-point path entirely.
+ * - Strings are scanned 16 bytes at a time (SSE2) or 8 (SWAR) for the next
+ *   byte that needs escaping, so clean runs are copied with a single append.
+ *
+ * Each runtime defines gs_json_encode(StringBuilder&, const T&) overloads
+ * on top of these; codegen emits one per generated class, interface and
+ * object literal struct that reaches JSON.stringify.
+ */
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) && !defined(GS_JSON_PORTABLE)
+#include <emmintrin.h>
+#define GS_JSON_WRITER_SSE2 1
+#endif
+
+namespace gs {
+namespace json {
+
+/** Buffer size sufficient for any format_number() result */
+constexpr size_t NUMBER_BUFFER_SIZE = 32;
+
+/**
+ * Formats value like JavaScript's String(value) into buf (at least
+ * NUMBER_BUFFER_SIZE bytes) and returns the length. Not null-terminated.
+ */
+inline size_t format_number(double value, char* buf) {
+  if (std::isnan(value)) {
+    std::memcpy(buf, "NaN", 3);
+    return 3;
+  }
+  if (std::isinf(value)) {
+    if (value < 0) {
+      std::memcpy(buf, "-Infinity", 9);
+      return 9;
+    }
+    std::memcpy(buf, "Infinity", 8);
+    return 8;
+  }
+  if (value == 0) {
+    buf[0] = '0';  // Also -0
+    return 1;
+  }
+
+  // Integers below 2^53 print exactly as themselves
+  if (std::fabs(value) < 9007199254740992.0 && value == std::trunc(value)) {
+    return static_cast<size_t>(
+      std::to_chars(buf, buf + NUMBER_BUFFER_SIZE, static_cast<int64_t>(value)).ptr - buf);
+  }
+
+  // Shortest round-trip digits in scientific form: [-]d[.ddd]e[+-]xx
+  char sci[NUMBER_BUFFER_SIZE];
+  char* end = std::to_chars(sci, sci + sizeof(sci), value, std::chars_format::scientific).ptr;
+
+  const char* p = sci;
+  char* out = buf;
+  if (*p == '-') {
+    *out++ = '-';
+    ++p;
+  }
+
+  char digits[20];
+  int k = 0;
+  for (; p < end && *p != 'e'; ++p) {
+    if (*p != '.') digits[k++] = *p;
+  }
+  // Exponent: p is at 'e', followed by the sign and at least two digits
+  bool negative_exponent = p[1] == '-';
+  int exponent = 0;
+  for (p += 2; p < end; ++p) {
+    exponent = exponent * 10 + (*p - '0');
+  }
+  if (negative_exponent) exponent = -exponent;
+
+  // JavaScript layout (ECMA-262 Number::toString): n is the position of the
+  // decimal point relative to the digit string
+  int n = exponent + 1;
+  if (k <= n && n <= 21) {
+    std::memcpy(out, digits, k);
+    out += k;
+    for (int i = k; i < n; ++i) *out++ = '0';
+  } else if (0 < n && n <= 21) {
+    std::memcpy(out, digits, n);
+    out += n;
+    *out++ = '.';
+    std::memcpy(out, digits + n, k - n);
+    out += k - n;
+  } else if (-6 < n && n <= 0) {
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = n; i < 0; ++i) *out++ = '0';
+    std::memcpy(out, digits, k);
+    out += k;
+  } else {
+    *out++ = digits[0];
+    if (k > 1) {
+      *out++ = '.';
+      std::memcpy(out, digits + 1, k - 1);
+      out += k - 1;
+    }
+    *out++ = 'e';
+    *out++ = exponent < 0 ? '-' : '+';
+    out = std::to_chars(out, buf + NUMBER_BUFFER_SIZE, std::abs(exponent)).ptr;
+  }
+  return static_cast<size_t>(out - buf);
+}
+
+/** Appends value as a JSON number (NaN and Infinity become null) */
+template<typename Out>
+void write_number(Out& out, double value) {
+  if (!std::isfinite(value)) {
+    out.append("null", 4);
+    return;
+  }
+  char buf[NUMBER_BUFFER_SIZE];
+  out.append(buf, format_number(value, buf));
+}
+
+template<typename Out>
+void write_integer(Out& out, int64_t value) {
+  char buf[NUMBER_BUFFER_SIZE];
+  out.append(buf, static_cast<size_t>(std::to_chars(buf, buf + sizeof(buf), value).ptr - buf));
+}
+
+template<typename Out>
+void write_bool(Out& out, bool value) {
+  if (value) {
+    out.append("true", 4);
+  } else {
+    out.append("false", 5);
+  }
+}
+
+namespace detail {
+
+// Offset of the first byte in [data, data + len) that must be escaped
+// (a control character, '"' or '\\'), or len if there is none
+inline size_t find_escape(const char* data, size_t len) {
+  size_t i = 0;
+#ifdef GS_JSON_WRITER_SSE2
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1F);
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i hit = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+      _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));  // v <= 0x1F, unsigned
+    int mask = _mm_movemask_epi8(hit);
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+  }
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+  constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t w;
+    std::memcpy(&w, data + i, 8);
+    uint64_t q = w ^ (LOW_BITS * '"');
+    uint64_t b = w ^ (LOW_BITS * '\\');
+    // Zero-byte and less-than tests; a false positive can only appear
+    // above a true one, so the lowest flagged byte is exact
+    uint64_t hit = ((q - LOW_BITS) & ~q) | ((b - LOW_BITS) & ~b) | ((w - LOW_BITS * 0x20) & ~w);
+    hit &= HIGH_BITS;
+    if (hit != 0) {
+      return i + static_cast<size_t>(__builtin_ctzll(hit) >> 3);
+    }
+  }
+#endif
+  for (; i < len; ++i) {
+    unsigned char c = static_cast<unsigned char>(data[i]);
+    if (c < 0x20 || c == '"' || c == '\\') return i;
+  }
+  return len;
+}
+
+} // namespace detail
+
+/** Appends s as a quoted JSON string, escaping as JSON.stringify does */
+template<typename Out>
+void write_string(Out& out, std::string_view s) {
+  static const char HEX[] = "0123456789abcdef";
+  out.append('"');
+  const char* data = s.data();
+  size_t len = s.size();
+  while (len > 0) {
+    size_t clean = detail::find_escape(data, len);
+    if (clean > 0) out.append(data, clean);
+    if (clean == len) break;
+
+    unsigned char c = static_cast<unsigned char>(data[clean]);
+    switch (c) {
+      case '"': out.append("\\\"", 2); break;
+      case '\\': out.append("\\\\", 2); break;
+      case '\b': out.append("\\b", 2); break;
+      case '\f': out.append("\\f", 2); break;
+      case '\n': out.append("\\n", 2); break;
+      case '\r': out.append("\\r", 2); break;
+      case '\t': out.append("\\t", 2); break;
+      default: {
+        char esc[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+        out.append(esc, 6);
+        break;
+      }
+    }
+    data += clean + 1;
+    len -= clean + 1;
+  }
+  out.append('"');
+}
+
+} // namespace json
+} // namespace gs
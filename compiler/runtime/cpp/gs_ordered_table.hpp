@@ -0,0 +1,374 @@
+#pragma once
+
+/**
+ * GoodScript Ordered Hash Table
+ *
+ * Insertion-ordered hash table behind Map and Set in both runtimes, laid
+ * out like the V8 and CPython dictionaries:
+ *
+ * - entries_: dense array of slots in insertion order. A slot holds the
+ *   value (std::pair<K, V> for Map, T for Set), 32 bits of its hash and an
+ *   explicit tombstone flag, so each key is stored exactly once and
+ *   iteration is a linear scan that skips tombstones.
+ * - index_: open-addressed (linear probing) array of uint32_t positions
+ *   into entries_, EMPTY when unused. Its size is a power of two and it is
+ *   kept at most 3/4 full, so a lookup is one hash, a few 4-byte probes and
+ *   normally a single key comparison (the stored hash bits reject the rest).
+ *
+ * Deleting marks the slot as a tombstone and resets its value; the index
+ * keeps pointing at it until the next rebuild. Once tombstones outnumber
+ * live entries the table compacts, preserving insertion order.
+ *
+ * Both arrays come from a Storage policy: HeapTableStorage (ownership
+ * mode) uses the C++ heap, the GC runtime supplies GcTableStorage so the
+ * collector can see keys and values (gc/table-storage.hpp).
+ *
+ * Pointers to values stay valid until the next insertion or deletion.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gs {
+
+namespace gc {
+template<typename T> struct Trace;
+}
+
+// KeyOf for Map entries: the key of a std::pair<K, V>
+struct PairKey {
+  template<typename P>
+  const auto& operator()(const P& entry) const { return entry.first; }
+};
+
+// KeyOf for Set entries: the value is its own key
+struct IdentityKey {
+  template<typename T>
+  const T& operator()(const T& value) const { return value; }
+};
+
+// One entry of the dense array (value first, so it sits at offset 0)
+template<typename Value>
+struct OrderedSlot {
+  Value value;
+  uint32_t hash;
+  bool deleted;
+};
+
+// Default storage: the C++ heap
+struct HeapTableStorage {
+  template<typename T>
+  static T* allocate(size_t count) {
+    return std::allocator<T>().allocate(count);
+  }
+
+  template<typename T>
+  static void deallocate(T* data, size_t count) {
+    std::allocator<T>().deallocate(data, count);
+  }
+};
+
+template<typename K, typename Value, typename KeyOf, typename Storage = HeapTableStorage>
+class OrderedHashTable {
+public:
+  using Slot = OrderedSlot<Value>;
+
+private:
+  static constexpr uint32_t EMPTY = UINT32_MAX;
+  static constexpr size_t MIN_INDEX_SIZE = 8;
+  static constexpr size_t MIN_CAPACITY = 4;
+
+  Slot* entries_ = nullptr;   // Insertion-ordered slots (with tombstones)
+  size_t count_ = 0;          // Slots in use, tombstones included
+  size_t capacity_ = 0;       // Slots allocated
+  uint32_t* index_ = nullptr; // Hash -> position in entries_
+  size_t index_size_ = 0;     // Power of two, or 0 before the first insert
+  size_t live_ = 0;           // Entries that are not tombstones
+
+  template<typename> friend struct gc::Trace;
+
+  // Can the index take one more entry without exceeding 3/4 load?
+  bool has_room() const {
+    return (count_ + 1) * 4 <= index_size_ * 3;
+  }
+
+  // Smallest power-of-two index size that holds count entries at 3/4 load
+  static size_t index_size_for(size_t count) {
+    size_t size = MIN_INDEX_SIZE;
+    while (count * 4 > size * 3) size <<= 1;
+    return size;
+  }
+
+  void rebuild_index(size_t size) {
+    if (size != index_size_) {
+      if (index_) Storage::deallocate(index_, index_size_);
+      index_ = Storage::template allocate<uint32_t>(size);
+      index_size_ = size;
+    }
+    std::fill(index_, index_ + size, EMPTY);
+    size_t mask = size - 1;
+    for (size_t i = 0; i < count_; ++i) {
+      if (entries_[i].deleted) continue;
+      size_t pos = entries_[i].hash & mask;
+      while (index_[pos] != EMPTY) pos = (pos + 1) & mask;
+      index_[pos] = static_cast<uint32_t>(i);
+    }
+  }
+
+  // Move the slots into a new array of the given capacity, dropping
+  // tombstones when compact is set (order preserved)
+  void relocate(size_t capacity, bool compact) {
+    Slot* entries = Storage::template allocate<Slot>(capacity);
+    size_t out = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      if (compact && entries_[i].deleted) continue;
+      new (&entries[out++]) Slot(std::move(entries_[i]));
+    }
+    destroy_entries();
+    entries_ = entries;
+    count_ = out;
+    capacity_ = capacity;
+  }
+
+  // Drop tombstones in place (order preserved)
+  void compact_in_place() {
+    size_t out = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      if (entries_[i].deleted) continue;
+      if (out != i) entries_[out] = std::move(entries_[i]);
+      ++out;
+    }
+    for (size_t i = out; i < count_; ++i) entries_[i].~Slot();
+    count_ = out;
+  }
+
+  // Make room for one more entry: compact if mostly tombstones, else grow
+  void grow() {
+    size_t tombstones = count_ - live_;
+    size_t size = index_size_ == 0 ? MIN_INDEX_SIZE
+                : (tombstones >= live_ ? index_size_ : index_size_ * 2);
+    size = std::max(size, index_size_for(live_ + 1));
+    if (tombstones > 0) compact_in_place();
+    rebuild_index(size);
+  }
+
+  void destroy_entries() {
+    if (!entries_) return;
+    for (size_t i = 0; i < count_; ++i) entries_[i].~Slot();
+    Storage::deallocate(entries_, capacity_);
+    entries_ = nullptr;
+    count_ = 0;
+    capacity_ = 0;
+  }
+
+  void release() {
+    destroy_entries();
+    if (index_) Storage::deallocate(index_, index_size_);
+    index_ = nullptr;
+    index_size_ = 0;
+    live_ = 0;
+  }
+
+  void copy_from(const OrderedHashTable& other) {
+    if (other.live_ == 0) return;
+    entries_ = Storage::template allocate<Slot>(other.live_);
+    capacity_ = other.live_;
+    for (size_t i = 0; i < other.count_; ++i) {
+      if (other.entries_[i].deleted) continue;
+      new (&entries_[count_++]) Slot(other.entries_[i]);
+    }
+    live_ = count_;
+    rebuild_index(index_size_for(live_));
+  }
+
+  void take_from(OrderedHashTable& other) noexcept {
+    entries_ = other.entries_;
+    count_ = other.count_;
+    capacity_ = other.capacity_;
+    index_ = other.index_;
+    index_size_ = other.index_size_;
+    live_ = other.live_;
+    other.entries_ = nullptr;
+    other.count_ = other.capacity_ = 0;
+    other.index_ = nullptr;
+    other.index_size_ = 0;
+    other.live_ = 0;
+  }
+
+public:
+  template<bool Const>
+  class basic_iterator {
+  private:
+    using SlotPtr = std::conditional_t<Const, const Slot*, Slot*>;
+    SlotPtr current_;
+    SlotPtr end_;
+
+    void skip_tombstones() {
+      while (current_ != end_ && current_->deleted) {
+        ++current_;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Value*, Value*>;
+    using reference = std::conditional_t<Const, const Value&, Value&>;
+
+    basic_iterator(SlotPtr current, SlotPtr end) : current_(current), end_(end) {
+      skip_tombstones();
+    }
+
+    // iterator -> const_iterator
+    template<bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false>& other)
+      : current_(other.current_), end_(other.end_) {}
+
+    reference operator*() const { return current_->value; }
+    pointer operator->() const { return &current_->value; }
+
+    basic_iterator& operator++() {
+      ++current_;
+      skip_tombstones();
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const basic_iterator& other) const {
+      return current_ == other.current_;
+    }
+
+    bool operator!=(const basic_iterator& other) const {
+      return current_ != other.current_;
+    }
+
+    friend class basic_iterator<true>;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  OrderedHashTable() = default;
+
+  OrderedHashTable(const OrderedHashTable& other) {
+    copy_from(other);
+  }
+
+  OrderedHashTable(OrderedHashTable&& other) noexcept {
+    take_from(other);
+  }
+
+  OrderedHashTable& operator=(const OrderedHashTable& other) {
+    if (this != &other) {
+      release();
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  OrderedHashTable& operator=(OrderedHashTable&& other) noexcept {
+    if (this != &other) {
+      release();
+      take_from(other);
+    }
+    return *this;
+  }
+
+  ~OrderedHashTable() {
+    release();
+  }
+
+  size_t size() const { return live_; }
+  bool empty() const { return live_ == 0; }
+
+  // 32 hash bits: std::hash mixed with a Fibonacci multiply so identity
+  // hashes (pointers, integers) still spread over the low bits
+  static uint32_t hash_of(const K& key) {
+    uint64_t h = static_cast<uint64_t>(std::hash<K>{}(key));
+    return static_cast<uint32_t>((h * 0x9E3779B97F4A7C15ull) >> 32);
+  }
+
+  static constexpr size_t npos = SIZE_MAX;
+
+  // Position of key in entries_, or npos
+  size_t find_pos(const K& key, uint32_t hash) const {
+    if (index_size_ == 0) return npos;
+    size_t mask = index_size_ - 1;
+    for (size_t pos = hash & mask; index_[pos] != EMPTY; pos = (pos + 1) & mask) {
+      const Slot& slot = entries_[index_[pos]];
+      if (slot.hash == hash && !slot.deleted && KeyOf{}(slot.value) == key) {
+        return index_[pos];
+      }
+    }
+    return npos;
+  }
+
+  Value* find(const K& key, uint32_t hash) {
+    size_t i = find_pos(key, hash);
+    return i == npos ? nullptr : &entries_[i].value;
+  }
+
+  const Value* find(const K& key, uint32_t hash) const {
+    size_t i = find_pos(key, hash);
+    return i == npos ? nullptr : &entries_[i].value;
+  }
+
+  Value* find(const K& key) { return find(key, hash_of(key)); }
+  const Value* find(const K& key) const { return find(key, hash_of(key)); }
+
+  // Append a value whose key is known to be absent (hash from hash_of)
+  Value& append(Value value, uint32_t hash) {
+    if (!has_room()) grow();
+    if (count_ == capacity_) relocate(std::max(MIN_CAPACITY, capacity_ * 2), false);
+    size_t mask = index_size_ - 1;
+    size_t pos = hash & mask;
+    while (index_[pos] != EMPTY) pos = (pos + 1) & mask;
+    index_[pos] = static_cast<uint32_t>(count_);
+    Slot* slot = new (&entries_[count_++]) Slot{std::move(value), hash, false};
+    ++live_;
+    return slot->value;
+  }
+
+  bool erase(const K& key) {
+    size_t i = find_pos(key, hash_of(key));
+    if (i == npos) return false;
+    entries_[i].deleted = true;
+    entries_[i].value = Value{};  // Release the key/value now rather than at compaction
+    --live_;
+    // Keep iteration linear in the live size
+    if (count_ > 32 && count_ - live_ > live_) {
+      compact_in_place();
+      rebuild_index(index_size_);
+    }
+    return true;
+  }
+
+  void clear() {
+    release();
+  }
+
+  void reserve(size_t count) {
+    if (count > capacity_) relocate(count, false);
+    if (count * 4 > index_size_ * 3) rebuild_index(index_size_for(count));
+  }
+
+  iterator begin() { return iterator(entries_, entries_ + count_); }
+  iterator end() { return iterator(entries_ + count_, entries_ + count_); }
+  const_iterator begin() const { return const_iterator(entries_, entries_ + count_); }
+  const_iterator end() const { return const_iterator(entries_ + count_, entries_ + count_); }
+};
+
+} // namespace gs
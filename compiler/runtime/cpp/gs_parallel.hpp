@@ -0,0 +1,430 @@
+#pragma once
+
+/**
+ * GoodScript Data-Parallel Array Operations
+ *
+ * Parallel.map/filter/reduce/sort split an Array into chunks and run them on
+ * a process-wide pool of worker threads. The compiler only accepts
+ * callbacks that capture no shared mutable state (GS306), so the chunks can
+ * run in any order on any thread and the result is the same as the
+ * sequential Array method's.
+ *
+ * Scheduling is work stealing: each participating thread (the caller
+ * included) starts with an even share of the chunk indices and takes them
+ * from the front; a thread that runs dry steals the back half of another
+ * thread's share. Uneven callbacks therefore keep every core busy without a
+ * shared queue.
+ *
+ * Arrays shorter than SERIAL_CUTOFF, calls made from inside a parallel
+ * callback, and calls made while another thread owns the pool run
+ * sequentially on the calling thread. So do all calls in builds without
+ * threads (wasm32-wasi) and with the precise GC (GS_GC_AMC), whose single
+ * allocation point and stack scanning only cover the main thread.
+ *
+ * Included by each runtime header right after its Array template.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gs {
+namespace parallel_detail {
+
+#if defined(__wasi__) || defined(GS_GC_AMC)
+constexpr bool THREADS_ENABLED = false;
+#else
+constexpr bool THREADS_ENABLED = true;
+#endif
+
+// Below this many elements a parallel call is not worth waking the pool
+constexpr size_t SERIAL_CUTOFF = 4096;
+
+// Elements per chunk at least, and chunks per thread at most
+constexpr size_t MIN_CHUNK = 1024;
+constexpr size_t CHUNKS_PER_THREAD = 8;
+
+/**
+ * Fork-join pool of hardware_concurrency() - 1 threads (GS_PARALLEL_THREADS
+ * - 1 when set), started on first use. run() blocks until every chunk is
+ * done and rethrows the first exception a chunk raised (later chunks are
+ * then skipped).
+ */
+class WorkerPool {
+public:
+  static WorkerPool& instance() {
+    static WorkerPool pool;
+    return pool;
+  }
+
+  /** Threads taking part in a parallel run, the caller included */
+  size_t concurrency() const { return workers_.size() + 1; }
+
+  /** Calls body(chunk) once for every chunk in [0, chunks) */
+  template<typename F>
+  void run(size_t chunks, F& body) {
+    std::unique_lock<std::mutex> owner(run_mutex_, std::defer_lock);
+    if (inside_run() || chunks < 2 || workers_.empty() || !owner.try_lock()) {
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        body(chunk);
+      }
+      return;
+    }
+
+    // Even initial shares; threads past the chunk count get none
+    size_t participants = std::min(concurrency(), chunks);
+    for (size_t p = 0; p < slots_.size(); ++p) {
+      size_t begin = p < participants ? chunks * p / participants : 0;
+      size_t end = p < participants ? chunks * (p + 1) / participants : 0;
+      slots_[p].range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      invoke_ = [](void* fn, size_t chunk) { (*static_cast<F*>(fn))(chunk); };
+      body_ = &body;
+      participants_ = participants;
+      total_ = chunks;
+      done_.store(0, std::memory_order_relaxed);
+      failed_.store(false, std::memory_order_relaxed);
+      error_ = nullptr;
+      accepting_ = true;
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    participate(0);
+
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      accepting_ = false;
+      idle_.wait(lock, [&] {
+        return done_.load(std::memory_order_acquire) == total_ && active_ == 0;
+      });
+      error = error_;
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+private:
+  // A share of chunk indices [lo, hi), packed so one CAS can update it
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> range{0};
+  };
+
+  std::vector<std::thread> workers_;
+  std::vector<Slot> slots_;
+
+  std::mutex run_mutex_;  // Held by the thread that owns the current run
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  uint64_t generation_ = 0;
+  bool accepting_ = false;
+  bool stopping_ = false;
+  size_t active_ = 0;
+
+  // Current run
+  void (*invoke_)(void*, size_t) = nullptr;
+  void* body_ = nullptr;
+  size_t participants_ = 0;
+  size_t total_ = 0;
+  std::atomic<size_t> done_{0};
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+
+  WorkerPool() : slots_(thread_count()) {
+    for (size_t p = 1; p < slots_.size(); ++p) {
+      workers_.emplace_back([this, p] { work(p); });
+    }
+  }
+
+  // GS_PARALLEL_THREADS overrides the hardware thread count
+  static size_t thread_count() {
+    if (!THREADS_ENABLED) return 1;
+    if (const char* env = std::getenv("GS_PARALLEL_THREADS")) {
+      long count = std::strtol(env, nullptr, 10);
+      if (count > 0) return static_cast<size_t>(std::min(count, 256L));
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  static bool& inside_run() {
+    static thread_local bool inside = false;
+    return inside;
+  }
+
+  static uint64_t pack(uint64_t lo, uint64_t hi) { return (hi << 32) | lo; }
+  static uint64_t lo(uint64_t range) { return range & 0xffffffffu; }
+  static uint64_t hi(uint64_t range) { return range >> 32; }
+
+  void work(size_t p) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [&] { return stopping_ || (accepting_ && generation_ != seen); });
+      if (stopping_) return;
+      seen = generation_;
+      if (p >= participants_) continue;
+
+      ++active_;
+      lock.unlock();
+      participate(p);
+      lock.lock();
+      if (--active_ == 0) {
+        idle_.notify_all();
+      }
+    }
+  }
+
+  void participate(size_t p) {
+    inside_run() = true;
+    size_t chunk;
+    while (take(p, chunk) || steal(p, chunk)) {
+      execute(chunk);
+    }
+    inside_run() = false;
+  }
+
+  // Next chunk from the front of this thread's own share
+  bool take(size_t p, size_t& chunk) {
+    auto& range = slots_[p].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    while (lo(current) < hi(current)) {
+      if (range.compare_exchange_weak(current, pack(lo(current) + 1, hi(current)),
+                                      std::memory_order_acq_rel)) {
+        chunk = lo(current);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Moves the back half of another thread's share into this thread's
+  // (empty) share and takes its first chunk
+  bool steal(size_t p, size_t& chunk) {
+    for (size_t i = 1; i < participants_; ++i) {
+      auto& victim = slots_[(p + i) % participants_].range;
+      uint64_t current = victim.load(std::memory_order_acquire);
+      while (lo(current) < hi(current)) {
+        uint64_t mid = lo(current) + (hi(current) - lo(current)) / 2;
+        if (victim.compare_exchange_weak(current, pack(lo(current), mid),
+                                         std::memory_order_acq_rel)) {
+          chunk = mid;
+          slots_[p].range.store(pack(mid + 1, hi(current)), std::memory_order_release);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void execute(size_t chunk) {
+    if (!failed_.load(std::memory_order_relaxed)) {
+      try {
+        invoke_(body_, chunk);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+        failed_.store(true, std::memory_order_relaxed);
+      }
+    }
+    if (done_.fetch_add(1, std::memory_order_acq_rel) + 1 == total_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      idle_.notify_all();
+    }
+  }
+};
+
+/** Number of chunks to split n elements into (1: run sequentially) */
+inline size_t chunk_count(size_t n) {
+  size_t threads = WorkerPool::instance().concurrency();
+  if (n < SERIAL_CUTOFF || threads == 1) return 1;
+  size_t most = threads * CHUNKS_PER_THREAD;
+  return std::max<size_t>(1, std::min(n / MIN_CHUNK, most));
+}
+
+/** Calls body(chunk, begin, end) for the element range of every chunk */
+template<typename F>
+void for_each_chunk(size_t n, size_t chunks, F body) {
+  auto run_chunk = [&](size_t chunk) {
+    body(chunk, n * chunk / chunks, n * (chunk + 1) / chunks);
+  };
+  WorkerPool::instance().run(chunks, run_chunk);
+}
+
+template<typename A>
+using element_t = std::decay_t<decltype(*std::declval<const A&>().begin())>;
+
+} // namespace parallel_detail
+
+/**
+ * Parallel - data-parallel versions of the Array methods
+ *
+ * Results match the sequential methods: map and filter keep element order,
+ * reduce folds with an associative callback, and sort is stable.
+ */
+class Parallel {
+public:
+  template<typename A, typename F>
+  static auto map(const A& array, F callback) {
+    using T = parallel_detail::element_t<A>;
+    using R = std::decay_t<decltype(callback(std::declval<const T&>()))>;
+    return collect<R>(array, [&](const T& value, auto&& sink) {
+      sink(callback(value));
+    });
+  }
+
+  template<typename A, typename F>
+  static A filter(const A& array, F predicate) {
+    using T = parallel_detail::element_t<A>;
+    return collect<T>(array, [&](const T& value, auto&& sink) {
+      if (predicate(value)) sink(value);
+    });
+  }
+
+  /**
+   * Each chunk is folded on its own, then the chunk results are folded into
+   * initialValue in order, so callback must be associative (a + b, max, ...)
+   * but initialValue need not be its identity.
+   */
+  template<typename A, typename F, typename U>
+  static auto reduce(const A& array, F callback, U initialValue) {
+    using T = parallel_detail::element_t<A>;
+    using R = decltype(callback(std::declval<U>(), std::declval<const T&>()));
+    size_t n = array.size();
+    size_t chunks = parallel_detail::chunk_count(n);
+    R accumulator = static_cast<R>(std::move(initialValue));
+    if (chunks == 1) {
+      for (const auto& value : array) {
+        accumulator = callback(std::move(accumulator), value);
+      }
+      return accumulator;
+    }
+
+    std::vector<std::optional<R>> partial(chunks);
+    parallel_detail::for_each_chunk(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      if (begin == end) return;
+      auto it = array.begin() + begin;
+      R folded = static_cast<R>(*it);
+      for (++it; it != array.begin() + end; ++it) {
+        folded = callback(std::move(folded), *it);
+      }
+      partial[chunk].emplace(std::move(folded));
+    });
+
+    for (auto& value : partial) {
+      if (value) accumulator = callback(std::move(accumulator), std::move(*value));
+    }
+    return accumulator;
+  }
+
+  /** Stable sort in place; returns the array, as Array.sort does */
+  template<typename A>
+  static A& sort(A& array) {
+    using T = parallel_detail::element_t<A>;
+    return sort(array, [](const T& a, const T& b) { return a < b ? -1 : (b < a ? 1 : 0); });
+  }
+
+  template<typename A, typename F>
+  static A& sort(A& array, F compareFn) {
+    using T = parallel_detail::element_t<A>;
+    // Packed Array<bool> (ownership mode) sorts by counting, a word at a
+    // time, and its chunks would share words: no worker can beat that
+    if constexpr (std::is_same_v<T, bool>) {
+      array.sort(compareFn);
+      return array;
+    } else {
+      // gs::sorting, as Array.sort uses: elements moved out of the array
+      // wait in collector storage under GS_GC_AMC, where std::stable_sort
+      // and std::inplace_merge would hold them in malloc'd buffers the
+      // collector does not scan while an allocating comparator runs
+      auto less = [&](const T& a, const T& b) { return compareFn(a, b) < 0; };
+      size_t n = array.size();
+      size_t chunks = parallel_detail::chunk_count(n);
+
+      T* first = n > 0 ? &*array.begin() : nullptr;
+      parallel_detail::for_each_chunk(n, chunks, [&](size_t, size_t begin, size_t end) {
+        gs::sorting::stable_sort(first + begin, end - begin, less);
+      });
+
+      // Merge neighbouring sorted runs pairwise until one is left
+      for (size_t width = 1; width < chunks; width *= 2) {
+        size_t merges = (chunks + 2 * width - 1) / (2 * width);
+        auto merge = [&](size_t m) {
+          size_t left = n * (2 * width * m) / chunks;
+          size_t mid = n * std::min(2 * width * m + width, chunks) / chunks;
+          size_t right = n * std::min(2 * width * m + 2 * width, chunks) / chunks;
+          if (mid == left || mid == right) return;
+          gs::sorting::detail::Scratch<T> scratch(std::min(mid - left, right - mid));
+          gs::sorting::detail::merge_runs(first + left, mid - left, right - left, less, scratch);
+        };
+        parallel_detail::WorkerPool::instance().run(merges, merge);
+      }
+      return array;
+    }
+  }
+
+private:
+  // Runs emit(value, sink) over every element, where sink appends to the
+  // output. Chunks collect into their own vector and are concatenated in
+  // order; a single chunk appends straight to the result, so nothing the
+  // GC should see is left in malloc memory while callbacks allocate.
+  template<typename R, typename A, typename F>
+  static Array<R> collect(const A& array, F emit) {
+    size_t n = array.size();
+    size_t chunks = parallel_detail::chunk_count(n);
+    if (chunks == 1) {
+      Array<R> result;
+      result.reserve(n);
+      for (const auto& value : array) {
+        emit(value, [&](auto&& out) { result.push(std::forward<decltype(out)>(out)); });
+      }
+      return result;
+    }
+
+    std::vector<std::vector<R>> partial(chunks);
+    parallel_detail::for_each_chunk(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      auto& out = partial[chunk];
+      out.reserve(end - begin);
+      for (auto it = array.begin() + begin; it != array.begin() + end; ++it) {
+        emit(*it, [&](auto&& value) { out.push_back(std::forward<decltype(value)>(value)); });
+      }
+    });
+
+    size_t total = 0;
+    for (auto& out : partial) total += out.size();
+    Array<R> result;
+    result.reserve(total);
+    for (auto& out : partial) {
+      for (auto& value : out) result.push(std::move(value));
+    }
+    return result;
+  }
+};
+
+} // namespace gs
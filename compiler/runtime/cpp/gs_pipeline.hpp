@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * GoodScript Array Pipelines
+ *
+ * Fused evaluation of map/filter chains in both runtimes. Codegen emits
+ *
+ *   arr.map(f).filter(g).reduce(h, 0)
+ *
+ * as
+ *
+ *   gs::lazy(arr).map(f).filter(g).reduce(h, 0)
+ *
+ * which runs f, g and h in a single loop over arr and allocates no
+ * intermediate Array. map() and filter() only compose stages; the terminal
+ * operation (reduce, forEach, some, every, find or toArray) runs the loop.
+ *
+ * The loop interleaves the callbacks, and some, every and find stop it
+ * early, so f may run on fewer elements than the eager chain would. Codegen
+ * therefore fuses only callbacks free of side effects
+ * (src/backend/cpp/array-pipeline.ts).
+ *
+ * Like the eager Array methods, the loop visits the elements present when
+ * it starts, by index, so a callback that pushes to the source is safe.
+ * The source is held by reference: a pipeline lives within the expression
+ * that builds it.
+ *
+ * Included by each runtime header right after its Array template.
+ */
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace gs {
+
+/**
+ * Elements of type T flowing out of a chain of stages. Gen is called with
+ * a sink and passes it every element that reaches the end of the chain;
+ * the sink returns false to stop the loop early.
+ */
+template<typename T, typename Gen>
+class Pipeline {
+  Gen gen_;
+
+public:
+  using value_type = T;
+
+  explicit Pipeline(Gen gen) : gen_(std::move(gen)) {}
+
+  template<typename F>
+  auto map(F f) && {
+    using R = std::decay_t<decltype(f(std::declval<const T&>()))>;
+    auto gen = [gen = std::move(gen_), f = std::move(f)](auto&& sink) mutable {
+      gen([&](auto&& value) { return sink(f(value)); });
+    };
+    return Pipeline<R, decltype(gen)>(std::move(gen));
+  }
+
+  template<typename F>
+  auto filter(F predicate) && {
+    auto gen = [gen = std::move(gen_), predicate = std::move(predicate)](auto&& sink) mutable {
+      gen([&](auto&& value) {
+        return predicate(value) ? sink(std::forward<decltype(value)>(value)) : true;
+      });
+    };
+    return Pipeline<T, decltype(gen)>(std::move(gen));
+  }
+
+  /** The result type follows the callback, as in Array::reduce */
+  template<typename F, typename U>
+  auto reduce(F callback, U initialValue) && {
+    using R = decltype(callback(std::declval<U>(), std::declval<const T&>()));
+    R accumulator = static_cast<R>(std::move(initialValue));
+    gen_([&](auto&& value) {
+      accumulator = callback(std::move(accumulator), value);
+      return true;
+    });
+    return accumulator;
+  }
+
+  template<typename F>
+  void forEach(F callback) && {
+    gen_([&](auto&& value) {
+      callback(value);
+      return true;
+    });
+  }
+
+  template<typename F>
+  bool some(F predicate) && {
+    bool found = false;
+    gen_([&](auto&& value) {
+      found = static_cast<bool>(predicate(value));
+      return !found;
+    });
+    return found;
+  }
+
+  template<typename F>
+  bool every(F predicate) && {
+    bool all = true;
+    gen_([&](auto&& value) {
+      all = static_cast<bool>(predicate(value));
+      return all;
+    });
+    return all;
+  }
+
+  template<typename F>
+  std::optional<T> find(F predicate) && {
+    std::optional<T> result;
+    gen_([&](auto&& value) {
+      if (predicate(value)) {
+        result.emplace(std::forward<decltype(value)>(value));
+        return false;
+      }
+      return true;
+    });
+    return result;
+  }
+
+  /** Collects the elements into a new Array (a chain ending in map or filter) */
+  Array<T> toArray() && {
+    Array<T> result;
+    gen_([&](auto&& value) {
+      result.push(std::forward<decltype(value)>(value));
+      return true;
+    });
+    return result;
+  }
+};
+
+/** Starts a pipeline over the elements of an Array */
+template<typename A>
+auto lazy(const A& source) {
+  using T = std::decay_t<decltype(*source.begin())>;
+  auto gen = [&source](auto&& sink) {
+    size_t length = source.size();
+    for (size_t i = 0; i < length; ++i) {
+      if (!sink(source.at_ref(static_cast<int>(i)))) {
+        return;
+      }
+    }
+  };
+  return Pipeline<T, decltype(gen)>(std::move(gen));
+}
+
+} // namespace gs
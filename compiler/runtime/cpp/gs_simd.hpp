@@ -0,0 +1,529 @@
+#pragma once
+
+/**
+ * GoodScript Numeric Kernels
+ *
+ * Vectorized scans over Array<number>, Array<integer>, Array<integer53>
+ * (double, int32_t and int64_t elements) and typed arrays in both
+ * runtimes. Codegen emits
+ *
+ *   for (const x of values) { if (x > best) best = x; }
+ *   values.reduce((a, b) => a + b, 0)
+ *
+ * as
+ *
+ *   best = gs::simd::max(values, best);
+ *   gs::simd::sum(values, 0)
+ *
+ * and Array::indexOf/includes search with index_of.
+ *
+ * Every kernel returns exactly what its scalar loop (simd::scalar) returns:
+ *
+ * - sum and dot wrap on integer overflow, like the loop on any target
+ *   this compiler supports. Adding doubles in a different order changes
+ *   the result, so double sum and dot stay scalar unless the program is
+ *   built with GS_FAST_MATH (--gsFastMath).
+ * - max keeps x when x > acc and min when x < acc, the way the loop does:
+ *   NaN elements are skipped and a NaN accumulator stays NaN. Only ±0 can
+ *   tell the lane order apart, so a result of zero is recomputed in order.
+ * - index_of compares with ==: NaN is never found and -0 finds 0.
+ *
+ * x86-64 builds use AVX2 when the CPU has it, checked once at run time
+ * (or always, when compiled with -mavx2 or -mcpu=<cpu with AVX2>).
+ * AArch64 builds always use NEON. Other targets run the scalar loops.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define GS_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define GS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace gs {
+namespace simd {
+
+/** Element types with kernels */
+template<typename T>
+inline constexpr bool is_numeric_v =
+    std::is_same_v<T, double> || std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>;
+
+namespace scalar {
+
+// Integer sums wrap instead of overflowing (undefined for signed types)
+template<typename T>
+inline T add(T a, T b) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+  } else {
+    return a + b;
+  }
+}
+
+template<typename T>
+inline T mul(T a, T b) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+  } else {
+    return a * b;
+  }
+}
+
+template<typename T>
+inline T sum(const T* data, size_t n, T acc) {
+  for (size_t i = 0; i < n; ++i) acc = add(acc, data[i]);
+  return acc;
+}
+
+template<typename T>
+inline T dot(const T* a, const T* b, size_t n, T acc) {
+  for (size_t i = 0; i < n; ++i) acc = add(acc, mul(a[i], b[i]));
+  return acc;
+}
+
+template<typename T>
+inline T max(const T* data, size_t n, T acc) {
+  for (size_t i = 0; i < n; ++i) {
+    if (data[i] > acc) acc = data[i];
+  }
+  return acc;
+}
+
+template<typename T>
+inline T min(const T* data, size_t n, T acc) {
+  for (size_t i = 0; i < n; ++i) {
+    if (data[i] < acc) acc = data[i];
+  }
+  return acc;
+}
+
+template<typename T>
+inline ptrdiff_t index_of(const T* data, size_t n, T value) {
+  for (size_t i = 0; i < n; ++i) {
+    if (data[i] == value) return static_cast<ptrdiff_t>(i);
+  }
+  return -1;
+}
+
+} // namespace scalar
+
+#if GS_SIMD_AVX2
+
+namespace avx2 {
+
+#define GS_AVX2 __attribute__((target("avx2")))
+
+inline bool available() {
+#ifdef __AVX2__
+  return true;
+#else
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#endif
+}
+
+// Lane folds, in lane order
+
+GS_AVX2 inline double max_lanes(__m256d v, double acc) {
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, v);
+  return scalar::max(lanes, 4, acc);
+}
+
+GS_AVX2 inline double min_lanes(__m256d v, double acc) {
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, v);
+  return scalar::min(lanes, 4, acc);
+}
+
+template<typename T>
+GS_AVX2 inline T sum_lanes(__m256i v, T acc) {
+  alignas(32) T lanes[32 / sizeof(T)];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+  return scalar::sum(lanes, 32 / sizeof(T), acc);
+}
+
+template<typename T>
+GS_AVX2 inline T max_lanes(__m256i v, T acc) {
+  alignas(32) T lanes[32 / sizeof(T)];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+  return scalar::max(lanes, 32 / sizeof(T), acc);
+}
+
+template<typename T>
+GS_AVX2 inline T min_lanes(__m256i v, T acc) {
+  alignas(32) T lanes[32 / sizeof(T)];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+  return scalar::min(lanes, 32 / sizeof(T), acc);
+}
+
+GS_AVX2 inline __m256i load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+GS_AVX2 inline __m256i load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+GS_AVX2 inline double sum(const double* data, size_t n, double acc) {
+  __m256d s0 = _mm256_set1_pd(-0.0), s1 = _mm256_set1_pd(-0.0);  // -0 + x is x
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s0 = _mm256_add_pd(s0, _mm256_loadu_pd(data + i));
+    s1 = _mm256_add_pd(s1, _mm256_loadu_pd(data + i + 4));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, _mm256_add_pd(s0, s1));
+  acc = scalar::sum(lanes, 4, acc);
+  return scalar::sum(data + i, n - i, acc);
+}
+
+GS_AVX2 inline double dot(const double* a, const double* b, size_t n, double acc) {
+  __m256d s0 = _mm256_set1_pd(-0.0), s1 = _mm256_set1_pd(-0.0);  // -0 + x is x
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, _mm256_add_pd(s0, s1));
+  acc = scalar::sum(lanes, 4, acc);
+  return scalar::dot(a + i, b + i, n - i, acc);
+}
+
+GS_AVX2 inline int32_t sum(const int32_t* data, size_t n, int32_t acc) {
+  __m256i s = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) s = _mm256_add_epi32(s, load(data + i));
+  return scalar::sum(data + i, n - i, sum_lanes(s, acc));
+}
+
+GS_AVX2 inline int64_t sum(const int64_t* data, size_t n, int64_t acc) {
+  __m256i s = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) s = _mm256_add_epi64(s, load(data + i));
+  return scalar::sum(data + i, n - i, sum_lanes(s, acc));
+}
+
+GS_AVX2 inline int32_t dot(const int32_t* a, const int32_t* b, size_t n, int32_t acc) {
+  __m256i s = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) s = _mm256_add_epi32(s, _mm256_mullo_epi32(load(a + i), load(b + i)));
+  return scalar::dot(a + i, b + i, n - i, sum_lanes(s, acc));
+}
+
+// AVX2 has no 64-bit multiply; integer53 dot stays scalar
+inline int64_t dot(const int64_t* a, const int64_t* b, size_t n, int64_t acc) {
+  return scalar::dot(a, b, n, acc);
+}
+
+// max_pd(x, m) is x > m ? x : m, lane by lane: the loop's own step
+GS_AVX2 inline double max(const double* data, size_t n, double acc) {
+  if (n < 4) return scalar::max(data, n, acc);
+  __m256d m = _mm256_set1_pd(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) m = _mm256_max_pd(_mm256_loadu_pd(data + i), m);
+  double result = scalar::max(data + i, n - i, max_lanes(m, acc));
+  return result == 0 ? scalar::max(data, n, acc) : result;
+}
+
+GS_AVX2 inline double min(const double* data, size_t n, double acc) {
+  if (n < 4) return scalar::min(data, n, acc);
+  __m256d m = _mm256_set1_pd(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) m = _mm256_min_pd(_mm256_loadu_pd(data + i), m);
+  double result = scalar::min(data + i, n - i, min_lanes(m, acc));
+  return result == 0 ? scalar::min(data, n, acc) : result;
+}
+
+GS_AVX2 inline int32_t max(const int32_t* data, size_t n, int32_t acc) {
+  __m256i m = _mm256_set1_epi32(acc);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) m = _mm256_max_epi32(m, load(data + i));
+  return scalar::max(data + i, n - i, max_lanes<int32_t>(m, acc));
+}
+
+GS_AVX2 inline int32_t min(const int32_t* data, size_t n, int32_t acc) {
+  __m256i m = _mm256_set1_epi32(acc);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) m = _mm256_min_epi32(m, load(data + i));
+  return scalar::min(data + i, n - i, min_lanes<int32_t>(m, acc));
+}
+
+GS_AVX2 inline int64_t max(const int64_t* data, size_t n, int64_t acc) {
+  __m256i m = _mm256_set1_epi64x(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = load(data + i);
+    m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(x, m));
+  }
+  return scalar::max(data + i, n - i, max_lanes<int64_t>(m, acc));
+}
+
+GS_AVX2 inline int64_t min(const int64_t* data, size_t n, int64_t acc) {
+  __m256i m = _mm256_set1_epi64x(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = load(data + i);
+    m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(m, x));
+  }
+  return scalar::min(data + i, n - i, min_lanes<int64_t>(m, acc));
+}
+
+GS_AVX2 inline ptrdiff_t index_of(const double* data, size_t n, double value) {
+  __m256d v = _mm256_set1_pd(value);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), v, _CMP_EQ_OQ));
+    if (mask) return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+GS_AVX2 inline ptrdiff_t index_of(const int32_t* data, size_t n, int32_t value) {
+  __m256i v = _mm256_set1_epi32(value);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(load(data + i), v)));
+    if (mask) return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+GS_AVX2 inline ptrdiff_t index_of(const int64_t* data, size_t n, int64_t value) {
+  __m256i v = _mm256_set1_epi64x(value);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(load(data + i), v)));
+    if (mask) return static_cast<ptrdiff_t>(i + __builtin_ctz(mask));
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+#undef GS_AVX2
+
+} // namespace avx2
+
+#define GS_SIMD_DISPATCH(name, ...) \
+  (avx2::available() ? avx2::name(__VA_ARGS__) : scalar::name(__VA_ARGS__))
+
+#elif GS_SIMD_NEON
+
+namespace neon {
+
+inline double sum(const double* data, size_t n, double acc) {
+  float64x2_t s0 = vdupq_n_f64(-0.0), s1 = vdupq_n_f64(-0.0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 = vaddq_f64(s0, vld1q_f64(data + i));
+    s1 = vaddq_f64(s1, vld1q_f64(data + i + 2));
+  }
+  float64x2_t s = vaddq_f64(s0, s1);
+  acc = acc + vgetq_lane_f64(s, 0) + vgetq_lane_f64(s, 1);
+  return scalar::sum(data + i, n - i, acc);
+}
+
+inline double dot(const double* a, const double* b, size_t n, double acc) {
+  float64x2_t s = vdupq_n_f64(-0.0);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) s = vaddq_f64(s, vmulq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+  acc = acc + vgetq_lane_f64(s, 0) + vgetq_lane_f64(s, 1);
+  return scalar::dot(a + i, b + i, n - i, acc);
+}
+
+inline int32_t sum(const int32_t* data, size_t n, int32_t acc) {
+  int32x4_t s = vdupq_n_s32(0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) s = vaddq_s32(s, vld1q_s32(data + i));
+  return scalar::sum(data + i, n - i, scalar::add(acc, vaddvq_s32(s)));
+}
+
+inline int64_t sum(const int64_t* data, size_t n, int64_t acc) {
+  int64x2_t s = vdupq_n_s64(0);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) s = vaddq_s64(s, vld1q_s64(data + i));
+  return scalar::sum(data + i, n - i, scalar::add(acc, vaddvq_s64(s)));
+}
+
+inline int32_t dot(const int32_t* a, const int32_t* b, size_t n, int32_t acc) {
+  int32x4_t s = vdupq_n_s32(0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) s = vmlaq_s32(s, vld1q_s32(a + i), vld1q_s32(b + i));
+  return scalar::dot(a + i, b + i, n - i, scalar::add(acc, vaddvq_s32(s)));
+}
+
+inline int64_t dot(const int64_t* a, const int64_t* b, size_t n, int64_t acc) {
+  return scalar::dot(a, b, n, acc);
+}
+
+// vbsl(x > m, x, m) is the loop's own step, lane by lane
+inline double max(const double* data, size_t n, double acc) {
+  if (n < 2) return scalar::max(data, n, acc);
+  float64x2_t m = vdupq_n_f64(acc);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t x = vld1q_f64(data + i);
+    m = vbslq_f64(vcgtq_f64(x, m), x, m);
+  }
+  double lanes[2] = {vgetq_lane_f64(m, 0), vgetq_lane_f64(m, 1)};
+  double result = scalar::max(data + i, n - i, scalar::max(lanes, 2, acc));
+  return result == 0 ? scalar::max(data, n, acc) : result;
+}
+
+inline double min(const double* data, size_t n, double acc) {
+  if (n < 2) return scalar::min(data, n, acc);
+  float64x2_t m = vdupq_n_f64(acc);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t x = vld1q_f64(data + i);
+    m = vbslq_f64(vcltq_f64(x, m), x, m);
+  }
+  double lanes[2] = {vgetq_lane_f64(m, 0), vgetq_lane_f64(m, 1)};
+  double result = scalar::min(data + i, n - i, scalar::min(lanes, 2, acc));
+  return result == 0 ? scalar::min(data, n, acc) : result;
+}
+
+inline int32_t max(const int32_t* data, size_t n, int32_t acc) {
+  int32x4_t m = vdupq_n_s32(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) m = vmaxq_s32(m, vld1q_s32(data + i));
+  return scalar::max(data + i, n - i, vmaxvq_s32(m));
+}
+
+inline int32_t min(const int32_t* data, size_t n, int32_t acc) {
+  int32x4_t m = vdupq_n_s32(acc);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) m = vminq_s32(m, vld1q_s32(data + i));
+  return scalar::min(data + i, n - i, vminvq_s32(m));
+}
+
+inline int64_t max(const int64_t* data, size_t n, int64_t acc) {
+  int64x2_t m = vdupq_n_s64(acc);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    int64x2_t x = vld1q_s64(data + i);
+    m = vbslq_s64(vcgtq_s64(x, m), x, m);
+  }
+  int64_t lanes[2] = {vgetq_lane_s64(m, 0), vgetq_lane_s64(m, 1)};
+  return scalar::max(data + i, n - i, scalar::max(lanes, 2, acc));
+}
+
+inline int64_t min(const int64_t* data, size_t n, int64_t acc) {
+  int64x2_t m = vdupq_n_s64(acc);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    int64x2_t x = vld1q_s64(data + i);
+    m = vbslq_s64(vcltq_s64(x, m), x, m);
+  }
+  int64_t lanes[2] = {vgetq_lane_s64(m, 0), vgetq_lane_s64(m, 1)};
+  return scalar::min(data + i, n - i, scalar::min(lanes, 2, acc));
+}
+
+inline ptrdiff_t index_of(const double* data, size_t n, double value) {
+  float64x2_t v = vdupq_n_f64(value);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    if (vmaxvq_u32(vreinterpretq_u32_u64(vceqq_f64(vld1q_f64(data + i), v)))) break;
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+inline ptrdiff_t index_of(const int32_t* data, size_t n, int32_t value) {
+  int32x4_t v = vdupq_n_s32(value);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    if (vmaxvq_u32(vceqq_s32(vld1q_s32(data + i), v))) break;
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+inline ptrdiff_t index_of(const int64_t* data, size_t n, int64_t value) {
+  int64x2_t v = vdupq_n_s64(value);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    if (vmaxvq_u32(vreinterpretq_u32_u64(vceqq_s64(vld1q_s64(data + i), v)))) break;
+  }
+  ptrdiff_t j = scalar::index_of(data + i, n - i, value);
+  return j < 0 ? -1 : static_cast<ptrdiff_t>(i) + j;
+}
+
+} // namespace neon
+
+#define GS_SIMD_DISPATCH(name, ...) neon::name(__VA_ARGS__)
+
+#else
+
+#define GS_SIMD_DISPATCH(name, ...) scalar::name(__VA_ARGS__)
+
+#endif
+
+// Pointer-level entry points
+
+template<typename T>
+inline T sum(const T* data, size_t n, T acc) {
+#ifndef GS_FAST_MATH
+  if constexpr (std::is_floating_point_v<T>) return scalar::sum(data, n, acc);
+#endif
+  return GS_SIMD_DISPATCH(sum, data, n, acc);
+}
+
+template<typename T>
+inline T dot(const T* a, const T* b, size_t n, T acc) {
+#ifndef GS_FAST_MATH
+  if constexpr (std::is_floating_point_v<T>) return scalar::dot(a, b, n, acc);
+#endif
+  return GS_SIMD_DISPATCH(dot, a, b, n, acc);
+}
+
+template<typename T>
+inline T max(const T* data, size_t n, T acc) { return GS_SIMD_DISPATCH(max, data, n, acc); }
+
+template<typename T>
+inline T min(const T* data, size_t n, T acc) { return GS_SIMD_DISPATCH(min, data, n, acc); }
+
+template<typename T>
+inline ptrdiff_t index_of(const T* data, size_t n, T value) { return GS_SIMD_DISPATCH(index_of, data, n, value); }
+
+#undef GS_SIMD_DISPATCH
+
+// Array-level entry points, as emitted by codegen
+
+template<typename A>
+using element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<const A&>().begin())>>;
+
+template<typename A>
+inline element_t<A> sum(const A& array, std::type_identity_t<element_t<A>> acc) {
+  return sum(std::to_address(array.begin()), array.size(), acc);
+}
+
+/** for (i < a.length) acc += a[i] * b[i]: elements of a past the end of b count as 0 */
+template<typename A, typename B>
+inline element_t<A> dot(const A& a, const B& b, std::type_identity_t<element_t<A>> acc) {
+  static_assert(std::is_same_v<element_t<A>, element_t<B>>, "dot needs one element type");
+  size_t n = a.size() < b.size() ? a.size() : b.size();
+  const auto* pa = std::to_address(a.begin());
+  acc = dot(pa, std::to_address(b.begin()), n, acc);
+  for (size_t i = n; i < a.size(); ++i) acc = scalar::add(acc, scalar::mul(pa[i], element_t<A>{}));
+  return acc;
+}
+
+template<typename A>
+inline element_t<A> max(const A& array, std::type_identity_t<element_t<A>> acc) {
+  return max(std::to_address(array.begin()), array.size(), acc);
+}
+
+template<typename A>
+inline element_t<A> min(const A& array, std::type_identity_t<element_t<A>> acc) {
+  return min(std::to_address(array.begin()), array.size(), acc);
+}
+
+} // namespace simd
+} // namespace gs
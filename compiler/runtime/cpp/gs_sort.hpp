@@ -0,0 +1,395 @@
+#pragma once
+
+/**
+ * GoodScript Array Sorting
+ *
+ * Array.sort in both runtimes is stable, as in JavaScript. stable_sort is
+ * a merge sort over natural runs (TimSort without galloping):
+ *
+ * - ascending runs are taken as they are and strictly descending ones are
+ *   reversed, so sorted, reversed and appended-to data cost O(n);
+ * - short runs are extended to min_run elements by binary insertion;
+ * - runs are merged under the TimSort stack invariants, through a scratch
+ *   buffer that holds the shorter run; the part of each run already in
+ *   place is found by binary search and never moved.
+ *
+ * Codegen emits
+ *
+ *   records.sort((a, b) => a.key - b.key)
+ *
+ * as
+ *
+ *   records.sortByKey([&](const auto& a) -> decltype(auto) { return (a->key); })
+ *
+ * for comparators that compare one key of both arguments. sort_by_key
+ * extracts every key once. Numeric keys are mapped to unsigned integers
+ * that order the same way and sorted with a stable LSD radix sort, which
+ * skips the digits all keys share; other keys (strings) are compared with
+ * <. Both orders are the comparator's order: -0 equals 0, and NaN keys,
+ * which make a - b comparators inconsistent, go last.
+ *
+ * Included by each runtime's Array header. Under GS_GC_AMC the scratch
+ * buffer is collector storage, so elements moved into it stay visible to
+ * the collector; elsewhere it is plain heap memory.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gs {
+namespace sorting {
+
+namespace detail {
+
+// Runs shorter than this are sorted by binary insertion alone
+constexpr size_t MIN_MERGE = 32;
+
+// Enough pending runs for any size_t: their lengths grow like Fibonacci numbers
+constexpr size_t MAX_RUNS = 96;
+
+/** Uninitialized storage for up to capacity elements, allocated on first use */
+template<typename T>
+class Scratch {
+  T* data_ = nullptr;
+  size_t capacity_ = 0;
+
+public:
+  explicit Scratch(size_t capacity) : capacity_(capacity) {}
+  Scratch(const Scratch&) = delete;
+  Scratch& operator=(const Scratch&) = delete;
+
+  ~Scratch() {
+#ifndef GS_GC_AMC
+    if (data_) ::operator delete(data_, std::align_val_t(alignof(T)));
+#endif
+  }
+
+  T* get() {
+    if (!data_) {
+#ifdef GS_GC_AMC
+      data_ = gc::Allocator::alloc_storage<T>(capacity_);
+#else
+      data_ = static_cast<T*>(::operator new(capacity_ * sizeof(T), std::align_val_t(alignof(T))));
+#endif
+    }
+    return data_;
+  }
+};
+
+/**
+ * Moves elements left in the scratch buffer into the gap they came from and
+ * destroys the scratch copies. Runs when a merge ends and also when the
+ * comparator throws, so every element ends up back in the array.
+ */
+template<typename T>
+struct MergeGuard {
+  T* scratch;
+  size_t count;     // Elements moved into the scratch buffer
+  size_t& from;     // First scratch element not yet merged
+  size_t& until;    // Last scratch element not yet merged, plus one
+  T*& gap;          // Where the unmerged scratch elements go
+
+  ~MergeGuard() {
+    std::move(scratch + from, scratch + until, gap);
+    std::destroy(scratch, scratch + count);
+  }
+};
+
+/** Sorts first[0, n) given that first[0, sorted) is already sorted */
+template<typename T, typename Less>
+void binary_insertion_sort(T* first, size_t sorted, size_t n, Less& less) {
+  for (size_t i = std::max<size_t>(sorted, 1); i < n; ++i) {
+    // After equal elements, which keeps the sort stable
+    T* pos = std::upper_bound(first, first + i, first[i], less);
+    if (pos != first + i) {
+      T value = std::move(first[i]);
+      std::move_backward(pos, first + i, first + i + 1);
+      *pos = std::move(value);
+    }
+  }
+}
+
+/** Length of the run at first, reversed first if it is strictly descending */
+template<typename T, typename Less>
+size_t count_run(T* first, size_t n, Less& less) {
+  if (n < 2) return n;
+  size_t i = 2;
+  if (less(first[1], first[0])) {
+    // Strictly, so that reversing cannot reorder equal elements
+    while (i < n && less(first[i], first[i - 1])) ++i;
+    std::reverse(first, first + i);
+  } else {
+    while (i < n && !less(first[i], first[i - 1])) ++i;
+  }
+  return i;
+}
+
+/** Run length below which runs are extended, between MIN_MERGE/2 and MIN_MERGE */
+inline size_t min_run_length(size_t n) {
+  size_t low_bits = 0;
+  while (n >= MIN_MERGE) {
+    low_bits |= n & 1;
+    n >>= 1;
+  }
+  return n + low_bits;
+}
+
+/** Merges first[0, mid) and first[mid, n), copying the left run out */
+template<typename T, typename Less>
+void merge_low(T* first, size_t mid, size_t n, Less& less, T* scratch) {
+  std::uninitialized_move(first, first + mid, scratch);
+  size_t i = 0, end = mid;
+  T* out = first;
+  T* right = first + mid;
+  T* last = first + n;
+  MergeGuard<T> guard{scratch, mid, i, end, out};
+  while (i < end && right < last) {
+    // Ties take the left element
+    if (less(*right, scratch[i])) {
+      *out++ = std::move(*right++);
+    } else {
+      *out++ = std::move(scratch[i++]);
+    }
+  }
+}
+
+/** Merges first[0, mid) and first[mid, n), copying the right run out */
+template<typename T, typename Less>
+void merge_high(T* first, size_t mid, size_t n, Less& less, T* scratch) {
+  size_t count = n - mid;
+  std::uninitialized_move(first + mid, first + n, scratch);
+  size_t begin = 0, j = count;
+  T* left = first + mid;
+  T* out = first + n;
+  // The unmerged scratch elements go right after the unmerged left ones
+  MergeGuard<T> guard{scratch, count, begin, j, left};
+  while (j > 0 && left > first) {
+    // Ties take the right element, which comes last
+    if (less(scratch[j - 1], left[-1])) {
+      *--out = std::move(*--left);
+    } else {
+      *--out = std::move(scratch[--j]);
+    }
+  }
+}
+
+/** Merges two adjacent sorted runs, skipping what is already in place */
+template<typename T, typename Less>
+void merge_runs(T* first, size_t mid, size_t n, Less& less, Scratch<T>& scratch) {
+  // Left elements not greater than the right run's first stay where they are
+  T* start = std::upper_bound(first, first + mid, first[mid], less);
+  // Right elements not less than the left run's last stay where they are
+  T* stop = std::lower_bound(first + mid, first + n, first[mid - 1], less);
+  if (start == first + mid || stop == first + mid) return;
+  size_t left = static_cast<size_t>(first + mid - start);
+  size_t right = static_cast<size_t>(stop - (first + mid));
+  if (left <= right) {
+    merge_low(start, left, left + right, less, scratch.get());
+  } else {
+    merge_high(start, left, left + right, less, scratch.get());
+  }
+}
+
+} // namespace detail
+
+/**
+ * Stable sort of first[0, n) by a strict weak order less. Elements are
+ * moved, never copied.
+ */
+template<typename T, typename Less>
+void stable_sort(T* first, size_t n, Less less) {
+  if (n < 2) return;
+  if (n < detail::MIN_MERGE) {
+    size_t run = detail::count_run(first, n, less);
+    detail::binary_insertion_sort(first, run, n, less);
+    return;
+  }
+
+  detail::Scratch<T> scratch(n / 2);
+  size_t min_run = detail::min_run_length(n);
+  size_t base[detail::MAX_RUNS];
+  size_t len[detail::MAX_RUNS];
+  size_t runs = 0;
+
+  auto merge_at = [&](size_t k) {
+    detail::merge_runs(first + base[k], len[k], len[k] + len[k + 1], less, scratch);
+    len[k] += len[k + 1];
+    if (k + 2 < runs) {
+      base[k + 1] = base[k + 2];
+      len[k + 1] = len[k + 2];
+    }
+    --runs;
+  };
+
+  size_t pos = 0;
+  while (pos < n) {
+    size_t remaining = n - pos;
+    size_t run = detail::count_run(first + pos, remaining, less);
+    if (run < min_run) {
+      size_t forced = std::min(min_run, remaining);
+      detail::binary_insertion_sort(first + pos, run, forced, less);
+      run = forced;
+    }
+    base[runs] = pos;
+    len[runs] = run;
+    ++runs;
+    pos += run;
+
+    // Keep the pending run lengths decreasing faster than Fibonacci
+    while (runs > 1) {
+      size_t k = runs - 2;
+      if ((k > 0 && len[k - 1] <= len[k] + len[k + 1]) ||
+          (k > 1 && len[k - 2] <= len[k - 1] + len[k])) {
+        if (len[k - 1] < len[k + 1]) --k;
+      } else if (len[k] > len[k + 1]) {
+        break;
+      }
+      merge_at(k);
+    }
+  }
+
+  while (runs > 1) {
+    size_t k = runs - 2;
+    if (k > 0 && len[k - 1] < len[k + 1]) --k;
+    merge_at(k);
+  }
+}
+
+namespace detail {
+
+/**
+ * Maps an arithmetic key to an unsigned integer that sorts the same way,
+ * or the opposite way when descending. NaN sorts last either way.
+ */
+template<typename K>
+uint64_t radix_key(K key, bool descending) {
+  uint64_t flip = descending ? ~uint64_t(0) : 0;
+  if constexpr (std::is_floating_point_v<K>) {
+    double value = static_cast<double>(key);
+    if (value != value) return ~uint64_t(0);
+    // -0 + 0.0 is 0
+    value += 0.0;
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // Finite and infinite keys map to [2^52 - 1, ~(2^52 - 1)], below NaN's
+    bits = (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+    return bits ^ flip;
+  } else if constexpr (std::is_signed_v<K>) {
+    // Within the key's own width, so narrow keys leave the high digits constant
+    using U = std::make_unsigned_t<K>;
+    constexpr U sign = U(1) << (sizeof(K) * 8 - 1);
+    U mapped = static_cast<U>(static_cast<U>(key) ^ sign);
+    return static_cast<uint64_t>(descending ? static_cast<U>(~mapped) : mapped);
+  } else {
+    using U = std::conditional_t<std::is_same_v<K, bool>, uint8_t, std::make_unsigned_t<K>>;
+    U mapped = static_cast<U>(key);
+    return static_cast<uint64_t>(descending ? static_cast<U>(~mapped) : mapped);
+  }
+}
+
+struct KeyIndex {
+  uint64_t key;
+  uint32_t index;
+};
+
+// Below this, sorting the elements directly beats building the key table
+constexpr size_t MIN_RADIX = 256;
+
+// Radix digit width: 6 passes cover a 64-bit key and the counts stay in cache
+constexpr int DIGIT_BITS = 11;
+constexpr int DIGITS = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+constexpr size_t BUCKETS = size_t(1) << DIGIT_BITS;
+
+inline size_t digit(uint64_t key, int d) {
+  return static_cast<size_t>(key >> (d * DIGIT_BITS)) & (BUCKETS - 1);
+}
+
+/** Stable LSD radix sort on the key */
+inline void radix_sort(std::vector<KeyIndex>& items) {
+  size_t n = items.size();
+  std::vector<size_t> counts(DIGITS * BUCKETS, 0);
+  for (const KeyIndex& item : items) {
+    for (int d = 0; d < DIGITS; ++d) {
+      ++counts[d * BUCKETS + digit(item.key, d)];
+    }
+  }
+
+  std::vector<KeyIndex> buffer(n);
+  for (int d = 0; d < DIGITS; ++d) {
+    size_t* count = &counts[d * BUCKETS];
+    // A digit every key shares orders nothing
+    if (count[digit(items[0].key, d)] == n) continue;
+    size_t offset = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+      size_t c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+    for (const KeyIndex& item : items) {
+      buffer[count[digit(item.key, d)]++] = item;
+    }
+    items.swap(buffer);
+  }
+}
+
+/**
+ * Moves first[order[i].index] to first[i] for every i. Gathering through a
+ * scratch buffer reads the elements independently, so cache misses overlap
+ * instead of chaining as they would following permutation cycles.
+ */
+template<typename T>
+void apply_order(T* first, const std::vector<KeyIndex>& order) {
+  size_t n = order.size();
+  Scratch<T> scratch(n);
+  T* gathered = scratch.get();
+  for (size_t i = 0; i < n; ++i) {
+    ::new (static_cast<void*>(gathered + i)) T(std::move(first[order[i].index]));
+  }
+  std::move(gathered, gathered + n, first);
+  std::destroy(gathered, gathered + n);
+}
+
+} // namespace detail
+
+/**
+ * Stable sort of first[0, n) by key(element), ascending or descending;
+ * the sort a - b or b - a comparators on that key describe.
+ */
+template<typename T, typename Key>
+void sort_by_key(T* first, size_t n, Key key, bool descending = false) {
+  using K = std::decay_t<std::invoke_result_t<Key&, const T&>>;
+  if (n < 2) return;
+
+  if constexpr (std::is_arithmetic_v<K>) {
+    if (n >= detail::MIN_RADIX && n <= UINT32_MAX) {
+      std::vector<detail::KeyIndex> order(n);
+      bool sorted = true;
+      for (size_t i = 0; i < n; ++i) {
+        order[i] = {detail::radix_key<K>(key(first[i]), descending), static_cast<uint32_t>(i)};
+        sorted = sorted && (i == 0 || order[i - 1].key <= order[i].key);
+      }
+      if (sorted) return;
+      detail::radix_sort(order);
+      detail::apply_order(first, order);
+      return;
+    }
+    stable_sort(first, n, [&](const T& a, const T& b) {
+      return detail::radix_key<K>(key(a), descending) < detail::radix_key<K>(key(b), descending);
+    });
+  } else if (descending) {
+    stable_sort(first, n, [&](const T& a, const T& b) { return key(b) < key(a); });
+  } else {
+    stable_sort(first, n, [&](const T& a, const T& b) { return key(a) < key(b); });
+  }
+}
+
+} // namespace sorting
+} // namespace gs
@@ -0,0 +1,555 @@
+#pragma once
+
+/**
+ * GoodScript Typed Arrays
+ *
+ * ArrayBuffer plus fixed-length Float64Array, Int32Array and Uint8Array
+ * views over it, for both runtimes:
+ *
+ *   const samples = new Float64Array(1024);      gs::Float64Array samples(1024);
+ *   const head = samples.subarray(0, 16);        auto head = samples.subarray(0, 16);
+ *   const bytes = FileSystem.readBytes(path);    gs::Uint8Array bytes = gs::FileSystem::readBytes(path);
+ *
+ * A typed array never grows, and its elements sit contiguously in the
+ * buffer. An index that has been checked against length() stays valid, so
+ * codegen reads it with at_ref() inside `for (i < a.length)` loops, and the
+ * simd kernels run on the elements in place. subarray() returns a view on
+ * the same buffer; slice() copies.
+ *
+ * Writes convert the way JavaScript does: Int32Array and Uint8Array keep
+ * the low bits of the truncated value (300 -> 44 in a Uint8Array), and NaN
+ * and infinities store 0. Out-of-range reads return 0; out-of-range writes
+ * are ignored.
+ *
+ * Buffer storage depends on the runtime:
+ * - GC mode: one GC block per buffer. Views hold the block's base pointer
+ *   and a byte offset, never an interior pointer, so AMC can move it.
+ * - Ownership mode: a block shared by the buffer and its views. A buffer
+ *   can adopt a std::string or std::vector<uint8_t> without copying, which
+ *   is how file reads and HTTP bodies become Uint8Arrays.
+ * - Either mode: external memory the GC does not manage, such as a file
+ *   mapping (FileSystem.mapFile). Ownership mode releases it with the
+ *   last view; in GC mode it stays until ArrayBuffer::release
+ *   (FileSystem.unmapFile) or the process exits.
+ *
+ * Included by gs_runtime.hpp and gs_gc_runtime.hpp after Array and Error.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gs_simd.hpp"
+
+namespace gs {
+
+namespace detail {
+
+/**
+ * Bytes behind an ArrayBuffer, shared by every view on it. Copying a
+ * ByteStore shares the bytes.
+ */
+#ifdef GS_GC_MODE
+
+class ByteStore {
+public:
+  ByteStore() = default;
+
+  // Zero-filled. Allocated in 8-byte words so Float64Array views are aligned.
+  explicit ByteStore(size_t size) : size_(size) {
+    if (size > 0) {
+      base_ = reinterpret_cast<uint8_t*>(gc::Allocator::alloc_array<uint64_t>((size + 7) / 8));
+    }
+  }
+
+  // The GC heap cannot take over malloc'd memory: copy it in once
+  static ByteStore adopt(std::string&& bytes) { return copy_of(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()); }
+  static ByteStore adopt(std::vector<uint8_t>&& bytes) { return copy_of(bytes.data(), bytes.size()); }
+
+  // Memory outside the GC heap: AMC leaves a reference outside its pools
+  // alone. Nothing runs at collection, so owner is held until release()
+  // or exit.
+  static ByteStore external(uint8_t* data, size_t size, std::shared_ptr<void> owner) {
+    if (owner && size > 0) {
+      Owners& owners = external_owners();
+      std::lock_guard<std::mutex> lock(owners.mutex);
+      owners.by_base[data] = std::move(owner);
+    }
+    ByteStore store;
+    store.base_ = size > 0 ? data : nullptr;
+    store.size_ = size;
+    return store;
+  }
+
+  // Drop the owner of external bytes; GC blocks have none
+  static void release(const uint8_t* data) {
+    std::shared_ptr<void> owner;
+    {
+      Owners& owners = external_owners();
+      std::lock_guard<std::mutex> lock(owners.mutex);
+      auto it = owners.by_base.find(data);
+      if (it == owners.by_base.end()) return;
+      owner = std::move(it->second);
+      owners.by_base.erase(it);
+    }
+    // owner frees the memory here, outside the lock
+  }
+
+  uint8_t* data() const { return base_; }
+  size_t size() const { return size_; }
+
+private:
+  // Shared by every thread that maps files (Parallel workers included)
+  struct Owners {
+    std::mutex mutex;
+    std::unordered_map<const uint8_t*, std::shared_ptr<void>> by_base;
+  };
+
+  static Owners& external_owners() {
+    static Owners owners;
+    return owners;
+  }
+
+  static ByteStore copy_of(const uint8_t* bytes, size_t size) {
+    ByteStore store(size);
+    if (size > 0) std::memcpy(store.base_, bytes, size);
+    return store;
+  }
+
+  uint8_t* base_ = nullptr;  // GC block base, nullptr when empty
+  size_t size_ = 0;
+
+  template<typename> friend struct gc::Trace;
+};
+
+#else
+
+class ByteStore {
+public:
+  ByteStore() = default;
+
+  explicit ByteStore(size_t size) : size_(size) {
+    if (size > 0) {
+      std::shared_ptr<uint8_t[]> block(new uint8_t[size]());
+      base_ = block.get();
+      owner_ = std::move(block);
+    }
+  }
+
+  // Takes over the container's heap block; nothing is copied
+  static ByteStore adopt(std::string&& bytes) { return adopt_container(std::move(bytes)); }
+  static ByteStore adopt(std::vector<uint8_t>&& bytes) { return adopt_container(std::move(bytes)); }
+
+  // Memory kept alive by owner, which is released with the last view
+  static ByteStore external(uint8_t* data, size_t size, std::shared_ptr<void> owner) {
+    ByteStore store;
+    if (size == 0) return store;
+    store.base_ = data;
+    store.size_ = size;
+    store.owner_ = std::move(owner);
+    return store;
+  }
+
+  uint8_t* data() const { return base_; }
+  size_t size() const { return size_; }
+
+private:
+  template<typename C>
+  static ByteStore adopt_container(C&& bytes) {
+    ByteStore store;
+    if (bytes.empty()) return store;
+    auto holder = std::make_shared<C>(std::move(bytes));
+    store.base_ = reinterpret_cast<uint8_t*>(holder->data());
+    store.size_ = holder->size();
+    store.owner_ = std::move(holder);
+    return store;
+  }
+
+  std::shared_ptr<void> owner_;
+  uint8_t* base_ = nullptr;
+  size_t size_ = 0;
+};
+
+#endif
+
+/**
+ * A JavaScript length or offset as a size_t: a whole number from 0 to
+ * 2^53 - 1. Anything else throws RangeError.
+ */
+inline size_t to_byte_index(double value, const char* what) {
+  if (!(value >= 0) || value > 9007199254740991.0 || std::trunc(value) != value) {
+    throw RangeError(String(std::string("Invalid typed array ") + what));
+  }
+  return static_cast<size_t>(value);
+}
+
+/**
+ * Resolve a relative index (negative counts from the end) against length,
+ * as slice/subarray/fill do. undefined means `fallback`.
+ */
+inline size_t clamp_relative(std::optional<double> index, size_t length, size_t fallback) {
+  if (!index.has_value()) return fallback;
+  double i = std::trunc(*index);
+  if (std::isnan(i)) return 0;
+  double n = static_cast<double>(length);
+  if (i < 0) return i + n <= 0 ? 0 : static_cast<size_t>(i + n);
+  return i >= n ? length : static_cast<size_t>(i);
+}
+
+/**
+ * Convert a value to element type T the way a typed array store does.
+ * Integer elements keep the low bits, so every integer type wraps modulo
+ * 2^32 first; NaN and infinities become 0.
+ */
+template<typename T, typename V>
+inline T to_element(V value) {
+  if constexpr (std::is_floating_point_v<T> || std::is_same_v<T, V>) {
+    return static_cast<T>(value);
+  } else if constexpr (std::is_integral_v<V>) {
+    return static_cast<T>(static_cast<uint32_t>(value));
+  } else {
+    double d = static_cast<double>(value);
+    if (d > -2147483648.0 && d < 2147483648.0) {
+      return static_cast<T>(static_cast<int32_t>(d));
+    }
+    if (!std::isfinite(d)) return T{};
+    double wrapped = std::fmod(std::trunc(d), 4294967296.0);
+    if (wrapped < 0) wrapped += 4294967296.0;
+    return static_cast<T>(static_cast<uint32_t>(wrapped));
+  }
+}
+
+} // namespace detail
+
+template<typename T>
+class TypedArray;
+
+/**
+ * ArrayBuffer - fixed-length raw bytes, viewed through typed arrays
+ *
+ * Equivalent to TypeScript: new ArrayBuffer(byteLength)
+ */
+class ArrayBuffer {
+public:
+  ArrayBuffer() = default;
+  explicit ArrayBuffer(double byteLength) : bytes_(detail::to_byte_index(byteLength, "length")) {}
+
+  /** Buffer over bytes read from a file or socket (no copy in ownership mode) */
+  static ArrayBuffer adopt(std::string&& bytes) { return ArrayBuffer(detail::ByteStore::adopt(std::move(bytes))); }
+  static ArrayBuffer adopt(std::vector<uint8_t>&& bytes) { return ArrayBuffer(detail::ByteStore::adopt(std::move(bytes))); }
+
+  /** Buffer over memory it does not allocate (a file mapping); owner keeps it alive */
+  static ArrayBuffer external(uint8_t* data, size_t size, std::shared_ptr<void> owner) {
+    return ArrayBuffer(detail::ByteStore::external(data, size, std::move(owner)));
+  }
+
+  int64_t byteLength() const { return static_cast<int64_t>(bytes_.size()); }
+
+  /** Copy of bytes [begin, end) */
+  ArrayBuffer slice(std::optional<double> begin = std::nullopt, std::optional<double> end = std::nullopt) const {
+    size_t from = detail::clamp_relative(begin, bytes_.size(), 0);
+    size_t to = detail::clamp_relative(end, bytes_.size(), bytes_.size());
+    ArrayBuffer result(static_cast<double>(to > from ? to - from : 0));
+    if (to > from) std::memcpy(result.data(), data() + from, to - from);
+    return result;
+  }
+
+  uint8_t* data() const { return bytes_.data(); }
+  size_t size() const { return bytes_.size(); }
+
+#ifdef GS_GC_MODE
+  /**
+   * Free the external memory behind buffer now rather than at exit. No
+   * view of it may be used afterwards. Does nothing for GC-allocated
+   * buffers, which the collector frees.
+   */
+  static void release(const ArrayBuffer& buffer) { detail::ByteStore::release(buffer.data()); }
+#endif
+
+private:
+  explicit ArrayBuffer(detail::ByteStore bytes) : bytes_(std::move(bytes)) {}
+
+  detail::ByteStore bytes_;
+
+  template<typename> friend class TypedArray;
+#ifdef GS_GC_MODE
+  template<typename> friend struct gc::Trace;
+#endif
+};
+
+/**
+ * TypedArray<T> - fixed-length view of T elements over an ArrayBuffer
+ *
+ * Copying a TypedArray copies the view: both copies share the elements,
+ * as two JavaScript references to the same typed array do.
+ *
+ * Lengths, offsets and indexes are int64_t, unlike Array's int: a mapped
+ * file can be larger than 2 GiB, and codegen casts typed array indexes to
+ * int64_t.
+ */
+template<typename T>
+class TypedArray {
+  static_assert(std::is_arithmetic_v<T>, "TypedArray elements are numbers");
+
+public:
+  using value_type = T;
+  static constexpr int BYTES_PER_ELEMENT = static_cast<int>(sizeof(T));
+
+  TypedArray() = default;
+
+  /** new Float64Array(length): zero-filled */
+  explicit TypedArray(double length)
+    : buffer_(static_cast<double>(detail::to_byte_index(length, "length") * sizeof(T))),
+      length_(static_cast<size_t>(length)) {}
+
+  /** new Float64Array(buffer, byteOffset?, length?): a view on buffer */
+  TypedArray(const ArrayBuffer& buffer, double byteOffset, std::optional<double> length = std::nullopt)
+    : buffer_(buffer), offset_(detail::to_byte_index(byteOffset, "offset")) {
+    if (offset_ % sizeof(T) != 0) {
+      throw RangeError("Typed array offset must be a multiple of the element size");
+    }
+    if (offset_ > buffer.size()) {
+      throw RangeError("Typed array offset is out of bounds");
+    }
+    if (length.has_value()) {
+      length_ = detail::to_byte_index(*length, "length");
+      if (length_ > (buffer.size() - offset_) / sizeof(T)) {
+        throw RangeError("Typed array length is out of bounds");
+      }
+    } else {
+      if ((buffer.size() - offset_) % sizeof(T) != 0) {
+        throw RangeError("Buffer length minus offset must be a multiple of the element size");
+      }
+      length_ = (buffer.size() - offset_) / sizeof(T);
+    }
+  }
+
+  explicit TypedArray(const ArrayBuffer& buffer) : TypedArray(buffer, 0) {}
+
+  TypedArray(std::initializer_list<T> values) : TypedArray(static_cast<double>(values.size())) {
+    std::copy(values.begin(), values.end(), begin());
+  }
+
+  /** new Float64Array(array) / Float64Array.from(array): converting copy */
+  template<typename U>
+  explicit TypedArray(const Array<U>& values) : TypedArray(static_cast<double>(values.size())) {
+    T* out = begin();
+    for (const auto& value : values) *out++ = detail::to_element<T>(value);
+  }
+
+  template<typename U>
+  explicit TypedArray(const TypedArray<U>& values) : TypedArray(static_cast<double>(values.size())) {
+    T* out = begin();
+    for (U value : values) *out++ = detail::to_element<T>(value);
+  }
+
+  template<typename U>
+  static TypedArray from(const U& values) { return TypedArray(values); }
+
+  int64_t length() const { return static_cast<int64_t>(length_); }
+  size_t size() const { return length_; }
+  int64_t byteLength() const { return static_cast<int64_t>(length_ * sizeof(T)); }
+  int64_t byteOffset() const { return static_cast<int64_t>(offset_); }
+  ArrayBuffer buffer() const { return buffer_; }
+
+  // Elements are recomputed from the buffer base on each call (AMC may move it)
+  T* data() const { return reinterpret_cast<T*>(buffer_.data() + offset_); }
+  T* begin() const { return data(); }
+  T* end() const { return data() + length_; }
+
+  /** ta[i] when i may be out of range: 0 */
+  T get_or_default(int64_t index, T defaultValue = T{}) const {
+    if (index < 0 || static_cast<size_t>(index) >= length_) return defaultValue;
+    return data()[index];
+  }
+
+  /** ta[i] = value; out-of-range writes are dropped */
+  template<typename V>
+  void set(int64_t index, V value) {
+    if (index < 0 || static_cast<size_t>(index) >= length_) return;
+    data()[index] = detail::to_element<T>(value);
+  }
+
+  /** Element access once the index is known to be below length() */
+  T& at_ref(int64_t index) const { return data()[index]; }
+
+  template<typename V>
+  void set_unchecked(int64_t index, V value) const { data()[index] = detail::to_element<T>(value); }
+
+  /** ta.set(source, offset): copy source's elements in at offset */
+  template<typename U>
+  void set(const TypedArray<U>& source, double offset = 0) {
+    size_t at = checked_target(source.size(), offset);
+    if constexpr (std::is_same_v<T, U>) {
+      // Source and target may share a buffer
+      std::memmove(data() + at, source.data(), source.size() * sizeof(T));
+    } else {
+      std::vector<U> values(source.begin(), source.end());
+      T* out = data() + at;
+      for (U value : values) *out++ = detail::to_element<T>(value);
+    }
+  }
+
+  template<typename U>
+  void set(const Array<U>& source, double offset = 0) {
+    T* out = data() + checked_target(source.size(), offset);
+    for (const auto& value : source) *out++ = detail::to_element<T>(value);
+  }
+
+  /** View of elements [begin, end) sharing this array's buffer */
+  TypedArray subarray(std::optional<double> begin = std::nullopt, std::optional<double> end = std::nullopt) const {
+    size_t from = detail::clamp_relative(begin, length_, 0);
+    size_t to = detail::clamp_relative(end, length_, length_);
+    TypedArray view(*this);
+    view.offset_ = offset_ + from * sizeof(T);
+    view.length_ = to > from ? to - from : 0;
+    return view;
+  }
+
+  /** Copy of elements [begin, end) in a new buffer */
+  TypedArray slice(std::optional<double> begin = std::nullopt, std::optional<double> end = std::nullopt) const {
+    TypedArray view = subarray(begin, end);
+    TypedArray result(static_cast<double>(view.length_));
+    if (view.length_ > 0) std::memcpy(result.data(), view.data(), view.length_ * sizeof(T));
+    return result;
+  }
+
+  template<typename V>
+  TypedArray& fill(V value, std::optional<double> start = std::nullopt, std::optional<double> end = std::nullopt) {
+    size_t from = detail::clamp_relative(start, length_, 0);
+    size_t to = detail::clamp_relative(end, length_, length_);
+    if (to > from) std::fill(data() + from, data() + to, detail::to_element<T>(value));
+    return *this;
+  }
+
+  /** indexOf(value, fromIndex?): a negative fromIndex counts from the end */
+  int64_t indexOf(double value, std::optional<double> fromIndex = std::nullopt) const {
+    // A value the element type cannot hold exactly is never found
+    if constexpr (std::is_integral_v<T>) {
+      if (!(value >= std::numeric_limits<T>::min() && value <= std::numeric_limits<T>::max())) return -1;
+    }
+    if (static_cast<double>(static_cast<T>(value)) != value) return -1;
+    size_t from = detail::clamp_relative(fromIndex, length_, 0);
+    const T* first = data() + from;
+    size_t count = length_ - from;
+    if constexpr (simd::is_numeric_v<T>) {
+      ptrdiff_t found = simd::index_of(first, count, static_cast<T>(value));
+      return found < 0 ? -1 : static_cast<int64_t>(from + found);
+    } else if constexpr (sizeof(T) == 1) {
+      // Bytes: memchr, for scanning large buffers (lines of a mapped file)
+      const void* found = count > 0 ? std::memchr(first, static_cast<unsigned char>(value), count) : nullptr;
+      return found ? static_cast<int64_t>(static_cast<const T*>(found) - data()) : -1;
+    } else {
+      const T* found = std::find(first, end(), static_cast<T>(value));
+      return found == end() ? -1 : static_cast<int64_t>(found - data());
+    }
+  }
+
+  bool includes(double value) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      // SameValueZero: NaN is found
+      if (std::isnan(value)) return std::any_of(begin(), end(), [](T x) { return std::isnan(x); });
+    }
+    return indexOf(value) >= 0;
+  }
+
+  template<typename Fn>
+  void forEach(Fn fn) const {
+    for (size_t i = 0; i < length_; ++i) fn(data()[i]);
+  }
+
+  template<typename Fn>
+  TypedArray map(Fn fn) const {
+    TypedArray result(static_cast<double>(length_));
+    for (size_t i = 0; i < length_; ++i) result.data()[i] = detail::to_element<T>(fn(data()[i]));
+    return result;
+  }
+
+  template<typename Fn, typename Acc>
+  Acc reduce(Fn fn, Acc initial) const {
+    for (size_t i = 0; i < length_; ++i) initial = fn(initial, data()[i]);
+    return initial;
+  }
+
+private:
+  size_t checked_target(size_t count, double offset) const {
+    size_t at = detail::to_byte_index(offset, "offset");
+    if (at > length_ || count > length_ - at) {
+      throw RangeError("Source is too large for the target typed array");
+    }
+    return at;
+  }
+
+  ArrayBuffer buffer_;
+  size_t offset_ = 0;  // in bytes
+  size_t length_ = 0;  // in elements
+
+  template<typename> friend class TypedArray;
+#ifdef GS_GC_MODE
+  template<typename> friend struct gc::Trace;
+#endif
+};
+
+using Float64Array = TypedArray<double>;
+using Int32Array = TypedArray<int32_t>;
+using Uint8Array = TypedArray<uint8_t>;
+
+/** Float64Array(3) [1, 2, 3], as Node prints it */
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const TypedArray<T>& array) {
+  if constexpr (std::is_same_v<T, double>) os << "Float64Array";
+  else if constexpr (std::is_same_v<T, int32_t>) os << "Int32Array";
+  else if constexpr (std::is_same_v<T, uint8_t>) os << "Uint8Array";
+  else os << "TypedArray";
+  os << "(" << array.length() << ") [";
+  for (size_t i = 0; i < array.size(); ++i) {
+    if (i > 0) os << ", ";
+    // + prints uint8_t as a number, not a character
+    os << +array.data()[i];
+  }
+  return os << "]";
+}
+
+#if defined(GS_GC_MODE) && defined(GS_GC_AMC)
+// Precise GC: buffers and views reference the buffer's block
+template<>
+struct gc::Trace<detail::ByteStore> {
+  static constexpr bool has_refs = true;
+
+  static mps_res_t scan(mps_ss_t ss, detail::ByteStore* store) {
+    return gc::Trace<uint8_t*>::scan(ss, &store->base_);
+  }
+};
+
+template<>
+struct gc::Trace<ArrayBuffer> {
+  static constexpr bool has_refs = true;
+
+  static mps_res_t scan(mps_ss_t ss, ArrayBuffer* buffer) {
+    return gc::Trace<detail::ByteStore>::scan(ss, &buffer->bytes_);
+  }
+};
+
+template<typename T>
+struct gc::Trace<TypedArray<T>> {
+  static constexpr bool has_refs = true;
+
+  static mps_res_t scan(mps_ss_t ss, TypedArray<T>* array) {
+    return gc::Trace<ArrayBuffer>::scan(ss, &array->buffer_);
+  }
+};
+#endif
+
+} // namespace gs
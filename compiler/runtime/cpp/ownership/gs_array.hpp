@@ -6,17 +6,338 @@
 #include <functional>
 #include <optional>
 #include <sstream>
+#include <iterator>
+#include <utility>
+#include <memory>
+#include <type_traits>
+#include "../gs_simd.hpp"
+#include "../gs_sort.hpp"
 
 namespace gs {
 
 // Forward declaration
 class String;
 
+namespace detail {
+
+/**
+ * Elements an Array holds inside itself before it allocates: up to 8, in
+ * at most 128 bytes, so that small temporaries (split() results, argument
+ * lists, short paths) never touch the heap. Elements over 128 bytes are
+ * always allocated.
+ */
+template<typename T>
+constexpr size_t inline_capacity() {
+  constexpr size_t INLINE_BYTES = 128;
+  constexpr size_t MAX_INLINE = 8;
+  return std::min(MAX_INLINE, INLINE_BYTES / sizeof(T));
+}
+
+// Uninitialized room for N elements inside the owning object
+template<typename T, size_t N>
+struct InlineSlots {
+  alignas(T) unsigned char bytes[N * sizeof(T)];
+  InlineSlots() {}
+  T* get() { return reinterpret_cast<T*>(bytes); }
+  const T* get() const { return reinterpret_cast<const T*>(bytes); }
+};
+
+template<typename T>
+struct InlineSlots<T, 0> {
+  T* get() { return nullptr; }
+  const T* get() const { return nullptr; }
+};
+
+/**
+ * Array storage: a buffer with a gap in front.
+ *
+ * The elements are buf_[head_, head_ + size_), so removing from or adding
+ * at the front moves head_ instead of every element (amortized O(1) shift
+ * and unshift). The buffer starts as inline_capacity<T>() slots inside the
+ * object and moves to the heap once it overflows; pushing into a buffer
+ * whose gap is at least as large as the elements slides them to the front
+ * instead of growing it. Gap and spare slots hold no objects. Provides the
+ * part of the std::vector interface Array uses, with pointer iterators.
+ */
+template<typename T>
+class OffsetVector {
+  static constexpr size_t INLINE = inline_capacity<T>();
+  static constexpr size_t MIN_GAP = 8;
+
+  [[no_unique_address]] InlineSlots<T, INLINE> inline_;
+  T* buf_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  size_t cap_ = INLINE;
+
+  bool on_heap() const { return buf_ != inline_.get(); }
+
+  // Moves the elements into a heap buffer of new_head + new_cap slots,
+  // starting at new_head
+  void relocate(size_t new_cap, size_t new_head) {
+    T* fresh = std::allocator<T>().allocate(new_head + new_cap);
+    T* first = data();
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+      std::uninitialized_move(first, first + size_, fresh + new_head);
+    } else {
+      try {
+        std::uninitialized_copy(first, first + size_, fresh + new_head);
+      } catch (...) {
+        std::allocator<T>().deallocate(fresh, new_head + new_cap);
+        throw;
+      }
+    }
+    std::destroy(first, first + size_);
+    release();
+    buf_ = fresh;
+    head_ = new_head;
+    cap_ = new_head + new_cap;
+  }
+
+  void release() {
+    if (on_heap()) {
+      std::allocator<T>().deallocate(buf_, cap_);
+    }
+  }
+
+  // Makes room for extra elements at the back
+  void grow_back(size_t extra) {
+    size_t needed = size_ + extra;
+    if (head_ + needed <= cap_) {
+      return;
+    }
+    if (needed <= cap_ && head_ >= size_) {
+      // Non-overlapping: the elements fit in the gap they leave behind
+      std::uninitialized_move(data(), data() + size_, buf_);
+      std::destroy(data(), data() + size_);
+      head_ = 0;
+      return;
+    }
+    relocate(std::max(needed, 2 * (cap_ - head_)), 0);
+  }
+
+  // Appends by moving, after any growth: value may be an element
+  template<typename V>
+  void append(V&& value) {
+    if (head_ + size_ < cap_) {
+      ::new (static_cast<void*>(data() + size_)) T(std::forward<V>(value));
+    } else {
+      T held(std::forward<V>(value));
+      grow_back(1);
+      ::new (static_cast<void*>(data() + size_)) T(std::move(held));
+    }
+    ++size_;
+  }
+
+  void steal(OffsetVector& other) noexcept {
+    if (other.on_heap()) {
+      buf_ = std::exchange(other.buf_, other.inline_.get());
+      head_ = std::exchange(other.head_, 0);
+      size_ = std::exchange(other.size_, 0);
+      cap_ = std::exchange(other.cap_, INLINE);
+    } else {
+      std::uninitialized_move(other.begin(), other.end(), buf_);
+      size_ = other.size_;
+      other.clear();
+    }
+  }
+
+public:
+  using iterator = T*;
+  using const_iterator = const T*;
+  using reverse_iterator = std::reverse_iterator<T*>;
+  using const_reverse_iterator = std::reverse_iterator<const T*>;
+
+  OffsetVector() : buf_(inline_.get()) {}
+
+  OffsetVector(std::initializer_list<T> init) : OffsetVector() {
+    append(init.begin(), init.end());
+  }
+
+  explicit OffsetVector(size_t count) : OffsetVector() { resize(count); }
+  OffsetVector(size_t count, const T& value) : OffsetVector() { resize(count, value); }
+
+  OffsetVector(std::vector<T> vec) : OffsetVector() {
+    append(std::make_move_iterator(vec.begin()), std::make_move_iterator(vec.end()));
+  }
+
+  // Copies take the elements only, not the gap
+  OffsetVector(const OffsetVector& other) : OffsetVector() {
+    append(other.begin(), other.end());
+  }
+
+  OffsetVector(OffsetVector&& other) noexcept : OffsetVector() { steal(other); }
+
+  ~OffsetVector() {
+    clear();
+    release();
+  }
+
+  OffsetVector& operator=(const OffsetVector& other) {
+    if (this != &other) {
+      clear();
+      append(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  OffsetVector& operator=(OffsetVector&& other) noexcept {
+    if (this != &other) {
+      clear();
+      release();
+      buf_ = inline_.get();
+      cap_ = INLINE;
+      steal(other);
+    }
+    return *this;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return cap_ - head_; }
+
+  void reserve(size_t count) {
+    if (head_ + count > cap_) {
+      relocate(count, 0);
+    }
+  }
+
+  void resize(size_t count) {
+    if (count < size_) {
+      std::destroy(data() + count, data() + size_);
+    } else {
+      grow_back(count - size_);
+      std::uninitialized_value_construct(data() + size_, data() + count);
+    }
+    size_ = count;
+  }
+
+  void resize(size_t count, const T& value) {
+    if (count < size_) {
+      std::destroy(data() + count, data() + size_);
+      size_ = count;
+    } else {
+      T held(value);
+      grow_back(count - size_);
+      std::uninitialized_fill(data() + size_, data() + count, held);
+      size_ = count;
+    }
+  }
+
+  void clear() {
+    std::destroy(data(), data() + size_);
+    head_ = 0;
+    size_ = 0;
+  }
+
+  T& operator[](size_t index) { return buf_[head_ + index]; }
+  const T& operator[](size_t index) const { return buf_[head_ + index]; }
+  T* data() { return buf_ + head_; }
+  const T* data() const { return buf_ + head_; }
+  T& front() { return buf_[head_]; }
+  const T& front() const { return buf_[head_]; }
+  T& back() { return buf_[head_ + size_ - 1]; }
+  const T& back() const { return buf_[head_ + size_ - 1]; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  void push_back(const T& value) { append(value); }
+  void push_back(T&& value) { append(std::move(value)); }
+
+  /** Appends [first, last), which must not be this vector's elements */
+  template<typename InputIt>
+  void append(InputIt first, InputIt last) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>) {
+      grow_back(static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      append(*first);
+    }
+  }
+
+  void pop_back() {
+    std::destroy_at(&back());
+    if (--size_ == 0) {
+      head_ = 0;
+    }
+  }
+
+  /** Removes and returns the first element (must not be empty) */
+  T pop_front() {
+    T value = std::move(front());
+    std::destroy_at(&front());
+    ++head_;
+    if (--size_ == 0) {
+      head_ = 0;
+    }
+    return value;
+  }
+
+  void push_front(T value) {
+    if (head_ == 0) {
+      if (size_ < MIN_GAP && size_ < cap_) {
+        // A few elements: step them back one slot rather than reallocate
+        T* first = data();
+        ::new (static_cast<void*>(first + size_)) T(std::move(value));
+        std::rotate(first, first + size_, first + size_ + 1);
+        ++size_;
+        return;
+      }
+      // Reopens a gap in front, as large as the elements, so that repeated
+      // unshifts reallocate only O(log n) times
+      relocate(std::max(cap_, size_ + 1), std::max(size_, MIN_GAP));
+    }
+    ::new (static_cast<void*>(buf_ + head_ - 1)) T(std::move(value));
+    --head_;
+    ++size_;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    T* from = const_cast<T*>(first);
+    T* to = const_cast<T*>(last);
+    T* tail = std::move(to, end(), from);
+    std::destroy(tail, end());
+    size_ -= static_cast<size_t>(to - from);
+    if (size_ == 0) {
+      head_ = 0;
+    }
+    return from;
+  }
+
+  /** The elements as a plain std::vector */
+  std::vector<T> vec() const { return std::vector<T>(begin(), end()); }
+
+  bool operator==(const OffsetVector& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  bool operator!=(const OffsetVector& other) const {
+    return !(*this == other);
+  }
+};
+
+} // namespace detail
+
 /**
  * GoodScript Array class - TypeScript-compatible array wrapper
  * 
  * Wraps std::vector with a TypeScript/JavaScript-like API.
  * Designed for composition, not inheritance from std::vector.
+ * The storage keeps a gap in front (detail::OffsetVector), so shift() and
+ * unshift() are amortized O(1) like push() and pop(), and holds the first
+ * few elements inline, so small arrays cost no allocation.
  */
 template<typename T>
 class Array {
@@ -26,13 +347,13 @@ class Array {
   friend class Array;
 
 private:
-  std::vector<T> impl_;
+  detail::OffsetVector<T> impl_;
 
 public:
   // Type aliases for STL compatibility
   using value_type = T;
-  using iterator = typename std::vector<T>::iterator;
-  using const_iterator = typename std::vector<T>::const_iterator;
+  using iterator = typename detail::OffsetVector<T>::iterator;
+  using const_iterator = typename detail::OffsetVector<T>::const_iterator;
   
   // Constructors
   Array() = default;
@@ -147,9 +468,7 @@ public:
     if (impl_.empty()) {
       return std::nullopt;
     }
-    T value = std::move(impl_.front());
-    impl_.erase(impl_.begin());
-    return value;
+    return impl_.pop_front();
   }
   
   /**
@@ -158,12 +477,12 @@ public:
    * Returns the new length
    */
   int unshift(const T& element) {
-    impl_.insert(impl_.begin(), element);
+    impl_.push_front(element);
     return static_cast<int>(impl_.size());
   }
   
   int unshift(T&& element) {
-    impl_.insert(impl_.begin(), std::move(element));
+    impl_.push_front(std::move(element));
     return static_cast<int>(impl_.size());
   }
   
@@ -186,7 +505,9 @@ public:
       return Array<T>();
     }
     
-    return Array<T>(std::vector<T>(impl_.begin() + startIdx, impl_.begin() + endIdx));
+    Array<T> result;
+    result.impl_.append(impl_.begin() + startIdx, impl_.begin() + endIdx);
+    return result;
   }
   
   /**
@@ -202,7 +523,7 @@ public:
     if (actualDeleteCount > 0) {
       auto startIt = impl_.begin() + startIdx;
       auto endIt = startIt + actualDeleteCount;
-      deleted = Array<T>(std::vector<T>(startIt, endIt));
+      deleted.impl_.append(std::make_move_iterator(startIt), std::make_move_iterator(endIt));
       impl_.erase(startIt, endIt);
     }
     
@@ -217,10 +538,10 @@ public:
   auto map(Fn&& callback) const -> Array<decltype(callback(std::declval<T>()))> {
     using ResultType = decltype(callback(std::declval<T>()));
     Array<ResultType> result;
-    result.impl_.reserve(impl_.size());
+    result.reserve(impl_.size());
     
     for (const auto& element : impl_) {
-      result.impl_.push_back(callback(element));
+      result.push_back(callback(element));
     }
     
     return result;
@@ -315,6 +636,9 @@ public:
    * Returns -1 if not found
    */
   int indexOf(const T& searchElement) const {
+    if constexpr (simd::is_numeric_v<T>) {
+      return static_cast<int>(simd::index_of(std::to_address(impl_.begin()), impl_.size(), searchElement));
+    }
     auto it = std::find(impl_.begin(), impl_.end(), searchElement);
     if (it != impl_.end()) {
       return static_cast<int>(std::distance(impl_.begin(), it));
@@ -340,6 +664,9 @@ public:
    * Equivalent to TypeScript: arr.includes(searchElement)
    */
   bool includes(const T& searchElement) const {
+    if constexpr (simd::is_numeric_v<T>) {
+      return indexOf(searchElement) >= 0;
+    }
     return std::find(impl_.begin(), impl_.end(), searchElement) != impl_.end();
   }
   
@@ -377,31 +704,61 @@ public:
   }
   
   /**
-   * Sorts the elements of an array in place
+   * Fills a portion of the array with a value, in place
+   * Equivalent to TypeScript: arr.fill(value, start, end)
+   */
+  Array<T>& fill(const T& value, std::optional<int> start = std::nullopt, std::optional<int> end = std::nullopt) {
+    int len = static_cast<int>(impl_.size());
+    int startIdx = start.has_value()
+      ? (start.value() < 0 ? std::max(0, len + start.value()) : std::min(start.value(), len))
+      : 0;
+    int endIdx = end.has_value()
+      ? (end.value() < 0 ? std::max(0, len + end.value()) : std::min(end.value(), len))
+      : len;
+    if (startIdx < endIdx) {
+      std::fill(impl_.begin() + startIdx, impl_.begin() + endIdx, value);
+    }
+    return *this;
+  }
+  
+  /**
+   * Sorts the elements of an array in place, stably
    * Equivalent to TypeScript: arr.sort()
    */
   Array<T>& sort() {
-    std::sort(impl_.begin(), impl_.end());
+    gs::sorting::stable_sort(impl_.data(), impl_.size(), std::less<T>());
     return *this;
   }
   
   /**
-   * Sorts the elements of an array in place using a comparison function
+   * Sorts the elements of an array in place using a comparison function.
+   * The sort is stable, as in JavaScript (see gs_sort.hpp).
    * Equivalent to TypeScript: arr.sort(compareFn)
    * 
    * Note: TypeScript comparators return a number (negative/zero/positive),
-   * but C++ std::sort expects a boolean comparator. We wrap the user's
+   * but the sort expects a boolean comparator. We wrap the user's
    * comparator to convert the numeric result to boolean.
    */
   template<typename Fn>
   Array<T>& sort(Fn&& compareFn) {
-    std::sort(impl_.begin(), impl_.end(), [&](const T& a, const T& b) {
+    gs::sorting::stable_sort(impl_.data(), impl_.size(), [&](const T& a, const T& b) {
       auto result = compareFn(a, b);
       return result < 0;
     });
     return *this;
   }
   
+  /**
+   * Sorts by a numeric or string key extracted once per element.
+   * Codegen emits this for arr.sort((a, b) => a.key - b.key), and with
+   * descending = true for b.key - a.key.
+   */
+  template<typename Fn>
+  Array<T>& sortByKey(Fn&& key, bool descending = false) {
+    gs::sorting::sort_by_key(impl_.data(), impl_.size(), key, descending);
+    return *this;
+  }
+  
   /**
    * Calls a function for each element in the array
    * Equivalent to TypeScript: arr.forEach(callback)
@@ -575,17 +932,10 @@ public:
   // Conversion operators for C++ interop
   
   /**
-   * Explicit access to underlying std::vector
+   * Copy of the elements as a std::vector
    */
-  const std::vector<T>& vec() const {
-    return impl_;
-  }
-  
-  /**
-   * Get underlying std::vector (mutable)
-   */
-  std::vector<T>& vec() {
-    return impl_;
+  std::vector<T> vec() const {
+    return impl_.vec();
   }
   
   // Comparison operators
@@ -602,14 +952,18 @@ public:
 /**
  * Template specialization for Array<bool>
  * 
- * std::vector<bool> is specialized to use bit-packing, which returns
- * a proxy object instead of bool& from operator[]. This breaks our
- * at_ref() method. We use std::vector<uint8_t> internally (1 byte per bool)
- * to provide true references while maintaining better cache locality than deque.
+ * A packed bitset: 64 elements per word, so a sieve of 10^9 flags takes
+ * 125 MB instead of 1 GB. Bits outside the elements are always zero, which
+ * lets fill, indexOf/includes, countOf, equality and sort work a word at a
+ * time (popcount and count-trailing-zeros) instead of an element at a time.
  * 
- * Note: This uses 1 byte per boolean instead of 1 bit. For most use cases,
- * the performance benefits of true references and better cache behavior
- * outweigh the 8x memory overhead.
+ * Elements have no address: at_ref() returns a BitReference proxy that
+ * reads as bool and assigns through to the bit; iterators yield bool.
+ * Element i is bit head_ + i: shift() and unshift() move the head, as the
+ * other arrays keep a gap in front, so both are amortized O(1).
+ * 
+ * Callbacks are templates, called as callback(value) or
+ * callback(value, index), so they inline like the generic Array's.
  */
 template<>
 class Array<bool> {
@@ -617,169 +971,399 @@ class Array<bool> {
   friend class Array;
 
 private:
-  std::vector<uint8_t> impl_;  // Use uint8_t to avoid vector<bool> proxy issues
+  static constexpr size_t WORD_BITS = 64;
+
+  std::vector<uint64_t> words_;
+  size_t head_ = 0;  // Bit of element 0; the bits before it are zero
+  size_t size_ = 0;
+
+  static size_t words_for(size_t bits) { return (bits + WORD_BITS - 1) / WORD_BITS; }
+  static uint64_t bit(size_t index) { return uint64_t(1) << (index % WORD_BITS); }
+
+  // Bits [from, to) of one word, from < to <= 64
+  static uint64_t span(size_t from, size_t to) {
+    uint64_t upper = to == WORD_BITS ? ~uint64_t(0) : (uint64_t(1) << to) - 1;
+    return upper & ~((uint64_t(1) << from) - 1);
+  }
+
+  // Element indices below are relative to the head; for_words(), bit()
+  // and span() work on word positions
+
+  bool test(size_t index) const {
+    size_t pos = head_ + index;
+    return (words_[pos / WORD_BITS] & bit(pos)) != 0;
+  }
+
+  void assign(size_t index, bool value) {
+    size_t pos = head_ + index;
+    uint64_t& word = words_[pos / WORD_BITS];
+    word = (word & ~bit(pos)) | ((uint64_t(0) - uint64_t(value)) & bit(pos));
+  }
+
+  void resize_bits(size_t count) {
+    if (count == 0) {
+      clear();
+      return;
+    }
+    size_t end = head_ + count;
+    words_.resize(words_for(end), 0);
+    if (end % WORD_BITS != 0) words_.back() &= span(0, end % WORD_BITS);
+    size_ = count;
+  }
+
+  // Calls fn(word index, mask) for the words covering bits [begin, end)
+  template<typename Fn>
+  static void for_words(size_t begin, size_t end, Fn&& fn) {
+    if (begin >= end) return;
+    size_t first = begin / WORD_BITS, last = (end - 1) / WORD_BITS;
+    for (size_t w = first; w <= last; ++w) {
+      size_t from = w == first ? begin % WORD_BITS : 0;
+      size_t to = w == last ? (end - 1) % WORD_BITS + 1 : WORD_BITS;
+      fn(w, span(from, to));
+    }
+  }
+
+  void fill_bits(size_t begin, size_t end, bool value) {
+    for_words(head_ + begin, head_ + end, [&](size_t w, uint64_t mask) {
+      words_[w] = value ? words_[w] | mask : words_[w] & ~mask;
+    });
+  }
+
+  size_t count_bits(size_t begin, size_t end) const {
+    size_t count = 0;
+    for_words(head_ + begin, head_ + end, [&](size_t w, uint64_t mask) {
+      count += static_cast<size_t>(__builtin_popcountll(words_[w] & mask));
+    });
+    return count;
+  }
+
+  // Index of the first bit equal to value at or after from, or size_
+  size_t find_bit(bool value, size_t from) const {
+    if (from >= size_) return size_;
+    uint64_t flip = value ? 0 : ~uint64_t(0);
+    size_t pos = head_ + from;
+    size_t w = pos / WORD_BITS;
+    uint64_t word = (words_[w] ^ flip) & span(pos % WORD_BITS, WORD_BITS);
+    while (word == 0) {
+      if (++w == words_.size()) return size_;
+      word = words_[w] ^ flip;
+    }
+    size_t index = w * WORD_BITS + static_cast<size_t>(__builtin_ctzll(word)) - head_;
+    return std::min(index, size_);
+  }
+
+  // count <= 64 bits starting at pos, in the low bits of the result
+  uint64_t extract(size_t index, size_t count) const {
+    size_t pos = head_ + index;
+    size_t w = pos / WORD_BITS, shift = pos % WORD_BITS;
+    uint64_t bits = words_[w] >> shift;
+    if (shift != 0 && shift + count > WORD_BITS) bits |= words_[w + 1] << (WORD_BITS - shift);
+    return count == WORD_BITS ? bits : bits & span(0, count);
+  }
+
+  void append_bits(const Array<bool>& source, size_t begin, size_t end) {
+    if (begin >= end) return;
+    size_t at = head_ + size_;
+    words_.resize(words_for(at + (end - begin)), 0);
+    for (size_t pos = begin; pos < end; pos += WORD_BITS, at += WORD_BITS) {
+      size_t count = std::min(WORD_BITS, end - pos);
+      uint64_t bits = source.extract(pos, count);
+      size_t w = at / WORD_BITS, shift = at % WORD_BITS;
+      words_[w] |= bits << shift;
+      if (shift != 0 && shift + count > WORD_BITS) words_[w + 1] |= bits >> (WORD_BITS - shift);
+    }
+    size_ += end - begin;
+  }
+
+  template<typename Fn>
+  static auto call(Fn& callback, bool value, size_t index) {
+    if constexpr (std::is_invocable_v<Fn&, bool, int>) {
+      return callback(value, static_cast<int>(index));
+    } else {
+      return callback(value);
+    }
+  }
+
+  int clamp_index(std::optional<int> index, int fallback) const {
+    int len = length();
+    if (!index.has_value()) return fallback;
+    return index.value() < 0 ? std::max(0, len + index.value()) : std::min(index.value(), len);
+  }
 
 public:
   // Type aliases for STL compatibility
   using value_type = bool;
+
+  /** Reads as bool and writes through to one bit */
+  class BitReference {
+    uint64_t* word_;
+    uint64_t mask_;
+  public:
+    BitReference(uint64_t* word, uint64_t mask) : word_(word), mask_(mask) {}
+    operator bool() const { return (*word_ & mask_) != 0; }
+    BitReference& operator=(bool value) {
+      *word_ = value ? *word_ | mask_ : *word_ & ~mask_;
+      return *this;
+    }
+    BitReference& operator=(const BitReference& other) { return *this = static_cast<bool>(other); }
+  };
   
   // Constructors
   Array() = default;
   Array(std::initializer_list<bool> init) {
-    impl_.reserve(init.size());
+    reserve(init.size());
     for (bool val : init) {
-      impl_.push_back(val ? 1 : 0);
+      push(val);
     }
   }
-  explicit Array(int size) : impl_(size, 0) {}
-  Array(int size, bool value) : impl_(size, value ? 1 : 0) {}
+  explicit Array(int size) { resize_bits(static_cast<size_t>(size)); }
+  Array(int size, bool value) {
+    resize_bits(static_cast<size_t>(size));
+    if (value) fill_bits(0, size_, true);
+  }
   Array(const Array& other) = default;
-  Array(Array&& other) noexcept = default;
+  Array(Array&& other) noexcept
+    : words_(std::move(other.words_)),
+      head_(std::exchange(other.head_, 0)),
+      size_(std::exchange(other.size_, 0)) {
+    other.words_.clear();
+  }
   
   // Assignment
   Array& operator=(const Array& other) = default;
-  Array& operator=(Array&& other) noexcept = default;
+  Array& operator=(Array&& other) noexcept {
+    if (this != &other) {
+      words_ = std::move(other.words_);
+      head_ = std::exchange(other.head_, 0);
+      size_ = std::exchange(other.size_, 0);
+      other.words_.clear();
+    }
+    return *this;
+  }
   
   // Core array methods
-  int getLength() const { return static_cast<int>(impl_.size()); }
+  int getLength() const { return static_cast<int>(size_); }
   void setLength(int newLength) { 
     if (newLength < 0) {
       throw std::invalid_argument("Array length must be non-negative");
     }
-    impl_.resize(static_cast<size_t>(newLength), 0); 
+    resize_bits(static_cast<size_t>(newLength));
   }
   int length() const { return getLength(); }  // Alias for compatibility
+
+  void resize(size_t count) { resize_bits(count); }
+  void reserve(size_t capacity) { words_.reserve(words_for(head_ + capacity)); }
+  size_t capacity() const { return words_.capacity() * WORD_BITS - head_; }
   
-  void push(bool value) { impl_.push_back(value ? 1 : 0); }
+  int push(bool value) {
+    size_t pos = head_ + size_;
+    if (pos % WORD_BITS == 0) words_.push_back(0);
+    if (value) words_.back() |= bit(pos);
+    ++size_;
+    return length();
+  }
+  void push_back(bool value) { push(value); }
   
   std::optional<bool> pop() {
-    if (impl_.empty()) return std::nullopt;
-    bool value = impl_.back() != 0;
-    impl_.pop_back();
+    if (size_ == 0) return std::nullopt;
+    bool value = test(size_ - 1);
+    resize_bits(size_ - 1);
     return value;
   }
   
   std::optional<bool> shift() {
-    if (impl_.empty()) return std::nullopt;
-    bool value = impl_.front() != 0;
-    impl_.erase(impl_.begin());
+    if (size_ == 0) return std::nullopt;
+    bool value = test(0);
+    assign(0, false);
+    ++head_;
+    if (--size_ == 0) {
+      clear();
+    } else if (head_ >= WORD_BITS && head_ >= size_) {
+      // Drop the whole words in front once they outnumber the elements
+      size_t drop = head_ / WORD_BITS;
+      words_.erase(words_.begin(), words_.begin() + static_cast<std::ptrdiff_t>(drop));
+      head_ -= drop * WORD_BITS;
+    }
     return value;
   }
   
-  void unshift(bool value) { impl_.insert(impl_.begin(), value ? 1 : 0); }
+  int unshift(bool value) {
+    if (head_ == 0) {
+      // Reopen a gap in front, proportional to the length so that
+      // repeated unshifts move the words only O(log n) times
+      size_t gap = std::max<size_t>(words_for(size_) / 2, 1);
+      words_.insert(words_.begin(), gap, 0);
+      head_ = gap * WORD_BITS;
+    }
+    --head_;
+    ++size_;
+    assign(0, value);
+    return length();
+  }
   
-  Array<bool> slice(int start, std::optional<int> end = std::nullopt) const {
-    int len = static_cast<int>(impl_.size());
-    int actualStart = start < 0 ? std::max(0, len + start) : std::min(start, len);
-    int actualEnd = end.has_value() 
-      ? (end.value() < 0 ? std::max(0, len + end.value()) : std::min(end.value(), len))
-      : len;
-    
-    if (actualStart >= actualEnd) return Array<bool>();
-    
+  Array<bool> slice(std::optional<int> start = std::nullopt, std::optional<int> end = std::nullopt) const {
+    int actualStart = clamp_index(start, 0);
+    int actualEnd = clamp_index(end, length());
     Array<bool> result;
-    result.impl_.reserve(actualEnd - actualStart);
-    for (int i = actualStart; i < actualEnd; i++) {
-      result.impl_.push_back(impl_[i]);
+    if (actualStart < actualEnd) {
+      result.append_bits(*this, static_cast<size_t>(actualStart), static_cast<size_t>(actualEnd));
     }
     return result;
   }
   
   Array<bool> concat(const Array<bool>& other) const {
-    Array<bool> result;
-    result.impl_.reserve(impl_.size() + other.impl_.size());
-    result.impl_ = impl_;
-    result.impl_.insert(result.impl_.end(), other.impl_.begin(), other.impl_.end());
+    Array<bool> result(*this);
+    result.append_bits(other, 0, other.size_);
     return result;
   }
   
-  std::optional<int> indexOf(bool searchElement, int fromIndex = 0) const {
-    int len = static_cast<int>(impl_.size());
-    int start = fromIndex < 0 ? std::max(0, len + fromIndex) : fromIndex;
-    uint8_t searchVal = searchElement ? 1 : 0;
-    
-    for (int i = start; i < len; i++) {
-      if (impl_[i] == searchVal) {
-        return i;
-      }
-    }
-    return std::nullopt;
+  /** Number of elements equal to value (JavaScript: filter(x => x === value).length) */
+  int countOf(bool value) const {
+    size_t set = count_bits(0, size_);
+    return static_cast<int>(value ? set : size_ - set);
+  }
+  
+  int indexOf(bool searchElement, int fromIndex = 0) const {
+    int start = fromIndex < 0 ? std::max(0, length() + fromIndex) : fromIndex;
+    size_t index = find_bit(searchElement, static_cast<size_t>(start));
+    return index < size_ ? static_cast<int>(index) : -1;
   }
   
   bool includes(bool searchElement, int fromIndex = 0) const {
-    return indexOf(searchElement, fromIndex).has_value();
+    return indexOf(searchElement, fromIndex) >= 0;
   }
   
-  String join(const String& separator) const;
+  String join(const String& separator = String(",")) const {
+    std::string result;
+    result.reserve(size_ * 6);
+    for (size_t i = 0; i < size_; ++i) {
+      if (i > 0) result += separator.str();
+      result += test(i) ? "true" : "false";
+    }
+    return String(std::move(result));
+  }
   
-  void forEach(std::function<void(bool, int)> callback) const {
-    for (size_t i = 0; i < impl_.size(); i++) {
-      callback(impl_[i] != 0, static_cast<int>(i));
+  template<typename Fn>
+  void forEach(Fn&& callback) const {
+    for (size_t i = 0; i < size_; i++) {
+      call(callback, test(i), i);
     }
   }
   
-  template<typename R>
-  Array<R> map(std::function<R(bool, int)> callback) const {
-    std::vector<R> result;
-    result.reserve(impl_.size());
-    for (size_t i = 0; i < impl_.size(); i++) {
-      result.push_back(callback(impl_[i] != 0, static_cast<int>(i)));
+  template<typename Fn>
+  auto map(Fn&& callback) const {
+    using R = std::decay_t<decltype(call(callback, false, 0))>;
+    Array<R> result;
+    result.reserve(size_);
+    for (size_t i = 0; i < size_; i++) {
+      result.push(call(callback, test(i), i));
     }
-    return Array<R>(std::move(result));
+    return result;
   }
   
-  Array<bool> filter(std::function<bool(bool, int)> predicate) const {
+  template<typename Fn>
+  Array<bool> filter(Fn&& predicate) const {
     Array<bool> result;
-    for (size_t i = 0; i < impl_.size(); i++) {
-      bool val = impl_[i] != 0;
-      if (predicate(val, static_cast<int>(i))) {
-        result.impl_.push_back(impl_[i]);
+    for (size_t i = 0; i < size_; i++) {
+      bool val = test(i);
+      if (call(predicate, val, i)) {
+        result.push(val);
       }
     }
     return result;
   }
   
-  std::optional<bool> find(std::function<bool(bool, int)> predicate) const {
-    for (size_t i = 0; i < impl_.size(); i++) {
-      bool val = impl_[i] != 0;
-      if (predicate(val, static_cast<int>(i))) {
+  template<typename Fn, typename U>
+  auto reduce(Fn&& callback, U initialValue) const
+    -> decltype(callback(std::declval<U>(), false)) {
+    using R = decltype(callback(std::declval<U>(), false));
+    R accumulator = static_cast<R>(std::move(initialValue));
+    for (size_t i = 0; i < size_; i++) {
+      accumulator = callback(std::move(accumulator), test(i));
+    }
+    return accumulator;
+  }
+  
+  template<typename Fn>
+  std::optional<bool> find(Fn&& predicate) const {
+    for (size_t i = 0; i < size_; i++) {
+      bool val = test(i);
+      if (call(predicate, val, i)) {
         return val;
       }
     }
     return std::nullopt;
   }
   
-  bool some(std::function<bool(bool, int)> predicate) const {
-    for (size_t i = 0; i < impl_.size(); i++) {
-      if (predicate(impl_[i] != 0, static_cast<int>(i))) {
+  template<typename Fn>
+  int findIndex(Fn&& predicate) const {
+    for (size_t i = 0; i < size_; i++) {
+      if (call(predicate, test(i), i)) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+  
+  template<typename Fn>
+  bool some(Fn&& predicate) const {
+    for (size_t i = 0; i < size_; i++) {
+      if (call(predicate, test(i), i)) {
         return true;
       }
     }
     return false;
   }
   
-  bool every(std::function<bool(bool, int)> predicate) const {
-    for (size_t i = 0; i < impl_.size(); i++) {
-      if (!predicate(impl_[i] != 0, static_cast<int>(i))) {
+  template<typename Fn>
+  bool every(Fn&& predicate) const {
+    for (size_t i = 0; i < size_; i++) {
+      if (!call(predicate, test(i), i)) {
         return false;
       }
     }
     return true;
   }
   
-  void reverse() {
-    std::reverse(impl_.begin(), impl_.end());
+  Array<bool>& reverse() {
+    for (size_t i = 0, j = size_; i + 1 < j; ++i) {
+      --j;
+      bool a = test(i), b = test(j);
+      assign(i, b);
+      assign(j, a);
+    }
+    return *this;
   }
   
-  void sort(std::function<int(bool, bool)> compareFn = nullptr) {
-    if (compareFn) {
-      std::sort(impl_.begin(), impl_.end(), 
-        [&compareFn](uint8_t a, uint8_t b) { 
-          return compareFn(a != 0, b != 0) < 0; 
-        });
-    } else {
-      std::sort(impl_.begin(), impl_.end());
+  Array<bool>& fill(bool value, std::optional<int> start = std::nullopt, std::optional<int> end = std::nullopt) {
+    int startIdx = clamp_index(start, 0);
+    int endIdx = clamp_index(end, length());
+    if (startIdx < endIdx) {
+      fill_bits(static_cast<size_t>(startIdx), static_cast<size_t>(endIdx), value);
+    }
+    return *this;
+  }
+  
+  /**
+   * Sorts in place. Equal booleans are indistinguishable, so sorting is
+   * counting: the comparator is asked once which value comes first.
+   */
+  Array<bool>& sort() {
+    size_t set = count_bits(0, size_);
+    fill_bits(0, size_ - set, false);
+    fill_bits(size_ - set, size_, true);
+    return *this;
+  }
+  
+  template<typename Fn>
+  Array<bool>& sort(Fn&& compareFn) {
+    if (compareFn(false, true) < 0) return sort();
+    if (compareFn(true, false) < 0) {
+      size_t set = count_bits(0, size_);
+      fill_bits(0, set, true);
+      fill_bits(set, size_, false);
     }
+    return *this;
   }
   
   /**
@@ -787,31 +1371,30 @@ public:
    * Returns default value for out-of-bounds or negative indices
    */
   bool get_or_default(int index, bool defaultValue = false) const {
-    if (index < 0 || index >= static_cast<int>(impl_.size())) {
+    if (index < 0 || index >= length()) {
       return defaultValue;
     }
-    return impl_[static_cast<size_t>(index)] != 0;
+    return test(static_cast<size_t>(index));
   }
   
-  // Direct element access - returns uint8_t& which implicitly converts to bool
-  // For reading: uint8_t implicitly converts to bool
-  // For writing: use set_unchecked() or operator[]
-  uint8_t& at_ref(int index) {
-    return impl_[static_cast<size_t>(index)];
+  // Direct element access without bounds checks
+  BitReference at_ref(int index) {
+    size_t pos = head_ + static_cast<size_t>(index);
+    return BitReference(&words_[pos / WORD_BITS], bit(pos));
   }
   
-  const uint8_t& at_ref(int index) const {
-    return impl_[static_cast<size_t>(index)];
+  bool at_ref(int index) const {
+    return test(static_cast<size_t>(index));
   }
   
   // Subscript operators - return value for reading
   bool operator[](int index) const {
-    return impl_[static_cast<size_t>(index)] != 0;
+    return test(static_cast<size_t>(index));
   }
   
   // For writing, provide a helper
   void set_unchecked(int index, bool value) {
-    impl_[static_cast<size_t>(index)] = value ? 1 : 0;
+    assign(static_cast<size_t>(index), value);
   }
   
   /**
@@ -824,33 +1407,16 @@ public:
       throw std::invalid_argument("Array index must be non-negative");
     }
     size_t idx = static_cast<size_t>(index);
-    if (idx >= impl_.size()) {
-      impl_.resize(idx + 1, 0);
+    if (idx >= size_) {
+      resize_bits(idx + 1);
     }
-    impl_[idx] = value ? 1 : 0;
+    assign(idx, value);
   }
   
-  // STL compatibility - iterator support for range-based for loops
-  // We create a custom iterator that converts uint8_t to bool on the fly
-  class BoolIterator {
-    typename std::vector<uint8_t>::iterator it_;
-  public:
-    using iterator_category = std::random_access_iterator_tag;
-    using value_type = bool;
-    using difference_type = std::ptrdiff_t;
-    using pointer = bool*;
-    using reference = bool;
-    
-    BoolIterator(typename std::vector<uint8_t>::iterator it) : it_(it) {}
-    bool operator*() const { return *it_ != 0; }
-    BoolIterator& operator++() { ++it_; return *this; }
-    BoolIterator operator++(int) { BoolIterator tmp = *this; ++it_; return tmp; }
-    bool operator==(const BoolIterator& other) const { return it_ == other.it_; }
-    bool operator!=(const BoolIterator& other) const { return it_ != other.it_; }
-  };
-  
-  class ConstBoolIterator {
-    typename std::vector<uint8_t>::const_iterator it_;
+  // STL compatibility - random access iterator that reads one bit per element
+  class BitIterator {
+    const Array<bool>* array_;
+    size_t index_;
   public:
     using iterator_category = std::random_access_iterator_tag;
     using value_type = bool;
@@ -858,32 +1424,54 @@ public:
     using pointer = const bool*;
     using reference = bool;
     
-    ConstBoolIterator(typename std::vector<uint8_t>::const_iterator it) : it_(it) {}
-    bool operator*() const { return *it_ != 0; }
-    ConstBoolIterator& operator++() { ++it_; return *this; }
-    ConstBoolIterator operator++(int) { ConstBoolIterator tmp = *this; ++it_; return tmp; }
-    bool operator==(const ConstBoolIterator& other) const { return it_ == other.it_; }
-    bool operator!=(const ConstBoolIterator& other) const { return it_ != other.it_; }
+    BitIterator(const Array<bool>* array, size_t index) : array_(array), index_(index) {}
+    bool operator*() const { return array_->test(index_); }
+    bool operator[](difference_type n) const { return array_->test(index_ + n); }
+    BitIterator& operator++() { ++index_; return *this; }
+    BitIterator operator++(int) { BitIterator tmp = *this; ++index_; return tmp; }
+    BitIterator& operator--() { --index_; return *this; }
+    BitIterator operator--(int) { BitIterator tmp = *this; --index_; return tmp; }
+    BitIterator& operator+=(difference_type n) { index_ += n; return *this; }
+    BitIterator& operator-=(difference_type n) { index_ -= n; return *this; }
+    BitIterator operator+(difference_type n) const { return BitIterator(array_, index_ + n); }
+    BitIterator operator-(difference_type n) const { return BitIterator(array_, index_ - n); }
+    difference_type operator-(const BitIterator& other) const {
+      return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    }
+    bool operator==(const BitIterator& other) const { return index_ == other.index_; }
+    bool operator!=(const BitIterator& other) const { return index_ != other.index_; }
+    bool operator<(const BitIterator& other) const { return index_ < other.index_; }
   };
   
-  BoolIterator begin() { return BoolIterator(impl_.begin()); }
-  BoolIterator end() { return BoolIterator(impl_.end()); }
-  ConstBoolIterator begin() const { return ConstBoolIterator(impl_.begin()); }
-  ConstBoolIterator end() const { return ConstBoolIterator(impl_.end()); }
-  ConstBoolIterator cbegin() const { return ConstBoolIterator(impl_.cbegin()); }
-  ConstBoolIterator cend() const { return ConstBoolIterator(impl_.cend()); }
+  using iterator = BitIterator;
+  using const_iterator = BitIterator;
+  
+  BitIterator begin() const { return BitIterator(this, 0); }
+  BitIterator end() const { return BitIterator(this, size_); }
+  BitIterator cbegin() const { return begin(); }
+  BitIterator cend() const { return end(); }
   
-  bool empty() const { return impl_.empty(); }
-  size_t size() const { return impl_.size(); }
-  void clear() { impl_.clear(); }
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  void clear() {
+    words_.clear();
+    head_ = 0;
+    size_ = 0;
+  }
   
-  // Equality operators
+  // Equality operators (64 elements at a time, whatever the heads)
   bool operator==(const Array<bool>& other) const {
-    return impl_ == other.impl_;
+    if (size_ != other.size_) return false;
+    if (head_ == other.head_) return words_ == other.words_;
+    for (size_t i = 0; i < size_; i += WORD_BITS) {
+      size_t count = std::min(WORD_BITS, size_ - i);
+      if (extract(i, count) != other.extract(i, count)) return false;
+    }
+    return true;
   }
   
   bool operator!=(const Array<bool>& other) const {
-    return impl_ != other.impl_;
+    return !(*this == other);
   }
 };
 
@@ -12,7 +12,8 @@
  * 
  * Requires C++17 or later for std::filesystem
  * 
- * Note: This header should be included AFTER gs_string.hpp, gs_array.hpp, and gs_error.hpp
+ * Note: This header should be included AFTER gs_string.hpp, gs_array.hpp, gs_error.hpp, gs_typed_array.hpp
+ * and the timer header (FileSystemAsync runs on its event loop)
  * It is automatically included by gs_runtime.hpp and gs_gc_runtime.hpp
  */
 
@@ -28,9 +29,27 @@
 #include <codecvt>
 #include <locale>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #ifdef CPPCORO_TASK_HPP_INCLUDED
 #include <cppcoro/task.hpp>
 #include <cppcoro/sync_wait.hpp>
+#include <deque>
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #endif
 
 // Forward declarations - actual types provided by gs_runtime.hpp or gs_gc_runtime.hpp
@@ -282,14 +301,10 @@ public:
   }
 
   /**
-   * Read entire file as bytes
+   * Read entire file as bytes, straight into the Uint8Array's buffer
    */
-  static gs::Array<uint8_t> readBytes(const gs::String& path) {
-    #ifdef GS_GC_MODE
-    std::filesystem::path p(GS_STRING_CSTR(path));
-    #else
+  static gs::Uint8Array readBytes(const gs::String& path) {
     std::filesystem::path p(GS_STRING_CSTR(path));
-    #endif
     std::ifstream file(p, std::ios::binary);
     
     if (!file.is_open()) {
@@ -301,15 +316,8 @@ public:
     size_t size = file.tellg();
     file.seekg(0, std::ios::beg);
     
-    // Read into vector
-    std::vector<uint8_t> buffer(size);
-    file.read(reinterpret_cast<char*>(buffer.data()), size);
-    
-    // Convert to gs::Array
-    gs::Array<uint8_t> result;
-    for (uint8_t byte : buffer) {
-      result.push(byte);
-    }
+    gs::Uint8Array result(static_cast<double>(size));
+    file.read(reinterpret_cast<char*>(result.data()), size);
     
     return result;
   }
@@ -317,28 +325,16 @@ public:
   /**
    * Write bytes to file
    */
-  static void writeBytes(const gs::String& path, const gs::Array<uint8_t>& data,
+  static void writeBytes(const gs::String& path, const gs::Uint8Array& data,
                          const std::optional<int>& mode = std::nullopt) {
-    #ifdef GS_GC_MODE
     std::filesystem::path p(GS_STRING_CSTR(path));
-    #else
-    std::filesystem::path p(GS_STRING_CSTR(path));
-    #endif
     std::ofstream file(p, std::ios::binary | std::ios::trunc);
     
     if (!file.is_open()) {
       throw gs::Error("Failed to open file for writing: " + path);
     }
     
-    // Write array data
-    for (int i = 0; i < data.length(); i++) {
-      #ifdef GS_GC_MODE
-      uint8_t byte = data[i];  // GC mode: operator[] returns T&
-      #else
-      uint8_t byte = *data[i]; // Ownership mode: operator[] returns T*
-      #endif
-      file.write(reinterpret_cast<const char*>(&byte), 1);
-    }
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
     
     // Set permissions if provided (POSIX only)
     #ifndef _WIN32
@@ -350,6 +346,86 @@ public:
     #endif
   }
 
+  static void writeBytes(const gs::String& path, const gs::Array<uint8_t>& data,
+                         const std::optional<int>& mode = std::nullopt) {
+    writeBytes(path, gs::Uint8Array(data), mode);
+  }
+
+  /**
+   * Map a file into memory and return a view of its bytes, without reading
+   * it. Pages load as the view is scanned (indexOf, subarray), so files
+   * larger than memory work; decodeText turns the slices needed into text.
+   * The mapping is private: writes through the view never reach the file.
+   * access hints the kernel's readahead: "sequential", "random",
+   * "willneed" or "normal" (the default).
+   * Ownership mode unmaps with the last view; the GC runtime keeps the
+   * mapping until unmapFile or exit.
+   * Windows reads the file instead (readBytes).
+   */
+  static gs::Uint8Array mapFile(const gs::String& path, const std::optional<gs::String>& access = std::nullopt) {
+    #ifdef _WIN32
+    return readBytes(path);
+    #else
+    int advice = MADV_NORMAL;
+    if (access.has_value()) {
+      std::string hint = GS_STRING_TO_STD(*access);
+      if (hint == "sequential") advice = MADV_SEQUENTIAL;
+      else if (hint == "random") advice = MADV_RANDOM;
+      else if (hint == "willneed") advice = MADV_WILLNEED;
+      else if (hint != "normal") throw gs::Error("Unsupported access hint: " + *access);
+    }
+
+    int fd = ::open(GS_STRING_CSTR(path), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw gs::Error("Failed to open file: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      ::close(fd);
+      throw gs::Error("Failed to map file: " + path);
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+      ::close(fd);
+      return gs::Uint8Array(0.0);
+    }
+
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file open
+    if (base == MAP_FAILED) {
+      throw gs::Error("Failed to map file: " + path);
+    }
+    if (advice != MADV_NORMAL) {
+      ::madvise(base, size, advice);
+    }
+
+    std::shared_ptr<void> mapping(base, [size](void* p) { ::munmap(p, size); });
+    return gs::Uint8Array(gs::ArrayBuffer::external(static_cast<uint8_t*>(base), size, std::move(mapping)));
+    #endif
+  }
+
+  /**
+   * Unmap a mapFile view now. Neither it nor any subarray of it may be
+   * used afterwards. Only the GC runtime needs this: ownership mode
+   * unmaps with the last view, so the call does nothing there.
+   */
+  static void unmapFile(const gs::Uint8Array& bytes) {
+    #ifdef GS_GC_MODE
+    gs::ArrayBuffer::release(bytes.buffer());
+    #else
+    (void)bytes;
+    #endif
+  }
+
+  /**
+   * Decode bytes as text (UTF-8 by default), e.g. a line found in a mapFile view
+   */
+  static gs::String decodeText(const gs::Uint8Array& bytes, const std::optional<gs::String>& encoding = std::nullopt) {
+    std::string raw(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    std::string enc = encoding.has_value() ? GS_STRING_TO_STD(*encoding) : "utf-8";
+    return gs::String(detail::decodeBytes(raw, enc));
+  }
+
   /**
    * Delete a file or empty directory
    */
@@ -707,48 +783,469 @@ public:
 };
 
 #ifdef CPPCORO_TASK_HPP_INCLUDED
+#if defined(__linux__)
+namespace detail {
+
+/**
+ * io_uring rings behind FileSystemAsync (Linux 5.6 and later)
+ * 
+ * An operation fills a submission entry and suspends. Entries queued while
+ * the program runs reach the kernel in one io_uring_enter when the event
+ * loop is about to wait, so reads started together (Promise.all over many
+ * files) cost one system call per step rather than one per file.
+ * Completions signal an eventfd in the loop's epoll set, and the loop
+ * resumes each waiting coroutine through the microtask queue.
+ * 
+ * No more operations are in flight than the completion ring holds, and no
+ * more than MAX_OPEN_FILES files (half the descriptor limit at most) are
+ * open; the others wait their turn.
+ * Where io_uring is missing (older kernels, seccomp filters) instance()
+ * is null and FileSystemAsync blocks as FileSystem does.
+ */
+class IoRing {
+public:
+  static constexpr unsigned ENTRIES = 256;
+  static constexpr unsigned MAX_OPEN_FILES = 256;
+
+  /**
+   * Awaitable operation; co_await yields its result, -errno on failure
+   */
+  struct Operation {
+    enum Kind { Other, Open, Close };
+
+    io_uring_sqe sqe{};
+    Kind kind = Other;
+    int result = 0;
+    cppcoro::coroutine_handle<> waiter;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(cppcoro::coroutine_handle<> handle) {
+      waiter = handle;
+      instance()->queue(this);
+    }
+    int await_resume() const noexcept { return result; }
+  };
+
+  static IoRing* instance() {
+    static IoRing* ring = open();
+    return ring;
+  }
+
+  static Operation openat(const char* path, int flags, mode_t mode) {
+    Operation op;
+    op.kind = Operation::Open;
+    op.sqe.opcode = IORING_OP_OPENAT;
+    op.sqe.fd = AT_FDCWD;
+    op.sqe.addr = reinterpret_cast<uint64_t>(path);
+    op.sqe.len = mode;
+    op.sqe.open_flags = static_cast<uint32_t>(flags | O_CLOEXEC);
+    return op;
+  }
+
+  // statx(dirfd, path, flags, STATX_BASIC_STATS, buffer)
+  static Operation statx(int dirfd, const char* path, int flags, struct ::statx* buffer) {
+    Operation op;
+    op.sqe.opcode = IORING_OP_STATX;
+    op.sqe.fd = dirfd;
+    op.sqe.addr = reinterpret_cast<uint64_t>(path);
+    op.sqe.len = STATX_BASIC_STATS;
+    op.sqe.off = reinterpret_cast<uint64_t>(buffer);
+    op.sqe.statx_flags = static_cast<uint32_t>(flags);
+    return op;
+  }
+
+  // offset -1 reads from, or writes at, the file position
+  static Operation read(int fd, void* buffer, unsigned length, uint64_t offset) {
+    return transfer(IORING_OP_READ, fd, buffer, length, offset);
+  }
+
+  static Operation write(int fd, const void* buffer, unsigned length, uint64_t offset) {
+    return transfer(IORING_OP_WRITE, fd, buffer, length, offset);
+  }
+
+  static Operation close(int fd) {
+    Operation op;
+    op.kind = Operation::Close;
+    op.sqe.opcode = IORING_OP_CLOSE;
+    op.sqe.fd = fd;
+    return op;
+  }
+
+private:
+  int ringFd_;
+  int eventFd_;
+  unsigned* sqTail_;
+  unsigned* sqMask_;
+  unsigned* sqArray_;
+  io_uring_sqe* sqes_;
+  unsigned* cqHead_;
+  unsigned* cqTail_;
+  unsigned* cqMask_;
+  io_uring_cqe* cqes_;
+  unsigned sqEntries_;
+  unsigned cqEntries_;
+
+  unsigned unsubmitted_ = 0;
+  unsigned inFlight_ = 0;      // In the rings, submitted or not
+  unsigned openFiles_ = 0;     // Opening or open
+  unsigned maxOpenFiles_;
+  std::deque<Operation*> waiting_;
+  std::deque<Operation*> waitingOpens_;
+
+  static Operation transfer(uint8_t opcode, int fd, const void* buffer, unsigned length, uint64_t offset) {
+    Operation op;
+    op.sqe.opcode = opcode;
+    op.sqe.fd = fd;
+    op.sqe.addr = reinterpret_cast<uint64_t>(buffer);
+    op.sqe.len = length;
+    op.sqe.off = offset;
+    return op;
+  }
+
+  // Sets up the rings and registers them with the event loop; null if
+  // the kernel lacks io_uring or one of the operations used here
+  static IoRing* open() {
+    io_uring_params params{};
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+    if (fd < 0) {
+      return nullptr;
+    }
+    if (!supported(fd) || !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+      ::close(fd);
+      return nullptr;
+    }
+
+    size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    size_t ringSize = std::max(sqSize, cqSize);
+    void* rings = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    void* sqes = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    int eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (rings == MAP_FAILED || sqes == MAP_FAILED || eventFd < 0 ||
+        syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0) {
+      if (eventFd >= 0) ::close(eventFd);
+      ::close(fd);  // Also unmaps the rings
+      return nullptr;
+    }
+
+    auto* ring = new IoRing();
+    char* base = static_cast<char*>(rings);
+    ring->ringFd_ = fd;
+    ring->eventFd_ = eventFd;
+    ring->sqTail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    ring->sqMask_ = reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    ring->sqArray_ = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+    ring->cqHead_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    ring->cqTail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    ring->cqMask_ = reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    ring->cqes_ = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    ring->sqEntries_ = params.sq_entries;
+    ring->cqEntries_ = params.cq_entries;
+    rlimit files{};
+    getrlimit(RLIMIT_NOFILE, &files);
+    ring->maxOpenFiles_ = static_cast<unsigned>(std::clamp<rlim_t>(files.rlim_cur / 2, 1, MAX_OPEN_FILES));
+
+    TimerManager::addIoSource({
+      eventFd,
+      [] { return instance()->busy(); },
+      [] { instance()->submit(); },
+      [] { instance()->complete(); },
+    });
+    return ring;
+  }
+
+  static bool supported(int fd) {
+    constexpr unsigned OPS = 256;
+    std::vector<char> storage(sizeof(io_uring_probe) + OPS * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, OPS) < 0) {
+      return false;
+    }
+    for (uint8_t op : {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE}) {
+      if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool busy() const {
+    return inFlight_ > 0 || !waiting_.empty() || !waitingOpens_.empty();
+  }
+
+  void queue(Operation* op) {
+    if (op->kind == Operation::Open) {
+      if (openFiles_ >= maxOpenFiles_) {
+        waitingOpens_.push_back(op);
+        return;
+      }
+      ++openFiles_;
+    }
+    if (inFlight_ >= cqEntries_) {
+      waiting_.push_back(op);
+      return;
+    }
+    push(op);
+  }
+
+  void push(Operation* op) {
+    if (unsubmitted_ == sqEntries_) {
+      submit();
+    }
+    unsigned tail = *sqTail_;
+    unsigned index = tail & *sqMask_;
+    sqes_[index] = op->sqe;
+    sqes_[index].user_data = reinterpret_cast<uint64_t>(op);
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    ++unsubmitted_;
+    ++inFlight_;
+  }
+
+  // Hands the queued entries to the kernel in one call
+  void submit() {
+    while (unsubmitted_ > 0) {
+      long submitted = syscall(__NR_io_uring_enter, ringFd_, unsubmitted_, 0, 0, nullptr, 0);
+      if (submitted < 0) {
+        if (errno == EINTR || errno == EAGAIN) continue;
+        throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+      }
+      unsigned count = static_cast<unsigned>(submitted);
+      unsubmitted_ -= count;
+    }
+  }
+
+  void complete() {
+    uint64_t signals;
+    while (::read(eventFd_, &signals, sizeof(signals)) < 0 && errno == EINTR) {
+    }
+
+    unsigned head = *cqHead_;
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes_[head & *cqMask_];
+      auto* op = reinterpret_cast<Operation*>(cqe.user_data);
+      op->result = cqe.res;
+      --inFlight_;
+      if (op->kind == Operation::Close || (op->kind == Operation::Open && op->result < 0)) {
+        --openFiles_;
+      }
+      MicrotaskQueue::enqueue(&resume, op->waiter.address());
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    while (!waitingOpens_.empty() && openFiles_ < maxOpenFiles_) {
+      Operation* op = waitingOpens_.front();
+      waitingOpens_.pop_front();
+      ++openFiles_;
+      waiting_.push_back(op);
+    }
+    while (!waiting_.empty() && inFlight_ < cqEntries_) {
+      push(waiting_.front());
+      waiting_.pop_front();
+    }
+  }
+
+  static void resume(void* address) {
+    cppcoro::coroutine_handle<>::from_address(address).resume();
+  }
+};
+
+// Reads all of an open file: size bytes if size > 0, else until end of file
+inline cppcoro::task<int> readAll(int fd, std::string& bytes, int64_t size) {
+  bytes.resize(size > 0 ? static_cast<size_t>(size) : 64 * 1024);
+  size_t done = 0;
+  while (true) {
+    if (done == bytes.size()) {
+      if (size > 0) break;
+      bytes.resize(bytes.size() * 2);
+    }
+    unsigned length = static_cast<unsigned>(std::min<size_t>(bytes.size() - done, 1u << 30));
+    int n = co_await IoRing::read(fd, bytes.data() + done, length, done);
+    if (n < 0) co_return n;
+    if (n == 0) break;
+    done += static_cast<size_t>(n);
+  }
+  bytes.resize(done);
+  co_return 0;
+}
+
+// Writes size bytes to an open file at the file position
+inline cppcoro::task<int> writeAll(int fd, const char* data, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    unsigned length = static_cast<unsigned>(std::min<size_t>(size - done, 1u << 30));
+    int n = co_await IoRing::write(fd, data + done, length, static_cast<uint64_t>(-1));
+    if (n < 0) co_return n;
+    done += static_cast<size_t>(n);
+  }
+  co_return 0;
+}
+
+// Opens path, reads all of it and closes it; -errno if any step fails
+inline cppcoro::task<int> readFile(const std::string& path, std::string& bytes) {
+  int fd = co_await IoRing::openat(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) co_return fd;
+  struct ::statx info;
+  int result = co_await IoRing::statx(fd, "", AT_EMPTY_PATH, &info);
+  if (result == 0) {
+    result = co_await readAll(fd, bytes, static_cast<int64_t>(info.stx_size));
+  }
+  co_await IoRing::close(fd);
+  co_return result;
+}
+
+// Opens path for writing with flags, writes the data and closes it
+inline cppcoro::task<int> writeFile(const std::string& path, const char* data, size_t size, int flags,
+                                    const std::optional<int>& mode) {
+  int fd = co_await IoRing::openat(path.c_str(), O_WRONLY | O_CREAT | flags, 0666);
+  if (fd < 0) co_return fd;
+  int result = 0;
+  if (mode.has_value() && ::fchmod(fd, static_cast<mode_t>(mode.value())) < 0) {
+    result = -errno;
+  }
+  if (result == 0) {
+    result = co_await writeAll(fd, data, size);
+  }
+  co_await IoRing::close(fd);
+  co_return result;
+}
+
+inline FileInfo toFileInfo(const gs::String& path, const struct ::statx& info) {
+  FileInfo result;
+  result.path = path;
+  if (S_ISREG(info.stx_mode)) {
+    result.type = FileType::File;
+  } else if (S_ISDIR(info.stx_mode)) {
+    result.type = FileType::Directory;
+  } else if (S_ISLNK(info.stx_mode)) {
+    result.type = FileType::Symlink;
+  } else {
+    result.type = FileType::Unknown;
+  }
+  result.size = result.type == FileType::File ? static_cast<int64_t>(info.stx_size) : 0;
+  result.modified = static_cast<double>(info.stx_mtime.tv_sec) * 1000.0 + info.stx_mtime.tv_nsec / 1000000;
+  return result;
+}
+
+} // namespace detail
+#endif // __linux__
+
 /**
  * FileSystemAsync - Asynchronous filesystem operations
  * 
  * Provides async/await compatible filesystem operations using cppcoro.
- * All operations run synchronously but return cppcoro::task for compatibility.
  * 
- * Note: True async I/O would require platform-specific APIs (io_uring, IOCP, etc.)
- * For now, we provide task-based wrappers around synchronous operations.
+ * On Linux, reading, writing and stat go through io_uring (detail::IoRing)
+ * and only suspend the calling coroutine: the event loop runs other work,
+ * and operations started together are submitted together. The other
+ * operations, and every operation where io_uring is unavailable, run the
+ * blocking FileSystem calls.
+ * 
+ * Paths and contents are taken by value: the task may run after the
+ * caller's temporaries are gone. In GC mode the coroutine frame holding
+ * them is a root, and the buffers handed to io_uring are malloc'd copies,
+ * never GC blocks.
  */
 class FileSystemAsync {
 public:
-  static cppcoro::task<bool> exists(const gs::String& path) {
+  static cppcoro::task<bool> exists(gs::String path) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string p = GS_STRING_TO_STD(path);
+      struct ::statx info;
+      co_return co_await detail::IoRing::statx(AT_FDCWD, p.c_str(), 0, &info) == 0;
+    }
+    #endif
     co_return FileSystem::exists(path);
   }
 
-  static cppcoro::task<gs::String> readText(const gs::String& path, 
-                                            const std::optional<gs::String>& encoding = std::nullopt) {
+  static cppcoro::task<gs::String> readText(gs::String path,
+                                            std::optional<gs::String> encoding = std::nullopt) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string bytes;
+      if (co_await detail::readFile(GS_STRING_TO_STD(path), bytes) < 0) {
+        throw gs::Error("Failed to open file: " + path);
+      }
+      std::string enc = encoding.has_value() ? GS_STRING_TO_STD(*encoding) : "utf-8";
+      co_return gs::String(detail::decodeBytes(bytes, enc));
+    }
+    #endif
     co_return FileSystem::readText(path, encoding);
   }
 
-  static cppcoro::task<void> writeText(const gs::String& path, const gs::String& content,
-                                       const std::optional<gs::String>& encoding = std::nullopt,
-                                       const std::optional<int>& mode = std::nullopt) {
+  static cppcoro::task<void> writeText(gs::String path, gs::String content,
+                                       std::optional<gs::String> encoding = std::nullopt,
+                                       std::optional<int> mode = std::nullopt) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string enc = encoding.has_value() ? GS_STRING_TO_STD(*encoding) : "utf-8";
+      std::string bytes = detail::encodeString(GS_STRING_TO_STD(content), enc);
+      if (co_await detail::writeFile(GS_STRING_TO_STD(path), bytes.data(), bytes.size(), O_TRUNC, mode) < 0) {
+        throw gs::Error("Failed to open file for writing: " + path);
+      }
+      co_return;
+    }
+    #endif
     FileSystem::writeText(path, content, encoding, mode);
-    co_return;
   }
 
-  static cppcoro::task<void> appendText(const gs::String& path, const gs::String& content,
-                                        const std::optional<gs::String>& encoding = std::nullopt,
-                                        const std::optional<int>& mode = std::nullopt) {
+  static cppcoro::task<void> appendText(gs::String path, gs::String content,
+                                        std::optional<gs::String> encoding = std::nullopt,
+                                        std::optional<int> mode = std::nullopt) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string enc = encoding.has_value() ? GS_STRING_TO_STD(*encoding) : "utf-8";
+      std::string bytes = detail::encodeString(GS_STRING_TO_STD(content), enc);
+      if (co_await detail::writeFile(GS_STRING_TO_STD(path), bytes.data(), bytes.size(), O_APPEND, std::nullopt) < 0) {
+        throw gs::Error("Failed to open file for appending: " + path);
+      }
+      co_return;
+    }
+    #endif
     FileSystem::appendText(path, content, encoding, mode);
-    co_return;
   }
 
-  static cppcoro::task<gs::Array<uint8_t>> readBytes(const gs::String& path) {
+  static cppcoro::task<gs::Uint8Array> readBytes(gs::String path) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string bytes;
+      if (co_await detail::readFile(GS_STRING_TO_STD(path), bytes) < 0) {
+        throw gs::Error("Failed to open file: " + path);
+      }
+      // Ownership mode keeps the string's buffer; GC mode copies it once
+      co_return gs::Uint8Array(gs::ArrayBuffer::adopt(std::move(bytes)));
+    }
+    #endif
     co_return FileSystem::readBytes(path);
   }
 
-  static cppcoro::task<void> writeBytes(const gs::String& path, const gs::Array<uint8_t>& data,
-                                        const std::optional<int>& mode = std::nullopt) {
+  static cppcoro::task<void> writeBytes(gs::String path, gs::Uint8Array data,
+                                        std::optional<int> mode = std::nullopt) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      #if defined(GS_GC_AMC)
+      // AMC may move the buffer's block while the kernel reads it
+      std::string copy(reinterpret_cast<const char*>(data.data()), data.size());
+      const char* bytes = copy.data();
+      #else
+      const char* bytes = reinterpret_cast<const char*>(data.data());
+      #endif
+      if (co_await detail::writeFile(GS_STRING_TO_STD(path), bytes, data.size(), O_TRUNC, mode) < 0) {
+        throw gs::Error("Failed to open file for writing: " + path);
+      }
+      co_return;
+    }
+    #endif
     FileSystem::writeBytes(path, data, mode);
-    co_return;
+  }
+
+  static cppcoro::task<void> writeBytes(gs::String path, const gs::Array<uint8_t>& data,
+                                        std::optional<int> mode = std::nullopt) {
+    return writeBytes(std::move(path), gs::Uint8Array(data), mode);
   }
 
   static cppcoro::task<void> remove(const gs::String& path) {
@@ -775,15 +1272,43 @@ public:
     co_return FileSystem::readDir(path, recursive);
   }
 
-  static cppcoro::task<FileInfo> stat(const gs::String& path) {
+  static cppcoro::task<FileInfo> stat(gs::String path) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string p = GS_STRING_TO_STD(path);
+      struct ::statx info;
+      int result = co_await detail::IoRing::statx(AT_FDCWD, p.c_str(), 0, &info);
+      if (result == -ENOENT || result == -ENOTDIR) {
+        throw gs::Error("File not found: " + path);
+      }
+      if (result < 0) {
+        throw gs::Error("Failed to get file status: " + path + " (" + gs::String(std::generic_category().message(-result)) + ")");
+      }
+      co_return detail::toFileInfo(path, info);
+    }
+    #endif
     co_return FileSystem::stat(path);
   }
 
-  static cppcoro::task<bool> isFile(const gs::String& path) {
+  static cppcoro::task<bool> isFile(gs::String path) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string p = GS_STRING_TO_STD(path);
+      struct ::statx info;
+      co_return co_await detail::IoRing::statx(AT_FDCWD, p.c_str(), 0, &info) == 0 && S_ISREG(info.stx_mode);
+    }
+    #endif
     co_return FileSystem::isFile(path);
   }
 
-  static cppcoro::task<bool> isDirectory(const gs::String& path) {
+  static cppcoro::task<bool> isDirectory(gs::String path) {
+    #if defined(__linux__)
+    if (detail::IoRing::instance()) {
+      std::string p = GS_STRING_TO_STD(path);
+      struct ::statx info;
+      co_return co_await detail::IoRing::statx(AT_FDCWD, p.c_str(), 0, &info) == 0 && S_ISDIR(info.stx_mode);
+    }
+    #endif
     co_return FileSystem::isDirectory(path);
   }
 
@@ -57,6 +57,7 @@ struct HttpResponse {
   gs::String statusText;
   gs::Map<gs::String, gs::String> headers;
   gs::String body;
+  gs::Uint8Array bytes;  // Body of syncFetchBytes/fetchBytes (body stays empty)
   
   HttpResponse() : status(0) {}
 };
@@ -111,10 +112,12 @@ static size_t header_callback(char* buffer, size_t size, size_t nitems, void* us
 
 /**
  * Internal helper to perform HTTP request
+ * With binary set, the body is returned as bytes, adopting curl's buffer
  */
 static HttpResponse perform_http_request(
   const std::string& url,
-  const HttpOptions& options
+  const HttpOptions& options,
+  bool binary = false
 ) {
   // Initialize curl
   CURL* curl = curl_easy_init();
@@ -213,7 +216,11 @@ static HttpResponse perform_http_request(
   // Build response object
   HttpResponse response;
   response.status = static_cast<int>(http_code);
-  response.body = GS_STRING_FROM_STD(response_body);
+  if (binary) {
+    response.bytes = gs::Uint8Array(gs::ArrayBuffer::adopt(std::move(response_body)));
+  } else {
+    response.body = GS_STRING_FROM_STD(response_body);
+  }
   
   // Convert status code to status text
   std::string status_text;
@@ -278,6 +285,18 @@ public:
     return perform_http_request(url_str, options);
   }
   
+  /**
+   * Perform synchronous HTTP GET request for binary content
+   * 
+   * @param url - The URL to fetch
+   * @returns HttpResponse with status, headers, and the body in bytes
+   * @throws gs::Error on network errors or timeouts
+   */
+  static HttpResponse syncFetchBytes(const gs::String& url) {
+    HttpOptions options;
+    return perform_http_request(GS_STRING_TO_STD(url), options, true);
+  }
+  
   /**
    * Initialize curl library (called automatically, but can be called manually)
    */
@@ -330,6 +349,16 @@ public:
     std::string url_str = GS_STRING_TO_STD(url);
     co_return perform_http_request(url_str, options);
   }
+  
+  /**
+   * Perform asynchronous HTTP GET request for binary content
+   * 
+   * @param url - The URL to fetch
+   * @returns cppcoro::task<HttpResponse> with the body in bytes
+   */
+  static cppcoro::task<HttpResponse> fetchBytes(const gs::String& url) {
+    co_return HTTP::syncFetchBytes(url);
+  }
 };
 #endif
 
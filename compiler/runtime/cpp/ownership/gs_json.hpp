@@ -1,26 +1,185 @@
 #pragma once
 
-#include <sstream>
-#include <iomanip>
 #include <string>
 #include <vector>
 #include <memory>
-// String/Array defined by mode-specific runtime
+#include <optional>
 // String/Array defined by mode-specific runtime
 #include "gs_property.hpp"
+#include "gs_literal_object.hpp"
+#include "gs_error.hpp"
+#include "gs_string_builder.hpp"
+#include "../gs_json_parser.hpp"
+#include "../gs_json_writer.hpp"
 
 namespace gs {
 
-// Forward declaration for LiteralObject
-template<typename K, typename V> class Map;
-using LiteralObject = Map<gs::String, Property>;
+// Typed JSON decoding for ownership runtime types (see gs_json_parser.hpp)
+// Overloads live in gs::json so argument-dependent lookup through Reader
+// finds them for every target type
+namespace json {
+
+inline void gs_json_decode(Reader& in, String& out) {
+  out = String(in.read_string());
+}
+
+template<typename T>
+void gs_json_decode(Reader& in, Array<T>& out) {
+  out = Array<T>();
+  in.read_array([&] {
+    T element{};
+    gs_json_decode(in, element);
+    out.push(std::move(element));
+  });
+}
+
+// Owned and shared references to generated interfaces
+template<typename T>
+void gs_json_decode(Reader& in, std::unique_ptr<T>& out) {
+  if (in.try_null()) {
+    out.reset();
+    return;
+  }
+  out = std::make_unique<T>();
+  gs_json_decode(in, *out);
+}
+
+template<typename T>
+void gs_json_decode(Reader& in, std::shared_ptr<T>& out) {
+  if (in.try_null()) {
+    out.reset();
+    return;
+  }
+  out = std::make_shared<T>();
+  gs_json_decode(in, *out);
+}
+
+} // namespace json
+
+// JSON encoding for ownership runtime types (see gs_json_writer.hpp)
+// gs_json_encode(out, value) appends the JSON for value to out. Overloads
+// live in gs so argument-dependent lookup through StringBuilder finds them;
+// codegen adds one per generated type that reaches JSON.stringify.
+inline void gs_json_encode(StringBuilder& out, double value) {
+  json::write_number(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, int32_t value) {
+  json::write_integer(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, int64_t value) {
+  json::write_integer(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, bool value) {
+  json::write_bool(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, const String& value) {
+  json::write_string(out, value.str());
+}
+
+inline void gs_json_encode(StringBuilder& out, const char* value) {
+  json::write_string(out, value);
+}
+
+inline void gs_json_encode(StringBuilder& out, std::nullptr_t) {
+  out.append("null", 4);
+}
+
+template<typename T>
+void gs_json_encode(StringBuilder& out, const Array<T>& arr) {
+  out.append('[');
+  bool first = true;
+  for (const auto& element : arr) {
+    if (!first) out.append(',');
+    first = false;
+    gs_json_encode(out, element);
+  }
+  out.append(']');
+}
+
+template<typename T>
+void gs_json_encode(StringBuilder& out, const std::optional<T>& value) {
+  if (value) {
+    gs_json_encode(out, *value);
+  } else {
+    out.append("null", 4);
+  }
+}
+
+// Owned and shared references to generated types
+template<typename T>
+void gs_json_encode(StringBuilder& out, const std::unique_ptr<T>& value) {
+  if (value) {
+    gs_json_encode(out, *value);
+  } else {
+    out.append("null", 4);
+  }
+}
+
+template<typename T>
+void gs_json_encode(StringBuilder& out, const std::shared_ptr<T>& value) {
+  if (value) {
+    gs_json_encode(out, *value);
+  } else {
+    out.append("null", 4);
+  }
+}
+
+inline void gs_json_encode(StringBuilder& out, const LiteralObject& obj);
+
+// Objects are LiteralObject or Array<Property> (what JSON::parse builds);
+// other boxed values have no JSON form and print as {}
+inline void gs_json_encode(StringBuilder& out, const Property& prop) {
+  switch (prop.type()) {
+    case Property::Type::Undefined:
+    case Property::Type::Null:
+      out.append("null", 4);
+      break;
+    case Property::Type::Bool:
+      json::write_bool(out, prop.asBool());
+      break;
+    case Property::Type::Number:
+      json::write_number(out, prop.asNumber());
+      break;
+    case Property::Type::String:
+      json::write_string(out, prop.stringView());
+      break;
+    case Property::Type::Object:
+      if (prop.isObjectOf<LiteralObject>()) {
+        gs_json_encode(out, prop.asObject<LiteralObject>());
+      } else if (prop.isObjectOf<Array<Property>>()) {
+        gs_json_encode(out, prop.asObject<Array<Property>>());
+      } else {
+        out.append("{}", 2);
+      }
+      break;
+  }
+}
+
+// Undefined properties are left out, as in JavaScript
+inline void gs_json_encode(StringBuilder& out, const LiteralObject& obj) {
+  out.append('{');
+  bool first = true;
+  for (const auto& [key, value] : obj) {
+    if (value.isUndefined()) continue;
+    if (!first) out.append(',');
+    first = false;
+    json::write_string(out, key.str());
+    out.append(':');
+    gs_json_encode(out, value);
+  }
+  out.append('}');
+}
 
 /**
  * GoodScript JSON class - TypeScript-compatible JSON utilities
  * 
  * Provides JSON.parse() and JSON.stringify() functionality.
- * Note: Full JSON support requires a JSON library (e.g., nlohmann/json).
- * This is a minimal implementation for basic types.
+ * stringify() appends everything into one StringBuilder through the
+ * gs_json_encode() overloads; scalars are formatted on the stack.
  */
 class JSON {
 public:
@@ -29,23 +188,13 @@ public:
    * Equivalent to TypeScript: JSON.stringify(value)
    */
   
-  // Stringify for numbers
+  // Stringify for numbers (shortest round-trip form, like JavaScript)
   static String stringify(double value) {
-    std::ostringstream oss;
-    // Check if it's an integer
-    if (value == static_cast<int>(value)) {
-      oss << static_cast<int>(value);
-    } else {
-      oss << std::fixed << std::setprecision(6) << value;
-      // Remove trailing zeros
-      std::string str = oss.str();
-      str.erase(str.find_last_not_of('0') + 1, std::string::npos);
-      if (str.back() == '.') {
-        str.push_back('0');
-      }
-      return String(str);
+    if (!std::isfinite(value)) {
+      return String("null");
     }
-    return String(oss.str());
+    char buf[json::NUMBER_BUFFER_SIZE];
+    return String(std::string(buf, json::format_number(value, buf)));
   }
   
   // Stringify for integers
@@ -58,111 +207,14 @@ public:
     return String(value ? "true" : "false");
   }
   
-  // Stringify for strings (adds quotes and escapes)
-  static String stringify(const String& value) {
-    std::ostringstream oss;
-    oss << '"';
-    
-    for (int i = 0; i < value.length(); ++i) {
-      char c = value[i];
-      switch (c) {
-        case '"':  oss << "\\\""; break;
-        case '\\': oss << "\\\\"; break;
-        case '\b': oss << "\\b"; break;
-        case '\f': oss << "\\f"; break;
-        case '\n': oss << "\\n"; break;
-        case '\r': oss << "\\r"; break;
-        case '\t': oss << "\\t"; break;
-        default:
-          if (c < 32) {
-            // Control character - use unicode escape
-            oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
-          } else {
-            oss << c;
-          }
-          break;
-      }
-    }
-    
-    oss << '"';
-    return String(oss.str());
-  }
-  
-  // Stringify for const char*
-  static String stringify(const char* value) {
-    return stringify(String(value));
-  }
-  
-  // Stringify for number arrays
-  static String stringify(const Array<double>& arr) {
-    std::ostringstream oss;
-    oss << '[';
-    
-    for (int i = 0; i < arr.length(); ++i) {
-      if (i > 0) oss << ',';
-      auto ptr = arr[i];
-      if (ptr) {
-        oss << stringify(*ptr).str();
-      } else {
-        oss << "null";
-      }
-    }
-    
-    oss << ']';
-    return String(oss.str());
-  }
-  
-  // Stringify for integer arrays
-  static String stringify(const Array<int>& arr) {
-    std::ostringstream oss;
-    oss << '[';
-    
-    for (int i = 0; i < arr.length(); ++i) {
-      if (i > 0) oss << ',';
-      auto ptr = arr[i];
-      if (ptr) {
-        oss << *ptr;
-      } else {
-        oss << "null";
-      }
-    }
-    
-    oss << ']';
-    return String(oss.str());
-  }
-  
-  // Stringify for string arrays
-  static String stringify(const Array<String>& arr) {
-    std::ostringstream oss;
-    oss << '[';
-    
-    for (int i = 0; i < arr.length(); ++i) {
-      if (i > 0) oss << ',';
-      auto ptr = arr[i];
-      if (ptr) {
-        oss << stringify(*ptr).str();
-      } else {
-        oss << "null";
-      }
-    }
-    
-    oss << ']';
-    return String(oss.str());
-  }
-  
-  // Stringify for boolean arrays
-  static String stringify(const Array<bool>& arr) {
-    std::ostringstream oss;
-    oss << '[';
-    
-    for (int i = 0; i < arr.length(); ++i) {
-      if (i > 0) oss << ',';
-      bool value = arr[i];
-      oss << (value ? "true" : "false");
+  // Stringify for Property (type-erased value); undefined stays "undefined"
+  static String stringify(const Property& prop) {
+    if (prop.isUndefined()) {
+      return String("undefined");
     }
-    
-    oss << ']';
-    return String(oss.str());
+    StringBuilder out;
+    gs_json_encode(out, prop);
+    return out.toString();
   }
   
   // Stringify for std::vector (for interop)
@@ -182,63 +234,78 @@ public:
     return stringify(arr);
   }
   
-  // Stringify for Property (type-erased value)
-  static String stringify(const Property& prop) {
-    switch (prop.type()) {
-      case Property::Type::Undefined:
-        return String("undefined");
-      case Property::Type::Null:
-        return String("null");
-      case Property::Type::Bool:
-        return stringify(prop.asBool());
-      case Property::Type::Number:
-        return stringify(prop.asNumber());
-      case Property::Type::String:
-        return stringify(prop.asString());
-      case Property::Type::Object:
-        // For objects, use a generic representation
-        // In a full implementation, would recursively stringify
-        return String("{}");
-    }
-    return String("null");
-  }
-  
-  // Stringify for LiteralObject (object literals)
-  static String stringify(const LiteralObject& obj) {
-    std::ostringstream oss;
-    oss << '{';
-    
-    bool first = true;
-    // Note: This requires Object::keys() which returns the keys
-    // We'll iterate manually through the map
-    for (auto it = obj.begin(); it != obj.end(); ++it) {
-      if (!first) oss << ',';
-      first = false;
-      
-      // Property name (quoted)
-      oss << '"' << it->first.str() << '"';
-      oss << ':';
-      
-      // Property value
-      oss << stringify(it->second).str();
-    }
-    
-    oss << '}';
-    return String(oss.str());
+  // Stringify for strings, arrays, objects, optionals and generated types
+  template<typename T>
+  static String stringify(const T& value) {
+    StringBuilder out;
+    gs_json_encode(out, value);
+    return out.toString();
   }
   
   /**
-   * Parses a JSON string
+   * Parses a JSON string into a Property tree
    * Equivalent to TypeScript: JSON.parse(text)
    * 
-   * Note: This is a very basic implementation. For production use,
-   * integrate a proper JSON library like nlohmann/json or simdjson.
+   * Objects become LiteralObject, arrays Array<Property>; members that share
+   * a key order share one Shape. Throws SyntaxError on malformed input.
    */
-  static String parse(const String& text) {
-    // TODO: Implement full JSON parsing
-    // For now, just return the input (placeholder)
-    // In production, use nlohmann::json or similar
-    return text;
+  static Property parse(const String& text) {
+    try {
+      json::Reader in(text.str().data(), text.str().size());
+      Property result = parse_value(in);
+      in.finish();
+      return result;
+    } catch (const json::ParseError& e) {
+      throw SyntaxError(e.what());
+    }
+  }
+
+  /**
+   * Parses a JSON string directly into T (number, boolean, string, Array,
+   * std::optional or a generated interface), with no intermediate tree.
+   * Equivalent to TypeScript: const value: T = JSON.parse(text)
+   * Throws SyntaxError on malformed input or a value of the wrong type.
+   */
+  template<typename T>
+  static T parse(const String& text) {
+    try {
+      json::Reader in(text.str().data(), text.str().size());
+      T result{};
+      gs_json_decode(in, result);
+      in.finish();
+      return result;
+    } catch (const json::ParseError& e) {
+      throw SyntaxError(e.what());
+    }
+  }
+
+private:
+  static Property parse_value(json::Reader& in) {
+    switch (in.peek()) {
+      case '{': {
+        LiteralObject obj;
+        in.read_object([&](std::string_view key) {
+          String name(key);  // The key view does not survive reading the value
+          obj.set(name, parse_value(in));
+        });
+        return Property(std::move(obj));
+      }
+      case '[': {
+        Array<Property> arr;
+        in.read_array([&] { arr.push(parse_value(in)); });
+        return Property(std::move(arr));
+      }
+      case '"':
+        return Property(String(in.read_string()));
+      case 't':
+      case 'f':
+        return Property(in.read_bool());
+      case 'n':
+        in.read_null();
+        return Property::Null();
+      default:
+        return Property(in.read_number());
+    }
   }
 };
 
@@ -0,0 +1,396 @@
+/**
+ * GoodScript Literal Object Runtime
+ *
+ * Shape-based ("hidden class") representation for object literals that
+ * codegen cannot turn into a struct.
+ */
+
+#pragma once
+
+#include "gs_string.hpp"
+#include "gs_array.hpp"
+#include "gs_property.hpp"
+#include "../gs_ordered_table.hpp"
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gs {
+
+/**
+ * Shape - shared key -> slot layout of a LiteralObject
+ *
+ * Objects built by adding the same keys in the same order share one Shape,
+ * so each object stores only its values (a compact slot vector) and a
+ * property lookup is a key -> slot resolution on the shape plus an indexed
+ * load. With a PropertyCache at the access site even that resolution is
+ * skipped while the shape stays the same.
+ *
+ * Shapes form a transition tree rooted at Shape::empty(): adding key k to
+ * an object of shape S moves it to the cached child S + k. Shapes in the
+ * tree are immutable and live as long as the tree.
+ *
+ * Objects that grow past MAX_SHARED_PROPERTIES (dictionary-like usage)
+ * switch to a private, uncached shape instead, so unbounded key sets do
+ * not grow the tree; a private shape owned by a single object is extended
+ * in place.
+ *
+ * Like the rest of the ownership runtime this assumes single-threaded use.
+ */
+class Shape {
+public:
+  static constexpr size_t MAX_SHARED_PROPERTIES = 64;
+  static constexpr size_t LINEAR_LOOKUP_MAX = 8;
+  static constexpr int64_t NOT_FOUND = -1;
+
+  Shape() = default;
+  Shape(const Shape&) = delete;
+  Shape& operator=(const Shape&) = delete;
+
+  /** The root shape (no properties) */
+  static const std::shared_ptr<Shape>& empty() {
+    static const std::shared_ptr<Shape> root = std::make_shared<Shape>();
+    return root;
+  }
+
+  size_t size() const { return keys_.size(); }
+  const String& key(size_t slot) const { return keys_[slot]; }
+
+  /** Is this shape part of the shared transition tree? */
+  bool is_shared() const { return shared_; }
+
+  /** Slot holding key, or NOT_FOUND */
+  int64_t find(const String& key) const {
+    if (keys_.size() <= LINEAR_LOOKUP_MAX) {
+      for (size_t i = 0; i < keys_.size(); ++i) {
+        if (keys_[i] == key) return static_cast<int64_t>(i);
+      }
+      return NOT_FOUND;
+    }
+    const auto* entry = slots_.find(key);
+    return entry ? static_cast<int64_t>(entry->second) : NOT_FOUND;
+  }
+
+  /**
+   * Shape with key appended as the last slot.
+   * self must own this shape; for a private shape held only by the caller
+   * the shape is extended in place and self is returned.
+   */
+  static std::shared_ptr<Shape> with(const std::shared_ptr<Shape>& self, const String& key) {
+    if (self->shared_) {
+      if (self->keys_.size() >= MAX_SHARED_PROPERTIES) {
+        auto shape = copy_private(*self);
+        shape->append(key);
+        return shape;
+      }
+      auto it = self->transitions_.find(key);
+      if (it != self->transitions_.end()) {
+        return it->second;
+      }
+      auto child = std::make_shared<Shape>();
+      child->keys_.reserve(self->keys_.size() + 1);
+      for (const auto& k : self->keys_) child->append(k);
+      child->append(key);
+      self->transitions_.emplace(key, child);
+      return child;
+    }
+    if (self.use_count() == 1) {
+      self->append(key);
+      return self;
+    }
+    auto shape = copy_private(*self);
+    shape->append(key);
+    return shape;
+  }
+
+  /**
+   * Shape with the given slot removed (later slots shift down by one).
+   * Stays in the shared tree when the remaining keys fit in it.
+   */
+  static std::shared_ptr<Shape> without(const std::shared_ptr<Shape>& self, size_t slot) {
+    if (self->shared_ || self->keys_.size() - 1 <= MAX_SHARED_PROPERTIES) {
+      std::shared_ptr<Shape> shape = empty();
+      for (size_t i = 0; i < self->keys_.size(); ++i) {
+        if (i != slot) shape = with(shape, self->keys_[i]);
+      }
+      return shape;
+    }
+    auto shape = self.use_count() == 1 ? self : copy_private(*self);
+    shape->keys_.erase(shape->keys_.begin() + static_cast<std::ptrdiff_t>(slot));
+    shape->rebuild_slots();
+    return shape;
+  }
+
+private:
+  std::vector<String> keys_;  // Keys in slot order
+  OrderedHashTable<String, std::pair<String, uint32_t>, PairKey> slots_;  // key -> slot (large shapes)
+  std::unordered_map<String, std::shared_ptr<Shape>> transitions_;        // key -> child shape
+  bool shared_ = true;
+
+  void append(const String& key) {
+    keys_.push_back(key);
+    if (keys_.size() == LINEAR_LOOKUP_MAX + 1) {
+      rebuild_slots();
+    } else if (keys_.size() > LINEAR_LOOKUP_MAX) {
+      slots_.append(std::pair<String, uint32_t>(key, static_cast<uint32_t>(keys_.size() - 1)),
+                    decltype(slots_)::hash_of(key));
+    }
+  }
+
+  void rebuild_slots() {
+    slots_.clear();
+    if (keys_.size() <= LINEAR_LOOKUP_MAX) return;
+    slots_.reserve(keys_.size());
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      slots_.append(std::pair<String, uint32_t>(keys_[i], static_cast<uint32_t>(i)),
+                    decltype(slots_)::hash_of(keys_[i]));
+    }
+  }
+
+  static std::shared_ptr<Shape> copy_private(const Shape& from) {
+    auto shape = std::make_shared<Shape>();
+    shape->shared_ = false;
+    shape->keys_ = from.keys_;
+    shape->rebuild_slots();
+    return shape;
+  }
+};
+
+/**
+ * PropertyCache - inline cache for one property access site
+ *
+ * Remembers the slot a key resolved to for the last shape seen, so repeated
+ * accesses on same-shaped objects skip the key lookup entirely:
+ *
+ *   static gs::PropertyCache cache;
+ *   Property* name = obj.get(key, cache);
+ */
+struct PropertyCache {
+  const Shape* shape = nullptr;
+  uint32_t slot = 0;
+};
+
+/**
+ * LiteralObject - Type for object literals with heterogeneous property values
+ *
+ * Property names live in a shared Shape; the object itself holds only the
+ * shape and a vector of Property values in slot (insertion) order.
+ * Allows object literals like { a: 1, b: "hello", c: true }
+ *
+ * Example:
+ *   LiteralObject obj = {
+ *     {"name", Property("Alice")},
+ *     {"age", Property(30)},
+ *     {"active", Property(true)}
+ *   };
+ *
+ *   auto name = obj.get("name")->asString();  // "Alice"
+ *   auto age = obj.get("age")->asNumber();    // 30.0
+ */
+class LiteralObject {
+private:
+  std::shared_ptr<Shape> shape_ = Shape::empty();
+  std::vector<Property> slots_;
+
+  Property* lookup(const String& key) {
+    int64_t slot = shape_->find(key);
+    return slot == Shape::NOT_FOUND ? nullptr : &slots_[static_cast<size_t>(slot)];
+  }
+
+public:
+  // Iteration yields (key, value) pairs in insertion order
+  template<bool Const>
+  class basic_iterator {
+  private:
+    using Owner = std::conditional_t<Const, const LiteralObject, LiteralObject>;
+    Owner* obj_;
+    size_t slot_;
+
+  public:
+    struct reference {
+      const String& first;
+      std::conditional_t<Const, const Property&, Property&> second;
+
+      operator std::pair<String, Property>() const { return {first, second}; }
+    };
+
+    struct arrow {
+      reference ref;
+      const reference* operator->() const { return &ref; }
+    };
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<String, Property>;
+    using difference_type = std::ptrdiff_t;
+
+    basic_iterator(Owner* obj, size_t slot) : obj_(obj), slot_(slot) {}
+
+    reference operator*() const { return {obj_->shape_->key(slot_), obj_->slots_[slot_]}; }
+    arrow operator->() const { return arrow{**this}; }
+
+    basic_iterator& operator++() {
+      ++slot_;
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++slot_;
+      return tmp;
+    }
+
+    bool operator==(const basic_iterator& other) const { return slot_ == other.slot_; }
+    bool operator!=(const basic_iterator& other) const { return slot_ != other.slot_; }
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using key_type = String;
+  using mapped_type = Property;
+
+  LiteralObject() = default;
+  LiteralObject(std::initializer_list<std::pair<String, Property>> init) {
+    slots_.reserve(init.size());
+    for (const auto& [key, value] : init) {
+      set(key, value);
+    }
+  }
+
+  /**
+   * Number of properties
+   * Equivalent to TypeScript: Object.keys(obj).length
+   */
+  int size() const {
+    return static_cast<int>(slots_.size());
+  }
+
+  const Shape& shape() const { return *shape_; }
+
+  /**
+   * Sets a property, appending it (and transitioning the shape) when new
+   * Returns the object itself for chaining
+   */
+  LiteralObject& set(const String& key, Property value) {
+    if (Property* slot = lookup(key)) {
+      *slot = std::move(value);
+    } else {
+      shape_ = Shape::with(shape_, key);
+      slots_.push_back(std::move(value));
+    }
+    return *this;
+  }
+
+  /** Returns the property, or nullptr if the object has no such key */
+  Property* get(const String& key) {
+    return lookup(key);
+  }
+
+  const Property* get(const String& key) const {
+    return const_cast<LiteralObject*>(this)->lookup(key);
+  }
+
+  /** Cached lookup: an indexed load while the site keeps seeing one shape */
+  Property* get(const String& key, PropertyCache& cache) {
+    if (cache.shape == shape_.get()) {
+      return &slots_[cache.slot];
+    }
+    int64_t slot = shape_->find(key);
+    if (slot == Shape::NOT_FOUND) return nullptr;
+    if (shape_->is_shared()) {
+      // Private shapes can change in place, so only shared ones are cached
+      cache.shape = shape_.get();
+      cache.slot = static_cast<uint32_t>(slot);
+    }
+    return &slots_[static_cast<size_t>(slot)];
+  }
+
+  Property* operator[](const String& key) {
+    return lookup(key);
+  }
+
+  const Property* operator[](const String& key) const {
+    return get(key);
+  }
+
+  bool has(const String& key) const {
+    return shape_->find(key) != Shape::NOT_FOUND;
+  }
+
+  /**
+   * Removes a property
+   * Equivalent to TypeScript: delete obj[key]
+   * Returns true if the property existed
+   */
+  bool delete_(const String& key) {
+    int64_t slot = shape_->find(key);
+    if (slot == Shape::NOT_FOUND) return false;
+    shape_ = Shape::without(shape_, static_cast<size_t>(slot));
+    slots_.erase(slots_.begin() + static_cast<std::ptrdiff_t>(slot));
+    return true;
+  }
+
+  void clear() {
+    shape_ = Shape::empty();
+    slots_.clear();
+  }
+
+  /**
+   * Calls callback(value, key) for each property in insertion order
+   */
+  template<typename Fn>
+  void forEach(Fn&& callback) const {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      callback(slots_[i], shape_->key(i));
+    }
+  }
+
+  Array<String> keys() const {
+    Array<String> result;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      result.push(shape_->key(i));
+    }
+    return result;
+  }
+
+  Array<Property> values() const {
+    Array<Property> result;
+    for (const auto& value : slots_) {
+      result.push(value);
+    }
+    return result;
+  }
+
+  Array<std::pair<String, Property>> entries() const {
+    Array<std::pair<String, Property>> result;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      result.push(std::make_pair(shape_->key(i), slots_[i]));
+    }
+    return result;
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, slots_.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, slots_.size()); }
+
+  bool operator==(const LiteralObject& other) const {
+    if (slots_.size() != other.slots_.size()) return false;
+    // Same shape: compare slot by slot; otherwise by key (order-independent)
+    if (shape_ == other.shape_) {
+      return slots_ == other.slots_;
+    }
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      const Property* value = other.get(shape_->key(i));
+      if (!value || *value != slots_[i]) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const LiteralObject& other) const {
+    return !(*this == other);
+  }
+};
+
+}  // namespace gs
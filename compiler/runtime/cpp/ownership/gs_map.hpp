@@ -6,6 +6,7 @@
 #include <optional>
 #include <vector>
 #include "gs_array.hpp"
+#include "../gs_ordered_table.hpp"
 
 namespace gs {
 
@@ -13,119 +14,23 @@ namespace gs {
  * GoodScript Map class - TypeScript-compatible map wrapper
  * 
  * Preserves insertion order like JavaScript Map.
- * Uses a vector to track insertion order and an unordered_map for O(1) lookup.
+ * Backed by an OrderedHashTable: dense insertion-ordered entries plus an
+ * open-addressed index (see gs_ordered_table.hpp).
  * Designed for composition, not inheritance from std::unordered_map.
  */
 template<typename K, typename V>
 class Map {
 private:
-  std::vector<std::pair<K, V>> items_;  // Insertion-ordered storage
-  std::unordered_map<K, size_t> index_; // Key -> index in items_ for O(1) lookup
+  using Table = OrderedHashTable<K, std::pair<K, V>, PairKey>;
+  Table table_;
   
   // Allow Object class to access impl_ for keys/values/entries
   friend class Object;
 
 public:
-  // Custom iterator that skips tombstones
-  class iterator {
-  private:
-    typename std::vector<std::pair<K, V>>::iterator current_;
-    typename std::vector<std::pair<K, V>>::iterator end_;
-    const std::unordered_map<K, size_t>* index_;
-    
-    void skip_tombstones() {
-      while (current_ != end_ && index_->find(current_->first) == index_->end()) {
-        ++current_;
-      }
-    }
-    
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = std::pair<K, V>;
-    using difference_type = std::ptrdiff_t;
-    using pointer = std::pair<K, V>*;
-    using reference = std::pair<K, V>&;
-    
-    iterator(typename std::vector<std::pair<K, V>>::iterator current,
-             typename std::vector<std::pair<K, V>>::iterator end,
-             const std::unordered_map<K, size_t>* index)
-      : current_(current), end_(end), index_(index) {
-      skip_tombstones();
-    }
-    
-    reference operator*() { return *current_; }
-    pointer operator->() { return &(*current_); }
-    
-    iterator& operator++() {
-      ++current_;
-      skip_tombstones();
-      return *this;
-    }
-    
-    iterator operator++(int) {
-      iterator tmp = *this;
-      ++(*this);
-      return tmp;
-    }
-    
-    bool operator==(const iterator& other) const {
-      return current_ == other.current_;
-    }
-    
-    bool operator!=(const iterator& other) const {
-      return current_ != other.current_;
-    }
-  };
-  
-  class const_iterator {
-  private:
-    typename std::vector<std::pair<K, V>>::const_iterator current_;
-    typename std::vector<std::pair<K, V>>::const_iterator end_;
-    const std::unordered_map<K, size_t>* index_;
-    
-    void skip_tombstones() {
-      while (current_ != end_ && index_->find(current_->first) == index_->end()) {
-        ++current_;
-      }
-    }
-    
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = std::pair<K, V>;
-    using difference_type = std::ptrdiff_t;
-    using pointer = const std::pair<K, V>*;
-    using reference = const std::pair<K, V>&;
-    
-    const_iterator(typename std::vector<std::pair<K, V>>::const_iterator current,
-                   typename std::vector<std::pair<K, V>>::const_iterator end,
-                   const std::unordered_map<K, size_t>* index)
-      : current_(current), end_(end), index_(index) {
-      skip_tombstones();
-    }
-    
-    reference operator*() const { return *current_; }
-    pointer operator->() const { return &(*current_); }
-    
-    const_iterator& operator++() {
-      ++current_;
-      skip_tombstones();
-      return *this;
-    }
-    
-    const_iterator operator++(int) {
-      const_iterator tmp = *this;
-      ++(*this);
-      return tmp;
-    }
-    
-    bool operator==(const const_iterator& other) const {
-      return current_ == other.current_;
-    }
-    
-    bool operator!=(const const_iterator& other) const {
-      return current_ != other.current_;
-    }
-  };
+  // Iterators yield std::pair<K, V>& in insertion order, skipping tombstones
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
 
   // Type aliases for STL compatibility
   using key_type = K;
@@ -159,8 +64,7 @@ public:
    * Helps avoid rehashing during bulk inserts
    */
   void reserve(int capacity) {
-    items_.reserve(static_cast<size_t>(capacity));
-    index_.reserve(static_cast<size_t>(capacity));
+    table_.reserve(static_cast<size_t>(capacity));
   }
   
   /**
@@ -168,7 +72,7 @@ public:
    * Equivalent to TypeScript: map.size
    */
   int size() const {
-    return static_cast<int>(index_.size());
+    return static_cast<int>(table_.size());
   }
   
   /**
@@ -178,49 +82,43 @@ public:
    * Preserves insertion order - updates don't change order
    */
   Map<K, V>& set(const K& key, const V& value) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
+    uint32_t hash = Table::hash_of(key);
+    if (auto* entry = table_.find(key, hash)) {
       // Key exists - update value in place
-      items_[it->second].second = value;
+      entry->second = value;
     } else {
-      // New key - append to items and record index
-      index_[key] = items_.size();
-      items_.emplace_back(key, value);
+      // New key - append in insertion order
+      table_.append(std::pair<K, V>(key, value), hash);
     }
     return *this;
   }
   
   Map<K, V>& set(const K& key, V&& value) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      items_[it->second].second = std::move(value);
+    uint32_t hash = Table::hash_of(key);
+    if (auto* entry = table_.find(key, hash)) {
+      entry->second = std::move(value);
     } else {
-      index_[key] = items_.size();
-      items_.emplace_back(key, std::move(value));
+      table_.append(std::pair<K, V>(key, std::move(value)), hash);
     }
     return *this;
   }
   
   Map<K, V>& set(K&& key, const V& value) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      items_[it->second].second = value;
+    uint32_t hash = Table::hash_of(key);
+    if (auto* entry = table_.find(key, hash)) {
+      entry->second = value;
     } else {
-      auto key_copy = key;
-      index_[std::move(key)] = items_.size();
-      items_.emplace_back(std::move(key_copy), value);
+      table_.append(std::pair<K, V>(std::move(key), value), hash);
     }
     return *this;
   }
   
   Map<K, V>& set(K&& key, V&& value) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      items_[it->second].second = std::move(value);
+    uint32_t hash = Table::hash_of(key);
+    if (auto* entry = table_.find(key, hash)) {
+      entry->second = std::move(value);
     } else {
-      auto key_copy = key;
-      index_[std::move(key)] = items_.size();
-      items_.emplace_back(std::move(key_copy), std::move(value));
+      table_.append(std::pair<K, V>(std::move(key), std::move(value)), hash);
     }
     return *this;
   }
@@ -231,11 +129,8 @@ public:
    * Returns pointer to allow null return (matches JS undefined semantics)
    */
   V* get(const K& key) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      return &items_[it->second].second;
-    }
-    return nullptr;
+    auto* entry = table_.find(key);
+    return entry ? &entry->second : nullptr;
   }
   
   /**
@@ -244,19 +139,13 @@ public:
    * Not part of JavaScript API - C++ optimization
    */
   V get_or_default(const K& key, const V& defaultValue) const {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      return items_[it->second].second;
-    }
-    return defaultValue;
+    const auto* entry = table_.find(key);
+    return entry ? entry->second : defaultValue;
   }
   
   const V* get(const K& key) const {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      return &items_[it->second].second;
-    }
-    return nullptr;
+    const auto* entry = table_.find(key);
+    return entry ? &entry->second : nullptr;
   }
   
   /**
@@ -265,19 +154,11 @@ public:
    * Matches Array operator[] semantics (returns pointer)
    */
   V* operator[](const K& key) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      return &items_[it->second].second;
-    }
-    return nullptr;
+    return get(key);
   }
   
   const V* operator[](const K& key) const {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      return &items_[it->second].second;
-    }
-    return nullptr;
+    return get(key);
   }
   
   /**
@@ -285,29 +166,17 @@ public:
    * Equivalent to TypeScript: map.has(key)
    */
   bool has(const K& key) const {
-    return index_.find(key) != index_.end();
+    return table_.find(key) != nullptr;
   }
   
   /**
    * Removes the specified element from the map
    * Equivalent to TypeScript: map.delete(key)
    * Returns true if the element was removed, false otherwise
-   * Maintains insertion order by using tombstone (null key)
+   * Maintains insertion order by leaving a tombstone in the entry array
    */
   bool delete_(const K& key) {
-    auto it = index_.find(key);
-    if (it != index_.end()) {
-      size_t idx = it->second;
-      index_.erase(it);
-      // Mark as deleted by clearing the pair (tombstone)
-      items_[idx] = {};
-      // Periodically compact if too many tombstones
-      if (index_.size() < items_.size() / 2 && items_.size() > 100) {
-        compact();
-      }
-      return true;
-    }
-    return false;
+    return table_.erase(key);
   }
   
   // Note: 'delete' is a C++ keyword, so we use 'delete_' instead
@@ -318,31 +187,7 @@ public:
    * Equivalent to TypeScript: map.clear()
    */
   void clear() {
-    items_.clear();
-    index_.clear();
-  }
-
-private:
-  /**
-   * Compact the items_ vector by removing tombstones
-   * and updating the index_ map
-   */
-  void compact() {
-    std::vector<std::pair<K, V>> new_items;
-    new_items.reserve(index_.size());
-    std::unordered_map<K, size_t> new_index;
-    new_index.reserve(index_.size());
-    
-    for (size_t i = 0; i < items_.size(); ++i) {
-      // Check if this slot is occupied (not a tombstone)
-      if (index_.find(items_[i].first) != index_.end()) {
-        new_index[items_[i].first] = new_items.size();
-        new_items.push_back(std::move(items_[i]));
-      }
-    }
-    
-    items_ = std::move(new_items);
-    index_ = std::move(new_index);
+    table_.clear();
   }
 
 public:
@@ -407,12 +252,12 @@ public:
   
   // STL-compatible iterators (in insertion order, automatically skip tombstones)
   
-  iterator begin() { return iterator(items_.begin(), items_.end(), &index_); }
-  iterator end() { return iterator(items_.end(), items_.end(), &index_); }
-  const_iterator begin() const { return const_iterator(items_.begin(), items_.end(), &index_); }
-  const_iterator end() const { return const_iterator(items_.end(), items_.end(), &index_); }
-  const_iterator cbegin() const { return const_iterator(items_.cbegin(), items_.cend(), &index_); }
-  const_iterator cend() const { return const_iterator(items_.cend(), items_.cend(), &index_); }
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+  const_iterator cbegin() const { return table_.begin(); }
+  const_iterator cend() const { return table_.end(); }
   
   // Conversion operators for C++ interop
   
@@ -431,11 +276,11 @@ public:
   // Comparison operators
   
   bool operator==(const Map<K, V>& other) const {
-    if (index_.size() != other.index_.size()) return false;
+    if (table_.size() != other.table_.size()) return false;
     // Compare all key-value pairs (order-independent)
-    for (const auto& [key, idx] : index_) {
-      auto it = other.index_.find(key);
-      if (it == other.index_.end() || items_[idx].second != other.items_[it->second].second) {
+    for (const auto& [key, value] : table_) {
+      const auto* entry = other.table_.find(key);
+      if (!entry || value != entry->second) {
         return false;
       }
     }
@@ -451,151 +296,19 @@ public:
  * GoodScript Set class - TypeScript-compatible set wrapper
  * 
  * Preserves insertion order like JavaScript Set.
- * Uses a vector to track insertion order and an unordered_map for O(1) lookup.
+ * Backed by an OrderedHashTable: dense insertion-ordered entries plus an
+ * open-addressed index (see gs_ordered_table.hpp).
  */
 template<typename T>
 class Set {
 private:
-  std::vector<T> items_;               // Insertion-ordered storage
-  std::unordered_map<T, size_t> index_; // Value -> index in items_ for O(1) lookup
-
-  // Compact the items_ vector by removing tombstones
-  void compact() {
-    std::vector<T> new_items;
-    new_items.reserve(index_.size());
-    std::unordered_map<T, size_t> new_index;
-    new_index.reserve(index_.size());
-    
-    for (size_t i = 0; i < items_.size(); ++i) {
-      // Check if this position is the canonical one for this value
-      auto it = index_.find(items_[i]);
-      if (it != index_.end() && it->second == i) {
-        new_index[items_[i]] = new_items.size();
-        new_items.push_back(std::move(items_[i]));
-      }
-    }
-    
-    items_ = std::move(new_items);
-    index_ = std::move(new_index);
-  }
+  using Table = OrderedHashTable<T, T, IdentityKey>;
+  Table table_;
 
 public:
-  // Custom iterator that skips tombstones
-  class iterator {
-  private:
-    typename std::vector<T>::iterator current_;
-    typename std::vector<T>::iterator end_;
-    const std::unordered_map<T, size_t>* index_;
-    typename std::vector<T>::iterator begin_; // Need to calculate position
-    
-    void skip_tombstones() {
-      while (current_ != end_) {
-        size_t pos = std::distance(begin_, current_);
-        auto it = index_->find(*current_);
-        // This position is valid if the index points to it
-        if (it != index_->end() && it->second == pos) {
-          break;
-        }
-        ++current_;
-      }
-    }
-    
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = T;
-    using difference_type = std::ptrdiff_t;
-    using pointer = T*;
-    using reference = T&;
-    
-    iterator(typename std::vector<T>::iterator begin,
-             typename std::vector<T>::iterator current,
-             typename std::vector<T>::iterator end,
-             const std::unordered_map<T, size_t>* index)
-      : current_(current), end_(end), index_(index), begin_(begin) {
-      skip_tombstones();
-    }
-    
-    reference operator*() { return *current_; }
-    pointer operator->() { return &(*current_); }
-    
-    iterator& operator++() {
-      ++current_;
-      skip_tombstones();
-      return *this;
-    }
-    
-    iterator operator++(int) {
-      iterator tmp = *this;
-      ++(*this);
-      return tmp;
-    }
-    
-    bool operator==(const iterator& other) const {
-      return current_ == other.current_;
-    }
-    
-    bool operator!=(const iterator& other) const {
-      return current_ != other.current_;
-    }
-  };
-
-  class const_iterator {
-  private:
-    typename std::vector<T>::const_iterator current_;
-    typename std::vector<T>::const_iterator end_;
-    const std::unordered_map<T, size_t>* index_;
-    typename std::vector<T>::const_iterator begin_;
-    
-    void skip_tombstones() {
-      while (current_ != end_) {
-        size_t pos = std::distance(begin_, current_);
-        auto it = index_->find(*current_);
-        // This position is valid if the index points to it
-        if (it != index_->end() && it->second == pos) {
-          break;
-        }
-        ++current_;
-      }
-    }
-    
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = T;
-    using difference_type = std::ptrdiff_t;
-    using pointer = const T*;
-    using reference = const T&;
-    
-    const_iterator(typename std::vector<T>::const_iterator begin,
-                   typename std::vector<T>::const_iterator current,
-                   typename std::vector<T>::const_iterator end,
-                   const std::unordered_map<T, size_t>* index)
-      : current_(current), end_(end), index_(index), begin_(begin) {
-      skip_tombstones();
-    }
-    
-    reference operator*() const { return *current_; }
-    pointer operator->() const { return &(*current_); }
-    
-    const_iterator& operator++() {
-      ++current_;
-      skip_tombstones();
-      return *this;
-    }
-    
-    const_iterator operator++(int) {
-      const_iterator tmp = *this;
-      ++(*this);
-      return tmp;
-    }
-    
-    bool operator==(const const_iterator& other) const {
-      return current_ == other.current_;
-    }
-    
-    bool operator!=(const const_iterator& other) const {
-      return current_ != other.current_;
-    }
-  };
+  // Iterators yield values in insertion order, skipping tombstones
+  using iterator = typename Table::iterator;
+  using const_iterator = typename Table::const_iterator;
 
   // Type aliases for STL compatibility
   using value_type = T;
@@ -627,7 +340,7 @@ public:
    * Equivalent to TypeScript: set.size
    */
   int size() const {
-    return static_cast<int>(index_.size());
+    return static_cast<int>(table_.size());
   }
   
   /**
@@ -636,39 +349,18 @@ public:
    * Returns the set itself for chaining
    */
   Set<T>& add(const T& value) {
-    // Check if already exists
-    if (index_.find(value) != index_.end()) {
-      return *this; // Already in set, maintain original insertion order
-    }
-    
-    // Add to vector and index
-    index_[value] = items_.size();
-    items_.push_back(value);
-    
-    // Compact if too many tombstones (same threshold as Map)
-    if (items_.size() > index_.size() * 2) {
-      compact();
+    uint32_t hash = Table::hash_of(value);
+    if (!table_.find(value, hash)) {
+      table_.append(value, hash);
     }
-    
-    return *this;
+    return *this; // Existing values keep their original insertion order
   }
   
   Set<T>& add(T&& value) {
-    // Check if already exists
-    if (index_.find(value) != index_.end()) {
-      return *this;
-    }
-    
-    // Add to vector and index
-    size_t idx = items_.size();
-    items_.push_back(std::move(value));
-    index_[items_.back()] = idx;
-    
-    // Compact if too many tombstones
-    if (items_.size() > index_.size() * 2) {
-      compact();
+    uint32_t hash = Table::hash_of(value);
+    if (!table_.find(value, hash)) {
+      table_.append(std::move(value), hash);
     }
-    
     return *this;
   }
   
@@ -677,7 +369,7 @@ public:
    * Equivalent to TypeScript: set.has(value)
    */
   bool has(const T& value) const {
-    return index_.find(value) != index_.end();
+    return table_.find(value) != nullptr;
   }
   
   /**
@@ -685,23 +377,10 @@ public:
    * Equivalent to TypeScript: set.delete(value)
    * Returns true if the element was removed, false otherwise
    * 
-   * Uses tombstone pattern - marks slot as deleted but preserves indices
+   * Uses tombstone pattern - marks slot as deleted but preserves order
    */
   bool delete_(const T& value) {
-    auto it = index_.find(value);
-    if (it == index_.end()) {
-      return false;
-    }
-    
-    // Remove from index (creates tombstone in items_)
-    index_.erase(it);
-    
-    // Compact if too many tombstones
-    if (items_.size() > index_.size() * 2) {
-      compact();
-    }
-    
-    return true;
+    return table_.erase(value);
   }
   
   /**
@@ -709,8 +388,7 @@ public:
    * Equivalent to TypeScript: set.clear()
    */
   void clear() {
-    items_.clear();
-    index_.clear();
+    table_.clear();
   }
   
   /**
@@ -745,17 +423,17 @@ public:
   
   // STL-compatible iterators (skip tombstones, preserve insertion order)
   
-  iterator begin() { return iterator(items_.begin(), items_.begin(), items_.end(), &index_); }
-  iterator end() { return iterator(items_.begin(), items_.end(), items_.end(), &index_); }
-  const_iterator begin() const { return const_iterator(items_.begin(), items_.begin(), items_.end(), &index_); }
-  const_iterator end() const { return const_iterator(items_.begin(), items_.end(), items_.end(), &index_); }
-  const_iterator cbegin() const { return const_iterator(items_.begin(), items_.begin(), items_.end(), &index_); }
-  const_iterator cend() const { return const_iterator(items_.begin(), items_.end(), items_.end(), &index_); }
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+  const_iterator cbegin() const { return table_.begin(); }
+  const_iterator cend() const { return table_.end(); }
   
   // Comparison operators
   
   bool operator==(const Set<T>& other) const {
-    if (index_.size() != other.index_.size()) {
+    if (table_.size() != other.table_.size()) {
       return false;
     }
     // Sets are equal if they contain the same elements (order doesn't matter for equality)
@@ -1,7 +1,8 @@
 /**
  * GoodScript Object Runtime
  * 
- * Provides Object class with useful utility methods and LiteralObject type.
+ * Provides Object class with useful utility methods for Map and LiteralObject
+ * (see gs_literal_object.hpp).
  */
 
 #pragma once
@@ -9,29 +10,12 @@
 #include "gs_map.hpp"
 #include "gs_array.hpp"
 #include "gs_property.hpp"
+#include "gs_literal_object.hpp"
 #include <cmath>
 #include <limits>
 
 namespace gs {
 
-/**
- * LiteralObject - Type for object literals with heterogeneous property values
- * 
- * Maps property names (strings) to Property values (type-erased).
- * Allows object literals like { a: 1, b: "hello", c: true }
- * 
- * Example:
- *   LiteralObject obj = {
- *     {"name", Property("Alice")},
- *     {"age", Property(30)},
- *     {"active", Property(true)}
- *   };
- *   
- *   auto name = obj.get("name")->asString();  // "Alice"
- *   auto age = obj.get("age")->asNumber();    // 30.0
- */
-using LiteralObject = Map<gs::String, Property>;
-
 /**
  * Object class - provides static methods for object operations
  * 
@@ -95,33 +79,21 @@ public:
    * Object.keys(literalObject) - Get array of property names
    */
   static Array<gs::String> keys(const LiteralObject& obj) {
-    Array<gs::String> result;
-    for (const auto& pair : obj) {
-      result.push(pair.first);
-    }
-    return result;
+    return obj.keys();
   }
 
   /**
    * Object.values(obj) - Get array of property values
    */
   static Array<Property> values(const LiteralObject& obj) {
-    Array<Property> result;
-    for (const auto& pair : obj) {
-      result.push(pair.second);
-    }
-    return result;
+    return obj.values();
   }
 
   /**
    * Object.entries(obj) - Get array of [key, value] pairs
    */
   static Array<std::pair<String, Property>> entries(const LiteralObject& obj) {
-    Array<std::pair<String, Property>> result;
-    for (const auto& pair : obj) {
-      result.push(pair);
-    }
-    return result;
+    return obj.entries();
   }
 
   // ============================================================================
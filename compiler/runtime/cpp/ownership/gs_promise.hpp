@@ -5,7 +5,10 @@
 // This is a lightweight wrapper that enables:
 // - Storing promises as member variables
 // - Deferred completion patterns (Completer, Future)
-// - Promise combinators (all, race, etc. - to be added)
+// - Settlement without polling: resolve()/reject() schedule the awaiting
+//   coroutines on the event loop's microtask queue
+// - Promise.all, race, allSettled and any, which run their tasks
+//   concurrently on the event loop
 //
 // This is the ownership mode version - uses unique_ptr instead of shared_ptr
 // for promise state to maintain single-owner semantics.
@@ -22,54 +25,106 @@
 #include <cppcoro/task.hpp>
 #include <cppcoro/sync_wait.hpp>
 #include <memory>
+#include <cppcoro/is_awaitable.hpp>
+#include <cppcoro/awaitable_traits.hpp>
+#include <cstdlib>
+#include <exception>
 #include <functional>
+#include <iostream>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "gs_timer.hpp"  // MicrotaskQueue and the event loop
 
 namespace gs {
 
-// Forward declaration
-template<typename T>
+// Forward declaration; Promise<> holds the statics (Promise.all, ...)
+template<typename T = void>
 class Promise;
 
 namespace detail {
-    // Promise controller - allows external completion of a promise
-    template<typename T>
-    struct PromiseController {
-        std::optional<T> value;
-        std::optional<gs::Error> error;
+    // Microtask entry that resumes a suspended coroutine
+    inline void resume_coroutine(void* address) {
+        cppcoro::coroutine_handle<>::from_address(address).resume();
+    }
+
+    // Settlement shared by both controllers: the error, if rejected, and
+    // the coroutines waiting for either outcome
+    struct PromiseSettlement {
+        std::exception_ptr error;
         bool completed = false;
+        std::vector<cppcoro::coroutine_handle<>> waiters;
         
-        void resolve(T val) {
-            if (completed) return;
-            value = std::move(val);
-            completed = true;
+        void reject(gs::Error err) {
+            fail(std::make_exception_ptr(std::move(err)));
         }
         
-        void reject(gs::Error err) {
+        // Rejects with whatever a task threw
+        void fail(std::exception_ptr err) {
             if (completed) return;
             error = std::move(err);
+            settle();
+        }
+        
+        // Schedules every waiter on the microtask queue; nothing polls
+        void settle() {
             completed = true;
+            for (cppcoro::coroutine_handle<> waiter : waiters) {
+                MicrotaskQueue::enqueue(&resume_coroutine, waiter.address());
+            }
+            waiters.clear();
+        }
+        
+        // co_await settlement: suspends until resolve() or reject()
+        auto operator co_await() {
+            struct Awaiter {
+                PromiseSettlement* settlement;
+                bool await_ready() const noexcept { return settlement->completed; }
+                void await_suspend(cppcoro::coroutine_handle<> waiter) {
+                    settlement->waiters.push_back(waiter);
+                }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{this};
         }
     };
     
-    // Specialization for void
-    template<>
-    struct PromiseController<void> {
-        std::optional<gs::Error> error;
-        bool completed = false;
+    // Promise controller - allows external completion of a promise
+    template<typename T>
+    struct PromiseController : PromiseSettlement {
+        std::optional<T> value;
         
-        void resolve() {
+        void resolve(T val) {
             if (completed) return;
-            completed = true;
+            value = std::move(val);
+            settle();
         }
-        
-        void reject(gs::Error err) {
+    };
+    
+    // Specialization for void
+    template<>
+    struct PromiseController<void> : PromiseSettlement {
+        void resolve() {
             if (completed) return;
-            error = std::move(err);
-            completed = true;
+            settle();
         }
     };
     
+    // Suspends until the controller settles, which resumes it through the
+    // microtask queue, then returns the value or rethrows the error
+    template<typename T>
+    cppcoro::task<T> settled_task(std::shared_ptr<PromiseController<T>> controller) {
+        co_await *controller;
+        if (controller->error) {
+            std::rethrow_exception(controller->error);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            co_return std::move(controller->value.value());
+        }
+    }
+    
     // Promise state - holds the task and allows deferred completion
     template<typename T>
     class PromiseState {
@@ -81,6 +136,266 @@ namespace detail {
         PromiseState(cppcoro::task<T>&& t) : task(std::move(t)) {}
         PromiseState(std::shared_ptr<PromiseController<T>> ctrl) : controller(ctrl) {}
     };
+    
+    // Coroutine that starts at once and flags the completion of a task
+    struct CompletionDriver {
+        struct promise_type {
+            CompletionDriver get_return_object() noexcept { return {}; }
+            cppcoro::suspend_never initial_suspend() noexcept { return {}; }
+            cppcoro::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept {}
+        };
+    };
+    
+    template<typename Task>
+    CompletionDriver drive(Task& task, bool& done) {
+        co_await task.when_ready();
+        done = true;
+    }
+    
+    // What co_await yields for a task or Promise, void included
+    template<typename Task>
+    using await_value_t = std::remove_cvref_t<typename cppcoro::awaitable_traits<Task&&>::await_result_t>;
+    
+    // Storable stand-in for the result of a void task
+    template<typename T>
+    using result_slot_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+    
+    // The Error a rejection carries, whatever the task threw
+    inline gs::Error rejection_reason(std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const gs::Error& e) {
+            return e;
+        } catch (const std::exception& e) {
+            return gs::Error(e.what());
+        } catch (...) {
+            return gs::Error("Unknown error");
+        }
+    }
+    
+    // Starts a task at once and reports how it settled: on_value(result)
+    // (on_value() for a void task) or on_error(exception). The coroutine
+    // owns the task and frees itself when the task completes.
+    template<typename Task, typename OnValue, typename OnError>
+    CompletionDriver watch(Task task, OnValue on_value, OnError on_error) {
+        using T = await_value_t<Task>;
+        std::exception_ptr error;
+        std::optional<result_slot_t<T>> value;
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(task);
+                value.emplace();
+            } else {
+                value.emplace(co_await std::move(task));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Outside the try: a throwing callback is not a rejection
+        if (error) {
+            on_error(error);
+        } else if constexpr (std::is_void_v<T>) {
+            on_value();
+        } else {
+            on_value(std::move(*value));
+        }
+    }
+    
+    // The tasks a combinator runs: an array of them as is, or the elements
+    // of an array literal passed one by one (tasks cannot be copied out of
+    // an initializer list)
+    template<typename Tasks>
+        requires (!cppcoro::is_awaitable_v<Tasks&&>)
+    Tasks&& task_list(Tasks&& tasks) {
+        return std::forward<Tasks>(tasks);
+    }
+    
+    template<typename... Tasks>
+        requires (sizeof...(Tasks) > 0 && (cppcoro::is_awaitable_v<Tasks&&> && ...))
+    auto task_list(Tasks&&... tasks) {
+        std::vector<std::common_type_t<std::decay_t<Tasks>...>> list;
+        list.reserve(sizeof...(Tasks));
+        (list.push_back(std::forward<Tasks>(tasks)), ...);
+        return list;
+    }
+    
+    template<typename Tasks>
+    using task_value_t = await_value_t<std::decay_t<decltype(*std::begin(std::declval<Tasks&>()))>>;
+    
+    // Progress of a combinator over n tasks; the controller settles the
+    // task the combinator returned. pending starts at one for the loop
+    // that starts the tasks, so a task that has already settled cannot
+    // finish the combinator before the others are counted.
+    template<typename Result, typename T>
+    struct CombinatorState : PromiseController<Result> {
+        std::vector<std::optional<result_slot_t<T>>> values;
+        std::vector<std::optional<gs::Error>> reasons;
+        size_t pending = 1;
+    };
+    
+    // Every task starts before the combinator returns, as the promises
+    // passed to Promise.all in JavaScript are already running; the event
+    // loop then interleaves them
+    template<typename Tasks>
+    auto all(Tasks&& tasks) {
+        using T = task_value_t<Tasks>;
+        using Result = std::conditional_t<std::is_void_v<T>, void, Array<T>>;
+        auto state = std::make_shared<CombinatorState<Result, T>>();
+        auto fulfilled = [state] {
+            if (--state->pending > 0) return;
+            if constexpr (std::is_void_v<T>) {
+                state->resolve();
+            } else {
+                Array<T> results;
+                results.reserve(state->values.size());
+                for (auto& slot : state->values) {
+                    results.push_back(std::move(*slot));
+                }
+                state->resolve(std::move(results));
+            }
+        };
+        for (auto& task : tasks) {
+            size_t index = state->values.size();
+            state->values.emplace_back();
+            state->pending++;
+            watch(std::move(task),
+                  [state, index, fulfilled](auto&&... value) {
+                      state->values[index].emplace(std::forward<decltype(value)>(value)...);
+                      fulfilled();
+                  },
+                  [state](std::exception_ptr error) { state->fail(error); });
+        }
+        fulfilled();
+        return settled_task<Result>(state);
+    }
+    
+    template<typename Tasks>
+    auto race(Tasks&& tasks) {
+        using T = task_value_t<Tasks>;
+        auto state = std::make_shared<PromiseController<T>>();
+        for (auto& task : tasks) {
+            watch(std::move(task),
+                  [state](auto&&... value) { state->resolve(std::forward<decltype(value)>(value)...); },
+                  [state](std::exception_ptr error) { state->fail(error); });
+        }
+        return settled_task<T>(state);
+    }
+    
+    template<typename Tasks>
+    auto any(Tasks&& tasks) {
+        using T = task_value_t<Tasks>;
+        auto state = std::make_shared<CombinatorState<T, T>>();
+        auto all_rejected = [state] {
+            state->reject(gs::Error("All promises were rejected", "AggregateError"));
+        };
+        for (auto& task : tasks) {
+            state->pending++;
+            watch(std::move(task),
+                  [state](auto&&... value) { state->resolve(std::forward<decltype(value)>(value)...); },
+                  [state, all_rejected](std::exception_ptr) {
+                      if (--state->pending == 0) all_rejected();
+                  });
+        }
+        if (--state->pending == 0) {
+            all_rejected();
+        }
+        return settled_task<T>(state);
+    }
+}
+
+/**
+ * Outcome of one task of Promise.allSettled: status is "fulfilled", with
+ * the value, or "rejected", with the reason
+ */
+template<typename T>
+struct PromiseSettledResult {
+    String status;
+    std::optional<T> value;
+    std::optional<gs::Error> reason;
+};
+
+template<>
+struct PromiseSettledResult<void> {
+    String status;
+    std::optional<gs::Error> reason;
+};
+
+namespace detail {
+    template<typename Tasks>
+    auto allSettled(Tasks&& tasks) {
+        using T = task_value_t<Tasks>;
+        using Result = Array<PromiseSettledResult<T>>;
+        auto state = std::make_shared<CombinatorState<Result, T>>();
+        auto settled = [state] {
+            if (--state->pending > 0) return;
+            Result results;
+            results.reserve(state->values.size());
+            for (size_t i = 0; i < state->values.size(); i++) {
+                PromiseSettledResult<T> result;
+                if (state->reasons[i]) {
+                    result.status = String("rejected");
+                    result.reason = std::move(state->reasons[i]);
+                } else {
+                    result.status = String("fulfilled");
+                    if constexpr (!std::is_void_v<T>) {
+                        result.value = std::move(*state->values[i]);
+                    }
+                }
+                results.push_back(std::move(result));
+            }
+            state->resolve(std::move(results));
+        };
+        for (auto& task : tasks) {
+            size_t index = state->values.size();
+            state->values.emplace_back();
+            state->reasons.emplace_back();
+            state->pending++;
+            watch(std::move(task),
+                  [state, index, settled](auto&&... value) {
+                      state->values[index].emplace(std::forward<decltype(value)>(value)...);
+                      settled();
+                  },
+                  [state, index, settled](std::exception_ptr error) {
+                      state->reasons[index] = rejection_reason(error);
+                      settled();
+                  });
+        }
+        settled();
+        return settled_task<Result>(state);
+    }
+}
+
+/**
+ * Run a task to completion on the event loop and return its result
+ * 
+ * The task starts at once; timers and microtasks run until it finishes.
+ * Throws if it is still pending when nothing is left that could settle
+ * it (Node.js would exit with the promise unsettled).
+ */
+template<typename T>
+T sync_wait(cppcoro::task<T> task) {
+    bool done = false;
+    detail::drive(task, done);
+    if (!runEventLoopUntil([&done] { return done; })) {
+        throw std::runtime_error("Promise never settled: no pending timer can settle it");
+    }
+    // Already complete: returns the value or rethrows the error
+    return cppcoro::sync_wait(std::move(task));
+}
+
+/**
+ * Start a task without waiting for it, as calling an async function
+ * without await does; the event loop runs it alongside everything else.
+ * A rejection nothing awaits ends the process, as in Node.js.
+ */
+template<typename Task>
+void spawn(Task task) {
+    detail::watch(std::move(task), [](auto&&...) {}, [](std::exception_ptr error) {
+        std::cerr << "Uncaught (in promise) " << detail::rejection_reason(error).toString() << std::endl;
+        std::exit(1);
+    });
 }
 
 template<typename T>
@@ -88,32 +403,6 @@ class Promise {
 private:
     std::shared_ptr<detail::PromiseState<T>> state_;
     
-    // Helper coroutine for executor-based promise
-    static cppcoro::task<T> executor_task(
-        std::function<void(std::function<void(T)>, std::function<void(gs::Error)>)> executor,
-        std::shared_ptr<detail::PromiseController<T>> controller
-    ) {
-        // Call the executor with resolve/reject functions
-        executor(
-            [controller](T value) { controller->resolve(std::move(value)); },
-            [controller](gs::Error error) { controller->reject(std::move(error)); }
-        );
-        
-        // Wait for completion (polling for now - could use condition variable)
-        while (!controller->completed) {
-            // Yield to allow other coroutines to run
-            co_await cppcoro::suspend_always{};
-        }
-        
-        // Check if rejected
-        if (controller->error.has_value()) {
-            throw controller->error.value();
-        }
-        
-        // Return the value
-        co_return std::move(controller->value.value());
-    }
-    
 public:
     // Default constructor - creates empty promise
     Promise() : state_(std::make_shared<detail::PromiseState<T>>()) {}
@@ -123,10 +412,20 @@ public:
         : state_(std::make_shared<detail::PromiseState<T>>(std::move(task))) {}
     
     // Construct with executor function: new Promise((resolve, reject) => {...})
+    // The executor runs immediately, as in JavaScript; an Error it throws
+    // rejects the promise.
     Promise(std::function<void(std::function<void(T)>, std::function<void(gs::Error)>)> executor) {
         auto controller = std::make_shared<detail::PromiseController<T>>();
         state_ = std::make_shared<detail::PromiseState<T>>(controller);
-        state_->task = executor_task(std::move(executor), controller);
+        state_->task = detail::settled_task(controller);
+        try {
+            executor(
+                [controller](T value) { controller->resolve(std::move(value)); },
+                [controller](gs::Error error) { controller->reject(std::move(error)); }
+            );
+        } catch (const gs::Error& error) {
+            controller->reject(error);
+        }
     }
     
     // Move semantics
@@ -168,9 +467,9 @@ public:
         return state_->task->operator co_await();
     }
     
-    // Sync wait (for testing/compatibility)
+    // Sync wait: runs the event loop until the promise settles
     T sync_wait() {
-        return cppcoro::sync_wait(take_task());
+        return gs::sync_wait(take_task());
     }
     
     // Static helper: Promise.resolve(value)
@@ -194,41 +493,25 @@ class Promise<void> {
 private:
     std::shared_ptr<detail::PromiseState<void>> state_;
     
-    // Helper coroutine for executor-based promise
-    static cppcoro::task<void> executor_task(
-        std::function<void(std::function<void()>, std::function<void(gs::Error)>)> executor,
-        std::shared_ptr<detail::PromiseController<void>> controller
-    ) {
-        // Call the executor with resolve/reject functions
-        executor(
-            [controller]() { controller->resolve(); },
-            [controller](gs::Error error) { controller->reject(std::move(error)); }
-        );
-        
-        // Wait for completion
-        while (!controller->completed) {
-            co_await cppcoro::suspend_always{};
-        }
-        
-        // Check if rejected
-        if (controller->error.has_value()) {
-            throw controller->error.value();
-        }
-        
-        co_return;
-    }
-    
 public:
     Promise() : state_(std::make_shared<detail::PromiseState<void>>()) {}
     
     Promise(cppcoro::task<void>&& task) 
         : state_(std::make_shared<detail::PromiseState<void>>(std::move(task))) {}
     
-    // Construct with executor function
+    // Construct with executor function (runs immediately)
     Promise(std::function<void(std::function<void()>, std::function<void(gs::Error)>)> executor) {
         auto controller = std::make_shared<detail::PromiseController<void>>();
         state_ = std::make_shared<detail::PromiseState<void>>(controller);
-        state_->task = executor_task(std::move(executor), controller);
+        state_->task = detail::settled_task(controller);
+        try {
+            executor(
+                [controller]() { controller->resolve(); },
+                [controller](gs::Error error) { controller->reject(std::move(error)); }
+            );
+        } catch (const gs::Error& error) {
+            controller->reject(error);
+        }
     }
     
     Promise(Promise&&) = default;
@@ -265,7 +548,7 @@ public:
     }
     
     void sync_wait() {
-        cppcoro::sync_wait(take_task());
+        gs::sync_wait(take_task());
     }
     
     // Static helper: Promise.resolve()
@@ -281,6 +564,38 @@ public:
             reject(error);
         });
     }
+    
+    // Static helper: Promise.resolve(value), called as Promise<>::resolve
+    template<typename U>
+    static cppcoro::task<U> resolve(U value) {
+        co_return value;
+    }
+    
+    // Promise.all(tasks): every result, in order, once all have fulfilled;
+    // rejects as soon as one of them rejects
+    template<typename... Tasks>
+    static auto all(Tasks&&... tasks) {
+        return detail::all(detail::task_list(std::forward<Tasks>(tasks)...));
+    }
+    
+    // Promise.race(tasks): settles as the first of them to settle
+    template<typename... Tasks>
+    static auto race(Tasks&&... tasks) {
+        return detail::race(detail::task_list(std::forward<Tasks>(tasks)...));
+    }
+    
+    // Promise.allSettled(tasks): the outcome of each, once all have settled
+    template<typename... Tasks>
+    static auto allSettled(Tasks&&... tasks) {
+        return detail::allSettled(detail::task_list(std::forward<Tasks>(tasks)...));
+    }
+    
+    // Promise.any(tasks): the first value; rejects with an AggregateError
+    // once all of them have rejected
+    template<typename... Tasks>
+    static auto any(Tasks&&... tasks) {
+        return detail::any(detail::task_list(std::forward<Tasks>(tasks)...));
+    }
 };
 
 } // namespace gs
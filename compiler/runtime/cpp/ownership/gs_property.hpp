@@ -1,6 +1,6 @@
 /**
  * GoodScript Property Runtime
- * 
+ *
  * Type-erased wrapper for object literal property values.
  * Allows heterogeneous object literals like { a: 1, b: "hello", c: true }
  */
@@ -8,31 +8,44 @@
 #pragma once
 
 #include "gs_string.hpp"
-#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
-#include <functional>
+#include <utility>
 
 namespace gs {
 
 /**
  * Property - Type-erased container for any value type
- * 
+ *
  * Used internally for object literal properties where values can have different types.
  * Provides runtime type checking and safe value extraction.
- * 
+ *
+ * Layout: 16 bytes - a 14-byte payload, an inline string length and a tag.
+ * - Undefined / Null / Bool / Number: stored inline, no allocation
+ * - String of up to INLINE_CAPACITY bytes: characters stored inline
+ * - Longer String and Object: one intrusively refcounted heap box, shared
+ *   between copies (copying a Property never copies the string or object)
+ *
+ * Boxes carry a plain destroy function pointer, which also identifies the
+ * boxed type for asObject<T>(). Like the rest of the ownership runtime the
+ * refcount is not atomic (single-threaded use).
+ *
  * Example:
  *   Property p1(42);           // number
  *   Property p2("hello");      // string
  *   Property p3(true);         // bool
- *   
+ *
  *   double n = p1.asNumber();  // 42.0
  *   String s = p2.asString();  // "hello"
  *   bool b = p3.asBool();      // true
  */
 class Property {
 public:
-  enum class Type {
+  enum class Type : uint8_t {
     Undefined,
     Null,
     Bool,
@@ -41,250 +54,350 @@ public:
     Object  // For complex types (arrays, maps, custom classes, etc.)
   };
 
+  /** Longest string kept inline (one payload byte holds the length) */
+  static constexpr size_t INLINE_CAPACITY = 14;
+
 private:
-  Type type_;
-  
-  // Storage for primitive types
-  union PrimitiveValue {
-    bool bool_val;
-    double num_val;
-    
-    PrimitiveValue() : num_val(0.0) {}
-  } value_;
-  
-  // Storage for string (uses unique_ptr for automatic cleanup)
-  std::unique_ptr<gs::String> str_val_;
-  
-  // Storage for complex objects (type-erased)
-  std::shared_ptr<void> obj_val_;
-  std::function<void()> obj_deleter_;
+  // Header of a heap box; the value follows it in the same allocation
+  struct Box {
+    uint32_t refs;
+    void (*destroy)(Box*);
+  };
+
+  template<typename T>
+  struct ValueBox : Box {
+    T value;
+
+    template<typename... Args>
+    explicit ValueBox(Args&&... args) : Box{1, &ValueBox::destroy_box}, value(std::forward<Args>(args)...) {}
+
+    static void destroy_box(Box* box) {
+      delete static_cast<ValueBox*>(box);
+    }
+  };
+
+  using StringBox = ValueBox<gs::String>;
+
+  // Internal tag: String is split by where the characters live
+  enum class Tag : uint8_t {
+    Undefined,
+    Null,
+    Bool,
+    Number,
+    InlineString,
+    BoxedString,
+    Object
+  };
+
+  // 14 payload bytes (a double, a bool, a Box* or inline characters), the
+  // inline string length and the tag
+  alignas(8) char data_[INLINE_CAPACITY] = {};
+  uint8_t length_ = 0;
+  Tag tag_ = Tag::Undefined;
+
+  template<typename T>
+  T load() const {
+    T value;
+    std::memcpy(&value, data_, sizeof(T));
+    return value;
+  }
+
+  template<typename T>
+  void store(T value) {
+    std::memcpy(data_, &value, sizeof(T));
+  }
+
+  Box* box() const { return load<Box*>(); }
+
+  bool has_box() const {
+    return tag_ == Tag::Object || tag_ == Tag::BoxedString;
+  }
+
+  void retain() {
+    if (has_box()) ++box()->refs;
+  }
+
+  void release() {
+    if (has_box()) {
+      Box* b = box();
+      if (--b->refs == 0) b->destroy(b);
+    }
+  }
+
+  void copy_from(const Property& other) {
+    std::memcpy(static_cast<void*>(this), &other, sizeof(Property));
+    retain();
+  }
+
+  void take_from(Property& other) {
+    std::memcpy(static_cast<void*>(this), &other, sizeof(Property));
+    other.tag_ = Tag::Undefined;
+  }
+
+  void init_string(std::string_view s) {
+    if (s.size() <= INLINE_CAPACITY) {
+      tag_ = Tag::InlineString;
+      std::memcpy(data_, s.data(), s.size());
+      length_ = static_cast<uint8_t>(s.size());
+    } else {
+      tag_ = Tag::BoxedString;
+      store<Box*>(new StringBox(s));
+    }
+  }
+
+  void init_string(gs::String&& s) {
+    if (s.str().size() <= INLINE_CAPACITY) {
+      init_string(std::string_view(s));
+    } else {
+      tag_ = Tag::BoxedString;
+      store<Box*>(new StringBox(std::move(s)));
+    }
+  }
+
+  template<typename T>
+  const T* object_ptr() const {
+    if (tag_ != Tag::Object) {
+      throw std::runtime_error("Property is not an object");
+    }
+    if (box()->destroy != &ValueBox<T>::destroy_box) {
+      throw std::runtime_error("Property object has wrong type");
+    }
+    return &static_cast<const ValueBox<T>*>(box())->value;
+  }
 
 public:
   // ============================================================================
   // Constructors
   // ============================================================================
-  
+
   /** Default constructor - undefined */
-  Property() : type_(Type::Undefined) {}
-  
+  Property() {}
+
   /** Null constructor */
   static Property Null() {
     Property p;
-    p.type_ = Type::Null;
+    p.tag_ = Tag::Null;
     return p;
   }
-  
+
   /** Boolean constructor */
-  Property(bool b) : type_(Type::Bool) {
-    value_.bool_val = b;
+  Property(bool b) : tag_(Tag::Bool) {
+    store(b);
   }
-  
+
   /** Number constructors */
-  Property(int n) : type_(Type::Number) {
-    value_.num_val = static_cast<double>(n);
-  }
-  
-  Property(double n) : type_(Type::Number) {
-    value_.num_val = n;
-  }
-  
-  Property(float n) : type_(Type::Number) {
-    value_.num_val = static_cast<double>(n);
-  }
-  
-  /** String constructors */
-  Property(const gs::String& s) : type_(Type::String), str_val_(new gs::String(s)) {}
-  
-  Property(const char* s) : type_(Type::String), str_val_(new gs::String(s)) {}
-  
+  Property(int n) : tag_(Tag::Number) {
+    store(static_cast<double>(n));
+  }
+
+  Property(double n) : tag_(Tag::Number) {
+    store(n);
+  }
+
+  Property(float n) : tag_(Tag::Number) {
+    store(static_cast<double>(n));
+  }
+
+  /** String constructors - short strings are stored inline */
+  Property(const gs::String& s) {
+    init_string(std::string_view(s));
+  }
+
+  Property(gs::String&& s) {
+    init_string(std::move(s));
+  }
+
+  Property(const char* s) {
+    init_string(std::string_view(s));
+  }
+
   /** Complex object constructor - for arrays, maps, custom classes */
-  template<typename T, typename = std::enable_if_t<!std::is_same_v<T, bool> && 
-                                                     !std::is_arithmetic_v<T> &&
-                                                     !std::is_same_v<T, gs::String> &&
-                                                     !std::is_same_v<T, const char*>>>
-  Property(const T& val) : type_(Type::Object) {
-    obj_val_ = std::make_shared<T>(val);
-  }
-  
+  template<typename T, typename U = std::decay_t<T>,
+           typename = std::enable_if_t<!std::is_same_v<U, Property> &&
+                                       !std::is_same_v<U, bool> &&
+                                       !std::is_arithmetic_v<U> &&
+                                       !std::is_same_v<U, gs::String> &&
+                                       !std::is_same_v<U, const char*> &&
+                                       !std::is_same_v<U, char*>>>
+  Property(T&& val) : tag_(Tag::Object) {
+    store<Box*>(new ValueBox<U>(std::forward<T>(val)));
+  }
+
   // ============================================================================
   // Copy and Move Semantics
   // ============================================================================
-  
-  Property(const Property& other) : type_(other.type_), value_(other.value_) {
-    if (type_ == Type::String && other.str_val_) {
-      str_val_ = std::make_unique<gs::String>(*other.str_val_);
-    } else if (type_ == Type::Object) {
-      obj_val_ = other.obj_val_;
-      obj_deleter_ = other.obj_deleter_;
-    }
+
+  Property(const Property& other) {
+    copy_from(other);
   }
-  
-  Property(Property&& other) noexcept 
-    : type_(other.type_), value_(other.value_),
-      str_val_(std::move(other.str_val_)),
-      obj_val_(std::move(other.obj_val_)),
-      obj_deleter_(std::move(other.obj_deleter_)) {
-    other.type_ = Type::Undefined;
+
+  Property(Property&& other) noexcept {
+    take_from(other);
   }
-  
+
   Property& operator=(const Property& other) {
     if (this != &other) {
-      type_ = other.type_;
-      value_ = other.value_;
-      
-      if (type_ == Type::String && other.str_val_) {
-        str_val_ = std::make_unique<gs::String>(*other.str_val_);
-      } else {
-        str_val_.reset();
-      }
-      
-      if (type_ == Type::Object) {
-        obj_val_ = other.obj_val_;
-        obj_deleter_ = other.obj_deleter_;
-      } else {
-        obj_val_.reset();
-        obj_deleter_ = nullptr;
-      }
+      Property old(std::move(*this));
+      copy_from(other);
     }
     return *this;
   }
-  
+
   Property& operator=(Property&& other) noexcept {
     if (this != &other) {
-      type_ = other.type_;
-      value_ = other.value_;
-      str_val_ = std::move(other.str_val_);
-      obj_val_ = std::move(other.obj_val_);
-      obj_deleter_ = std::move(other.obj_deleter_);
-      other.type_ = Type::Undefined;
+      release();
+      take_from(other);
     }
     return *this;
   }
-  
-  ~Property() = default;
-  
+
+  ~Property() {
+    release();
+  }
+
   // ============================================================================
   // Type Checking
   // ============================================================================
-  
-  Type type() const { return type_; }
-  
-  bool isUndefined() const { return type_ == Type::Undefined; }
-  bool isNull() const { return type_ == Type::Null; }
-  bool isBool() const { return type_ == Type::Bool; }
-  bool isNumber() const { return type_ == Type::Number; }
-  bool isString() const { return type_ == Type::String; }
-  bool isObject() const { return type_ == Type::Object; }
-  
+
+  Type type() const {
+    switch (tag_) {
+      case Tag::Undefined: return Type::Undefined;
+      case Tag::Null: return Type::Null;
+      case Tag::Bool: return Type::Bool;
+      case Tag::Number: return Type::Number;
+      case Tag::InlineString:
+      case Tag::BoxedString: return Type::String;
+      case Tag::Object: return Type::Object;
+    }
+    return Type::Undefined;
+  }
+
+  bool isUndefined() const { return tag_ == Tag::Undefined; }
+  bool isNull() const { return tag_ == Tag::Null; }
+  bool isBool() const { return tag_ == Tag::Bool; }
+  bool isNumber() const { return tag_ == Tag::Number; }
+  bool isString() const { return tag_ == Tag::InlineString || tag_ == Tag::BoxedString; }
+  bool isObject() const { return tag_ == Tag::Object; }
+
+  /** Is this an object holding a T (so asObject<T>() will not throw)? */
+  template<typename T>
+  bool isObjectOf() const {
+    return tag_ == Tag::Object && box()->destroy == &ValueBox<T>::destroy_box;
+  }
+
   // ============================================================================
   // Value Extraction (with runtime type checking)
   // ============================================================================
-  
+
   /** Extract boolean value - throws if not a boolean */
   bool asBool() const {
-    if (type_ != Type::Bool) {
+    if (tag_ != Tag::Bool) {
       throw std::runtime_error("Property is not a boolean");
     }
-    return value_.bool_val;
+    return load<bool>();
   }
-  
+
   /** Extract number value - throws if not a number */
   double asNumber() const {
-    if (type_ != Type::Number) {
+    if (tag_ != Tag::Number) {
       throw std::runtime_error("Property is not a number");
     }
-    return value_.num_val;
+    return load<double>();
+  }
+
+  /**
+   * View of the string characters without copying - throws if not a string
+   * Valid while this Property (or a copy sharing its box) is alive and unchanged
+   */
+  std::string_view stringView() const {
+    if (tag_ == Tag::InlineString) {
+      return std::string_view(data_, length_);
+    }
+    if (tag_ != Tag::BoxedString) {
+      throw std::runtime_error("Property is not a string");
+    }
+    return std::string_view(static_cast<const StringBox*>(box())->value);
   }
-  
+
   /** Extract string value - throws if not a string */
   gs::String asString() const {
-    if (type_ != Type::String) {
-      throw std::runtime_error("Property is not a string");
+    if (tag_ == Tag::BoxedString) {
+      return static_cast<const StringBox*>(box())->value;
     }
-    return *str_val_;
+    return gs::String(stringView());
   }
-  
+
   /** Extract object value - throws if not an object or wrong type */
   template<typename T>
   T& asObject() {
-    if (type_ != Type::Object) {
-      throw std::runtime_error("Property is not an object");
-    }
-    T* ptr = static_cast<T*>(obj_val_.get());
-    if (!ptr) {
-      throw std::runtime_error("Property object has wrong type");
-    }
-    return *ptr;
+    return *const_cast<T*>(object_ptr<T>());
   }
-  
+
   template<typename T>
   const T& asObject() const {
-    if (type_ != Type::Object) {
-      throw std::runtime_error("Property is not an object");
-    }
-    const T* ptr = static_cast<const T*>(obj_val_.get());
-    if (!ptr) {
-      throw std::runtime_error("Property object has wrong type");
-    }
-    return *ptr;
+    return *object_ptr<T>();
   }
-  
+
   // ============================================================================
   // Conversions to String (for console.log, etc.)
   // ============================================================================
-  
+
   /** Convert property to string representation */
   gs::String toString() const {
-    switch (type_) {
+    switch (type()) {
       case Type::Undefined:
         return gs::String("undefined");
       case Type::Null:
         return gs::String("null");
       case Type::Bool:
-        return gs::String(value_.bool_val ? "true" : "false");
+        return gs::String(load<bool>() ? "true" : "false");
       case Type::Number: {
         // Format number without unnecessary decimals
-        if (value_.num_val == static_cast<int>(value_.num_val)) {
-          return gs::String(std::to_string(static_cast<int>(value_.num_val)));
+        double num = load<double>();
+        if (num == static_cast<int>(num)) {
+          return gs::String(std::to_string(static_cast<int>(num)));
         }
-        return gs::String(std::to_string(value_.num_val));
+        return gs::String(std::to_string(num));
       }
       case Type::String:
-        return *str_val_;
+        return asString();
       case Type::Object:
         return gs::String("[object Object]");
     }
     return gs::String("");
   }
-  
+
   // ============================================================================
   // Equality Comparison
   // ============================================================================
-  
+
   bool operator==(const Property& other) const {
-    if (type_ != other.type_) {
+    Type kind = type();
+    if (kind != other.type()) {
       return false;
     }
-    
-    switch (type_) {
+
+    switch (kind) {
       case Type::Undefined:
       case Type::Null:
         return true;
       case Type::Bool:
-        return value_.bool_val == other.value_.bool_val;
+        return load<bool>() == other.load<bool>();
       case Type::Number:
-        return value_.num_val == other.value_.num_val;
+        return load<double>() == other.load<double>();
       case Type::String:
-        return *str_val_ == *other.str_val_;
+        return stringView() == other.stringView();
       case Type::Object:
-        return obj_val_ == other.obj_val_;  // Pointer equality
+        return box() == other.box();  // Pointer equality
     }
     return false;
   }
-  
+
   bool operator!=(const Property& other) const {
     return !(*this == other);
   }
 };
 
+static_assert(sizeof(Property) == 16, "Property should stay two words");
+
 }  // namespace gs
@@ -15,7 +15,7 @@
  *   - gs::Map<K,V>: TypeScript-compatible map wrapper
  *   - gs::Set<T>: TypeScript-compatible set wrapper
  *   - gs::Property: Type-erased value wrapper for object literal properties
- *   - gs::LiteralObject: Object literals with heterogeneous property types
+ *   - gs::LiteralObject: Object literals with heterogeneous property types (shape-based)
  *   - gs::JSON: JSON.stringify() and JSON.parse()
  *   - gs::console: console.log(), console.error(), console.warn()
  *   - gs::Math: Math functions (sin, cos, sqrt, PI, etc.)
@@ -23,12 +23,14 @@
  *   - gs::Object: Object utilities (keys, values, entries, assign, is)
  *   - gs::RegExp: Regular expression support with full JS semantics (PCRE2)
  *   - gs::Error: Error classes (Error, TypeError, RangeError, SyntaxError, etc.)
+ *   - gs::ArrayBuffer, gs::Float64Array/Int32Array/Uint8Array: Fixed-length typed arrays
  *   - gs::Iterator<T>: TypeScript-style iterator protocol
  *   - gs::Iterable<T>: TypeScript-style iterable protocol
  *   - gs::setTimeout/clearTimeout: Timer support for async operations
  *   - gs::setInterval/clearInterval: Interval timer support
+ *   - gs::runEventLoop: Runs pending timers to completion (end of main)
  *   - gs::FileSystem: Cross-platform filesystem operations (sync)
- *   - gs::FileSystemAsync: Async filesystem operations (requires cppcoro)
+ *   - gs::FileSystemAsync: Async filesystem operations (requires cppcoro; io_uring on Linux)
  *   - gs::shared_ptr<T>: Non-atomic shared pointer for single-threaded use
  *   - gs::weak_ptr<T>: Non-atomic weak pointer for single-threaded use
  */
@@ -39,6 +41,8 @@
 #include "gs_string.hpp"
 #include "gs_string_builder.hpp"
 #include "gs_array.hpp"
+#include "../gs_pipeline.hpp"  // Fused map/filter chains (after Array)
+#include "../gs_parallel.hpp"  // Parallel.map/filter/reduce/sort (after Array)
 #include "gs_map.hpp"
 #include "gs_iterator.hpp"
 #include "gs_property.hpp"
@@ -50,6 +54,7 @@
 #include "gs_tuple.hpp"
 #include "gs_date.hpp"
 #include "gs_error.hpp"
+#include "../gs_typed_array.hpp"  // ArrayBuffer and typed array views (after Array and Error)
 #include "gs_timer.hpp"
 #include "gs_process.hpp"
 
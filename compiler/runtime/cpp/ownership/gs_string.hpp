@@ -5,6 +5,7 @@
 #include <optional>
 #include <sstream>
 #include <cmath>
+#include "../gs_hash.hpp"
 
 namespace gs {
 
@@ -621,8 +622,9 @@ public:
 namespace std {
   template<>
   struct hash<gs::String> {
-    size_t operator()(const gs::String& s) const {
-      return hash<string_view>()(s);
+    size_t operator()(const gs::String& s) const noexcept {
+      string_view sv = s;
+      return static_cast<size_t>(gs::hash_bytes(sv.data(), sv.size()));
     }
   };
 }
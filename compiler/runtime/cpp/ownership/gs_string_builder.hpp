@@ -50,6 +50,11 @@ public:
     return *this;
   }
   
+  StringBuilder& append(const char* data, size_t len) {
+    buffer_.append(data, len);
+    return *this;
+  }
+  
   StringBuilder& append(char c) {
     buffer_ += c;
     return *this;
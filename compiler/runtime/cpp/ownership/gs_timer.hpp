@@ -5,116 +5,352 @@
  * 
  * Provides setTimeout/clearTimeout functionality for C++ runtime.
  * 
- * THREAD SAFETY: Implements an event queue model similar to JavaScript/Node.js.
- * Timer threads only enqueue callbacks - they never execute user code directly.
- * User code must call processTimers() to execute pending callbacks on the main thread.
+ * EVENT LOOP: Timers live in a min-heap ordered by expiry on the main
+ * thread; no thread is ever started for them. The generated main() calls
+ * runEventLoop() after the top-level statements, which sleeps until the
+ * earliest timer is due (epoll on a timerfd on Linux, sleep_until
+ * elsewhere), runs every timer that has expired, and returns once none
+ * are left. processTimers() runs the expired ones without waiting.
  * 
- * This maintains GoodScript's single-threaded execution guarantee while providing
- * async timer functionality compatible with TypeScript semantics.
+ * Callbacks run one at a time on the main thread, in expiry order, and
+ * timers with the same expiry in the order they were scheduled. Timers
+ * must be set and cleared from the main thread.
  * 
- * NOTE: Timer support requires threading and is disabled for wasm32-wasi target.
+ * MICROTASKS: Promise continuations go to the MicrotaskQueue, which the
+ * loop drains after every timer callback, before the next one runs, as
+ * JavaScript does with its job queue.
+ * 
+ * I/O: Other event sources (the io_uring of FileSystemAsync) register a
+ * file descriptor that becomes readable when their operations complete.
+ * The loop waits on it together with the timerfd and keeps running while
+ * any operation is in flight.
+ * 
+ * GC: under the precise collector (GS_GC_AMC) callbacks and promise state
+ * live in rooted blocks, since their captures and values may be the only
+ * reference to a GC object and the malloc heap is not scanned.
+ * 
+ * NOTE: Timer support is disabled for wasm32-wasi target.
  */
 
 #include <functional>
 #include <chrono>
+#include <deque>
+#include <memory>
+
+namespace gs {
+
+/**
+ * Microtask queue: work that runs as soon as the current callback returns
+ * (the continuation of a coroutine awaiting a settled Promise). An entry
+ * is a function and its argument, so queuing one never allocates beyond
+ * the queue itself.
+ */
+class MicrotaskQueue {
+private:
+    struct Microtask {
+        void (*run)(void*);
+        void* data;
+    };
+
+    static std::deque<Microtask> queue;
 
-// Timer support requires threading (not available in wasm32-wasi)
+public:
+    static void enqueue(void (*run)(void*), void* data) {
+        queue.push_back({run, data});
+    }
+
+    static bool empty() {
+        return queue.empty();
+    }
+
+    /**
+     * Run microtasks until none are left, including those they queue
+     * 
+     * @return Number of microtasks executed
+     */
+    static int drain() {
+        int executed = 0;
+        while (!queue.empty()) {
+            Microtask task = queue.front();
+            queue.pop_front();
+            task.run(task.data);
+            ++executed;
+        }
+        return executed;
+    }
+};
+
+inline std::deque<MicrotaskQueue::Microtask> MicrotaskQueue::queue;
+
+namespace detail {
+    // Allocator for event loop state on the malloc heap that may hold GC
+    // values: a scanned root under the precise collector
+#ifdef GS_GC_AMC
+    template<typename T>
+    using rooted_allocator = gc::RootedAllocator<T>;
+#else
+    template<typename T>
+    using rooted_allocator = std::allocator<T>;
+#endif
+}
+
+} // namespace gs
+
+// Timer support is not available in wasm32-wasi
 #if !defined(__wasi__)
 
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cerrno>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#else
 #include <thread>
-#include <atomic>
-#include <map>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#endif
 
 namespace gs {
 
+namespace detail {
+    // A callback as the timer queue stores it. std::function keeps large
+    // captures on the malloc heap, so under the precise collector they
+    // move to a rooted block and the std::function holds a pointer to it.
+    template<typename F>
+    std::function<void()> rooted_callback(F&& callback) {
+#ifdef GS_GC_AMC
+        using Fn = std::decay_t<F>;
+        auto held = std::allocate_shared<Fn>(rooted_allocator<Fn>(), std::forward<F>(callback));
+        return [held] { (*held)(); };
+#else
+        return std::function<void()>(std::forward<F>(callback));
+#endif
+    }
+}
+
 /**
- * Timer implementation using event queue pattern (JavaScript/Node.js style)
+ * Timer queue and event loop (JavaScript/Node.js style)
  * 
- * SAFETY GUARANTEE:
- * - Timer threads ONLY enqueue callbacks, never execute them
- * - Main thread executes callbacks via processTimers()
- * - No race conditions on user code/objects
- * - Compatible with single-threaded execution model
+ * Scheduling and cancelling are O(log n): every timer records its
+ * position in the heap, so clearTimeout removes it where it is.
  */
 class TimerManager {
+public:
+    /**
+     * Event source besides the timers, such as the file I/O ring
+     */
+    struct IoSource {
+        int fd;               // Readable once completions are waiting
+        bool (*busy)();       // Whether operations are still in flight
+        void (*flush)();      // Hands queued operations over, before the loop waits
+        void (*complete)();   // Runs the completions that are ready
+    };
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t NOT_QUEUED = static_cast<size_t>(-1);
+
     struct TimerEntry {
         int id;
-        std::chrono::steady_clock::time_point expiry;
+        Clock::time_point expiry;
+        uint64_t seq;                    // Scheduling order, breaks expiry ties
         std::function<void()> callback;
         bool repeating;
         int interval;
-        
-        bool operator>(const TimerEntry& other) const {
-            return expiry > other.expiry; // Min-heap (earliest first)
-        }
+        size_t slot = NOT_QUEUED;        // Position in heap
     };
-    
-    struct WaitingTimer {
-        std::thread thread;
-        std::atomic<bool> cancelled{false};
-        
-        WaitingTimer() = default;
-        
-        // Custom move constructor (atomic isn't movable)
-        WaitingTimer(WaitingTimer&& other) noexcept 
-            : thread(std::move(other.thread))
-            , cancelled(other.cancelled.load()) {
+
+    // Binary min-heap of the pending timers, earliest first
+    static std::vector<TimerEntry*> heap;
+
+    // Timer records by id (owning)
+    static std::unordered_map<int, std::unique_ptr<TimerEntry>> timers;
+
+    static std::vector<IoSource> ioSources;
+
+    static int nextId;
+    static uint64_t nextSeq;
+
+    static bool earlier(const TimerEntry* a, const TimerEntry* b) {
+        return a->expiry != b->expiry ? a->expiry < b->expiry : a->seq < b->seq;
+    }
+
+    static void place(TimerEntry* entry, size_t slot) {
+        heap[slot] = entry;
+        entry->slot = slot;
+    }
+
+    static void siftUp(size_t slot) {
+        TimerEntry* entry = heap[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / 2;
+            if (!earlier(entry, heap[parent])) break;
+            place(heap[parent], slot);
+            slot = parent;
         }
-        
-        // Custom move assignment
-        WaitingTimer& operator=(WaitingTimer&& other) noexcept {
-            if (this != &other) {
-                thread = std::move(other.thread);
-                cancelled.store(other.cancelled.load());
+        place(entry, slot);
+    }
+
+    static void siftDown(size_t slot) {
+        TimerEntry* entry = heap[slot];
+        size_t count = heap.size();
+        while (true) {
+            size_t child = 2 * slot + 1;
+            if (child >= count) break;
+            if (child + 1 < count && earlier(heap[child + 1], heap[child])) ++child;
+            if (!earlier(heap[child], entry)) break;
+            place(heap[child], slot);
+            slot = child;
+        }
+        place(entry, slot);
+    }
+
+    static void enqueue(TimerEntry* entry) {
+        entry->seq = nextSeq++;
+        heap.push_back(entry);
+        siftUp(heap.size() - 1);
+    }
+
+    static void dequeue(TimerEntry* entry) {
+        size_t slot = entry->slot;
+        TimerEntry* last = heap.back();
+        heap.pop_back();
+        entry->slot = NOT_QUEUED;
+        if (last != entry) {
+            place(last, slot);
+            if (slot > 0 && earlier(last, heap[(slot - 1) / 2])) {
+                siftUp(slot);
+            } else {
+                siftDown(slot);
             }
-            return *this;
         }
-        
-        WaitingTimer(const WaitingTimer&) = delete;
-        WaitingTimer& operator=(const WaitingTimer&) = delete;
-    };
-    
-    // Event queue - callbacks ready to execute on main thread
-    static std::queue<std::function<void()>> eventQueue;
-    static std::mutex eventQueueMutex;
-    
-    // Active waiting timers (threads sleeping until expiry)
-    static std::map<int, WaitingTimer> waitingTimers;
-    static std::mutex waitingTimersMutex;
-    
-    // Timer metadata
-    static std::map<int, TimerEntry> activeTimers;
-    static std::mutex activeTimersMutex;
-    
-    static std::atomic<int> nextId;
+    }
+
+    static int scheduleTimer(std::function<void()> callback, int milliseconds, bool repeating) {
+        // Like JavaScript, negative delays mean "as soon as possible"
+        milliseconds = milliseconds < 0 ? 0 : milliseconds;
+        int id = nextId++;
+        auto entry = std::make_unique<TimerEntry>();
+        entry->id = id;
+        entry->expiry = Clock::now() + std::chrono::milliseconds(milliseconds);
+        entry->callback = std::move(callback);
+        entry->repeating = repeating;
+        entry->interval = milliseconds;
+        enqueue(entry.get());
+        timers.emplace(id, std::move(entry));
+        return id;
+    }
+
+    static bool ioBusy() {
+        for (const IoSource& source : ioSources) {
+            if (source.busy()) return true;
+        }
+        return false;
+    }
+
+#if defined(__linux__)
+    // epoll instance watching a timerfd armed for the earliest expiry,
+    // and the file descriptors of the I/O sources
+    static int epollFd;
+    static int timerFd;
+
+    static void watchFd(int fd) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    static void openEpoll() {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (epollFd < 0 || timerFd < 0) {
+            int error = errno;
+            closeEpoll();
+            throw std::system_error(error, std::generic_category(), "timer event loop");
+        }
+        watchFd(timerFd);
+        // Sources added before a cleanup() closed the previous instance
+        for (const IoSource& source : ioSources) {
+            watchFd(source.fd);
+        }
+    }
+
+    static void closeEpoll() {
+        if (epollFd >= 0) ::close(epollFd);
+        if (timerFd >= 0) ::close(timerFd);
+        epollFd = -1;
+        timerFd = -1;
+    }
 
     /**
-     * Enqueue a callback to be executed on the main thread
-     * Called by timer threads - NEVER executes user code directly
+     * Blocks until the monotonic clock reaches expiry (steady_clock is
+     * CLOCK_MONOTONIC on Linux) or, without one, until an I/O source has
+     * completions, then runs the completions that are ready. A due expiry
+     * only polls the I/O sources.
      */
-    static void enqueueCallback(std::function<void()> callback) {
-        std::lock_guard<std::mutex> lock(eventQueueMutex);
-        eventQueue.push(std::move(callback));
+    static void waitForEvents(std::optional<Clock::time_point> expiry) {
+        if (epollFd < 0) {
+            openEpoll();
+        }
+        int timeout = -1;
+        if (expiry && *expiry <= Clock::now()) {
+            if (ioSources.empty()) return;
+            timeout = 0;
+        } else if (expiry) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(expiry->time_since_epoch()).count();
+            itimerspec spec{};
+            spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+            if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+                return;  // Zero would disarm the timer
+            }
+            timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+        }
+
+        epoll_event events[8];
+        int count;
+        while ((count = epoll_wait(epollFd, events, 8, timeout)) < 0 && errno == EINTR) {
+        }
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == timerFd) {
+                // A stale expiry only wakes the loop once
+                uint64_t expirations;
+                while (read(timerFd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+                }
+                continue;
+            }
+            for (const IoSource& source : ioSources) {
+                if (source.fd == events[i].data.fd) source.complete();
+            }
+        }
+    }
+#else
+    static void waitForEvents(std::optional<Clock::time_point> expiry) {
+        if (expiry) {
+            std::this_thread::sleep_until(*expiry);
+        }
     }
+#endif
 
 public:
     /**
      * Schedule a function to be called after a delay
      * Similar to JavaScript's setTimeout()
      * 
-     * THREAD SAFETY: The callback will be executed on the main thread
-     * when processTimers() is called, NOT on the timer thread.
-     * 
      * @param callback Function to call after delay (executed on main thread)
      * @param milliseconds Delay in milliseconds
      * @return Timer ID that can be used with clearTimeout
      */
-    static int setTimeout(std::function<void()> callback, int milliseconds) {
-        return scheduleTimer(std::move(callback), milliseconds, false);
+    template<typename F>
+    static int setTimeout(F&& callback, int milliseconds) {
+        return scheduleTimer(detail::rooted_callback(std::forward<F>(callback)), milliseconds, false);
     }
     
     /**
@@ -125,99 +361,29 @@ public:
      * @param milliseconds Delay between calls in milliseconds
      * @return Timer ID that can be used with clearInterval
      */
-    static int setInterval(std::function<void()> callback, int milliseconds) {
-        return scheduleTimer(std::move(callback), milliseconds, true);
+    template<typename F>
+    static int setInterval(F&& callback, int milliseconds) {
+        return scheduleTimer(detail::rooted_callback(std::forward<F>(callback)), milliseconds, true);
     }
 
-private:
-    static int scheduleTimer(std::function<void()> callback, int milliseconds, bool repeating) {
-        int id = nextId++;
-        
-        // Store timer metadata
-        {
-            std::lock_guard<std::mutex> lock(activeTimersMutex);
-            TimerEntry entry;
-            entry.id = id;
-            entry.expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
-            entry.callback = callback;
-            entry.repeating = repeating;
-            entry.interval = milliseconds;
-            activeTimers.emplace(id, std::move(entry));
-        }
-        
-        // Create timer thread that will enqueue the callback when it expires
-        WaitingTimer timer;
-        timer.thread = std::thread([id, callback, milliseconds, repeating]() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
-            
-            // Check if timer was cancelled during sleep
-            bool shouldEnqueue = false;
-            {
-                std::lock_guard<std::mutex> lock(waitingTimersMutex);
-                auto it = waitingTimers.find(id);
-                if (it != waitingTimers.end() && !it->second.cancelled) {
-                    shouldEnqueue = true;
-                }
-            }
-            
-            if (shouldEnqueue) {
-                // Enqueue callback to be executed on main thread
-                // This is the ONLY interaction with user code - just storing the function
-                enqueueCallback([id, callback, repeating, milliseconds]() {
-                    // This lambda executes on main thread via processTimers()
-                    callback();
-                    
-                    // If repeating, schedule next execution
-                    if (repeating) {
-                        std::lock_guard<std::mutex> lock(activeTimersMutex);
-                        auto it = activeTimers.find(id);
-                        if (it != activeTimers.end()) {
-                            // Schedule next interval
-                            scheduleTimer(callback, milliseconds, true);
-                        }
-                    }
-                });
-                
-                // Clean up waiting timer
-                {
-                    std::lock_guard<std::mutex> lock(waitingTimersMutex);
-                    waitingTimers.erase(id);
-                }
-            }
-        });
-        
-        std::lock_guard<std::mutex> lock(waitingTimersMutex);
-        waitingTimers.emplace(id, std::move(timer));
-        
-        return id;
-    }
-
-public:
     /**
      * Cancel a scheduled timer
      * Similar to JavaScript's clearTimeout()
      * 
+     * Unknown, fired and already cleared ids are ignored. A callback may
+     * clear its own interval.
+     * 
      * @param id Timer ID returned from setTimeout
      */
     static void clearTimeout(int id) {
-        // Remove from active timers
-        {
-            std::lock_guard<std::mutex> lock(activeTimersMutex);
-            activeTimers.erase(id);
+        auto it = timers.find(id);
+        if (it == timers.end()) {
+            return;
         }
-        
-        // Cancel waiting timer thread
-        {
-            std::lock_guard<std::mutex> lock(waitingTimersMutex);
-            auto it = waitingTimers.find(id);
-            if (it != waitingTimers.end()) {
-                it->second.cancelled = true;
-                if (it->second.thread.joinable()) {
-                    it->second.thread.detach(); // Let it exit cleanly
-                }
-                waitingTimers.erase(it);
-            }
+        if (it->second->slot != NOT_QUEUED) {
+            dequeue(it->second.get());
         }
+        timers.erase(it);
     }
     
     /**
@@ -231,101 +397,148 @@ public:
     }
     
     /**
-     * Process pending timer callbacks on the main thread
-     * 
-     * IMPORTANT: This must be called from the main thread to execute
-     * timer callbacks. This is where callbacks actually run.
+     * Run the timers that have expired, without waiting
      * 
-     * For programs with event loops, call this in each iteration.
-     * For programs without event loops, call before program exit.
+     * Timers scheduled by the callbacks, including the next run of an
+     * interval, wait for the next call even when they are already due.
      * 
      * @param maxCallbacks Maximum number of callbacks to process (0 = all)
      * @return Number of callbacks executed
      */
     static int processTimers(int maxCallbacks = 0) {
-        std::vector<std::function<void()>> callbacks;
-        
-        // Dequeue all pending callbacks
-        {
-            std::lock_guard<std::mutex> lock(eventQueueMutex);
-            int count = (maxCallbacks > 0) ? maxCallbacks : static_cast<int>(eventQueue.size());
-            
-            while (!eventQueue.empty() && (maxCallbacks == 0 || callbacks.size() < static_cast<size_t>(maxCallbacks))) {
-                callbacks.push_back(std::move(eventQueue.front()));
-                eventQueue.pop();
+        Clock::time_point now = Clock::now();
+        uint64_t pass = nextSeq;
+        int executed = 0;
+
+        while (!heap.empty() && (maxCallbacks == 0 || executed < maxCallbacks)) {
+            TimerEntry* entry = heap.front();
+            if (entry->expiry > now || entry->seq >= pass) {
+                break;
             }
+            dequeue(entry);
+            ++executed;
+
+            if (entry->repeating) {
+                // Re-armed before the call, so the callback can clear it
+                entry->expiry = Clock::now() + std::chrono::milliseconds(entry->interval);
+                enqueue(entry);
+                std::function<void()> callback = entry->callback;
+                callback();
+            } else {
+                std::function<void()> callback = std::move(entry->callback);
+                timers.erase(entry->id);
+                callback();
+            }
+            MicrotaskQueue::drain();
         }
         
-        // Execute callbacks on main thread (outside lock)
-        for (auto& callback : callbacks) {
-            callback();
-        }
-        
-        return static_cast<int>(callbacks.size());
+        return executed;
     }
     
     /**
      * Check if there are pending timer callbacks
      * 
-     * @return true if there are callbacks waiting to be processed
+     * @return true if a timer has expired and waits to be processed
      */
     static bool hasPendingCallbacks() {
-        std::lock_guard<std::mutex> lock(eventQueueMutex);
-        return !eventQueue.empty();
+        return !heap.empty() && heap.front()->expiry <= Clock::now();
     }
-    
+
     /**
-     * Cleanup all timers (call at program exit)
-     * Also processes any pending callbacks
+     * Check if any timer is still scheduled
      */
-    static void cleanup() {
-        // Process any remaining callbacks
-        processTimers();
-        
-        // Cancel all waiting timers
-        {
-            std::lock_guard<std::mutex> lock(waitingTimersMutex);
-            for (auto& pair : waitingTimers) {
-                pair.second.cancelled = true;
-                if (pair.second.thread.joinable()) {
-                    pair.second.thread.detach();
-                }
-            }
-            waitingTimers.clear();
-        }
-        
-        // Clear active timers
-        {
-            std::lock_guard<std::mutex> lock(activeTimersMutex);
-            activeTimers.clear();
+    static bool hasTimers() {
+        return !heap.empty();
+    }
+
+    /**
+     * Add an event source the loop waits on along with the timers
+     * (Linux: its fd joins the epoll set)
+     */
+    static void addIoSource(IoSource source) {
+#if defined(__linux__)
+        if (epollFd < 0) {
+            openEpoll();
         }
-        
-        // Clear event queue
-        {
-            std::lock_guard<std::mutex> lock(eventQueueMutex);
-            while (!eventQueue.empty()) {
-                eventQueue.pop();
+        watchFd(source.fd);
+#endif
+        ioSources.push_back(source);
+    }
+
+    /**
+     * Run the event loop until done() holds or nothing is left to run
+     * 
+     * Drains the microtasks, then sleeps until the earliest timer expires
+     * or I/O completes and runs everything due, checking done() in
+     * between.
+     * 
+     * @return Whether done() holds (false: no timer or I/O left to change it)
+     */
+    template<typename Done>
+    static bool runUntil(Done done) {
+        MicrotaskQueue::drain();
+        while (!done()) {
+            // Operations queued since the last wait go out together
+            for (const IoSource& source : ioSources) {
+                source.flush();
+            }
+            if (heap.empty() && !ioBusy()) {
+                return false;
             }
+            std::optional<Clock::time_point> next;
+            if (!heap.empty()) {
+                next = heap.front()->expiry;
+            }
+            waitForEvents(next);
+            MicrotaskQueue::drain();  // Coroutines resumed by I/O completions
+            processTimers();
         }
+        return true;
+    }
+
+    /**
+     * Run the event loop until no timer or I/O is left, like Node.js
+     * before it exits
+     */
+    static void run() {
+        runUntil([] { return false; });
+    }
+    
+    /**
+     * Cancel all timers and close the loop's descriptors (runs at program
+     * exit); a later run() opens them again
+     */
+    static void cleanup() {
+        heap.clear();
+        timers.clear();
+#if defined(__linux__)
+        closeEpoll();
+#endif
     }
 };
 
 // Static member initialization (inline to avoid duplicate symbols)
-inline std::queue<std::function<void()>> TimerManager::eventQueue;
-inline std::mutex TimerManager::eventQueueMutex;
-inline std::map<int, TimerManager::WaitingTimer> TimerManager::waitingTimers;
-inline std::mutex TimerManager::waitingTimersMutex;
-inline std::map<int, TimerManager::TimerEntry> TimerManager::activeTimers;
-inline std::mutex TimerManager::activeTimersMutex;
-inline std::atomic<int> TimerManager::nextId{1};
+inline std::vector<TimerManager::TimerEntry*> TimerManager::heap;
+inline std::unordered_map<int, std::unique_ptr<TimerManager::TimerEntry>> TimerManager::timers;
+inline std::vector<TimerManager::IoSource> TimerManager::ioSources;
+inline int TimerManager::nextId = 1;
+inline uint64_t TimerManager::nextSeq = 0;
+#if defined(__linux__)
+inline int TimerManager::epollFd = -1;
+inline int TimerManager::timerFd = -1;
+#endif
+
+// Release the event loop at program exit
+inline struct TimerManagerCleanup {
+    ~TimerManagerCleanup() { TimerManager::cleanup(); }
+} timerManagerCleanup;
 
 /**
  * Global setTimeout function (JavaScript-compatible API)
- * 
- * THREAD SAFETY: Callback executes on main thread via processTimers()
  */
-inline int setTimeout(std::function<void()> callback, int milliseconds) {
-    return TimerManager::setTimeout(callback, milliseconds);
+template<typename F>
+inline int setTimeout(F&& callback, int milliseconds) {
+    return TimerManager::setTimeout(std::forward<F>(callback), milliseconds);
 }
 
 /**
@@ -346,11 +559,10 @@ inline void clearTimeout(std::optional<double> id) {
 
 /**
  * Global setInterval function (JavaScript-compatible API)
- * 
- * THREAD SAFETY: Callback executes on main thread via processTimers()
  */
-inline int setInterval(std::function<void()> callback, int milliseconds) {
-    return TimerManager::setInterval(callback, milliseconds);
+template<typename F>
+inline int setInterval(F&& callback, int milliseconds) {
+    return TimerManager::setInterval(std::forward<F>(callback), milliseconds);
 }
 
 /**
@@ -361,22 +573,13 @@ inline void clearInterval(int id) {
 }
 
 /**
- * Process pending timer callbacks
- * 
- * IMPORTANT: Must be called from main thread to execute timer callbacks.
+ * Run the timers that have expired, without waiting
  * 
- * For event loop programs, call this in each iteration:
+ * For programs that drive their own loop:
  *   while (running) {
  *     gs::processTimers();
  *     // ... other work
  *   }
- * 
- * For simple programs, call before exit:
- *   int main() {
- *     // ... set up timers
- *     gs::processTimers(); // Execute any pending callbacks
- *     return 0;
- *   }
  */
 inline int processTimers(int maxCallbacks = 0) {
     return TimerManager::processTimers(maxCallbacks);
@@ -389,11 +592,28 @@ inline bool hasPendingTimers() {
     return TimerManager::hasPendingCallbacks();
 }
 
+/**
+ * Run the event loop until no timer or I/O is left (end of the generated
+ * main())
+ */
+inline void runEventLoop() {
+    TimerManager::run();
+}
+
+/**
+ * Run the event loop until done() holds; false if nothing is left that
+ * could make it hold
+ */
+template<typename Done>
+inline bool runEventLoopUntil(Done done) {
+    return TimerManager::runUntil(std::move(done));
+}
+
 } // namespace gs
 
 #else // __wasi__
 
-// Stub implementation for wasm32-wasi (no threading support)
+// Stub implementation for wasm32-wasi
 namespace gs {
 
 // Stub timer functions that do nothing
@@ -403,6 +623,13 @@ inline double setInterval(std::function<void()>, double) { return -1.0; }
 inline void clearInterval(double) {}
 inline void processTimers() {}
 inline bool hasPendingTimers() { return false; }
+inline void runEventLoop() { MicrotaskQueue::drain(); }
+
+template<typename Done>
+inline bool runEventLoopUntil(Done done) {
+    MicrotaskQueue::drain();
+    return done();
+}
 
 // Optional overloads
 inline double setTimeout(std::function<void()>, std::optional<double>) { return -1.0; }
@@ -0,0 +1,239 @@
+/**
+ * Phase 2d: AMC Closure Check
+ *
+ * The precise AMC pool (--gsGc amc) scans its own pools, the stack, async
+ * frames, timer callbacks and promise state, but not the heap storage of a
+ * std::function. A closure held as a function value (a field, parameter,
+ * container element or non-literal const) keeps its captures there, so the
+ * collector neither sees nor updates the GC references they hold.
+ *
+ * Function-typed locals initialized with a lambda, and functions returning
+ * one, are emitted as `auto` and stay on the stack, so they are allowed.
+ *
+ * Only enforced for GC mode with the AMC pool.
+ *
+ * Error Codes: GS501-GS599
+ */
+
+import type {
+  IRModule,
+  IRType,
+  IRParam,
+  IRClassDecl,
+  IRInterfaceDecl,
+  IRFunctionDecl,
+  IRConstDecl,
+} from '../ir/types.js';
+
+/**
+ * Diagnostic message for closures the AMC pool cannot scan
+ */
+export interface AmcClosureDiagnostic {
+  code: string;
+  message: string;
+  severity: 'error' | 'warning';
+  location: {
+    file: string;
+    line: number;
+    column: number;
+  };
+}
+
+type Location = { line: number; column: number };
+
+// Node properties that hold types rather than statements or expressions
+const TYPE_KEYS = new Set(['type', 'variableType', 'returnType', 'captures']);
+
+/**
+ * AMC Closure Checker
+ *
+ * Reports every declaration whose C++ type would hold a std::function.
+ */
+export class AmcClosureChecker {
+  private diagnostics: AmcClosureDiagnostic[] = [];
+  private modulePath = '';
+
+  analyze(module: IRModule): AmcClosureDiagnostic[] {
+    this.diagnostics = [];
+    this.modulePath = module.path;
+
+    for (const decl of module.declarations) {
+      switch (decl.kind) {
+        case 'function':
+          this.checkFunction(decl, decl.source);
+          break;
+        case 'class':
+          this.checkClass(decl, decl.source);
+          break;
+        case 'interface':
+          this.checkInterface(decl);
+          break;
+        case 'const':
+          this.checkConst(decl);
+          break;
+      }
+    }
+    for (const stmt of module.initStatements ?? []) {
+      this.walk(stmt, undefined);
+    }
+
+    return this.diagnostics;
+  }
+
+  private checkFunction(func: IRFunctionDecl, location?: Location): void {
+    this.checkParams(func.params, location);
+    this.checkReturn(func.name, func.returnType, location);
+    this.walk(func.body, location);
+  }
+
+  private checkClass(classDecl: IRClassDecl, location?: Location): void {
+    for (const field of classDecl.fields) {
+      if (this.containsFunction(field.type)) {
+        this.report(`Class field '${field.name}'`, location);
+      }
+      if (field.initializer) this.walk(field.initializer, location);
+    }
+    if (classDecl.constructor?.params) {
+      this.checkParams(classDecl.constructor.params, location);
+      this.walk(classDecl.constructor.body, location);
+    }
+    for (const method of classDecl.methods) {
+      this.checkParams(method.params, location);
+      // Unlike free functions, methods spell out their return type
+      if (this.containsFunction(method.returnType)) {
+        this.report(`Method '${method.name}' return value`, location);
+      }
+      this.walk(method.body, location);
+    }
+  }
+
+  private checkInterface(interfaceDecl: IRInterfaceDecl): void {
+    for (const prop of interfaceDecl.properties) {
+      if (this.containsFunction(prop.type)) {
+        this.report(`Interface property '${prop.name}'`, prop.location);
+      }
+    }
+  }
+
+  private checkConst(constDecl: IRConstDecl): void {
+    // A lambda literal is emitted as `auto`; anything else as std::function
+    if (constDecl.value.kind === 'lambda') {
+      this.walk(constDecl.value, constDecl.source);
+    } else if (this.containsFunction(constDecl.type)) {
+      this.report(`Constant '${constDecl.name}'`, constDecl.source);
+    }
+  }
+
+  private checkParams(params: IRParam[], location?: Location): void {
+    for (const param of params) {
+      if (this.containsFunction(param.type)) {
+        this.report(`Parameter '${param.name}'`, location);
+      }
+    }
+  }
+
+  private checkReturn(name: string, returnType: IRType, location?: Location): void {
+    // A returned lambda is emitted as `auto`, a function inside another type is not
+    if (returnType.kind !== 'function' && this.containsFunction(returnType)) {
+      this.report(`Function '${name}' return value`, location);
+    }
+  }
+
+  /**
+   * Visit statements, expressions and SSA instructions in either IR form,
+   * checking the declarations and lambdas nested anywhere inside them
+   */
+  private walk(node: unknown, location?: Location): void {
+    if (Array.isArray(node)) {
+      for (const child of node) this.walk(child, location);
+      return;
+    }
+    if (node === null || typeof node !== 'object') return;
+
+    const n = node as Record<string, any>;
+    const here: Location | undefined = n.location ?? n.source ?? location;
+    switch (n.kind) {
+      case 'variableDeclaration':
+        // Locals are `auto` unless their type has to be spelled out
+        if (n.variableType.kind !== 'function' && this.containsFunction(n.variableType)) {
+          this.report(`Variable '${n.name}'`, here);
+        }
+        break;
+      case 'functionDecl':
+        // Nested functions spell out their return type
+        this.checkParams(n.params, here);
+        if (this.containsFunction(n.returnType)) {
+          this.report(`Function '${n.name}' return value`, here);
+        }
+        break;
+      case 'lambda':
+        this.checkParams(n.params, here);
+        break;
+    }
+
+    for (const [key, value] of Object.entries(n)) {
+      if (!TYPE_KEYS.has(key) && key !== 'params') this.walk(value, here);
+    }
+  }
+
+  /**
+   * Would this type be emitted with a std::function anywhere inside it?
+   */
+  private containsFunction(type: IRType): boolean {
+    switch (type.kind) {
+      case 'function':
+        return true;
+      case 'array':
+        return this.containsFunction(type.element);
+      case 'map':
+        return this.containsFunction(type.key) || this.containsFunction(type.value);
+      case 'struct':
+        return type.fields.some(f => this.containsFunction(f.type));
+      case 'promise':
+        return this.containsFunction(type.resultType);
+      case 'nullable':
+        return this.containsFunction(type.inner);
+      case 'union':
+      case 'intersection':
+        return type.types.some(t => this.containsFunction(t));
+      case 'typeAlias':
+        return this.containsFunction(type.aliasedType);
+      case 'class':
+      case 'interface':
+        return (type.typeArgs ?? []).some(t => this.containsFunction(t));
+      default:
+        return false;
+    }
+  }
+
+  private report(subject: string, location?: Location): void {
+    this.diagnostics.push({
+      code: 'GS501',
+      message: `${subject} stores a closure as a function value, which --gsGc amc does not support: ` +
+        'its captures live in std::function storage the precise collector does not scan (use --gsGc mvff)',
+      severity: 'error',
+      location: {
+        file: this.modulePath,
+        line: location?.line ?? 0,
+        column: location?.column ?? 0,
+      },
+    });
+  }
+}
+
+/**
+ * Analyze a module for closures the AMC pool cannot scan
+ *
+ * @param module - The IR module to analyze
+ * @param gcPool - GC pool selected with --gsGc (checks run only for 'amc')
+ */
+export function analyzeAmcClosures(
+  module: IRModule,
+  gcPool: 'mvff' | 'amc' = 'amc'
+): AmcClosureDiagnostic[] {
+  if (gcPool !== 'amc') {
+    return [];
+  }
+  const checker = new AmcClosureChecker();
+  return checker.analyze(module);
+}
@@ -0,0 +1,206 @@
+/**
+ * Array Pipeline Fusion
+ *
+ * Evaluated eagerly, arr.map(f).filter(g).reduce(h, 0) builds a full Array
+ * after map and another after filter. This pass finds such chains so that
+ * codegen can emit them through the runtime's lazy pipeline
+ * (runtime/cpp/gs_pipeline.hpp):
+ *
+ *   gs::lazy(arr).map(f).filter(g).reduce(h, 0)
+ *
+ * which runs every callback in one loop over arr, with no intermediate
+ * arrays. A chain qualifies when it has at least two steps, every step but
+ * the last is map or filter, and every receiver is an array.
+ *
+ * Fusing changes when callbacks run: JavaScript calls f on every element of
+ * arr.map(f).some(g) before g runs once, the fused loop alternates them and
+ * stops calling f when some() finds a match. So every fused callback must be
+ * a lambda proven free of side effects (see isPureLambda), and reduce's
+ * initial value a literal or variable. The chain is fused only after the
+ * last step that fails this, which still runs eagerly.
+ *
+ * Works on both AST-level calls (call of a memberAccess) and SSA-level
+ * methodCall expressions.
+ */
+
+import type { IRBlock, IRExpr, IRExpression, IRInstruction, IRParam, IRType } from '../../ir/types.js';
+import { BinaryOp, PrimitiveType, UnaryOp } from '../../ir/types.js';
+import { isReadOnlyMethod } from './copy-elision.js';
+
+// Steps that hand elements on to the next one
+const LAZY_STEPS = new Set(['map', 'filter']);
+
+// Steps that can end a pipeline, with their argument counts
+const TERMINAL_STEPS = new Map<string, number>([
+  ['map', 1],
+  ['filter', 1],
+  ['reduce', 2],
+  ['forEach', 1],
+  ['some', 1],
+  ['every', 1],
+  ['find', 1],
+]);
+
+export interface PipelineStep<E> {
+  method: string;
+  args: E[];
+}
+
+/** A fusable chain: source.steps[0](...).steps[1](...)... */
+export interface ArrayPipeline<E> {
+  source: E;
+  /** In evaluation order */
+  steps: PipelineStep<E>[];
+  /** Ends in map or filter, so the result is collected into a new Array */
+  collects: boolean;
+}
+
+interface ArrayMethodCall<E> {
+  receiver: E;
+  method: string;
+  args: E[];
+}
+
+/** Fusable chain ending in this AST-level call, if any */
+export function findArrayPipeline(expr: IRExpression): ArrayPipeline<IRExpression> | null {
+  return findPipeline(expr, e => {
+    if (e.kind !== 'call' || e.callee.kind !== 'memberAccess') return null;
+    return { receiver: e.callee.object, method: e.callee.member, args: e.arguments };
+  });
+}
+
+/** Fusable chain ending in this SSA-level method call, if any */
+export function findArrayPipelineExpr(expr: IRExpr): ArrayPipeline<IRExpr> | null {
+  return findPipeline(expr, e => {
+    if (e.kind !== 'methodCall') return null;
+    return { receiver: e.object, method: e.method, args: e.args };
+  });
+}
+
+function findPipeline<E extends { kind: string; type: IRType }>(
+  expr: E,
+  asMethodCall: (e: E) => ArrayMethodCall<E> | null,
+): ArrayPipeline<E> | null {
+  const steps: PipelineStep<E>[] = [];
+  let current = expr;
+
+  for (let call = asMethodCall(current); call; call = asMethodCall(current)) {
+    if (call.receiver.type.kind !== 'array') break;
+    const fits = steps.length === 0
+      ? TERMINAL_STEPS.get(call.method) === call.args.length
+      : LAZY_STEPS.has(call.method) && call.args.length === 1;
+    if (!fits || !call.args.every(isFusableArgument)) break;
+    steps.unshift({ method: call.method, args: call.args });
+    current = call.receiver;
+  }
+
+  // A single step has no intermediate array to save
+  if (steps.length < 2) return null;
+  return {
+    source: current,
+    steps,
+    collects: LAZY_STEPS.has(steps[steps.length - 1].method),
+  };
+}
+
+// Built-in namespaces whose functions only compute a result (not console,
+// and not Math.random, whose sequence fusion would reorder)
+const PURE_NAMESPACES = new Set(['Math', 'JSON', 'String', 'Number', 'Boolean']);
+const IMPURE_BUILTINS = new Set(['random']);
+
+// Conversion functions called directly: Number(x), String(x), Boolean(x)
+const PURE_FUNCTIONS = new Set(['Number', 'String', 'Boolean']);
+
+interface LambdaLike {
+  kind: 'lambda';
+  params: IRParam[];
+  body: IRBlock;
+}
+
+// The callback comes first in every step; reduce's initial value follows
+function isFusableArgument(arg: { kind: string }, index: number): boolean {
+  if (index === 0) return arg.kind === 'lambda' && isPureLambda(arg as LambdaLike);
+  switch (arg.kind) {
+    case 'literal':
+    case 'identifier':
+    case 'variable':
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Does calling this lambda only compute its result? It may read anything,
+ * but assign only its own parameters and locals, and call only string
+ * methods, read-only array and map methods (with pure lambdas), and the
+ * pure built-ins. User functions, constructors and console all count as
+ * side effects. Lambda bodies are SSA-level in both IR forms.
+ */
+export function isPureLambda(lambda: LambdaLike): boolean {
+  const locals = new Set(lambda.params.map(p => p.name));
+  for (const instr of lambda.body.instructions) {
+    if (!isPureInstruction(instr, locals)) return false;
+  }
+  const terminator = lambda.body.terminator;
+  return terminator.kind === 'return' && (!terminator.value || isPureExpr(terminator.value));
+}
+
+function isPureInstruction(instr: IRInstruction, locals: Set<string>): boolean {
+  switch (instr.kind) {
+    case 'assign':
+      if (instr.isDeclaration) locals.add(instr.target.name);
+      return locals.has(instr.target.name) && isPureExpr(instr.value);
+    case 'expr':
+      return isPureExpr(instr.value);
+    default:
+      // Calls and writes through fields or indexes
+      return false;
+  }
+}
+
+function isPureExpr(expr: IRExpr): boolean {
+  switch (expr.kind) {
+    case 'literal':
+    case 'variable':
+      return true;
+    case 'binary':
+      return expr.op !== BinaryOp.Assign && isPureExpr(expr.left) && isPureExpr(expr.right);
+    case 'unary':
+      return expr.op !== UnaryOp.Await && isPureExpr(expr.operand);
+    case 'conditional':
+      return isPureExpr(expr.condition) && isPureExpr(expr.whenTrue) && isPureExpr(expr.whenFalse);
+    case 'member':
+      return isPureExpr(expr.object);
+    case 'index':
+      return isPureExpr(expr.object) && isPureExpr(expr.index);
+    case 'array':
+      return expr.elements.every(isPureExpr);
+    case 'object':
+      return expr.properties.every(p => isPureExpr(p.value));
+    case 'lambda':
+      // Creating a closure runs nothing
+      return true;
+    case 'move':
+    case 'borrow':
+      return isPureExpr(expr.source);
+    case 'methodCall':
+      return isPureMethod(expr.object, expr.method) &&
+        isPureExpr(expr.object) &&
+        expr.args.every(arg => arg.kind === 'lambda' ? isPureLambda(arg) : isPureExpr(arg));
+    case 'callExpr':
+      return expr.callee.kind === 'variable' && PURE_FUNCTIONS.has(expr.callee.name) &&
+        expr.args.every(isPureExpr);
+    default:
+      return false;
+  }
+}
+
+function isPureMethod(receiver: IRExpr, method: string): boolean {
+  if (receiver.kind === 'variable' && PURE_NAMESPACES.has(receiver.name)) {
+    return !IMPURE_BUILTINS.has(method);
+  }
+  // Strings are immutable: every string method is a read
+  if (receiver.type.kind === 'primitive' && receiver.type.type === PrimitiveType.String) return true;
+  return isReadOnlyMethod(receiver.type, method);
+}
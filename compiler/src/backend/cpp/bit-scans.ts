@@ -0,0 +1,95 @@
+/**
+ * Bit Scans
+ *
+ * In ownership mode boolean[] is a packed bitset (Array<bool> in
+ * runtime/cpp/ownership/gs_array.hpp) that counts and searches a word at a
+ * time. Callbacks that only pass the element through are rewritten to
+ * those word-level scans:
+ *
+ *   flags.some(f => f)               flags.includes(true)
+ *   flags.every(f => f)              !flags.includes(false)
+ *   flags.filter(f => !f).length     flags.countOf(false)
+ *
+ * and the same with the callback negated. The callbacks have no effects,
+ * so skipping their calls changes nothing.
+ */
+
+import type { IRExpr, IRExpression } from '../../ir/types.js';
+import { PrimitiveType, UnaryOp } from '../../ir/types.js';
+
+export interface BitScan<E> {
+  array: E;
+  /** includes(value), !includes(value) or countOf(value) */
+  scan: 'includes' | 'excludes' | 'countOf';
+  value: boolean;
+}
+
+/** arr.some(f => f), arr.every(f => !f) and the like */
+export function findBitScan(expr: IRExpression): BitScan<IRExpression> | null;
+export function findBitScan(expr: IRExpr): BitScan<IRExpr> | null;
+export function findBitScan(expr: IRExpression | IRExpr): BitScan<unknown> | null {
+  const call = methodCall(expr);
+  if (!call || (call.method !== 'some' && call.method !== 'every')) return null;
+  const passes = passedValue(call);
+  if (passes === null) return null;
+  // some: an element that passes exists; every: no element that fails does
+  return call.method === 'some'
+    ? { array: call.receiver, scan: 'includes', value: passes }
+    : { array: call.receiver, scan: 'excludes', value: !passes };
+}
+
+/** arr.filter(f => f).length and arr.filter(f => !f).length */
+export function findBitCount(expr: IRExpression): BitScan<IRExpression> | null;
+export function findBitCount(expr: IRExpr): BitScan<IRExpr> | null;
+export function findBitCount(expr: IRExpression | IRExpr): BitScan<unknown> | null {
+  let filtered: IRExpression | IRExpr;
+  if (expr.kind === 'memberAccess' && expr.member === 'length') {
+    filtered = expr.object;
+  } else if (expr.kind === 'member' && expr.member === 'length' && !expr.optional) {
+    filtered = expr.object;
+  } else {
+    return null;
+  }
+  const call = methodCall(filtered);
+  if (!call || call.method !== 'filter') return null;
+  const passes = passedValue(call);
+  return passes === null ? null : { array: call.receiver, scan: 'countOf', value: passes };
+}
+
+interface MethodCall {
+  receiver: IRExpression | IRExpr;
+  method: string;
+  args: Array<IRExpression | IRExpr>;
+}
+
+// A method call on a boolean[], AST or SSA form
+function methodCall(expr: IRExpression | IRExpr): MethodCall | null {
+  let call: MethodCall;
+  if (expr.kind === 'call' && expr.callee.kind === 'memberAccess') {
+    call = { receiver: expr.callee.object, method: expr.callee.member, args: expr.arguments };
+  } else if (expr.kind === 'methodCall') {
+    call = { receiver: expr.object, method: expr.method, args: expr.args };
+  } else {
+    return null;
+  }
+  const type = call.receiver.type;
+  if (type.kind !== 'array' || type.element.kind !== 'primitive' || type.element.type !== PrimitiveType.Boolean) {
+    return null;
+  }
+  return call;
+}
+
+// The element value the callback accepts: true for f => f, false for f => !f
+function passedValue(call: MethodCall): boolean | null {
+  const callback = call.args[0];
+  if (call.args.length !== 1 || callback.kind !== 'lambda' || callback.params.length !== 1) return null;
+  if (callback.body.instructions.length > 0) return null;
+  const result = callback.body.terminator;
+  if (result.kind !== 'return' || !result.value) return null;
+
+  const param = callback.params[0].name;
+  const isParam = (e: IRExpr) => e.kind === 'variable' && e.name === param;
+  if (isParam(result.value)) return true;
+  if (result.value.kind === 'unary' && result.value.op === UnaryOp.Not && isParam(result.value.operand)) return false;
+  return null;
+}
@@ -23,8 +23,13 @@ import type {
   IRStatement,
   IRExpression,
 } from '../../ir/types.js';
-import { Ownership, PrimitiveType, BinaryOp, type IRLiteral } from '../../ir/types.js';
+import { Ownership, PrimitiveType, BinaryOp, TYPED_ARRAY_NAMES, type IRLiteral } from '../../ir/types.js';
 import { types } from '../../ir/builder.js';
+import { findLastUseMoves, isCopiedValueType, isReadOnlyIn } from './copy-elision.js';
+import { findArrayPipeline, findArrayPipelineExpr, type ArrayPipeline } from './array-pipeline.js';
+import { findLoopKernel, findSumReduce, findValidatedIndex, type LoopKernel } from './numeric-kernels.js';
+import { findKeySort, type KeySort } from './sort-keys.js';
+import { findBitCount, findBitScan, type BitScan } from './bit-scans.js';
 
 type MemoryMode = 'ownership' | 'gc';
 
@@ -54,6 +59,16 @@ const CPP_STDLIB_NAMES = new Set([
 
 const CPP_RESERVED_KEYWORDS = new Set([...CPP_KEYWORDS, ...CPP_STDLIB_NAMES]);
 
+// Typed array and ArrayBuffer properties that are methods in C++
+const TYPED_ARRAY_PROPERTIES = new Set(['length', 'byteLength', 'byteOffset', 'buffer']);
+
+// One property of a generated type as JSON.stringify() sees it
+interface JsonMember {
+  key: string;     // JSON property name
+  member: string;  // C++ member name
+  type: IRType;
+}
+
 export class CppCodegen {
   private mode: MemoryMode;
   private sourceMap = false;
@@ -64,7 +79,15 @@ export class CppCodegen {
   private structCounter = 0;
   private isAsyncContext = false;  // Track if we're in an async function (for co_return vs return)
   private variableTypes = new Map<string, IRType>();  // Track variable types for identifier resolution
+  private validatedIndexes = new Map<string, string>();  // Typed array -> loop index known to be in range
   private currentFunctionReturnType: IRType | null = null;  // Track current function return type for nullopt returns
+  private classNames = new Set<string>();  // User classes across the program (for GC layout base chaining)
+  private interfaceDecls = new Map<string, IRInterfaceDecl>();  // Interfaces of the current module
+  private classDecls = new Map<string, IRClassDecl>();  // Classes of the current module
+  private jsonDecoders = new Set<string>();  // Interfaces JSON.parse() decodes into (gs_json_decode emitted)
+  private jsonEncoders = new Map<string, JsonMember[]>();  // Types JSON.stringify() reaches (gs_json_encode emitted)
+  private movedUses = new Set<IRExpression>();  // Last uses of locals emitted as std::move()
+  private movedDeclarations = new Set<IRStatement>();  // Their declarations (never emitted const)
 
   constructor(mode: MemoryMode = 'gc') {
     this.mode = mode;
@@ -113,6 +136,15 @@ export class CppCodegen {
     this.sourceMap = sourceMap;
     const files = new Map<string, string>();
 
+    this.classNames.clear();
+    for (const module of program.modules) {
+      for (const decl of module.declarations) {
+        if (decl.kind === 'class') {
+          this.classNames.add(decl.name);
+        }
+      }
+    }
+
     for (const module of program.modules) {
       // Get relative or base filenames for output
       const baseName = path.basename(module.path);
@@ -164,6 +196,17 @@ export class CppCodegen {
     // Reset struct registry for each module
     this.structRegistry.clear();
     this.structCounter = 0;
+    this.interfaceDecls.clear();
+    this.classDecls.clear();
+    this.jsonDecoders.clear();
+    this.jsonEncoders.clear();
+    for (const decl of module.declarations) {
+      if (decl.kind === 'interface') {
+        this.interfaceDecls.set(decl.name, decl);
+      } else if (decl.kind === 'class') {
+        this.classDecls.set(decl.name, decl);
+      }
+    }
     
     const guard = this.getIncludeGuard(module.path);
     this.emit(`#pragma once`);
@@ -171,6 +214,12 @@ export class CppCodegen {
     this.emit(`#define ${guard}`);
     this.emit('');
 
+    // cppcoro for async/await support (if module contains async functions),
+    // first so that the runtime includes its Promise support
+    if (this.moduleUsesAsync(module)) {
+      this.emit('#include <cppcoro/task.hpp>');
+    }
+
     // GoodScript runtime
     if (this.mode === 'gc') {
       this.emit('#include "runtime/cpp/gc/gs_gc_runtime.hpp"');
@@ -178,11 +227,6 @@ export class CppCodegen {
       this.emit('#include "runtime/cpp/ownership/gs_runtime.hpp"');
     }
     
-    // cppcoro for async/await support (if module contains async functions)
-    if (this.moduleUsesAsync(module)) {
-      this.emit('#include <cppcoro/task.hpp>');
-    }
-    
     this.emit('');
 
     // Module imports -> #includes
@@ -239,6 +283,16 @@ export class CppCodegen {
       this.emit('');
     }
 
+    // JSON decoders for the interfaces JSON.parse() targets
+    if (this.jsonDecoders.size > 0) {
+      this.generateJsonDecoders();
+    }
+
+    // JSON encoders for the generated types JSON.stringify() reaches
+    if (this.jsonEncoders.size > 0) {
+      this.generateJsonEncoders();
+    }
+
     // Lambda literal definitions (inline in header since they can't be forward-declared)
     // Only emit lambda literals, not function calls that return lambdas
     for (const decl of module.declarations) {
@@ -283,6 +337,15 @@ export class CppCodegen {
         }
       }
     }
+    // Or whether a top-level statement awaits or starts a promise
+    for (const stmt of module.initStatements ?? []) {
+      const expr = stmt.kind === 'expressionStatement' ? stmt.expression
+        : stmt.kind === 'variableDeclaration' ? stmt.initializer
+        : undefined;
+      if (expr && (expr.kind === 'await' || expr.type.kind === 'promise')) {
+        return true;
+      }
+    }
     return false;
   }
 
@@ -317,7 +380,7 @@ export class CppCodegen {
   private generateHeaderFunction(func: IRFunctionDecl): void {
     // For functions returning lambdas, use auto to avoid std::function overhead
     const returnType = func.returnType.kind === 'function' ? 'auto' : this.generateCppType(func.returnType);
-    const params = func.params.map(p => this.generateParam(p)).join(', ');
+    const params = this.generateParams(func.params, func.body, func.async);
     this.emit(`${returnType} ${this.sanitizeIdentifier(func.name)}(${params});`);
   }
 
@@ -330,7 +393,7 @@ export class CppCodegen {
 
     // Constructor
     if (cls.constructor) {
-      const params = cls.constructor.params.map(p => this.generateCppParam(p)).join(', ');
+      const params = this.generateParams(cls.constructor.params, cls.constructor.body);
       this.emit(`${className}(${params});`);
       this.emit('');
     }
@@ -339,7 +402,7 @@ export class CppCodegen {
     for (const method of cls.methods) {
       const staticMod = method.isStatic ? 'static ' : '';
       const returnType = this.generateCppType(method.returnType);
-      const params = method.params.map(p => this.generateParam(p)).join(', ');
+      const params = this.generateParams(method.params, method.body, method.async);
       this.emit(`${staticMod}${returnType} ${this.sanitizeIdentifier(method.name)}(${params});`);
     }
 
@@ -352,6 +415,12 @@ export class CppCodegen {
       this.emit(`${constMod}${this.generateCppType(field.type)} ${this.sanitizeIdentifier(field.name)}_;`);
     }
 
+    // Precise GC hooks (gc_layout() + GC-heap operator new); no-op unless GS_GC_AMC
+    if (this.mode === 'gc') {
+      this.emit('');
+      this.emit(`GS_GC_CLASS(${className})`);
+    }
+
     this.indent--;
     this.emit('};');
   }
@@ -376,8 +445,270 @@ export class CppCodegen {
     this.emit('');
     this.emit('virtual ~' + ifaceName + '() = default;');
 
+    // JSON.parse() allocates decoded instances with new: keep them in the GC heap
+    const decoded = this.mode === 'gc' && this.jsonDecoders.has(iface.name);
+    if (decoded) {
+      this.emit('');
+      this.emit(`GS_GC_CLASS(${ifaceName})`);
+    }
+
     this.indent--;
     this.emit('};');
+
+    if (decoded) {
+      const refFields = iface.properties
+        .filter(p => this.mayHoldGcRefs(p.type))
+        .map(p => this.sanitizeIdentifier(p.name));
+      this.generateGcLayout(ifaceName, refFields, 'nullptr', true);
+    }
+  }
+
+  /**
+   * Whether JSON.parse() can decode straight into this type: numbers,
+   * booleans, strings, arrays, T | null and method-less interfaces of this
+   * module whose properties are decodable in turn.
+   */
+  private isJsonDecodable(type: IRType, visiting = new Set<string>()): boolean {
+    switch (type.kind) {
+      case 'primitive':
+        return type.type !== PrimitiveType.Void && type.type !== PrimitiveType.Never;
+      case 'array':
+        return this.isJsonDecodable(type.element, visiting);
+      case 'nullable':
+        return this.isJsonDecodable(type.inner, visiting);
+      case 'union': {
+        const nonNullTypes = type.types.filter(t => !this.isNullType(t));
+        return nonNullTypes.length === 1 && nonNullTypes.length < type.types.length &&
+          this.isJsonDecodable(nonNullTypes[0], visiting);
+      }
+      case 'class':
+      case 'interface': {
+        const iface = this.interfaceDecls.get(type.name);
+        if (!iface || iface.methods.length > 0 || iface.extends?.length || iface.typeParams?.length) {
+          return false;
+        }
+        // Weak references cannot own a decoded instance
+        if (this.mode === 'ownership' && type.ownership === Ownership.Use) {
+          return false;
+        }
+        if (visiting.has(type.name)) {
+          return true;  // Recursive interface
+        }
+        visiting.add(type.name);
+        return iface.properties.every(p => this.isJsonDecodable(p.type, visiting));
+      }
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * Record the interfaces a decodable JSON.parse() target reaches
+   */
+  private collectJsonDecoders(type: IRType): void {
+    switch (type.kind) {
+      case 'array':
+        this.collectJsonDecoders(type.element);
+        break;
+      case 'nullable':
+        this.collectJsonDecoders(type.inner);
+        break;
+      case 'union':
+        for (const t of type.types) {
+          this.collectJsonDecoders(t);
+        }
+        break;
+      case 'class':
+      case 'interface': {
+        const iface = this.interfaceDecls.get(type.name);
+        if (iface && !this.jsonDecoders.has(type.name)) {
+          this.jsonDecoders.add(type.name);
+          for (const prop of iface.properties) {
+            this.collectJsonDecoders(prop.type);
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  /**
+   * JSON properties of a class, interface or object literal struct of this
+   * module, in JavaScript property order, or null if it has no JSON form
+   * here. Classes list inherited fields first, as the base constructor
+   * assigns them first.
+   */
+  private jsonMembers(type: IRType): { name: string; members: JsonMember[] } | null {
+    if (type.kind === 'struct') {
+      const name = this.getOrCreateStructType(type.fields);
+      const info = [...this.structRegistry.values()].find(s => s.name === name)!;
+      return {
+        name,
+        members: info.fields.map(f => ({ key: f.name, member: this.sanitizeIdentifier(f.name), type: f.type })),
+      };
+    }
+    if (type.kind !== 'class' && type.kind !== 'interface') {
+      return null;
+    }
+    // Weak references are not serialized through
+    if (this.mode === 'ownership' && type.ownership === Ownership.Use) {
+      return null;
+    }
+
+    const iface = this.interfaceDecls.get(type.name);
+    if (iface) {
+      if (iface.methods.length > 0 || iface.extends?.length || iface.typeParams?.length) {
+        return null;
+      }
+      return {
+        name: this.sanitizeIdentifier(iface.name),
+        members: iface.properties.map(p => ({ key: p.name, member: this.sanitizeIdentifier(p.name), type: p.type })),
+      };
+    }
+
+    const members: JsonMember[] = [];
+    for (let name: string | undefined = type.name; name; ) {
+      const cls = this.classDecls.get(name);
+      if (!cls || cls.typeParams?.length) {
+        return null;
+      }
+      members.unshift(...cls.fields.map(f => ({ key: f.name, member: `${this.sanitizeIdentifier(f.name)}_`, type: f.type })));
+      name = cls.extends;
+    }
+    return { name: this.sanitizeIdentifier(type.name), members };
+  }
+
+  /**
+   * Whether JSON.stringify() can encode this type with generated code:
+   * numbers, booleans, strings, arrays, T | null and classes, interfaces
+   * and object literals of this module whose properties are encodable.
+   */
+  private isJsonEncodable(type: IRType, visiting = new Set<string>()): boolean {
+    switch (type.kind) {
+      case 'primitive':
+        return type.type !== PrimitiveType.Void && type.type !== PrimitiveType.Never;
+      case 'array':
+        return this.isJsonEncodable(type.element, visiting);
+      case 'nullable':
+        return this.isJsonEncodable(type.inner, visiting);
+      case 'union': {
+        const nonNullTypes = type.types.filter(t => !this.isNullType(t));
+        return nonNullTypes.length === 1 && nonNullTypes.length < type.types.length &&
+          this.isJsonEncodable(nonNullTypes[0], visiting);
+      }
+      case 'class':
+      case 'interface':
+      case 'struct': {
+        const json = this.jsonMembers(type);
+        if (!json) {
+          return false;
+        }
+        if (visiting.has(json.name)) {
+          return true;  // Recursive type
+        }
+        visiting.add(json.name);
+        return json.members.every(m => this.isJsonEncodable(m.type, visiting));
+      }
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * Record the generated types an encodable JSON.stringify() argument reaches
+   */
+  private collectJsonEncoders(type: IRType): void {
+    switch (type.kind) {
+      case 'array':
+        this.collectJsonEncoders(type.element);
+        break;
+      case 'nullable':
+        this.collectJsonEncoders(type.inner);
+        break;
+      case 'union':
+        for (const t of type.types) {
+          this.collectJsonEncoders(t);
+        }
+        break;
+      case 'class':
+      case 'interface':
+      case 'struct': {
+        const json = this.jsonMembers(type);
+        if (json && !this.jsonEncoders.has(json.name)) {
+          this.jsonEncoders.set(json.name, json.members);
+          for (const m of json.members) {
+            this.collectJsonEncoders(m.type);
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  /**
+   * Emit gs_json_encode() for each generated type JSON.stringify() reaches.
+   * Keys and punctuation are precomputed literals; values go through the
+   * runtime overloads, found (like these) by argument-dependent lookup.
+   */
+  private generateJsonEncoders(): void {
+    for (const name of this.jsonEncoders.keys()) {
+      this.emit(`inline void gs_json_encode(gs::StringBuilder& out, const ${name}& value);`);
+    }
+    this.emit('');
+
+    for (const [name, members] of this.jsonEncoders) {
+      this.emit(`inline void gs_json_encode(gs::StringBuilder& out, const ${name}& value) {`);
+      this.indent++;
+      if (members.length === 0) {
+        this.emit('out.append("{}");');
+      } else {
+        members.forEach((m, i) => {
+          const prefix = `${i === 0 ? '{' : ','}${JSON.stringify(m.key)}:`;
+          this.emit(`out.append(${JSON.stringify(prefix)});`);
+          this.emit(`gs_json_encode(out, value.${m.member});`);
+        });
+        this.emit(`out.append('}');`);
+      }
+      this.indent--;
+      this.emit('}');
+      this.emit('');
+    }
+  }
+
+  /**
+   * Emit gs_json_decode() for each interface JSON.parse() decodes into.
+   * gs::JSON::parse<T>() finds them by argument-dependent lookup; unknown
+   * keys are skipped.
+   */
+  private generateJsonDecoders(): void {
+    for (const name of this.jsonDecoders) {
+      this.emit(`inline void gs_json_decode(gs::json::Reader& in, ${this.sanitizeIdentifier(name)}& out);`);
+    }
+    this.emit('');
+
+    for (const name of this.jsonDecoders) {
+      const iface = this.interfaceDecls.get(name)!;
+      this.emit(`inline void gs_json_decode(gs::json::Reader& in, ${this.sanitizeIdentifier(name)}& out) {`);
+      this.indent++;
+      if (iface.properties.length === 0) {
+        this.emit('in.read_object([&](std::string_view) { in.skip_value(); });');
+      } else {
+        this.emit('in.read_object([&](std::string_view key) {');
+        this.indent++;
+        iface.properties.forEach((prop, i) => {
+          this.emit(`${i === 0 ? 'if' : '} else if'} (key == ${JSON.stringify(prop.name)}) {`);
+          this.emit(`  gs_json_decode(in, out.${this.sanitizeIdentifier(prop.name)});`);
+        });
+        this.emit('} else {');
+        this.emit('  in.skip_value();');
+        this.emit('}');
+        this.indent--;
+        this.emit('});');
+      }
+      this.indent--;
+      this.emit('}');
+      this.emit('');
+    }
   }
 
   private generateHeaderConst(constDecl: any): void {
@@ -448,11 +779,31 @@ export class CppCodegen {
         this.emit(`using namespace ${this.currentNamespace.join('::')}; `);
         this.emit('');
       }
-      this.emit('// Execute top-level statements');
-      for (const stmt of module.initStatements) {
-        this.generateStatement(stmt);
+      if (this.moduleUsesAsync(module)) {
+        // One async main on one event loop: async calls run concurrently
+        // as they do in Node.js, instead of each blocking until it is done
+        this.emit('// Execute top-level statements');
+        this.emit('auto gs_main = []() -> cppcoro::task<void> {');
+        this.indent++;
+        const wasAsync = this.isAsyncContext;
+        this.isAsyncContext = true;
+        for (const stmt of module.initStatements) {
+          this.generateStatement(stmt);
+        }
+        this.isAsyncContext = wasAsync;
+        this.emit('co_return;');
+        this.indent--;
+        this.emit('};');
+        this.emit('gs::sync_wait(gs_main());');
+      } else {
+        this.emit('// Execute top-level statements');
+        for (const stmt of module.initStatements) {
+          this.generateStatement(stmt);
+        }
       }
       this.emit('');
+      this.emit('// Run pending timers to completion, as Node.js does before exiting');
+      this.emit('gs::runEventLoop();');
       this.emit('return 0;');
       this.indent--;
       this.emit('}');
@@ -485,7 +836,7 @@ export class CppCodegen {
   private generateSourceFunction(func: IRFunctionDecl): void {
     // For functions returning lambdas, use auto to avoid std::function overhead
     const returnType = func.returnType.kind === 'function' ? 'auto' : this.generateCppType(func.returnType);
-    const params = func.params.map(p => this.generateCppParam(p)).join(', ');
+    const params = this.generateParams(func.params, func.body, func.async);
     
     // Emit source location for function declaration
     this.emitSourceLocation(func.source);
@@ -507,7 +858,7 @@ export class CppCodegen {
     // Constructor implementation
     if (cls.constructor) {
       const className = this.sanitizeIdentifier(cls.name);
-      const params = cls.constructor.params.map(p => this.generateCppParam(p)).join(', ');
+      const params = this.generateParams(cls.constructor.params, cls.constructor.body);
       
       // Generate initializer list from:
       // 1. Constructor parameters that match field names
@@ -554,7 +905,7 @@ export class CppCodegen {
     for (const method of cls.methods) {
       const staticMod = method.isStatic ? '' : `${this.sanitizeIdentifier(cls.name)}::`;
       const returnType = this.generateCppType(method.returnType);
-      const params = method.params.map(p => this.generateCppParam(p)).join(', ');
+      const params = this.generateParams(method.params, method.body, method.async);
       
       // Track method return type for std::nullopt generation
       const previousReturnType = this.currentFunctionReturnType;
@@ -572,6 +923,20 @@ export class CppCodegen {
         this.emit('');
       }
     }
+
+    if (this.mode === 'gc') {
+      const className = this.sanitizeIdentifier(cls.name);
+      const refFields = cls.fields
+        .filter(f => this.mayHoldGcRefs(f.type))
+        .map(f => `${this.sanitizeIdentifier(f.name)}_`);
+      const baseLayout = cls.extends && this.classNames.has(cls.extends)
+        ? `${this.sanitizeIdentifier(cls.extends)}::gc_layout()`
+        : 'nullptr';
+      if (cls.methods.length > 0 || cls.constructor) {
+        this.emit('');
+      }
+      this.generateGcLayout(className, refFields, baseLayout, false);
+    }
   }
 
   private generateSourceConst(constDecl: any): void {
@@ -604,6 +969,56 @@ export class CppCodegen {
       : this.generateExpr(constDecl.value);
     
     this.emit(`${typeStr} ${this.sanitizeIdentifier(constDecl.name)} = ${valueExpr};`);
+
+    // Globals live outside the GC heap: register them as roots (no-op unless GS_GC_AMC)
+    if (this.mode === 'gc' && this.mayHoldGcRefs(constDecl.type)) {
+      this.emit(`GS_GC_ROOT(${this.sanitizeIdentifier(constDecl.name)});`);
+    }
+  }
+
+  /**
+   * Whether a value of this type can hold references into the GC heap.
+   * Numbers and booleans cannot; strings, arrays, class pointers etc. can.
+   */
+  private mayHoldGcRefs(type: IRType): boolean {
+    if (type.kind === 'primitive') {
+      return type.type === PrimitiveType.String;
+    }
+    if (type.kind === 'typeAlias') {
+      return this.mayHoldGcRefs(type.aliasedType);
+    }
+    return true;
+  }
+
+  /**
+   * Emit the pointer-offset table used by the precise AMC collector.
+   * Only reference-bearing fields are listed; the block compiles away
+   * unless the runtime is built with GS_GC_AMC.
+   */
+  private generateGcLayout(typeName: string, refFields: string[], baseLayout: string, inline: boolean): void {
+    const inlineMod = inline ? 'inline ' : '';
+    this.output.push('#ifdef GS_GC_AMC');
+    this.emit(`${inlineMod}const gs::gc::TypeLayout* ${typeName}::gc_layout() {`);
+    this.indent++;
+    if (refFields.length > 0) {
+      this.output.push('#pragma GCC diagnostic push');
+      this.output.push('#pragma GCC diagnostic ignored "-Winvalid-offsetof"');
+      this.emit('static const gs::gc::FieldLayout fields[] = {');
+      this.indent++;
+      for (const field of refFields) {
+        this.emit(`GS_GC_FIELD(${typeName}, ${field}),`);
+      }
+      this.indent--;
+      this.emit('};');
+      this.output.push('#pragma GCC diagnostic pop');
+      this.emit(`static const gs::gc::TypeLayout layout{fields, ${refFields.length}, ${baseLayout}, 0};`);
+    } else {
+      this.emit(`static const gs::gc::TypeLayout layout{nullptr, 0, ${baseLayout}, 0};`);
+    }
+    this.emit('return &layout;');
+    this.indent--;
+    this.emit('}');
+    this.output.push('#endif');
   }
 
   /**
@@ -617,6 +1032,9 @@ export class CppCodegen {
     // Support both old IRBlock format (from tests) and new IRFunctionBody format
     if ('statements' in body) {
       // New AST-level format
+      const moves = findLastUseMoves(body.statements);
+      moves.uses.forEach(use => this.movedUses.add(use));
+      moves.declarations.forEach(decl => this.movedDeclarations.add(decl));
       for (const stmt of body.statements) {
         this.generateStatement(stmt);
       }
@@ -660,7 +1078,8 @@ export class CppCodegen {
                             stmt.variableType.kind === 'struct';
         
         // Use const for immutable variables (const in source), but skip for object types
-        const constQualifier = (stmt.mutable === false && !isObjectType) ? 'const ' : '';
+        // Locals moved from on their last use can't be const either
+        const constQualifier = (stmt.mutable === false && !isObjectType && !this.movedDeclarations.has(stmt)) ? 'const ' : '';
         
         // Handle initializer value
         let initValue: string;
@@ -696,13 +1115,15 @@ export class CppCodegen {
         const exprCode = this.generateExpression(stmt.expression);
         if (exprCode !== 'nullptr') {
           // Check if this is a call to an async function (returns Promise/task)
-          // If so, we need to use cppcoro::sync_wait to execute it
           const isAsyncCall = stmt.expression.kind === 'call' && 
                              stmt.expression.type.kind === 'promise';
           
-          if (isAsyncCall) {
-            // Async function call at statement level needs sync_wait
-            this.emit(`cppcoro::sync_wait(${exprCode});`);
+          if (isAsyncCall && this.isAsyncContext) {
+            // Not awaited: starts it and goes on, as in JavaScript
+            this.emit(`gs::spawn(${exprCode});`);
+          } else if (isAsyncCall) {
+            // A synchronous function cannot suspend: wait for the call on the event loop
+            this.emit(`gs::sync_wait(${exprCode});`);
           } else {
             this.emit(`${exprCode};`);
           }
@@ -863,6 +1284,20 @@ export class CppCodegen {
       }
       
       case 'for': {
+        // Sum/dot/min/max scans run as one vectorized kernel call
+        const kernel = findLoopKernel(stmt);
+        if (kernel) {
+          this.emitLoopKernel(kernel);
+          break;
+        }
+
+        // In `for (i < ta.length)` over a typed array, ta[i] needs no bounds check
+        const validated = findValidatedIndex(stmt);
+        const outerIndex = validated ? this.validatedIndexes.get(validated.array) : undefined;
+        if (validated) {
+          this.validatedIndexes.set(validated.array, validated.index);
+        }
+
         // Traditional for loop: for (init; condition; increment) { body }
         const initCode = stmt.init ? this.generateStatementInline(stmt.init) : '';
         const condCode = stmt.condition ? this.generateExpression(stmt.condition) : '';
@@ -915,13 +1350,28 @@ export class CppCodegen {
           this.indent--;
           this.emit('}');
         }
+
+        if (validated) {
+          if (outerIndex === undefined) {
+            this.validatedIndexes.delete(validated.array);
+          } else {
+            this.validatedIndexes.set(validated.array, outerIndex);
+          }
+        }
         break;
       }
       
       case 'for-of': {
+        const kernel = findLoopKernel(stmt);
+        if (kernel) {
+          this.emitLoopKernel(kernel);
+          break;
+        }
+
         // Range-based for loop in C++
         const varName = this.sanitizeIdentifier(stmt.variable);
         const iterableCode = this.generateExpression(stmt.iterable);
+        const loopVar = `${this.forOfBinding(stmt)} ${varName}`;
         
         // Check for StringBuilder optimization opportunity
         const sbOpportunity = this.mode === 'gc' ? this.detectStringBuilderOpportunity(stmt.body) : null;
@@ -935,7 +1385,7 @@ export class CppCodegen {
           this.emit(`gs::StringBuilder ${sbName};`);
           
           // Generate loop with append instead of concatenation
-          this.emit(`for (auto ${varName} : ${iterableCode}) {`);
+          this.emit(`for (${loopVar} : ${iterableCode}) {`);
           this.indent++;
           
           for (let i = 0; i < stmt.body.length; i++) {
@@ -954,7 +1404,7 @@ export class CppCodegen {
           this.emit(`${this.sanitizeIdentifier(concatVarName)} = ${sbName}.toString();`);
         } else {
           // Normal for-of loop without StringBuilder optimization
-          this.emit(`for (auto ${varName} : ${iterableCode}) {`);
+          this.emit(`for (${loopVar} : ${iterableCode}) {`);
           this.indent++;
           for (const bodyStmt of stmt.body) {
             this.generateStatement(bodyStmt);
@@ -1018,6 +1468,52 @@ export class CppCodegen {
     }
   }
 
+  /**
+   * Emit a fused map/filter chain: gs::lazy(arr).map(f).filter(g).reduce(h, 0)
+   * (runtime/cpp/gs_pipeline.hpp). Chains ending in map or filter collect
+   * into a new Array with toArray().
+   */
+  private generatePipeline<E>(pipeline: ArrayPipeline<E>, generate: (e: E) => string): string {
+    let code = `gs::lazy(${generate(pipeline.source)})`;
+    for (const step of pipeline.steps) {
+      code += `.${step.method}(${step.args.map(generate).join(', ')})`;
+    }
+    return pipeline.collects ? `${code}.toArray()` : code;
+  }
+
+  /**
+   * Emit a scan loop as its vectorized kernel (runtime/cpp/gs_simd.hpp):
+   * total = gs::simd::sum(values, total);
+   */
+  /**
+   * arr[i] = value. Element stores go through set(): Arrays grow to fit,
+   * typed arrays drop out-of-range writes and convert to their element type.
+   */
+  private generateIndexStore(target: Extract<IRExpression, { kind: 'indexAccess' }>, value: IRExpression): string {
+    const obj = this.generateExpression(target.object);
+    const index = this.indexCast(target.object.type, this.generateExpression(target.index));
+    const method = this.isValidatedIndex(target) ? 'set_unchecked' : 'set';
+    return `${obj}.${method}(${index}, ${this.generateExpression(value)})`;
+  }
+
+  // Arrays index with int; typed arrays with int64_t, as a mapped file may
+  // be larger than 2 GiB
+  private indexCast(objectType: IRType, index: string): string {
+    return `static_cast<${objectType.kind === 'typedArray' ? 'int64_t' : 'int'}>(${index})`;
+  }
+
+  // ta[i] inside a loop that already checked i against ta.length
+  private isValidatedIndex(expr: Extract<IRExpression, { kind: 'indexAccess' }>): boolean {
+    return expr.object.kind === 'identifier' && expr.index.kind === 'identifier' &&
+      this.validatedIndexes.get(expr.object.name) === expr.index.name;
+  }
+
+  private emitLoopKernel(kernel: LoopKernel): void {
+    const acc = this.sanitizeIdentifier(kernel.accumulator);
+    const args = [...kernel.arrays.map(a => this.sanitizeIdentifier(a)), acc];
+    this.emit(`${acc} = gs::simd::${kernel.kernel}(${args.join(', ')});`);
+  }
+
   /**
    * Collect all parts of a string concatenation chain (AST-level IRExpression)
    */
@@ -1120,6 +1616,22 @@ export class CppCodegen {
     return null;
   }
 
+  /**
+   * Declaration of a for-of loop variable: `const auto&` when the body can
+   * change neither it nor the iterable (no per-element copy), `auto`
+   * otherwise.
+   * Numbers and booleans are cheaper to copy; async bodies keep the copy
+   * since the container may change while the coroutine is suspended.
+   */
+  private forOfBinding(stmt: Extract<IRStatement, { kind: 'for-of' }>): string {
+    const type = stmt.variableType;
+    const bindsByReference = isCopiedValueType(type) || type.kind === 'class' || type.kind === 'interface';
+    if (bindsByReference && !this.isAsyncContext && isReadOnlyIn(stmt.variable, type, stmt.body, stmt.iterable.type)) {
+      return 'const auto&';
+    }
+    return 'auto';
+  }
+
   /**
    * Detect if a loop body has string concatenation pattern that can use StringBuilder
    */
@@ -1216,9 +1728,17 @@ export class CppCodegen {
         }
       
       case 'identifier':
+        if (this.movedUses.has(expr)) {
+          return `std::move(${this.sanitizeIdentifier(expr.name)})`;
+        }
         return this.sanitizeIdentifier(expr.name);
       
       case 'binary': {
+        // arr[i] = v
+        if (expr.operator === BinaryOp.Assign && expr.left.kind === 'indexAccess') {
+          return this.generateIndexStore(expr.left, expr.right);
+        }
+
         // For equality comparisons with null and optional types, handle specially first
         if ((expr.operator === BinaryOp.Eq || expr.operator === BinaryOp.Ne)) {
           // Check if we're comparing an optional type with null
@@ -1360,16 +1880,44 @@ export class CppCodegen {
             expr.callee.object.name === 'JSON') {
           const method = expr.callee.member;
           const args = expr.arguments.map((arg: IRExpression) => this.generateExpression(arg)).join(', ');
+          // JSON.parse() with a known target type decodes straight into it
+          if (method === 'parse' && this.isJsonDecodable(expr.type)) {
+            return `gs::JSON::parse<${this.generateCppType(expr.type)}>(${args})`;
+          }
           return `gs::JSON::${method}(${args})`;
         }
         
+        // Special handling for Parallel static methods
+        if (expr.callee.kind === 'memberAccess' && 
+            expr.callee.object.kind === 'identifier' && 
+            expr.callee.object.name === 'Parallel') {
+          const method = expr.callee.member;
+          const args = expr.arguments.map((arg: IRExpression) => this.generateExpression(arg)).join(', ');
+          return `gs::Parallel::${method}(${args})`;
+        }
+        
+        // Special handling for typed array static methods (e.g., Float64Array.from)
+        if (expr.callee.kind === 'memberAccess' && 
+            expr.callee.object.kind === 'identifier' && 
+            TYPED_ARRAY_NAMES.has(expr.callee.object.name)) {
+          const className = expr.callee.object.name;
+          const method = expr.callee.member;
+          const args = expr.arguments.map((arg: IRExpression) => this.generateExpression(arg)).join(', ');
+          return `gs::${className}::${method}(${args})`;
+        }
+        
         // Special handling for Promise static methods
         if (expr.callee.kind === 'memberAccess' && 
             expr.callee.object.kind === 'identifier' && 
             expr.callee.object.name === 'Promise') {
           const method = expr.callee.member;
-          const args = expr.arguments.map((arg: IRExpression) => this.generateExpression(arg)).join(', ');
-          return `gs::Promise::${method}(${args})`;
+          // Tasks cannot be copied out of an initializer list, so the
+          // combinators take the elements of an array literal one by one
+          const [first] = expr.arguments;
+          const spread = expr.arguments.length === 1 && first.kind === 'arrayLiteral' && first.elements.length > 0;
+          const args = (spread ? first.elements : expr.arguments)
+            .map((arg: IRExpression) => this.generateExpression(arg)).join(', ');
+          return `gs::Promise<>::${method}(${args})`;
         }
         
         // Special handling for FileSystem static methods
@@ -1436,6 +1984,30 @@ export class CppCodegen {
           }
         }
         
+        // map/filter chains run as one fused loop, without intermediate arrays
+        const pipeline = findArrayPipeline(expr);
+        if (pipeline) {
+          return this.generatePipeline(pipeline, e => this.generateExpression(e));
+        }
+
+        // arr.reduce((a, b) => a + b, init) over numbers is a vectorized sum
+        const sumReduce = findSumReduce(expr);
+        if (sumReduce) {
+          return `gs::simd::sum(${this.generateExpression(sumReduce.array)}, ${this.generateExpression(sumReduce.initial)})`;
+        }
+
+        // arr.sort((a, b) => a.key - b.key) extracts each key once
+        const keySort = findKeySort(expr);
+        if (keySort) {
+          return this.generateKeySort(keySort, this.generateExpression(keySort.array));
+        }
+
+        // flags.some(f => f) on a packed boolean[] scans words
+        const bitScan = this.mode === 'ownership' ? findBitScan(expr) : null;
+        if (bitScan) {
+          return this.generateBitScan(bitScan, this.generateExpression(bitScan.array));
+        }
+        
         // Special case: if callee is memberAccess for .length() or .size(),
         // it already has () so don't add another for zero-arg calls
         if (expr.callee.kind === 'memberAccess') {
@@ -1468,6 +2040,11 @@ export class CppCodegen {
       }
       
       case 'memberAccess': {
+        // flags.filter(f => f).length on a packed boolean[] is a popcount
+        const bitCount = this.mode === 'ownership' ? findBitCount(expr) : null;
+        if (bitCount) {
+          return this.generateBitScan(bitCount, this.generateExpression(bitCount.array));
+        }
         const obj = this.generateExpression(expr.object);
         // Only sanitize actual C++ keywords (like delete), not stdlib names (like set)
         // Method names don't conflict with stdlib types
@@ -1488,9 +2065,19 @@ export class CppCodegen {
           return `gs::JSON::${member}`;
         }
         
+        // Special handling for Parallel static methods
+        if (expr.object.kind === 'identifier' && expr.object.name === 'Parallel') {
+          return `gs::Parallel::${member}`;
+        }
+        
+        // Special handling for typed array statics (Float64Array.from, Uint8Array.BYTES_PER_ELEMENT)
+        if (expr.object.kind === 'identifier' && TYPED_ARRAY_NAMES.has(expr.object.name)) {
+          return `gs::${expr.object.name}::${member}`;
+        }
+        
         // Special handling for Promise static methods
         if (expr.object.kind === 'identifier' && expr.object.name === 'Promise') {
-          return `gs::Promise::${member}`;
+          return `gs::Promise<>::${member}`;
         }
         
         // Special handling for FileSystem static methods
@@ -1541,6 +2128,10 @@ export class CppCodegen {
           const isMethodProperty = isMapOrArray || isString;
           accessExpr = isMethodProperty ? `${member}()` : member;
         }
+        // Typed array sizes are methods too
+        if (objectType.kind === 'typedArray' && TYPED_ARRAY_PROPERTIES.has(member)) {
+          accessExpr = `${member}()`;
+        }
         
         // For class fields, add underscore suffix (C++ convention to avoid keyword conflicts)
         // But don't add underscore for methods (function types)
@@ -1575,11 +2166,17 @@ export class CppCodegen {
         const index = this.generateExpression(expr.index);
         // Use safe get_or_default() method instead of operator[] to match JavaScript semantics
         // Cast index to int if it's a number type to avoid ambiguous overload
-        const finalIndex = `static_cast<int>(${index})`;
+        const finalIndex = this.indexCast(expr.object.type, index);
+        if (this.isValidatedIndex(expr)) {
+          return `${obj}.at_ref(${finalIndex})`;
+        }
         return `${obj}.get_or_default(${finalIndex})`;
       }
       
       case 'assignment': {
+        if (expr.left.kind === 'indexAccess') {
+          return this.generateIndexStore(expr.left, expr.right);
+        }
         const left = this.generateExpression(expr.left);
         const right = this.generateExpression(expr.right);
         return `(${left} = ${right})`;
@@ -1634,6 +2231,11 @@ export class CppCodegen {
           return `gs::${className}(${args})`;
         }
         
+        // Typed arrays and ArrayBuffer are value handles in both modes
+        if (expr.type.kind === 'typedArray') {
+          return `gs::${expr.type.name}(${args})`;
+        }
+        
         // For user-defined classes in GC mode, use new to allocate on heap
         if (this.mode === 'gc') {
           return `new ${className}(${args})`;
@@ -1724,7 +2326,7 @@ export class CppCodegen {
         const obj = this.generateExpr(inst.object);
         const index = this.generateExpr(inst.index);
         const value = this.generateExpr(inst.value);
-        this.emit(`${obj}.set(static_cast<int>(${index}), ${value});`);
+        this.emit(`${obj}.set(${this.indexCast(inst.object.type, index)}, ${value});`);
         break;
       }
       case 'memberAssign': {
@@ -1848,6 +2450,10 @@ export class CppCodegen {
       case 'conditional':
         return `(${this.generateExpr(expr.condition)} ? ${this.generateExpr(expr.whenTrue)} : ${this.generateExpr(expr.whenFalse)})`;
       case 'member': {
+        const bitCount = this.mode === 'ownership' ? findBitCount(expr) : null;
+        if (bitCount) {
+          return this.generateBitScan(bitCount, this.generateExpr(bitCount.array));
+        }
         const obj = this.generateExpr(expr.object);
         // Special case: console.log/error/warn -> gs::console::
         if (obj === 'console') {
@@ -1861,9 +2467,17 @@ export class CppCodegen {
         if (obj === 'JSON') {
           return `gs::JSON::${expr.member}`;
         }
+        // Special case: Parallel static methods
+        if (obj === 'Parallel') {
+          return `gs::Parallel::${expr.member}`;
+        }
+        // Special case: typed array statics
+        if (TYPED_ARRAY_NAMES.has(obj)) {
+          return `gs::${obj}::${expr.member}`;
+        }
         // Special case: Promise static methods
         if (obj === 'Promise') {
-          return `gs::Promise::${expr.member}`;
+          return `gs::Promise<>::${expr.member}`;
         }
         // Special case: FileSystem static methods
         if (obj === 'FileSystem') {
@@ -1896,6 +2510,9 @@ export class CppCodegen {
             return `${obj}.length()`;
           }
         }
+        if (objType.kind === 'typedArray' && TYPED_ARRAY_PROPERTIES.has(expr.member)) {
+          return `${obj}.${expr.member}()`;
+        }
         
         // For class types in GC mode, use -> since they're pointers
         // In ownership mode with smart pointers, also use ->
@@ -1908,7 +2525,7 @@ export class CppCodegen {
         // If index is a number (double), cast to int to avoid ambiguous overload
         const indexType = expr.index.type;
         const finalIndex = (indexType.kind === 'primitive' && indexType.type === PrimitiveType.Number) 
-          ? `static_cast<int>(${indexExpr})`
+          ? this.indexCast(expr.object.type, indexExpr)
           : indexExpr;
         
         // Use safe get_or_default() method instead of operator[] to match JavaScript semantics
@@ -1934,15 +2551,44 @@ export class CppCodegen {
           }
         }
         
+        // JSON.parse() with a known target type decodes straight into it
+        if (this.isJsonParseCallee(expr.callee) && this.isJsonDecodable(expr.type)) {
+          return `gs::JSON::parse<${this.generateCppType(expr.type)}>(${expr.args.map(a => this.generateExpr(a)).join(', ')})`;
+        }
+
         // Regular function call
         return `${this.generateExpr(expr.callee)}(${expr.args.map(a => this.generateExpr(a)).join(', ')})`;
       }      case 'methodCall': {
+        const pipeline = findArrayPipelineExpr(expr);
+        if (pipeline) {
+          return this.generatePipeline(pipeline, e => this.generateExpr(e));
+        }
+        const sumReduce = findSumReduce(expr);
+        if (sumReduce) {
+          return `gs::simd::sum(${this.generateExpr(sumReduce.array)}, ${this.generateExpr(sumReduce.initial)})`;
+        }
+        const keySort = findKeySort(expr);
+        if (keySort) {
+          return this.generateKeySort(keySort, this.generateExpr(keySort.array));
+        }
+        const bitScan = this.mode === 'ownership' ? findBitScan(expr) : null;
+        if (bitScan) {
+          return this.generateBitScan(bitScan, this.generateExpr(bitScan.array));
+        }
         const obj = this.generateExpr(expr.object);
         const args = expr.args.map(a => this.generateExpr(a)).join(', ');
         // Special case: console.log/error/warn -> gs::console::
         if (obj === 'console') {
           return `gs::console::${expr.method}(${args})`;
         }
+        // Special case: Parallel static methods
+        if (obj === 'Parallel') {
+          return `gs::Parallel::${expr.method}(${args})`;
+        }
+        // Special case: typed array static methods
+        if (TYPED_ARRAY_NAMES.has(obj)) {
+          return `gs::${obj}::${expr.method}(${args})`;
+        }
         // Special case: FileSystem and FileSystemAsync static methods
         if (obj === 'FileSystem' || obj === 'FileSystemAsync') {
           return `gs::${obj}::${expr.method}(${args})`;
@@ -2003,6 +2649,11 @@ export class CppCodegen {
       return `gs::Array<${elementType}>(${argsList})`;
     }
     
+    // Typed arrays and ArrayBuffer are value handles in both modes
+    if (type && type.kind === 'typedArray') {
+      return `gs::${type.name}(${argsList})`;
+    }
+    
     if (this.mode === 'gc') {
       // GC mode: For Error and other heap-allocated classes, use new
       // For built-in value types, use direct construction with gs:: namespace
@@ -2060,6 +2711,30 @@ export class CppCodegen {
     return `[${capture}](${params}) {\n${body}\n}`;
   }
 
+  /**
+   * arr.sortByKey(key, descending) for a comparator findKeySort recognized.
+   * The key returns a reference when it names a field, so string keys are
+   * compared in place.
+   */
+  private generateKeySort(keySort: KeySort<unknown>, array: string): string {
+    const captures = keySort.captures.map(c => this.sanitizeIdentifier(c.name)).join(', ');
+    const param = this.sanitizeIdentifier(keySort.param.name);
+    const key = `[${captures}](const auto& ${param}) -> decltype(auto) { return (${this.generateExpr(keySort.key)}); }`;
+    return `${array}.sortByKey(${key}${keySort.descending ? ', true' : ''})`;
+  }
+
+  /** Word-level Array<bool> scan for a callback findBitScan/findBitCount recognized */
+  private generateBitScan(scan: BitScan<unknown>, array: string): string {
+    switch (scan.scan) {
+      case 'includes':
+        return `${array}.includes(${scan.value})`;
+      case 'excludes':
+        return `(!${array}.includes(${scan.value}))`;
+      case 'countOf':
+        return `${array}.countOf(${scan.value})`;
+    }
+  }
+
   private generateTypeof(operand: IRExpr): string {
     // Generate runtime type checking based on static type information
     const typeStr = this.getTypeString(operand.type);
@@ -2114,6 +2789,8 @@ export class CppCodegen {
         return `gs::Array<${this.generateCppType(type.element)}>`;
       case 'map':
         return `gs::Map<${this.generateCppType(type.key)}, ${this.generateCppType(type.value)}>`;
+      case 'typedArray':
+        return `gs::${type.name}`;
       case 'promise':
         // Promise<T> → cppcoro::task<T>
         return `cppcoro::task<${this.generateCppType(type.resultType)}>`;
@@ -2213,6 +2890,23 @@ export class CppCodegen {
     return `${this.generateCppType(param.type)} ${this.sanitizeIdentifier(param.name)}`;
   }
 
+  /**
+   * Parameter list of a function, method or constructor. Strings, arrays,
+   * maps and structs the body only reads, and cannot change through an
+   * alias, are taken by const reference instead of copied. Coroutine frames
+   * would keep a reference past the caller's argument, so async parameters
+   * stay by value.
+   */
+  private generateParams(params: IRParam[], body: IRFunctionBody | IRBlock, isAsync?: boolean): string {
+    const statements = 'statements' in body && !isAsync ? body.statements : null;
+    return params.map(p => {
+      if (statements && isCopiedValueType(p.type) && isReadOnlyIn(p.name, p.type, statements, p.type, params.map(q => q.name))) {
+        return `const ${this.generateCppType(p.type)}& ${this.sanitizeIdentifier(p.name)}`;
+      }
+      return this.generateParam(p);
+    }).join(', ');
+  }
+
   // Alias for consistency
   private generateCppParam(param: IRParam): string {
     return this.generateParam(param);
@@ -2297,6 +2991,16 @@ export class CppCodegen {
     }
   }
 
+  private isJsonParseCallee(callee: IRExpr): boolean {
+    return callee.kind === 'member' && callee.member === 'parse' &&
+      callee.object.kind === 'variable' && callee.object.name === 'JSON';
+  }
+
+  private isJsonStringifyCallee(callee: IRExpr): boolean {
+    return callee.kind === 'member' && callee.member === 'stringify' &&
+      callee.object.kind === 'variable' && callee.object.name === 'JSON';
+  }
+
   private preScanExpr(expr: IRExpr): void {
     switch (expr.kind) {
       case 'binary':
@@ -2319,6 +3023,12 @@ export class CppCodegen {
         }
         break;
       case 'callExpr':
+        if (this.isJsonParseCallee(expr.callee) && this.isJsonDecodable(expr.type)) {
+          this.collectJsonDecoders(expr.type);
+        }
+        if (this.isJsonStringifyCallee(expr.callee) && expr.args.length > 0 && this.isJsonEncodable(expr.args[0].type)) {
+          this.collectJsonEncoders(expr.args[0].type);
+        }
         this.preScanExpr(expr.callee);
         for (const arg of expr.args) {
           this.preScanExpr(arg);
@@ -2469,6 +3179,16 @@ export class CppCodegen {
         this.preScanExpression(expr.right);
         break;
       case 'call':
+        if (expr.callee.kind === 'memberAccess' && expr.callee.object.kind === 'identifier' &&
+            expr.callee.object.name === 'JSON') {
+          if (expr.callee.member === 'parse' && this.isJsonDecodable(expr.type)) {
+            this.collectJsonDecoders(expr.type);
+          }
+          const arg = expr.arguments[0];
+          if (expr.callee.member === 'stringify' && arg && this.isJsonEncodable(arg.type)) {
+            this.collectJsonEncoders(arg.type);
+          }
+        }
         this.preScanExpression(expr.callee);
         for (const arg of expr.arguments || []) {
           this.preScanExpression(arg);
@@ -2624,8 +3344,17 @@ export class CppCodegen {
       for (const field of structInfo.fields) {
         this.emit(`${this.generateCppType(field.type)} ${this.sanitizeIdentifier(field.name)};`);
       }
+      if (this.mode === 'gc') {
+        this.emit(`GS_GC_CLASS(${structInfo.name})`);
+      }
       this.indent--;
       this.emit(`};`);
+      if (this.mode === 'gc') {
+        const refFields = structInfo.fields
+          .filter(f => this.mayHoldGcRefs(f.type))
+          .map(f => this.sanitizeIdentifier(f.name));
+        this.generateGcLayout(structInfo.name, refFields, 'nullptr', true);
+      }
       this.emit('');
     }
   }
@@ -0,0 +1,463 @@
+/**
+ * Copy Elision Analysis
+ *
+ * Strings, maps, object-literal structs and ownership-mode arrays are C++
+ * values (gs::String, gs::Map<K, V>, ...), so every by-value loop variable,
+ * parameter and local-to-local hand-off is a deep copy (GC-mode arrays are
+ * shared handles, where this only saves a pointer copy). This pass finds
+ * the copies nobody can observe:
+ *
+ * - for-of variables and parameters that are never reassigned and only used
+ *   through const operations can bind as const references, unless the body
+ *   could write or reallocate the storage the reference points into
+ * - a local whose last use passes it on (call argument, initializer or
+ *   assignment source) can be moved instead of copied
+ *
+ * Works on AST-level statements. Anything it cannot prove keeps the copy.
+ */
+
+import type { IRExpression, IRStatement, IRType } from '../../ir/types.js';
+import { BinaryOp, PrimitiveType } from '../../ir/types.js';
+
+// Methods that only read their receiver (const in both runtimes)
+const READ_ONLY_ARRAY_METHODS = new Set([
+  'length', 'indexOf', 'lastIndexOf', 'includes', 'slice', 'concat', 'join',
+  'map', 'filter', 'reduce', 'find', 'findIndex', 'some', 'every', 'forEach',
+  'toString',
+]);
+
+const READ_ONLY_MAP_METHODS = new Set([
+  'size', 'has', 'keys', 'values', 'entries', 'forEach',
+]);
+
+/** Does copying a value of this type copy its contents? */
+export function isCopiedValueType(type: IRType): boolean {
+  switch (type.kind) {
+    case 'primitive':
+      return type.type === PrimitiveType.String;
+    case 'array':
+    case 'map':
+    case 'struct':
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Can this for-of variable or parameter be bound by const reference?
+ * True when the body never reassigns it, for value types never mutates it
+ * in place, and cannot change the storage the reference points into.
+ *
+ * `storage` is the type of that storage: the iterable for a loop variable
+ * (a push reallocates its elements), the parameter type for a parameter
+ * (the caller may pass a field, a global or an element). The body must not
+ * assign anything that may hold such a value, other than its own locals and
+ * the `fresh` names (the other parameters), nor call anything that could:
+ * user functions, constructors, class methods, mutating methods on such
+ * containers and calls taking a lambda all keep the copy.
+ */
+export function isReadOnlyIn(
+  name: string,
+  type: IRType,
+  body: IRStatement[],
+  storage: IRType = type,
+  fresh: Iterable<string> = [],
+): boolean {
+  const locals = new Set(fresh);
+  forEachStatement(body, stmt => {
+    if (stmt.kind === 'variableDeclaration') locals.add(stmt.name);
+    if (stmt.kind === 'for-of') locals.add(stmt.variable);
+  }, () => {});
+
+  let readOnly = true;
+  forEachStatement(body, stmt => {
+    if (stmt.kind === 'assignment' &&
+        (stmt.target === name || (!locals.has(stmt.target) && mayContain(stmt.value.type, storage)))) {
+      readOnly = false;
+    }
+  }, expr => {
+    if (readOnly && (mutates(expr, name, type) || clobbers(expr, storage, locals))) {
+      readOnly = false;
+    }
+  });
+  return readOnly;
+}
+
+/** Result of findLastUseMoves() */
+export interface LastUseMoves {
+  /** Identifier nodes to emit as std::move(name) */
+  uses: Set<IRExpression>;
+  /** Declarations of the moved locals (must not be emitted const) */
+  declarations: Set<IRStatement>;
+}
+
+/**
+ * Finds locals whose last use can move instead of copy.
+ *
+ * A local qualifies when it is declared in a statement list, holds a copied
+ * value type, is not captured by any lambda or nested function, and the last
+ * statement of that list referring to it is a plain statement (not a loop or
+ * branch) that uses it exactly once: as a call argument, an initializer or
+ * the source of an assignment. Returning a local is left to the compiler,
+ * which already moves it.
+ */
+export function findLastUseMoves(body: IRStatement[], result?: LastUseMoves): LastUseMoves {
+  const moves = result ?? { uses: new Set<IRExpression>(), declarations: new Set<IRStatement>() };
+
+  for (let i = 0; i < body.length; i++) {
+    const decl = body[i];
+    if (decl.kind === 'variableDeclaration' && isCopiedValueType(decl.variableType)) {
+      const use = findMovableLastUse(decl.name, body.slice(i + 1));
+      if (use) {
+        moves.uses.add(use);
+        moves.declarations.add(decl);
+      }
+    }
+    forEachNestedList(decl, list => findLastUseMoves(list, moves));
+  }
+  return moves;
+}
+
+function findMovableLastUse(name: string, rest: IRStatement[]): IRExpression | null {
+  let last = -1;
+  for (let i = 0; i < rest.length; i++) {
+    if (countReferences(rest[i], name) > 0) last = i;
+    if (isCapturedIn(rest[i], name)) return null;
+  }
+  if (last < 0) return null;
+
+  const stmt = rest[last];
+  if (countReferences(stmt, name) !== 1) return null;
+
+  switch (stmt.kind) {
+    case 'variableDeclaration':
+      return stmt.initializer ? sinkUse(stmt.initializer, name) : null;
+    case 'assignment':
+      return sinkUse(stmt.value, name);
+    case 'expressionStatement':
+      return sinkUse(stmt.expression, name);
+    case 'return':
+      // `return name;` already moves; only look inside larger expressions
+      return stmt.value && stmt.value.kind !== 'identifier' ? sinkUse(stmt.value, name) : null;
+    default:
+      return null;
+  }
+}
+
+// The identifier node for name if expr hands it off whole: expr itself, an
+// argument of the outer call, or the source of the outer assignment
+function sinkUse(expr: IRExpression, name: string): IRExpression | null {
+  if (isIdentifier(expr, name)) return expr;
+  switch (expr.kind) {
+    case 'call':
+    case 'newExpression':
+      return expr.arguments.find(arg => isIdentifier(arg, name)) ?? null;
+    case 'assignment':
+      return isIdentifier(expr.right, name) ? expr.right : null;
+    case 'binary':
+      return expr.operator === BinaryOp.Assign && isIdentifier(expr.right, name) ? expr.right : null;
+    default:
+      return null;
+  }
+}
+
+// Does expr reassign name or (for value types) mutate it in place?
+function mutates(expr: IRExpression, name: string, type: IRType): boolean {
+  const valueType = isCopiedValueType(type);
+  switch (expr.kind) {
+    case 'assignment':
+      return writesTo(expr.left, name, valueType);
+    case 'binary':
+      return expr.operator === BinaryOp.Assign && writesTo(expr.left, name, valueType);
+    case 'call': {
+      if (!valueType || expr.callee.kind !== 'memberAccess') return false;
+      const receiver = expr.callee.object;
+      if (rootName(receiver) !== name) return false;
+      // Strings are immutable: every string method is a read
+      if (receiver.type.kind === 'primitive' && receiver.type.type === PrimitiveType.String) return false;
+      return !(isIdentifier(receiver, name) && isReadOnlyMethod(type, expr.callee.member));
+    }
+    default:
+      return false;
+  }
+}
+
+// Built-in namespaces whose functions never touch program values
+const PURE_NAMESPACES = new Set(['console', 'Math', 'JSON', 'String', 'Number', 'Boolean']);
+
+// Could expr write, free or reallocate a value of the storage type?
+function clobbers(expr: IRExpression, storage: IRType, locals: Set<string>): boolean {
+  switch (expr.kind) {
+    case 'assignment':
+      return writesInto(expr.left, storage, locals);
+    case 'binary':
+      return expr.operator === BinaryOp.Assign && writesInto(expr.left, storage, locals);
+    case 'newExpression':
+      return true;
+    case 'call': {
+      if (expr.arguments.some(arg => arg.kind === 'lambda')) return true;
+      if (expr.callee.kind !== 'memberAccess') return true;
+      const receiver = expr.callee.object;
+      if (receiver.kind === 'identifier' && PURE_NAMESPACES.has(receiver.name)) return false;
+      if (receiver.type.kind === 'primitive' && receiver.type.type === PrimitiveType.String) return false;
+      if (isReadOnlyMethod(receiver.type, expr.callee.member)) return false;
+      return mayContain(receiver.type, storage);
+    }
+    default:
+      return false;
+  }
+}
+
+// Assigning a variable replaces its value; writing a field or element
+// changes every container along the chain
+function writesInto(target: IRExpression, storage: IRType, locals: Set<string>): boolean {
+  if (target.kind === 'identifier') {
+    return !locals.has(target.name) && mayContain(target.type, storage);
+  }
+  let e = target;
+  while (e.kind === 'memberAccess' || e.kind === 'indexAccess') {
+    if (mayContain(e.object.type, storage)) return true;
+    e = e.object;
+  }
+  return false;
+}
+
+// Can a value of type outer hold (or be) a value of type inner? Classes,
+// interfaces and closures may hold anything.
+function mayContain(outer: IRType, inner: IRType): boolean {
+  if (sameType(outer, inner)) return true;
+  switch (outer.kind) {
+    case 'primitive':
+    case 'typedArray':
+      return false;
+    case 'array':
+      return mayContain(outer.element, inner);
+    case 'map':
+      return mayContain(outer.key, inner) || mayContain(outer.value, inner);
+    case 'struct':
+      return outer.fields.some(f => mayContain(f.type, inner));
+    case 'nullable':
+      return mayContain(outer.inner, inner);
+    case 'union':
+    case 'intersection':
+      return outer.types.some(t => mayContain(t, inner));
+    case 'typeAlias':
+      return mayContain(outer.aliasedType, inner);
+    default:
+      return true;
+  }
+}
+
+// Structural type equality, ignoring ownership annotations
+function sameType(a: IRType, b: IRType): boolean {
+  if (a.kind === 'typeAlias') return sameType(a.aliasedType, b);
+  if (b.kind === 'typeAlias') return sameType(a, b.aliasedType);
+  switch (a.kind) {
+    case 'primitive':
+      return b.kind === 'primitive' && a.type === b.type;
+    case 'array':
+      return b.kind === 'array' && sameType(a.element, b.element);
+    case 'map':
+      return b.kind === 'map' && sameType(a.key, b.key) && sameType(a.value, b.value);
+    case 'struct':
+      return b.kind === 'struct' && a.fields.length === b.fields.length &&
+        a.fields.every((f, i) => f.name === b.fields[i].name && sameType(f.type, b.fields[i].type));
+    case 'typedArray':
+      return b.kind === 'typedArray' && a.name === b.name;
+    case 'nullable':
+      return b.kind === 'nullable' && sameType(a.inner, b.inner);
+    default:
+      // Classes, interfaces, closures: mayContain() already assumes the worst
+      return a.kind === b.kind;
+  }
+}
+
+function writesTo(target: IRExpression, name: string, valueType: boolean): boolean {
+  if (isIdentifier(target, name)) return true;
+  // Writing a field or element through a pointer leaves the pointer unchanged
+  return valueType && rootName(target) === name;
+}
+
+/** Does this array or map method leave its receiver unchanged? */
+export function isReadOnlyMethod(type: IRType, method: string): boolean {
+  if (type.kind === 'array') return READ_ONLY_ARRAY_METHODS.has(method);
+  if (type.kind === 'map') {
+    // The ownership Map returns a pointer into itself from get()
+    if (method === 'get') return type.value.kind === 'primitive';
+    return READ_ONLY_MAP_METHODS.has(method);
+  }
+  return false;
+}
+
+function isIdentifier(expr: IRExpression, name: string): boolean {
+  return expr.kind === 'identifier' && expr.name === name;
+}
+
+// Variable at the base of a member/index/call chain (x in x.a[i].get(k)),
+// whose storage the chain may still point into
+function rootName(expr: IRExpression): string | null {
+  switch (expr.kind) {
+    case 'identifier':
+      return expr.name;
+    case 'memberAccess':
+    case 'indexAccess':
+      return rootName(expr.object);
+    case 'call':
+      return expr.callee.kind === 'memberAccess' ? rootName(expr.callee.object) : null;
+    default:
+      return null;
+  }
+}
+
+function countReferences(stmt: IRStatement, name: string): number {
+  let count = 0;
+  forEachStatement([stmt], () => {}, expr => {
+    if (isIdentifier(expr, name)) count++;
+  });
+  return count;
+}
+
+// Captured by a lambda or referenced from a nested function (which captures
+// by reference and may run after the last visible use)
+function isCapturedIn(stmt: IRStatement, name: string): boolean {
+  let captured = false;
+  forEachStatement([stmt], s => {
+    if (s.kind === 'functionDecl' && s.body.statements.some(inner => countReferences(inner, name) > 0)) {
+      captured = true;
+    }
+  }, expr => {
+    if (expr.kind === 'lambda' && expr.captures.some(c => c.name === name)) {
+      captured = true;
+    }
+  });
+  return captured;
+}
+
+/** Statement lists directly nested in stmt (branches, loop and block bodies) */
+function forEachNestedList(stmt: IRStatement, visit: (list: IRStatement[]) => void): void {
+  switch (stmt.kind) {
+    case 'if':
+      visit(stmt.thenBranch);
+      if (stmt.elseBranch) visit(stmt.elseBranch);
+      break;
+    case 'while':
+    case 'for':
+    case 'for-of':
+      visit(stmt.body);
+      break;
+    case 'switch':
+      for (const c of stmt.cases) visit(c.body);
+      break;
+    case 'try':
+      visit(stmt.tryBlock);
+      if (stmt.catchClause) visit(stmt.catchClause.body);
+      if (stmt.finallyBlock) visit(stmt.finallyBlock);
+      break;
+    case 'block':
+      visit(stmt.statements);
+      break;
+    case 'functionDecl':
+      visit(stmt.body.statements);
+      break;
+  }
+}
+
+/**
+ * Visits every statement and expression in body, recursively, including
+ * nested function bodies. Lambda bodies are SSA-level and not visited;
+ * lambdas capture by value, so they can neither mutate nor outlive a
+ * reference.
+ */
+function forEachStatement(
+  body: IRStatement[],
+  visitStmt: (stmt: IRStatement) => void,
+  visitExpr: (expr: IRExpression) => void,
+): void {
+  const expr = (e: IRExpression | undefined | null) => {
+    if (e) forEachExpression(e, visitExpr);
+  };
+  for (const stmt of body) {
+    visitStmt(stmt);
+    switch (stmt.kind) {
+      case 'variableDeclaration':
+        expr(stmt.initializer);
+        break;
+      case 'assignment':
+        expr(stmt.value);
+        break;
+      case 'expressionStatement':
+      case 'throw':
+        expr(stmt.expression);
+        break;
+      case 'return':
+        expr(stmt.value);
+        break;
+      case 'if':
+      case 'while':
+        expr(stmt.condition);
+        break;
+      case 'switch':
+        expr(stmt.expression);
+        for (const c of stmt.cases) {
+          if (c.values !== 'default') c.values.forEach(expr);
+        }
+        break;
+      case 'for':
+        if (stmt.init) forEachStatement([stmt.init], visitStmt, visitExpr);
+        expr(stmt.condition);
+        expr(stmt.increment);
+        break;
+      case 'for-of':
+        expr(stmt.iterable);
+        break;
+    }
+    forEachNestedList(stmt, list => forEachStatement(list, visitStmt, visitExpr));
+  }
+}
+
+function forEachExpression(expr: IRExpression, visit: (expr: IRExpression) => void): void {
+  visit(expr);
+  const sub = (e: IRExpression) => forEachExpression(e, visit);
+  switch (expr.kind) {
+    case 'binary':
+      sub(expr.left);
+      sub(expr.right);
+      break;
+    case 'unary':
+      sub(expr.operand);
+      break;
+    case 'call':
+      sub(expr.callee);
+      expr.arguments.forEach(sub);
+      break;
+    case 'memberAccess':
+      sub(expr.object);
+      break;
+    case 'indexAccess':
+      sub(expr.object);
+      sub(expr.index);
+      break;
+    case 'assignment':
+      sub(expr.left);
+      sub(expr.right);
+      break;
+    case 'arrayLiteral':
+      expr.elements.forEach(sub);
+      break;
+    case 'objectLiteral':
+      for (const p of expr.properties) sub(p.value);
+      break;
+    case 'newExpression':
+      expr.arguments.forEach(sub);
+      break;
+    case 'conditional':
+      sub(expr.condition);
+      sub(expr.thenExpr);
+      sub(expr.elseExpr);
+      break;
+    case 'await':
+      sub(expr.expression);
+      break;
+  }
+}
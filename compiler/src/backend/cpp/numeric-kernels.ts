@@ -0,0 +1,294 @@
+/**
+ * Numeric Kernels
+ *
+ * Scans over Array<number>, Array<integer>, Array<integer53> and
+ * Float64Array that the runtime has vectorized kernels for
+ * (runtime/cpp/gs_simd.hpp). This pass
+ * recognizes them so that codegen can emit one kernel call instead of the
+ * loop:
+ *
+ *   for (const x of values) { total = total + x; }     total = gs::simd::sum(values, total);
+ *   for (let i = 0; i < a.length; i = i + 1) {         dot = gs::simd::dot(a, b, dot);
+ *     dot = dot + a[i] * b[i];
+ *   }
+ *   for (const x of values) { if (x > best) best = x; }  best = gs::simd::max(values, best);
+ *   for (const x of values) { best = Math.min(best, x); }  best = gs::simd::min(values, best);
+ *   values.reduce((a, b) => a + b, 0)                   gs::simd::sum(values, 0)
+ *
+ * A loop qualifies when its body is that single statement, the arrays are
+ * plain variables, and the accumulator is a variable of the element type.
+ * Each kernel returns what the loop computes, so max/min only match the
+ * argument orders whose NaN and ±0 behaviour the kernels reproduce.
+ */
+
+import type { IRExpr, IRExpression, IRStatement, IRType } from '../../ir/types.js';
+import { BinaryOp, PrimitiveType } from '../../ir/types.js';
+
+// Element types with kernels
+const KERNEL_ELEMENTS = new Set<string>([
+  PrimitiveType.Number,
+  PrimitiveType.Integer,
+  PrimitiveType.Integer53,
+]);
+
+export type KernelName = 'sum' | 'dot' | 'max' | 'min';
+
+/** accumulator = gs::simd::<kernel>(...arrays, accumulator) */
+export interface LoopKernel {
+  kernel: KernelName;
+  accumulator: string;
+  /** The arrays scanned, the loop's own array first */
+  arrays: string[];
+}
+
+type ForStatement = Extract<IRStatement, { kind: 'for' }>;
+type ForOfStatement = Extract<IRStatement, { kind: 'for-of' }>;
+
+/** How the loop body reads the element at the current position */
+interface LoopShape {
+  array: string;
+  elementType: string;
+  /** Array read by an element expression, or null if it is not one */
+  elementOf: (e: IRExpression) => string | null;
+  /** Names the body may not accumulate into */
+  loopVariable: string;
+}
+
+/** Kernel computing this for or for-of loop, if any */
+export function findLoopKernel(stmt: ForStatement | ForOfStatement): LoopKernel | null {
+  const shape = stmt.kind === 'for' ? forShape(stmt) : forOfShape(stmt);
+  if (!shape) return null;
+  const body = singleStatement(stmt.body);
+  if (!body) return null;
+  return matchBody(body, shape);
+}
+
+/**
+ * Array scanned by arr.reduce((a, b) => a + b, init) over numeric elements,
+ * if this is one. Works on both AST-level calls and SSA-level methodCalls.
+ */
+export function findSumReduce(expr: IRExpression): { array: IRExpression; initial: IRExpression } | null;
+export function findSumReduce(expr: IRExpr): { array: IRExpr; initial: IRExpr } | null;
+export function findSumReduce(expr: IRExpression | IRExpr): { array: unknown; initial: unknown } | null {
+  let receiver: IRExpression | IRExpr;
+  let args: Array<IRExpression | IRExpr>;
+  if (expr.kind === 'call' && expr.callee.kind === 'memberAccess' && expr.callee.member === 'reduce') {
+    receiver = expr.callee.object;
+    args = expr.arguments;
+  } else if (expr.kind === 'methodCall' && expr.method === 'reduce') {
+    receiver = expr.object;
+    args = expr.args;
+  } else {
+    return null;
+  }
+
+  const elementType = kernelElement(receiver.type);
+  const callback = args[0];
+  if (!elementType || args.length !== 2 || callback.kind !== 'lambda') return null;
+  const [a, b] = callback.params;
+  if (callback.params.length !== 2 || callback.body.instructions.length > 0) return null;
+  if (primitiveOf(a.type) !== elementType || primitiveOf(b.type) !== elementType) return null;
+
+  const result = callback.body.terminator;
+  if (result.kind !== 'return' || !result.value) return null;
+  const sum = result.value;
+  if (sum.kind !== 'binary' || sum.op !== BinaryOp.Add) return null;
+  const names = [sum.left, sum.right].map(e => (e.kind === 'variable' ? e.name : null));
+  const addsParams = (names[0] === a.name && names[1] === b.name) || (names[0] === b.name && names[1] === a.name);
+  return addsParams ? { array: receiver, initial: args[1] } : null;
+}
+
+/**
+ * Typed array and index of a `for (let i = 0; i < a.length; i = i + 1)` loop
+ * whose body reassigns neither. A typed array never changes length, so a[i]
+ * in that body is in range and codegen can skip the bounds check.
+ */
+export function findValidatedIndex(stmt: ForStatement): { array: string; index: string } | null {
+  const init = stmt.init;
+  if (!init || init.kind !== 'variableDeclaration') return null;
+  if (init.initializer?.kind !== 'literal' || init.initializer.value !== 0) return null;
+  const index = init.name;
+
+  const cond = stmt.condition;
+  if (cond?.kind !== 'binary' || cond.operator !== BinaryOp.Lt || !isIdentifier(cond.left, index)) return null;
+  const bound = cond.right;
+  if (bound.kind !== 'memberAccess' || bound.member !== 'length' || bound.object.kind !== 'identifier') return null;
+  if (bound.object.type.kind !== 'typedArray' || bound.object.type.name === 'ArrayBuffer') return null;
+  if (!isIncrement(stmt.increment, index)) return null;
+
+  const array = bound.object.name;
+  return writesAny(stmt.body, new Set([array, index])) ? null : { array, index };
+}
+
+// Whether a statement or expression tree may write or shadow one of names
+function writesAny(node: unknown, names: ReadonlySet<string>): boolean {
+  if (Array.isArray(node)) return node.some(n => writesAny(n, names));
+  if (!node || typeof node !== 'object') return false;
+  const n = node as Record<string, unknown>;
+  const declares = (name: unknown) => typeof name === 'string' && names.has(name);
+  const targets = (e: unknown) => (e as IRExpression).kind === 'identifier' && declares((e as { name: string }).name);
+
+  // A nested function could write through a capture at any time
+  if (n.kind === 'lambda' || n.kind === 'functionDecl') return true;
+  if (n.kind === 'variableDeclaration' && declares(n.name)) return true;
+  if (n.kind === 'assignment' && (declares(n.target) || targets(n.left))) return true;
+  if (n.kind === 'binary' && n.operator === BinaryOp.Assign && targets(n.left)) return true;
+  // for-of and catch bindings
+  if (declares(n.variable)) return true;
+
+  for (const [key, value] of Object.entries(n)) {
+    if (key !== 'type' && key !== 'variableType' && writesAny(value, names)) return true;
+  }
+  return false;
+}
+
+function forShape(stmt: ForStatement): LoopShape | null {
+  // for (let i = 0; i < a.length; i = i + 1)
+  const init = stmt.init;
+  if (!init || init.kind !== 'variableDeclaration') return null;
+  if (init.initializer?.kind !== 'literal' || init.initializer.value !== 0) return null;
+  const index = init.name;
+
+  const cond = stmt.condition;
+  if (cond?.kind !== 'binary' || cond.operator !== BinaryOp.Lt || !isIdentifier(cond.left, index)) return null;
+  const bound = cond.right;
+  if (bound.kind !== 'memberAccess' || bound.member !== 'length' || bound.object.kind !== 'identifier') return null;
+  const array = bound.object.name;
+  const elementType = kernelElement(bound.object.type);
+  if (!elementType || !isIncrement(stmt.increment, index)) return null;
+
+  return {
+    array,
+    elementType,
+    loopVariable: index,
+    elementOf: e => {
+      if (e.kind !== 'indexAccess' || !isIdentifier(e.index, index) || e.object.kind !== 'identifier') return null;
+      return kernelElement(e.object.type) === elementType ? e.object.name : null;
+    },
+  };
+}
+
+function forOfShape(stmt: ForOfStatement): LoopShape | null {
+  if (stmt.iterable.kind !== 'identifier') return null;
+  const array = stmt.iterable.name;
+  const elementType = kernelElement(stmt.iterable.type);
+  if (!elementType) return null;
+  return {
+    array,
+    elementType,
+    loopVariable: stmt.variable,
+    elementOf: e => (isIdentifier(e, stmt.variable) ? array : null),
+  };
+}
+
+// i = i + 1, as a binary assignment or an assignment expression
+function isIncrement(expr: IRExpression | undefined, index: string): boolean {
+  if (!expr) return false;
+  let target: IRExpression;
+  let value: IRExpression;
+  if (expr.kind === 'binary' && expr.operator === BinaryOp.Assign) {
+    [target, value] = [expr.left, expr.right];
+  } else if (expr.kind === 'assignment') {
+    [target, value] = [expr.left, expr.right];
+  } else {
+    return false;
+  }
+  return isIdentifier(target, index) &&
+    value.kind === 'binary' && value.operator === BinaryOp.Add &&
+    isIdentifier(value.left, index) && value.right.kind === 'literal' && value.right.value === 1;
+}
+
+function matchBody(stmt: IRStatement, shape: LoopShape): LoopKernel | null {
+  // if (x > acc) acc = x;  /  if (acc < x) acc = x;  (and min)
+  if (stmt.kind === 'if') {
+    if (stmt.elseBranch && stmt.elseBranch.length > 0) return null;
+    const update = singleStatement(stmt.thenBranch);
+    const cond = stmt.condition;
+    if (!update || update.kind !== 'assignment' || cond.kind !== 'binary') return null;
+    const acc = update.target;
+    if (!isAccumulator(acc, shape) || shape.elementOf(update.value) !== shape.array) return null;
+
+    let elementFirst: boolean;
+    if (isAccumulatorRef(cond.right, acc, shape) && sameElement(cond.left, update.value, shape)) {
+      elementFirst = true;
+    } else if (isAccumulatorRef(cond.left, acc, shape) && sameElement(cond.right, update.value, shape)) {
+      elementFirst = false;
+    } else {
+      return null;
+    }
+    const greater = cond.operator === BinaryOp.Gt ? elementFirst : cond.operator === BinaryOp.Lt ? !elementFirst : null;
+    if (greater === null) return null;
+    return { kernel: greater ? 'max' : 'min', accumulator: acc, arrays: [shape.array] };
+  }
+
+  if (stmt.kind !== 'assignment' || !isAccumulator(stmt.target, shape)) return null;
+  const acc = stmt.target;
+  const value = stmt.value;
+
+  // acc = Math.max(acc, x)  /  acc = Math.min(acc, x)
+  if (value.kind === 'call' && value.callee.kind === 'memberAccess' &&
+      isIdentifier(value.callee.object, 'Math') && value.arguments.length === 2) {
+    const kernel = value.callee.member;
+    const [first, second] = value.arguments;
+    if ((kernel !== 'max' && kernel !== 'min') || !isAccumulatorRef(first, acc, shape)) return null;
+    return shape.elementOf(second) === shape.array ? { kernel, accumulator: acc, arrays: [shape.array] } : null;
+  }
+
+  // acc = acc + x  /  acc = acc + a[i] * b[i]
+  if (value.kind !== 'binary' || value.operator !== BinaryOp.Add) return null;
+  const term = isAccumulatorRef(value.left, acc, shape) ? value.right
+    : isAccumulatorRef(value.right, acc, shape) ? value.left
+    : null;
+  if (!term) return null;
+  if (shape.elementOf(term) === shape.array) {
+    return { kernel: 'sum', accumulator: acc, arrays: [shape.array] };
+  }
+  if (term.kind !== 'binary' || term.operator !== BinaryOp.Mul) return null;
+  const factors = [shape.elementOf(term.left), shape.elementOf(term.right)];
+  if (factors[0] === null || factors[1] === null) return null;
+  // The loop runs over its own array: put it first, as gs::simd::dot expects
+  if (factors[0] === shape.array) {
+    return { kernel: 'dot', accumulator: acc, arrays: [shape.array, factors[1]] };
+  }
+  if (factors[1] === shape.array) {
+    return { kernel: 'dot', accumulator: acc, arrays: [shape.array, factors[0]] };
+  }
+  return null;
+}
+
+function isAccumulator(name: string, shape: LoopShape): boolean {
+  return name !== shape.loopVariable && name !== shape.array;
+}
+
+// A read of the accumulator, which must have the element type
+function isAccumulatorRef(expr: IRExpression, name: string, shape: LoopShape): boolean {
+  return isIdentifier(expr, name) && primitiveOf(expr.type) === shape.elementType;
+}
+
+function sameElement(a: IRExpression, b: IRExpression, shape: LoopShape): boolean {
+  return shape.elementOf(a) !== null && shape.elementOf(a) === shape.elementOf(b);
+}
+
+// The statement, unwrapping single-statement blocks
+function singleStatement(stmts: IRStatement[]): IRStatement | null {
+  if (stmts.length !== 1) return null;
+  const stmt = stmts[0];
+  return stmt.kind === 'block' ? singleStatement(stmt.statements) : stmt;
+}
+
+function isIdentifier(expr: IRExpression, name: string): boolean {
+  return expr.kind === 'identifier' && expr.name === name;
+}
+
+function primitiveOf(type: IRType): string | null {
+  return type.kind === 'primitive' ? type.type : null;
+}
+
+// Element type of an array with kernels, or null
+function kernelElement(type: IRType): string | null {
+  // Int32Array and Uint8Array elements read as numbers but are stored narrower
+  if (type.kind === 'typedArray') return type.name === 'Float64Array' ? PrimitiveType.Number : null;
+  if (type.kind !== 'array') return null;
+  const element = primitiveOf(type.element);
+  return element && KERNEL_ELEMENTS.has(element) ? element : null;
+}
@@ -0,0 +1,125 @@
+/**
+ * Key Sorts
+ *
+ * Array.sort comparators that compare one key of both arguments, which the
+ * runtime sorts by extracting each key once (runtime/cpp/gs_sort.hpp):
+ *
+ *   records.sort((a, b) => a.score - b.score)       records.sortByKey(<a.score>)
+ *   records.sort((a, b) => b.score - a.score)       records.sortByKey(<a.score>, true)
+ *   names.sort((a, b) => a < b ? -1 : a > b ? 1 : 0)  names.sortByKey(<a>)
+ *
+ * The key is the parameter itself or a chain of non-optional properties of
+ * it. Subtraction needs a numeric key; the three-way conditional also takes
+ * strings, and either of its comparisons may come first. Numeric keys are
+ * radix sorted, so the key order must be the comparator's: -0 equals 0 and
+ * NaN keys, which no comparator orders consistently, go last.
+ */
+
+import type { IRExpr, IRExpression, IRParam } from '../../ir/types.js';
+import { BinaryOp, PrimitiveType, UnaryOp } from '../../ir/types.js';
+
+const NUMERIC_KEYS = new Set<string>([
+  PrimitiveType.Number,
+  PrimitiveType.Integer,
+  PrimitiveType.Integer53,
+]);
+
+/** receiver.sortByKey((param) => key, descending) */
+export interface KeySort<E> {
+  array: E;
+  /** The comparator's first parameter, which key reads */
+  param: IRParam;
+  key: IRExpr;
+  captures: Array<{ name: string }>;
+  descending: boolean;
+}
+
+export function findKeySort(expr: IRExpression): KeySort<IRExpression> | null;
+export function findKeySort(expr: IRExpr): KeySort<IRExpr> | null;
+export function findKeySort(expr: IRExpression | IRExpr): KeySort<unknown> | null {
+  let receiver: IRExpression | IRExpr;
+  let args: Array<IRExpression | IRExpr>;
+  if (expr.kind === 'call' && expr.callee.kind === 'memberAccess' && expr.callee.member === 'sort') {
+    receiver = expr.callee.object;
+    args = expr.arguments;
+  } else if (expr.kind === 'methodCall' && expr.method === 'sort') {
+    receiver = expr.object;
+    args = expr.args;
+  } else {
+    return null;
+  }
+
+  const comparator = args[0];
+  if (receiver.type.kind !== 'array' || args.length !== 1 || comparator.kind !== 'lambda') return null;
+  const [a, b] = comparator.params;
+  if (comparator.params.length !== 2 || comparator.body.instructions.length > 0) return null;
+
+  const result = comparator.body.terminator;
+  if (result.kind !== 'return' || !result.value) return null;
+  const order = compareOrder(result.value, a.name, b.name);
+  if (!order) return null;
+  return { array: receiver, param: a, key: order.key, captures: comparator.captures, descending: order.descending };
+}
+
+// Key and direction of `ka - kb` or of `ka < kb ? -1 : ka > kb ? 1 : 0`
+function compareOrder(value: IRExpr, a: string, b: string): { key: IRExpr; descending: boolean } | null {
+  if (value.kind === 'binary' && value.op === BinaryOp.Sub) {
+    if (!isNumericKey(value.left)) return null;
+    if (sameKey(value.left, a, value.right, b)) return { key: value.left, descending: false };
+    if (sameKey(value.left, b, value.right, a)) return { key: value.right, descending: true };
+    return null;
+  }
+
+  if (value.kind !== 'conditional' || value.whenFalse.kind !== 'conditional') return null;
+  const inner = value.whenFalse;
+  if (signOf(inner.whenFalse) !== 0) return null;
+  const first = comparison(value.condition, a, b);
+  const second = comparison(inner.condition, a, b);
+  const firstSign = signOf(value.whenTrue);
+  const secondSign = signOf(inner.whenTrue);
+  if (!first || !second || first.aFirst === second.aFirst) return null;
+  if (!firstSign || !secondSign || firstSign === secondSign) return null;
+  if (!isNumericKey(first.key) && !isStringKey(first.key)) return null;
+  if (!sameKey(first.key, a, second.key, a)) return null;
+  // Ascending when `ka < kb` yields a negative result
+  const descending = first.aFirst === (firstSign > 0);
+  return { key: first.key, descending };
+}
+
+// `ka < kb` or `kb > ka` (aFirst), `kb < ka` or `ka > kb` (not aFirst)
+function comparison(cond: IRExpr, a: string, b: string): { key: IRExpr; aFirst: boolean } | null {
+  if (cond.kind !== 'binary' || (cond.op !== BinaryOp.Lt && cond.op !== BinaryOp.Gt)) return null;
+  const [lower, upper] = cond.op === BinaryOp.Lt ? [cond.left, cond.right] : [cond.right, cond.left];
+  if (sameKey(lower, a, upper, b)) return { key: lower, aFirst: true };
+  if (sameKey(lower, b, upper, a)) return { key: upper, aFirst: false };
+  return null;
+}
+
+// Whether x reads from root x the same path y reads from root y
+function sameKey(x: IRExpr, xRoot: string, y: IRExpr, yRoot: string): boolean {
+  if (x.kind === 'variable' && y.kind === 'variable') {
+    return x.name === xRoot && y.name === yRoot;
+  }
+  if (x.kind === 'member' && y.kind === 'member') {
+    return !x.optional && !y.optional && x.member === y.member && sameKey(x.object, xRoot, y.object, yRoot);
+  }
+  return false;
+}
+
+// -1, 0 or 1 for a numeric literal, null for anything else
+function signOf(expr: IRExpr): number | null {
+  if (expr.kind === 'unary' && expr.op === UnaryOp.Neg) {
+    const sign = signOf(expr.operand);
+    return sign === null ? null : -sign;
+  }
+  if (expr.kind !== 'literal' || typeof expr.value !== 'number' || Number.isNaN(expr.value)) return null;
+  return Math.sign(expr.value) + 0;
+}
+
+function isNumericKey(expr: IRExpr): boolean {
+  return expr.type.kind === 'primitive' && NUMERIC_KEYS.has(expr.type.type);
+}
+
+function isStringKey(expr: IRExpr): boolean {
+  return expr.type.kind === 'primitive' && expr.type.type === PrimitiveType.String;
+}
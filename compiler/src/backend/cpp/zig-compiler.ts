@@ -19,9 +19,18 @@ export interface CompileOptions {
   /** Memory mode: 'gc' or 'ownership' */
   mode: 'gc' | 'ownership';
   
+  /** GC pool (gc mode only): 'mvff' (default, conservative, never frees) or 'amc' (precise, generational) */
+  gcPool?: 'mvff' | 'amc';
+  
   /** Target triple (e.g., 'x86_64-linux-gnu', 'wasm32-wasi') */
   target?: string;
   
+  /** CPU model (e.g., 'native', 'haswell'): its vector units serve the numeric kernels without a run-time check */
+  cpu?: string;
+  
+  /** Let numeric kernels reorder floating-point sums (defines GS_FAST_MATH) */
+  fastMath?: boolean;
+  
   /** Optimization level: 0-3 or 's' (size) or 'z' (size aggressive) */
   optimize?: '0' | '1' | '2' | '3' | 's' | 'z';
   
@@ -329,6 +338,19 @@ export class ZigCompiler {
         '-c',
       ];
       
+      // Precise generational collector (MPS AMC pool)
+      if (options.mode === 'gc' && options.gcPool === 'amc') {
+        flags.push('-DGS_GC_AMC');
+      }
+
+      // Vector instructions for the numeric kernels (runtime/cpp/gs_simd.hpp)
+      if (options.cpu) {
+        flags.push(`-mcpu=${options.cpu}`);
+      }
+      if (options.fastMath) {
+        flags.push('-DGS_FAST_MATH');
+      }
+
       // Conditionally enable features
       if (options.enableFileSystem) {
         flags.push('-DGS_ENABLE_FILESYSTEM');  // Enable FileSystem API
@@ -10,6 +10,7 @@ import ts from 'typescript';
 import { CliOptions } from './options.js';
 import { Validator } from '../frontend/validator.js';
 import { IRLowering } from '../frontend/lowering.js';
+import { analyzeAmcClosures } from '../analysis/amc-closures.js';
 import { CppCodegen } from '../backend/cpp/codegen.js';
 import { ZigCompiler } from '../backend/cpp/zig-compiler.js';
 import type { CompileOptions as ZigCompileOptions } from '../backend/cpp/zig-compiler.js';
@@ -81,6 +82,19 @@ export async function compileCommand(options: CliOptions): Promise<CommandResult
         const lowering = new IRLowering();
         let irProgram = lowering.lower(program);
         
+        // AMC cannot scan closures stored as function values
+        if (options.gsTarget === 'cpp' && options.gsGc === 'amc') {
+          const closureDiagnostics = irProgram.modules
+            .filter(m => m.path === sourceFile.fileName)
+            .flatMap(m => analyzeAmcClosures(m, options.gsGc));
+          for (const diag of closureDiagnostics) {
+            errors.push(formatDiagnostic(diag, file));
+          }
+          if (closureDiagnostics.length > 0) {
+            continue; // Skip this file
+          }
+        }
+        
         // Phase 4: Optimize (if not disabled)
         const optimizeLevel = options.gsOptimize || '3';
         if (optimizeLevel !== '0') {
@@ -213,7 +227,7 @@ async function compileToBinary(
   _warnings: string[]
 ): Promise<void> {
   console.log('\n🔨 Compiling to native binary...');
-  
+
   const buildDir = path.join(options.outDir || 'dist', 'build');
   const distDir = options.outDir || 'dist';
   const vendorDir = path.join(PACKAGE_ROOT, 'vendor');
@@ -252,7 +266,10 @@ async function compileToBinary(
     sources,
     output: outputPath,
     mode: options.gsMemory || 'gc',
+    gcPool: options.gsGc,
     target: options.gsTriple,
+    cpu: options.gsCpu,
+    fastMath: options.gsFastMath,
     optimize: options.gsOptimize || (options.sourceMap ? '0' : '3'),
     buildDir,
     vendorDir,
@@ -52,6 +52,9 @@ GOODSCRIPT OPTIONS:
   --gsMemory MODE         Memory management mode (C++ only)
                           Values: gc (default), ownership
 
+  --gsGc POOL             Garbage collector pool (gc memory mode only)
+                          Values: mvff (default, conservative), amc (precise, generational)
+
   --gsCodegen             Generate C++ code only, don't compile to binary
   -o FILE                 Output binary path (C++ target only)
 
@@ -61,6 +64,12 @@ GOODSCRIPT OPTIONS:
   --gsTriple TRIPLE       Target triple for cross-compilation
                           Examples: x86_64-linux-gnu, aarch64-apple-darwin, wasm32-wasi
 
+  --gsCpu CPU             CPU model to optimize for; enables its vector instructions
+                          Examples: native, x86_64_v3, haswell, apple_m1
+
+  --gsFastMath            Let vectorized sums of numbers add in any order
+                          (faster, but results may differ in the last bits)
+
   --gsDebug               Enable debug symbols and source maps
   --gsShowIR              Print intermediate representation (for debugging)
   --gsValidateOnly        Only validate GoodScript restrictions, don't compile
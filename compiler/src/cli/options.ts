@@ -27,9 +27,12 @@ export interface CliOptions {
   // GoodScript-specific flags (--gs* prefix)
   gsTarget?: 'cpp' | 'js' | 'ts' | 'haxe';
   gsMemory?: 'gc' | 'ownership';
+  gsGc?: 'mvff' | 'amc';
   gsCodegen?: boolean;     // Only generate C++ code, don't compile to binary
   gsOptimize?: '0' | '1' | '2' | '3' | 's' | 'z';
   gsTriple?: string;
+  gsCpu?: string;          // CPU model to generate code for (e.g., native, haswell)
+  gsFastMath?: boolean;    // Let numeric kernels reorder floating-point sums
   gsShowIR?: boolean;
   gsValidateOnly?: boolean;
   gsSkipValidation?: boolean;
@@ -143,6 +146,16 @@ export function parseArguments(args: string[]): ParsedOptions {
       continue;
     }
     
+    if (arg === '--gsGc') {
+      const pool = args[++i];
+      if (!pool || !['mvff', 'amc'].includes(pool)) {
+        errors.push('--gsGc must be one of: mvff, amc');
+      } else {
+        options.gsGc = pool as 'mvff' | 'amc';
+      }
+      continue;
+    }
+    
     if (arg === '--gsCodegen') {
       options.gsCodegen = true;
       continue;
@@ -166,6 +179,19 @@ export function parseArguments(args: string[]): ParsedOptions {
       continue;
     }
     
+    if (arg === '--gsCpu') {
+      options.gsCpu = args[++i];
+      if (!options.gsCpu) {
+        errors.push('--gsCpu requires a CPU model (e.g., native, haswell, apple_m1)');
+      }
+      continue;
+    }
+    
+    if (arg === '--gsFastMath') {
+      options.gsFastMath = true;
+      continue;
+    }
+    
     if (arg === '--gsShowIR') {
       options.gsShowIR = true;
       continue;
@@ -237,9 +263,12 @@ export function loadTsConfig(projectPath?: string): Partial<CliOptions> {
       const gs = config.goodscript;
       if (gs.target) result.gsTarget = gs.target;
       if (gs.memory) result.gsMemory = gs.memory;
+      if (gs.gc) result.gsGc = gs.gc;
       if (gs.codegen !== undefined) result.gsCodegen = gs.codegen;
       if (gs.optimize !== undefined) result.gsOptimize = String(gs.optimize) as any;
       if (gs.triple) result.gsTriple = gs.triple;
+      if (gs.cpu) result.gsCpu = gs.cpu;
+      if (gs.fastMath !== undefined) result.gsFastMath = gs.fastMath;
       if (gs.outFile) result.output = gs.outFile;
     }
     
@@ -314,10 +343,22 @@ export function validateOptions(options: CliOptions): string[] {
     errors.push('--gsMemory only applies to --gsTarget cpp');
   }
   
+  if (options.gsGc && options.gsMemory === 'ownership') {
+    errors.push('--gsGc only applies to --gsMemory gc');
+  }
+  
   if (options.gsTriple && options.gsCodegen) {
     errors.push('--gsTriple requires binary compilation (incompatible with --gsCodegen)');
   }
   
+  if (options.gsCpu && options.gsCodegen) {
+    errors.push('--gsCpu requires binary compilation (incompatible with --gsCodegen)');
+  }
+  
+  if (options.gsFastMath && options.gsCodegen) {
+    errors.push('--gsFastMath requires binary compilation (incompatible with --gsCodegen)');
+  }
+  
   if (options.output && options.gsTarget !== 'cpp') {
     errors.push('-o requires --gsTarget cpp');
   }
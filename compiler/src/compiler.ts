@@ -7,6 +7,7 @@ import { Validator } from './frontend/validator.js';
 import { OwnershipAnalyzer } from './frontend/ownership-analyzer.js';
 import { NullChecker } from './frontend/null-checker.js';
 import { IRLowering } from './frontend/lowering.js';
+import { analyzeAmcClosures } from './analysis/amc-closures.js';
 import { Optimizer } from './optimizer/optimizer.js';
 import { CppCodegen } from './backend/cpp/codegen.js';
 import { ZigCompiler } from './backend/cpp/zig-compiler.js';
@@ -69,6 +70,23 @@ export async function compile(options: CompileOptions): Promise<CompileResult> {
     const lowering = new IRLowering();
     let ir = lowering.lower(program);
 
+    // AMC cannot scan closures stored as function values
+    if (options.target === 'cpp' && (options.mode ?? 'gc') === 'gc' && options.gcPool === 'amc') {
+      for (const module of ir.modules) {
+        for (const diag of analyzeAmcClosures(module, options.gcPool)) {
+          diagnostics.push({
+            code: diag.code,
+            message: diag.message,
+            severity: diag.severity,
+            location: { fileName: diag.location.file, line: diag.location.line, column: diag.location.column },
+          });
+        }
+      }
+      if (diagnostics.some(d => d.severity === 'error')) {
+        return { success: false, diagnostics };
+      }
+    }
+
     // Phase 4: Optimize
     if (options.optimize) {
       const optimizer = new Optimizer();
@@ -93,6 +111,7 @@ export async function compile(options: CompileOptions): Promise<CompileResult> {
           sources: output,
           output: options.outputBinary ?? 'a.out',
           mode: options.mode ?? 'gc',
+          gcPool: options.gcPool,
           target: options.targetTriple,
           optimize: options.optimize ? '3' : '0',
           debug: options.debug,
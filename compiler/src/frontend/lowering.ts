@@ -5,8 +5,8 @@
  */
 
 import ts from 'typescript';
-import type { IRModule, IRProgram, IRDeclaration, IRExpr, IRType, IRBlock, IRInstruction, IRTerminator, IRStatement, IRFunctionBody, IRExpression, IRMethodSignature } from '../ir/types.js';
-import { BinaryOp, UnaryOp, Ownership, PrimitiveType } from '../ir/types.js';
+import type { IRModule, IRProgram, IRDeclaration, IRExpr, IRType, IRBlock, IRInstruction, IRTerminator, IRStatement, IRFunctionBody, IRExpression, IRMethodSignature, TypedArrayName } from '../ir/types.js';
+import { BinaryOp, UnaryOp, Ownership, PrimitiveType, TYPED_ARRAY_NAMES } from '../ir/types.js';
 import { IRBuilder, types, expr, stmts } from '../ir/builder.js';
 
 export class IRLowering {
@@ -1017,7 +1017,13 @@ export class IRLowering {
 
     // Call expression
     if (ts.isCallExpression(node)) {
-      return this.lowerCallExpr(node, sourceFile);
+      const call = this.lowerCallExpr(node, sourceFile);
+      // JSON.parse() returns any: take the declared type so codegen can
+      // decode straight into it
+      if (expectedType && this.isJsonParseCall(node)) {
+        return { ...call, type: expectedType };
+      }
+      return call;
     }
 
     // Property access (including optional chaining)
@@ -1142,7 +1148,8 @@ export class IRLowering {
     const builtins = new Set([
       'console', 'Math', 'JSON', 'String', 'Number', 'Boolean',
       'Array', 'Map', 'Set', 'Object', 'Error',
-      'FileSystem', 'FileSystemAsync', 'HTTP', 'HTTPAsync',
+      'FileSystem', 'FileSystemAsync', 'HTTP', 'HTTPAsync', 'Parallel',
+      'ArrayBuffer', 'Float64Array', 'Int32Array', 'Uint8Array',
       'Promise', 'undefined', 'null', 'NaN', 'Infinity'
     ]);
 
@@ -1273,6 +1280,14 @@ export class IRLowering {
     }
   }
 
+  private isJsonParseCall(node: ts.CallExpression): boolean {
+    const callee = node.expression;
+    return ts.isPropertyAccessExpression(callee) &&
+      ts.isIdentifier(callee.expression) &&
+      callee.expression.text === 'JSON' &&
+      callee.name.text === 'parse';
+  }
+
   private lowerCallExpr(node: ts.CallExpression, sourceFile: ts.SourceFile): IRExpr {
     // Check if this is a method call (obj.method(args) or obj?.method(args))
     if (ts.isPropertyAccessExpression(node.expression)) {
@@ -1580,6 +1595,13 @@ export class IRLowering {
       return types.array(types.void());
     }
     
+    // Check for typed arrays (BEFORE general Object check!)
+    // Only the lib's declarations: a user class of the same name stays a class
+    if (tsType.symbol && TYPED_ARRAY_NAMES.has(tsType.symbol.name) &&
+        !tsType.symbol.getDeclarations()?.some(ts.isClassDeclaration)) {
+      return types.typedArray(tsType.symbol.name as TypedArrayName);
+    }
+
     // Check for Map types (BEFORE general Object check!)
     if (tsType.symbol && tsType.symbol.name === 'Map') {
       const typeArgs = (tsType as ts.TypeReference).typeArguments;
@@ -7,6 +7,7 @@
  * 1. Detects cycles in share<T> relationships (prevents memory leaks)
  * 2. Validates ownership derivation rules (prevents logic errors)
  * 3. Ensures class fields have proper ownership annotations
+ * 4. Proves Parallel.* callbacks capture no shared mutable state (GS306)
  * 
  * Rules:
  * - share<T> creates an ownership edge (A → B)
@@ -14,6 +15,9 @@
  * - own<T> → only use<T> derivation allowed
  * - share<T> → share<T> or use<T> allowed
  * - use<T> → only use<T> allowed
+ * - Parallel callbacks may read primitives from enclosing scopes but not
+ *   assign them, capture objects, arrays or maps, or use `this`; functions
+ *   they call must follow the same rules
  */
 
 import ts from 'typescript';
@@ -26,6 +30,11 @@ interface OwnershipEdge {
   location: SourceLocation;
 }
 
+// Parallel methods; each takes its callback as the second argument
+const PARALLEL_METHODS = new Set(['map', 'filter', 'reduce', 'sort']);
+
+type FunctionWithBody = ts.FunctionDeclaration | ts.FunctionExpression | ts.ArrowFunction;
+
 interface OwnershipGraph {
   nodes: Set<string>;
   edges: OwnershipEdge[];
@@ -39,6 +48,7 @@ export class OwnershipAnalyzer {
     adjacencyList: new Map(),
   };
   private diagnostics: Diagnostic[] = [];
+  private parallelChecked = new Set<ts.Node>();
 
   /**
    * Analyze a source file for ownership relationships
@@ -46,6 +56,7 @@ export class OwnershipAnalyzer {
   analyze(sourceFile: ts.SourceFile, checker: ts.TypeChecker): void {
     this.collectTypeNodes(sourceFile);
     this.collectOwnershipEdges(sourceFile, checker);
+    this.checkParallelCallbacks(sourceFile, checker);
   }
 
   /**
@@ -66,6 +77,7 @@ export class OwnershipAnalyzer {
       adjacencyList: new Map(),
     };
     this.diagnostics = [];
+    this.parallelChecked = new Set();
   }
 
   /**
@@ -198,6 +210,163 @@ export class OwnershipAnalyzer {
     });
   }
 
+  /**
+   * Check the callbacks of Parallel.map/filter/reduce/sort calls, which run
+   * concurrently on worker threads
+   */
+  private checkParallelCallbacks(sourceFile: ts.SourceFile, checker: ts.TypeChecker): void {
+    const visit = (node: ts.Node) => {
+      if (ts.isCallExpression(node) &&
+          ts.isPropertyAccessExpression(node.expression) &&
+          ts.isIdentifier(node.expression.expression) &&
+          node.expression.expression.text === 'Parallel') {
+        const method = node.expression.name.text;
+        const callback = node.arguments[1];
+        if (PARALLEL_METHODS.has(method) && callback) {
+          this.checkParallelCallback(callback, `Parallel.${method}`, sourceFile, checker);
+        }
+      }
+      ts.forEachChild(node, visit);
+    };
+    visit(sourceFile);
+  }
+
+  private checkParallelCallback(
+    callback: ts.Expression,
+    api: string,
+    sourceFile: ts.SourceFile,
+    checker: ts.TypeChecker
+  ): void {
+    if (ts.isArrowFunction(callback) || ts.isFunctionExpression(callback)) {
+      this.checkCapturedState(callback, api, checker);
+      return;
+    }
+    const decl = ts.isIdentifier(callback) ? this.resolveDeclaration(callback, checker) : undefined;
+    if (decl && ts.isFunctionDeclaration(decl)) {
+      this.checkCapturedState(decl, api, checker);
+      return;
+    }
+    this.reportParallel(callback, sourceFile,
+      `${api} callback must be a function literal or a function declaration, so that it can be checked for shared mutable state.`);
+  }
+
+  /**
+   * Report every reference in fn's body to state declared outside fn that
+   * another thread could observe or change
+   */
+  private checkCapturedState(fn: FunctionWithBody, api: string, checker: ts.TypeChecker): void {
+    if (!fn.body || this.parallelChecked.has(fn)) return;
+    this.parallelChecked.add(fn);
+    const sourceFile = fn.getSourceFile();
+
+    const visit = (node: ts.Node) => {
+      if (ts.isTypeNode(node)) return;
+      if (node.kind === ts.SyntaxKind.ThisKeyword) {
+        this.reportParallel(node, sourceFile,
+          `${api} callback uses 'this', which is shared mutable state.`);
+      } else if (ts.isIdentifier(node) && this.isReference(node)) {
+        const decl = this.resolveDeclaration(node, checker);
+        if (decl && !this.isWithin(decl, fn)) {
+          this.checkCapture(node, decl, api, checker);
+        }
+      }
+      ts.forEachChild(node, visit);
+    };
+    visit(fn.body);
+  }
+
+  private checkCapture(node: ts.Identifier, decl: ts.Declaration, api: string, checker: ts.TypeChecker): void {
+    const sourceFile = node.getSourceFile();
+
+    // Runtime APIs and type-only declarations hold no user state
+    if (decl.getSourceFile().isDeclarationFile ||
+        ts.isClassDeclaration(decl) || ts.isEnumDeclaration(decl) ||
+        ts.isInterfaceDeclaration(decl) || ts.isTypeAliasDeclaration(decl)) {
+      return;
+    }
+    // Called functions run on the same thread: check them too
+    if (ts.isFunctionDeclaration(decl)) {
+      this.checkCapturedState(decl, api, checker);
+      return;
+    }
+    if (!ts.isVariableDeclaration(decl) && !ts.isParameter(decl) && !ts.isBindingElement(decl)) {
+      return;
+    }
+
+    if (this.isWriteTarget(node)) {
+      this.reportParallel(node, sourceFile,
+        `${api} callback assigns to '${node.text}', which is shared with other threads.`);
+      return;
+    }
+    // A const function literal is checked like a function declaration
+    if (ts.isVariableDeclaration(decl) && decl.initializer &&
+        (ts.getCombinedNodeFlags(decl) & ts.NodeFlags.Const) &&
+        (ts.isArrowFunction(decl.initializer) || ts.isFunctionExpression(decl.initializer))) {
+      this.checkCapturedState(decl.initializer, api, checker);
+      return;
+    }
+    if (!this.isPrimitiveType(checker.getTypeAtLocation(node))) {
+      this.reportParallel(node, sourceFile,
+        `${api} callback captures '${node.text}', which is shared mutable state. ` +
+        `Parallel callbacks may only read primitive values from enclosing scopes.`);
+    }
+  }
+
+  private resolveDeclaration(node: ts.Identifier, checker: ts.TypeChecker): ts.Declaration | undefined {
+    let symbol = ts.isShorthandPropertyAssignment(node.parent)
+      ? checker.getShorthandAssignmentValueSymbol(node.parent)
+      : checker.getSymbolAtLocation(node);
+    if (symbol && (symbol.flags & ts.SymbolFlags.Alias)) {
+      symbol = checker.getAliasedSymbol(symbol);
+    }
+    return symbol?.declarations?.[0];
+  }
+
+  // Identifiers that name a variable, not a property or member
+  private isReference(node: ts.Identifier): boolean {
+    const parent = node.parent;
+    if (ts.isPropertyAccessExpression(parent) && parent.name === node) return false;
+    if (ts.isQualifiedName(parent) && parent.right === node) return false;
+    if ((ts.isPropertyAssignment(parent) || ts.isMethodDeclaration(parent) ||
+         ts.isPropertyDeclaration(parent)) && parent.name === node) return false;
+    return true;
+  }
+
+  private isWriteTarget(node: ts.Identifier): boolean {
+    const parent = node.parent;
+    if (ts.isBinaryExpression(parent) && parent.left === node) {
+      const op = parent.operatorToken.kind;
+      return op >= ts.SyntaxKind.FirstAssignment && op <= ts.SyntaxKind.LastAssignment;
+    }
+    if (ts.isPrefixUnaryExpression(parent) || ts.isPostfixUnaryExpression(parent)) {
+      return parent.operator === ts.SyntaxKind.PlusPlusToken ||
+             parent.operator === ts.SyntaxKind.MinusMinusToken;
+    }
+    return false;
+  }
+
+  private isPrimitiveType(type: ts.Type): boolean {
+    if (type.isUnion()) {
+      return type.types.every(t => this.isPrimitiveType(t));
+    }
+    return (type.flags & (ts.TypeFlags.NumberLike | ts.TypeFlags.StringLike |
+                          ts.TypeFlags.BooleanLike | ts.TypeFlags.BigIntLike |
+                          ts.TypeFlags.EnumLike | ts.TypeFlags.Null | ts.TypeFlags.Undefined)) !== 0;
+  }
+
+  private isWithin(decl: ts.Node, fn: ts.Node): boolean {
+    return decl.getSourceFile() === fn.getSourceFile() && decl.pos >= fn.pos && decl.end <= fn.end;
+  }
+
+  private reportParallel(node: ts.Node, sourceFile: ts.SourceFile, message: string): void {
+    this.diagnostics.push({
+      code: 'GS306',
+      severity: 'error',
+      message,
+      location: this.getLocation(node, sourceFile),
+    });
+  }
+
   /**
    * Get the containing class name
    */
@@ -17,6 +17,7 @@ import type {
   IRStatement,
   IRExpression,
   IRFunctionBody,
+  TypedArrayName,
 } from './types.js';
 import { PrimitiveType, Ownership } from './types.js';
 
@@ -114,6 +115,10 @@ export const types = {
     return { kind: 'map', key, value, ownership: ownership ?? Ownership.Value };
   },
 
+  typedArray(name: TypedArrayName): IRType {
+    return { kind: 'typedArray', name };
+  },
+
   promise(resultType: IRType): IRType {
     return { kind: 'promise', resultType };
   },
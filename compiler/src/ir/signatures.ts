@@ -167,6 +167,10 @@ export class TypeSignatureGenerator {
         result = `Map<${this.getTypeString(type.key)},${this.getTypeString(type.value)},${type.ownership}>`;
         break;
 
+      case 'typedArray':
+        result = type.name;
+        break;
+
       case 'promise':
         result = `Promise<${this.getTypeString(type.resultType)}>`;
         break;
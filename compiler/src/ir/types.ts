@@ -26,6 +26,7 @@ export type IRType =
   | { kind: 'struct'; fields: Array<{ name: string; type: IRType }>; ownership: Ownership }
   | { kind: 'array'; element: IRType; ownership: Ownership }
   | { kind: 'map'; key: IRType; value: IRType; ownership: Ownership }
+  | { kind: 'typedArray'; name: TypedArrayName }
   | { kind: 'promise'; resultType: IRType }
   | { kind: 'function'; params: IRType[]; returnType: IRType }
   | { kind: 'union'; types: IRType[] }
@@ -33,6 +34,13 @@ export type IRType =
   | { kind: 'typeAlias'; name: string; aliasedType: IRType }
   | { kind: 'nullable'; inner: IRType };
 
+/** Fixed-length binary data types (runtime/cpp/gs_typed_array.hpp) */
+export type TypedArrayName = 'ArrayBuffer' | 'Float64Array' | 'Int32Array' | 'Uint8Array';
+
+export const TYPED_ARRAY_NAMES: ReadonlySet<string> = new Set<TypedArrayName>([
+  'ArrayBuffer', 'Float64Array', 'Int32Array', 'Uint8Array',
+]);
+
 export enum PrimitiveType {
   Number = 'number',
   Integer = 'integer',
@@ -7,6 +7,9 @@ export interface CompileOptions {
   outDir?: string;
   target?: 'cpp';
   mode?: 'ownership' | 'gc';
+  
+  /** GC pool for gc mode (amc rejects closures stored as function values) */
+  gcPool?: 'mvff' | 'amc';
   optimize?: boolean;
   emit?: 'js' | 'ts' | 'both';
   skipValidation?: boolean;
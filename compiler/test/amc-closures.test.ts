@@ -0,0 +1,138 @@
+/**
+ * Tests for Phase 2d: AMC Closure Check
+ */
+
+import { describe, it, expect } from 'vitest';
+import { analyzeAmcClosures } from '../src/analysis/amc-closures.js';
+import { types } from '../src/ir/builder.js';
+import type { IRModule, IRClassDecl, IRFunctionDecl, IRType } from '../src/ir/types.js';
+
+const callback: IRType = types.function([types.number()], types.void());
+
+function createModule(declarations: IRModule['declarations']): IRModule {
+  return { path: 'test.gs', declarations, imports: [] };
+}
+
+describe('AMC Closure Check', () => {
+  describe('Stored function values (GS501)', () => {
+    it('should reject function-typed class fields', () => {
+      const emitter: IRClassDecl = {
+        kind: 'class',
+        name: 'Emitter',
+        fields: [
+          { name: 'count', type: types.number(), isReadonly: false },
+          { name: 'listener', type: callback, isReadonly: false },
+        ],
+        methods: [],
+      };
+
+      const diagnostics = analyzeAmcClosures(createModule([emitter]));
+      expect(diagnostics).toHaveLength(1);
+      expect(diagnostics[0].code).toBe('GS501');
+      expect(diagnostics[0].message).toContain("field 'listener'");
+      expect(diagnostics[0].message).toContain('--gsGc mvff');
+    });
+
+    it('should reject function-typed parameters and containers', () => {
+      const func: IRFunctionDecl = {
+        kind: 'function',
+        name: 'run',
+        params: [{ name: 'onDone', type: callback }],
+        returnType: types.void(),
+        body: {
+          statements: [
+            {
+              kind: 'variableDeclaration',
+              name: 'handlers',
+              variableType: types.array(callback),
+              location: { line: 3, column: 3 },
+            },
+          ],
+        },
+      };
+
+      const diagnostics = analyzeAmcClosures(createModule([func]));
+      expect(diagnostics.map(d => d.message.split(' stores')[0])).toEqual([
+        "Parameter 'onDone'",
+        "Variable 'handlers'",
+      ]);
+      expect(diagnostics[1].location.line).toBe(3);
+    });
+
+    it('should reject function-typed parameters of nested lambdas', () => {
+      const func: IRFunctionDecl = {
+        kind: 'function',
+        name: 'main',
+        params: [],
+        returnType: types.void(),
+        body: {
+          statements: [
+            {
+              kind: 'expressionStatement',
+              expression: {
+                kind: 'lambda',
+                params: [{ name: 'next', type: callback }],
+                body: { id: 0, instructions: [], terminator: { kind: 'return' } },
+                captures: [],
+                type: types.function([callback], types.void()),
+              },
+            },
+          ],
+        },
+      };
+
+      const diagnostics = analyzeAmcClosures(createModule([func]));
+      expect(diagnostics).toHaveLength(1);
+      expect(diagnostics[0].message).toContain("Parameter 'next'");
+    });
+  });
+
+  describe('Closures kept on the stack', () => {
+    it('should allow lambda locals, returned lambdas and try/finally', () => {
+      const func: IRFunctionDecl = {
+        kind: 'function',
+        name: 'makeAdder',
+        params: [{ name: 'n', type: types.number() }],
+        returnType: callback,
+        body: {
+          statements: [
+            {
+              kind: 'variableDeclaration',
+              name: 'add',
+              variableType: callback,
+              initializer: {
+                kind: 'lambda',
+                params: [{ name: 'x', type: types.number() }],
+                body: { id: 0, instructions: [], terminator: { kind: 'return' } },
+                captures: [{ name: 'n', type: types.number() }],
+                type: callback,
+              },
+            },
+            {
+              kind: 'try',
+              tryBlock: [],
+              finallyBlock: [],
+            },
+            {
+              kind: 'return',
+              value: { kind: 'identifier', name: 'add', type: callback },
+            },
+          ],
+        },
+      };
+
+      expect(analyzeAmcClosures(createModule([func]))).toHaveLength(0);
+    });
+
+    it('should skip the check for the MVFF pool', () => {
+      const emitter: IRClassDecl = {
+        kind: 'class',
+        name: 'Emitter',
+        fields: [{ name: 'listener', type: callback, isReadonly: false }],
+        methods: [],
+      };
+
+      expect(analyzeAmcClosures(createModule([emitter]), 'mvff')).toHaveLength(0);
+    });
+  });
+});
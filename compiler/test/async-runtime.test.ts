@@ -15,7 +15,7 @@ import type {
   IRStatement,
 } from '../src/ir/types.js';
 import * as fs from 'fs/promises';
-import { exec } from 'child_process';
+import { exec, execFileSync } from 'child_process';
 import { promisify } from 'util';
 
 const execAsync = promisify(exec);
@@ -103,3 +103,88 @@ describe('Async Runtime', () => {
     });
   });
 });
+
+// Combinators over tasks that have already settled when they are watched:
+// none of them may finish before every task is counted
+function combinatorSource(runtimeHeader: string): string {
+  return `
+#include <cppcoro/task.hpp>
+#include "${runtimeHeader}"
+#include <iostream>
+using namespace gs;
+
+static cppcoro::task<double> now(double value) {
+  co_return value;
+}
+
+static cppcoro::task<double> failNow() {
+  throw Error("rejected");
+  co_return 0;
+}
+
+static int fail(const char* what) {
+  std::cout << "FAIL " << what << std::endl;
+  return 1;
+}
+
+int main() {
+  Array<double> values = sync_wait(Promise<>::all(now(1), now(2), now(3)));
+  if (values.length() != 3 || values.at_ref(0) != 1 || values.at_ref(2) != 3) return fail("all");
+  double first = sync_wait(Promise<>::any(failNow(), failNow(), now(7)));
+  if (first != 7) return fail("any");
+  auto outcomes = sync_wait(Promise<>::allSettled(now(1), failNow(), now(3)));
+  if (outcomes.length() != 3 || !(outcomes.at_ref(1).status == String("rejected"))) return fail("allSettled");
+  std::cout << "OK" << std::endl;
+  return 0;
+}
+`;
+}
+
+describe('Promise combinators at runtime', () => {
+  let zigAvailable = false;
+
+  beforeAll(async () => {
+    zigAvailable = await ZigCompiler.checkZigAvailable();
+  });
+
+  const modes = [
+    { mode: 'gc', gcPool: 'mvff', header: 'runtime/cpp/gc/gs_gc_runtime.hpp' },
+    { mode: 'gc', gcPool: 'amc', header: 'runtime/cpp/gc/gs_gc_runtime.hpp' },
+    { mode: 'ownership', gcPool: undefined, header: 'runtime/cpp/ownership/gs_runtime.hpp' },
+  ] as const;
+
+  for (const { mode, gcPool, header } of modes) {
+    const name = gcPool ?? mode;
+    it(`should wait for every already-resolved task (${name})`, async () => {
+      if (!zigAvailable) {
+        console.log('Skipping: Zig not available');
+        return;
+      }
+
+      const buildDir = `build-test-combinators-${name}`;
+      const sources = new Map<string, string>();
+      sources.set('main.cpp', combinatorSource(header));
+
+      const compiler = new ZigCompiler(buildDir, 'vendor');
+      const result = await compiler.compile({
+        sources,
+        output: `${buildDir}/combinators`,
+        mode,
+        gcPool,
+        optimize: '2',
+        includePaths: ['.', 'runtime/cpp', 'vendor/cppcoro/include'], // Same roots the CLI passes
+      });
+
+      if (!result.success) {
+        console.log('Compilation failed:', result.diagnostics);
+      }
+      expect(result.success).toBe(true);
+
+      const stdout = execFileSync(`${buildDir}/combinators`, { encoding: 'utf8', timeout: 60000 });
+      expect(stdout.trim()).toBe('OK');
+
+      // Cleanup
+      await fs.rm(buildDir, { recursive: true, force: true });
+    }, 120000);
+  }
+});
@@ -77,6 +77,19 @@ describe('CLI Options Parser', () => {
     expect(options.gsMemory).toBe('ownership');
   });
   
+  it('should parse --gsGc flag', () => {
+    const { options, errors } = parseArguments(['--gsGc', 'amc', 'src/main-gs.ts']);
+    
+    expect(errors).toEqual([]);
+    expect(options.gsGc).toBe('amc');
+  });
+  
+  it('should reject invalid --gsGc', () => {
+    const { errors } = parseArguments(['--gsGc', 'boehm']);
+    
+    expect(errors).toContain('--gsGc must be one of: mvff, amc');
+  });
+  
   it('should parse --gsCodegen flag', () => {
     const { options } = parseArguments(['--gsCodegen', 'src/main-gs.ts']);
     
@@ -97,6 +110,14 @@ describe('CLI Options Parser', () => {
     expect(options.gsTriple).toBe('wasm32-wasi');
   });
   
+  it('should parse --gsCpu and --gsFastMath flags', () => {
+    const { options, errors } = parseArguments(['--gsCpu', 'native', '--gsFastMath', 'src/main-gs.ts']);
+    
+    expect(errors).toEqual([]);
+    expect(options.gsCpu).toBe('native');
+    expect(options.gsFastMath).toBe(true);
+  });
+  
   it('should parse -o flag for binary output', () => {
     const { options, errors } = parseArguments(['-o', 'myapp', 'src/main-gs.ts']);
     
@@ -189,6 +210,19 @@ describe('Option Validation', () => {
     expect(errors).toContain('--gsMemory only applies to --gsTarget cpp');
   });
   
+  it('should reject --gsGc with ownership memory mode', () => {
+    const options = {
+      files: ['test.ts'],
+      gsTarget: 'cpp' as const,
+      gsMemory: 'ownership' as const,
+      gsGc: 'amc' as const,
+    };
+    
+    const errors = validateOptions(options);
+    
+    expect(errors).toContain('--gsGc only applies to --gsMemory gc');
+  });
+  
   it('should reject --gsTriple with --gsCodegen', () => {
     const options = {
       files: ['test.ts'],
@@ -202,6 +236,19 @@ describe('Option Validation', () => {
     expect(errors).toContain('--gsTriple requires binary compilation (incompatible with --gsCodegen)');
   });
   
+  it('should reject --gsCpu with --gsCodegen', () => {
+    const options = {
+      files: ['test.ts'],
+      gsTarget: 'cpp' as const,
+      gsCodegen: true,
+      gsCpu: 'haswell',
+    };
+    
+    const errors = validateOptions(options);
+    
+    expect(errors).toContain('--gsCpu requires binary compilation (incompatible with --gsCodegen)');
+  });
+  
   it('should reject -o without --gsTarget cpp', () => {
     const options = {
       files: ['test.ts'],
@@ -5,7 +5,7 @@
 import { describe, it, expect } from 'vitest';
 import { CppCodegen } from '../src/backend/cpp/codegen.js';
 import { types, exprs } from '../src/ir/builder.js';
-import { Ownership } from '../src/ir/types.js';
+import { Ownership, BinaryOp } from '../src/ir/types.js';
 import type {
   IRProgram,
   IRModule,
@@ -283,6 +283,52 @@ describe('C++ Codegen - GC Mode - Classes', () => {
     expect(source).toContain(': version_(gs::String("1.0.0"))');
     expect(source).toContain(', port_(8080)');
   });
+
+  it('should emit GC pointer-offset table for reference fields', () => {
+    const base: IRClassDecl = {
+      kind: 'class',
+      name: 'Shape',
+      fields: [
+        { name: 'id', type: types.integer(), isReadonly: false },
+      ],
+      methods: [],
+      constructor: undefined,
+    };
+    const cls: IRClassDecl = {
+      kind: 'class',
+      name: 'TreeNode',
+      extends: 'Shape',
+      fields: [
+        { name: 'label', type: types.string(), isReadonly: false },
+        { name: 'weight', type: types.number(), isReadonly: false },
+        { name: 'parent', type: types.nullable(types.class('TreeNode', Ownership.Use)), isReadonly: false },
+        { name: 'children', type: types.array(types.class('TreeNode', Ownership.Use)), isReadonly: false },
+      ],
+      methods: [],
+      constructor: undefined,
+    };
+
+    const module: IRModule = {
+      path: 'tree.gs',
+      declarations: [base, cls],
+      imports: [],
+    };
+
+    const output = codegen.generate(createProgram(module), 'gc');
+    const header = output.get('tree.hpp');
+    const source = output.get('tree.cpp');
+
+    expect(header).toContain('GS_GC_CLASS(TreeNode)');
+    expect(source).toContain('#ifdef GS_GC_AMC');
+    expect(source).toContain('const gs::gc::TypeLayout* TreeNode::gc_layout() {');
+    expect(source).toContain('GS_GC_FIELD(TreeNode, label_),');
+    expect(source).toContain('GS_GC_FIELD(TreeNode, parent_),');
+    expect(source).toContain('GS_GC_FIELD(TreeNode, children_),');
+    expect(source).not.toContain('GS_GC_FIELD(TreeNode, weight_)');
+    expect(source).toContain('static const gs::gc::TypeLayout layout{fields, 3, Shape::gc_layout(), 0};');
+    // Classes without references still get a (empty) layout
+    expect(source).toContain('static const gs::gc::TypeLayout layout{nullptr, 0, nullptr, 0};');
+  });
 });
 
 describe('C++ Codegen - GC Mode - Interfaces', () => {
@@ -597,6 +643,83 @@ describe('C++ Codegen - Namespaces', () => {
   });
 });
 
+describe('C++ Codegen - Event Loop', () => {
+  const codegen = new CppCodegen();
+
+  it('should run pending timers at the end of main()', () => {
+    const module: IRModule = {
+      path: 'app.gs',
+      declarations: [],
+      imports: [],
+      initStatements: [{ kind: 'expressionStatement', expression: exprs.literal(1, types.number()) }],
+    };
+
+    for (const mode of ['gc', 'ownership'] as const) {
+      const source = codegen.generate(createProgram(module), mode).get('app.cpp')!;
+      const main = source.slice(source.indexOf('int main('));
+      expect(main).toContain('gs::runEventLoop();');
+      expect(main.indexOf('gs::runEventLoop();')).toBeLessThan(main.indexOf('return 0;'));
+    }
+  });
+
+  it('should run top-level statements as one async main', () => {
+    const run: IRFunctionDecl = {
+      kind: 'function',
+      name: 'run',
+      params: [],
+      returnType: types.promise(types.void()),
+      async: true,
+      body: createBlock(0, [], { kind: 'return' }),
+    };
+    const call = exprs.call(exprs.identifier('run', types.function([], types.promise(types.void()))), [], types.promise(types.void()));
+    const module: IRModule = {
+      path: 'app.gs',
+      declarations: [run],
+      imports: [],
+      initStatements: [{ kind: 'expressionStatement', expression: call }],
+    };
+
+    const output = codegen.generate(createProgram(module), 'ownership');
+    const source = output.get('app.cpp')!;
+    expect(source).toContain('auto gs_main = []() -> cppcoro::task<void> {');
+    // Not awaited: runs alongside the rest, as in Node.js
+    expect(source).toContain('gs::spawn(run());');
+    expect(source).toContain('gs::sync_wait(gs_main());');
+    expect(source.indexOf('gs::sync_wait(gs_main());')).toBeLessThan(source.indexOf('gs::runEventLoop();'));
+    // Before the runtime, which includes Promise support only with cppcoro
+    const header = output.get('app.hpp')!;
+    expect(header.indexOf('#include <cppcoro/task.hpp>')).toBeLessThan(header.indexOf('gs_runtime.hpp'));
+  });
+});
+
+describe('C++ Codegen - Promise Combinators', () => {
+  const codegen = new CppCodegen();
+
+  it('should pass the tasks of an array literal one by one', () => {
+    const task = types.promise(types.number());
+    const read = (path: string) => exprs.call(
+      exprs.identifier('read', types.function([types.string()], task)),
+      [exprs.literal(path, types.string())],
+      task,
+    );
+    const all = exprs.call(
+      exprs.memberAccess(exprs.identifier('Promise', types.void()), 'all', types.void()),
+      [exprs.arrayLiteral([read('a'), read('b')], types.array(task))],
+      types.promise(types.array(types.number())),
+    );
+    const module: IRModule = {
+      path: 'app.gs',
+      declarations: [],
+      imports: [],
+      initStatements: [{ kind: 'expressionStatement', expression: all }],
+    };
+
+    const source = codegen.generate(createProgram(module), 'gc').get('app.cpp')!;
+    expect(source).toContain('gs::Promise<>::all(read(gs::String("a")), read(gs::String("b")))');
+    expect(source).toContain('gs::sync_wait(gs_main());');
+  });
+});
+
 describe('C++ Codegen - Identifier Sanitization', () => {
   const codegen = new CppCodegen();
 
@@ -1074,3 +1197,602 @@ describe('C++ Codegen - Source Maps', () => {
   });
 });
 
+
+describe('C++ Codegen - Copy Elision', () => {
+  const codegen = new CppCodegen();
+  const urls = types.array(types.string());
+  const id = (name: string, type: any): any => ({ kind: 'identifier', name, type });
+  const methodCall = (object: any, member: string, args: any[], type: any): any => ({
+    kind: 'call',
+    callee: { kind: 'memberAccess', object, member, type: types.void() },
+    arguments: args,
+    type,
+  });
+
+  function generate(func: IRFunctionDecl, mode: 'gc' | 'ownership' = 'gc') {
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    const output = codegen.generate(createProgram(module), mode);
+    return { header: output.get('test.hpp')!, source: output.get('test.cpp')! };
+  }
+
+  it('should bind read-only loop variables and parameters by const reference', () => {
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'countSecure',
+      params: [{ name: 'urls', type: urls }],
+      returnType: types.number(),
+      body: {
+        statements: [
+          { kind: 'variableDeclaration', name: 'n', mutable: true, variableType: types.number(), initializer: { kind: 'literal', value: 0, type: types.number() } },
+          {
+            kind: 'for-of',
+            variable: 'url',
+            variableType: types.string(),
+            iterable: id('urls', urls),
+            body: [
+              { kind: 'expressionStatement', expression: methodCall(id('url', types.string()), 'startsWith', [{ kind: 'literal', value: 'https', type: types.string() }], types.boolean()) },
+            ],
+          },
+          { kind: 'return', value: id('n', types.number()) },
+        ],
+      },
+    };
+
+    for (const mode of ['gc', 'ownership'] as const) {
+      const { header, source } = generate(func, mode);
+      expect(header).toContain('double countSecure(const gs::Array<gs::String>& urls);');
+      expect(source).toContain('double countSecure(const gs::Array<gs::String>& urls) {');
+      expect(source).toContain('for (const auto& url : urls) {');
+    }
+  });
+
+  it('should keep copies of mutated loop variables and parameters', () => {
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'normalize',
+      params: [{ name: 'urls', type: urls }],
+      returnType: urls,
+      body: {
+        statements: [
+          { kind: 'expressionStatement', expression: methodCall(id('urls', urls), 'push', [{ kind: 'literal', value: '/', type: types.string() }], types.number()) },
+          {
+            kind: 'for-of',
+            variable: 'url',
+            variableType: types.string(),
+            iterable: id('urls', urls),
+            body: [{ kind: 'assignment', target: 'url', value: { kind: 'literal', value: '', type: types.string() } }],
+          },
+          { kind: 'return', value: id('urls', urls) },
+        ],
+      },
+    };
+
+    const { source } = generate(func);
+    expect(source).toContain('gs::Array<gs::String> normalize(gs::Array<gs::String> urls) {');
+    expect(source).toContain('for (auto url : urls) {');
+  });
+
+  it('should keep copies of parameters the body can change through an alias', () => {
+    const box = types.class('Box', Ownership.Share);
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'retitle',
+      params: [{ name: 'box', type: box }, { name: 'title', type: types.string() }, { name: 'tag', type: types.string() }],
+      returnType: types.string(),
+      body: {
+        statements: [
+          // title may be box.title, tag may be the global lastTag
+          { kind: 'expressionStatement', expression: { kind: 'assignment', left: { kind: 'memberAccess', object: id('box', box), member: 'title', type: types.string() }, right: { kind: 'literal', value: '', type: types.string() }, type: types.string() } },
+          { kind: 'assignment', target: 'lastTag', value: { kind: 'literal', value: '', type: types.string() } },
+          { kind: 'return', value: { kind: 'binary', operator: BinaryOp.Add, left: id('title', types.string()), right: id('tag', types.string()), type: types.string() } },
+        ],
+      },
+    };
+
+    for (const mode of ['gc', 'ownership'] as const) {
+      const { source } = generate(func, mode);
+      expect(source).toContain('gs::String title, gs::String tag) {');
+    }
+  });
+
+  it('should keep copies of loop variables when the body grows or replaces the iterable', () => {
+    const lengths = types.array(types.number());
+    const loop = (body: any[]): IRFunctionDecl => ({
+      kind: 'function',
+      name: 'expand',
+      params: [{ name: 'urls', type: urls }],
+      returnType: types.void(),
+      body: {
+        statements: [
+          { kind: 'variableDeclaration', name: 'queue', mutable: true, variableType: urls, initializer: { kind: 'arrayLiteral', elements: [], type: urls } },
+          { kind: 'variableDeclaration', name: 'lengths', mutable: false, variableType: lengths, initializer: { kind: 'arrayLiteral', elements: [], type: lengths } },
+          { kind: 'for-of', variable: 'url', variableType: types.string(), iterable: id('queue', urls), body },
+        ],
+      },
+    });
+
+    const grows = loop([
+      { kind: 'expressionStatement', expression: methodCall(id('queue', urls), 'push', [id('url', types.string())], types.number()) },
+    ]);
+    const replaces = loop([
+      { kind: 'assignment', target: 'queue', value: id('urls', urls) },
+    ]);
+    const unrelated = loop([
+      { kind: 'expressionStatement', expression: methodCall(id('lengths', lengths), 'push', [{ kind: 'literal', value: 1, type: types.number() }], types.number()) },
+    ]);
+
+    for (const mode of ['gc', 'ownership'] as const) {
+      expect(generate(grows, mode).source).toContain('for (auto url : queue) {');
+      expect(generate(replaces, mode).source).toContain('for (auto url : queue) {');
+      expect(generate(unrelated, mode).source).toContain('for (const auto& url : queue) {');
+    }
+  });
+
+  it('should move locals on their last use', () => {
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'collect',
+      params: [{ name: 'out', type: types.array(urls) }],
+      returnType: types.void(),
+      body: {
+        statements: [
+          { kind: 'variableDeclaration', name: 'url', mutable: false, variableType: types.string(), initializer: { kind: 'literal', value: 'https://a', type: types.string() } },
+          { kind: 'variableDeclaration', name: 'batch', mutable: false, variableType: urls, initializer: { kind: 'arrayLiteral', elements: [], type: urls } },
+          { kind: 'expressionStatement', expression: methodCall(id('batch', urls), 'push', [id('url', types.string())], types.number()) },
+          { kind: 'expressionStatement', expression: methodCall(id('out', types.array(urls)), 'push', [id('batch', urls)], types.number()) },
+        ],
+      },
+    };
+
+    const { source } = generate(func, 'ownership');
+    expect(source).toContain('auto url = gs::String("https://a");');
+    expect(source).toContain('batch.push(std::move(url));');
+    expect(source).toContain('out.push(std::move(batch));');
+  });
+});
+
+describe('C++ Codegen - Array Pipelines', () => {
+  const codegen = new CppCodegen();
+  const nums = types.array(types.number());
+  const id = (name: string, type: any): any => ({ kind: 'identifier', name, type });
+  const methodCall = (object: any, member: string, args: any[], type: any): any => ({
+    kind: 'call',
+    callee: { kind: 'memberAccess', object, member, type: types.void() },
+    arguments: args,
+    type,
+  });
+  // (x) => x <op> operand
+  const lambda = (op: string, operand: number, returnType: any): any => ({
+    kind: 'lambda',
+    params: [{ name: 'x', type: types.number() }],
+    body: createBlock(0, [], {
+      kind: 'return',
+      value: {
+        kind: 'binary',
+        op: op as BinaryOp,
+        left: { kind: 'variable', name: 'x', version: 0, type: types.number() },
+        right: { kind: 'literal', value: operand, type: types.number() },
+        type: returnType,
+      },
+    }),
+    captures: [],
+    type: types.function([types.number()], returnType),
+  });
+
+  function generate(value: any, returnType: any) {
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'process',
+      params: [{ name: 'arr', type: nums }],
+      returnType,
+      body: { statements: [{ kind: 'return', value }] },
+    };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    return codegen.generate(createProgram(module), 'gc').get('test.cpp')!;
+  }
+
+  it('should fuse a map/filter/reduce chain into one pipeline', () => {
+    const mapped = methodCall(id('arr', nums), 'map', [lambda('*', 2, types.number())], nums);
+    const filtered = methodCall(mapped, 'filter', [lambda('>', 10, types.boolean())], nums);
+    const add = {
+      kind: 'lambda',
+      params: [{ name: 'acc', type: types.number() }, { name: 'x', type: types.number() }],
+      body: createBlock(0, [], { kind: 'return', value: { kind: 'variable', name: 'acc', version: 0, type: types.number() } }),
+      captures: [],
+      type: types.function([types.number(), types.number()], types.number()),
+    };
+    const reduced = methodCall(filtered, 'reduce', [add, { kind: 'literal', value: 0, type: types.number() }], types.number());
+
+    const source = generate(reduced, types.number());
+    expect(source).toContain('return gs::lazy(arr).map(');
+    expect(source).toMatch(/\.map\([\s\S]*\)\.filter\([\s\S]*\)\.reduce\(/);
+    expect(source).not.toContain('arr.map(');
+  });
+
+  it('should collect chains ending in map or filter and leave single calls alone', () => {
+    const chain = methodCall(
+      methodCall(id('arr', nums), 'filter', [lambda('>', 0, types.boolean())], nums),
+      'map', [lambda('+', 1, types.number())], nums);
+    expect(generate(chain, nums)).toMatch(/return gs::lazy\(arr\)\.filter\([\s\S]*\)\.map\([\s\S]*\)\.toArray\(\);/);
+
+    const single = methodCall(id('arr', nums), 'map', [lambda('+', 1, types.number())], nums);
+    const source = generate(single, nums);
+    expect(source).toContain('return arr.map(');
+    expect(source).not.toContain('gs::lazy');
+  });
+
+  it('should not fuse callbacks with side effects', () => {
+    // arr.map(x => { console.log(x); return x * 2; }).some(x => x > 10): JS logs every element first
+    const logged = lambda('*', 2, types.number());
+    logged.body.instructions = [{
+      kind: 'expr',
+      value: {
+        kind: 'methodCall',
+        object: { kind: 'variable', name: 'console', version: 0, type: types.void() },
+        method: 'log',
+        args: [{ kind: 'variable', name: 'x', version: 0, type: types.number() }],
+        type: types.void(),
+      },
+    }];
+    const mapped = methodCall(id('arr', nums), 'map', [logged], nums);
+    const found = methodCall(mapped, 'some', [lambda('>', 10, types.boolean())], types.boolean());
+    const source = generate(found, types.boolean());
+    expect(source).toContain('arr.map(');
+    expect(source).not.toContain('gs::lazy');
+
+    // A named function may have effects too
+    const named = methodCall(
+      methodCall(id('arr', nums), 'map', [id('double', types.function([types.number()], types.number()))], nums),
+      'filter', [lambda('>', 0, types.boolean())], nums);
+    expect(generate(named, nums)).not.toContain('gs::lazy');
+  });
+});
+
+describe('C++ Codegen - Parallel', () => {
+  it('should map Parallel static methods to gs::Parallel', () => {
+    const nums = types.array(types.number());
+    const arr = { kind: 'identifier', name: 'arr', type: nums } as any;
+    const double = {
+      kind: 'lambda',
+      params: [{ name: 'x', type: types.number() }],
+      body: createBlock(0, [], { kind: 'return', value: { kind: 'variable', name: 'x', version: 0, type: types.number() } }),
+      captures: [],
+      type: types.function([types.number()], types.number()),
+    } as any;
+    const call = {
+      kind: 'call',
+      callee: {
+        kind: 'memberAccess',
+        object: { kind: 'identifier', name: 'Parallel', type: types.void() },
+        member: 'map',
+        type: types.void(),
+      },
+      arguments: [arr, double],
+      type: nums,
+    } as any;
+    const func: IRFunctionDecl = {
+      kind: 'function',
+      name: 'process',
+      params: [{ name: 'arr', type: nums }],
+      returnType: nums,
+      body: { statements: [{ kind: 'return', value: call }] },
+    };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+
+    for (const mode of ['gc', 'ownership'] as const) {
+      const source = new CppCodegen().generate(createProgram(module), mode).get('test.cpp')!;
+      expect(source).toContain('return gs::Parallel::map(arr, ');
+    }
+  });
+});
+
+describe('C++ Codegen - Numeric Kernels', () => {
+  const codegen = new CppCodegen();
+  const nums = types.array(types.number());
+  const ints = types.array(types.integer());
+  const id = (name: string, type: any): any => ({ kind: 'identifier', name, type });
+  const num = (value: number): any => ({ kind: 'literal', value, type: types.number() });
+  const binary = (operator: BinaryOp, left: any, right: any, type: any): any => ({ kind: 'binary', operator, left, right, type });
+
+  function generate(params: any[], statements: any[], returnType: any) {
+    const func: IRFunctionDecl = { kind: 'function', name: 'scan', params, returnType, body: { statements } };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    return codegen.generate(createProgram(module), 'gc').get('test.cpp')!;
+  }
+
+  it('should emit for-of sum and max loops as kernel calls', () => {
+    const x = id('x', types.number());
+    const total = id('total', types.number());
+    const best = id('best', types.number());
+    const source = generate([{ name: 'values', type: nums }], [
+      { kind: 'variableDeclaration', name: 'total', mutable: true, variableType: types.number(), initializer: num(0) },
+      { kind: 'variableDeclaration', name: 'best', mutable: true, variableType: types.number(), initializer: num(0) },
+      {
+        kind: 'for-of', variable: 'x', variableType: types.number(), iterable: id('values', nums),
+        body: [{ kind: 'assignment', target: 'total', value: binary(BinaryOp.Add, total, x, types.number()) }],
+      },
+      {
+        kind: 'for-of', variable: 'x', variableType: types.number(), iterable: id('values', nums),
+        body: [{
+          kind: 'block',
+          statements: [{
+            kind: 'if',
+            condition: binary(BinaryOp.Gt, x, best, types.boolean()),
+            thenBranch: [{ kind: 'assignment', target: 'best', value: x }],
+          }],
+        }],
+      },
+      { kind: 'return', value: binary(BinaryOp.Add, total, best, types.number()) },
+    ], types.number());
+
+    expect(source).toContain('total = gs::simd::sum(values, total);');
+    expect(source).toContain('best = gs::simd::max(values, best);');
+    expect(source).not.toContain('for (');
+  });
+
+  it('should emit indexed dot product loops as kernel calls', () => {
+    const i = id('i', types.number());
+    const at = (array: string): any => ({ kind: 'indexAccess', object: id(array, ints), index: i, type: types.integer() });
+    const acc = id('acc', types.integer());
+    const source = generate([{ name: 'a', type: ints }, { name: 'b', type: ints }], [
+      { kind: 'variableDeclaration', name: 'acc', mutable: true, variableType: types.integer(), initializer: num(0) },
+      {
+        kind: 'for',
+        init: { kind: 'variableDeclaration', name: 'i', mutable: true, variableType: types.number(), initializer: num(0) },
+        condition: binary(BinaryOp.Lt, i, { kind: 'memberAccess', object: id('a', ints), member: 'length', type: types.number() }, types.boolean()),
+        increment: binary(BinaryOp.Assign, i, binary(BinaryOp.Add, i, num(1), types.number()), types.number()),
+        body: [{
+          kind: 'assignment',
+          target: 'acc',
+          value: binary(BinaryOp.Add, acc, binary(BinaryOp.Mul, at('b'), at('a'), types.integer()), types.integer()),
+        }],
+      },
+      { kind: 'return', value: acc },
+    ], types.integer());
+
+    expect(source).toContain('acc = gs::simd::dot(a, b, acc);');
+  });
+
+  it('should emit reduce with + as a kernel sum', () => {
+    const param = (name: string): any => ({ kind: 'variable', name, version: 0, type: types.number() });
+    const add = {
+      kind: 'lambda',
+      params: [{ name: 'a', type: types.number() }, { name: 'b', type: types.number() }],
+      body: createBlock(0, [], { kind: 'return', value: { kind: 'binary', op: BinaryOp.Add, left: param('a'), right: param('b'), type: types.number() } }),
+      captures: [],
+      type: types.function([types.number(), types.number()], types.number()),
+    };
+    const reduce = {
+      kind: 'call',
+      callee: { kind: 'memberAccess', object: id('values', nums), member: 'reduce', type: types.void() },
+      arguments: [add, num(0)],
+      type: types.number(),
+    };
+    const source = generate([{ name: 'values', type: nums }], [{ kind: 'return', value: reduce }], types.number());
+
+    expect(source).toContain('return gs::simd::sum(values, 0);');
+  });
+
+  it('should keep loops whose accumulator has another type', () => {
+    const x = id('x', types.integer());
+    const total = id('total', types.number());
+    const source = generate([{ name: 'values', type: ints }], [
+      { kind: 'variableDeclaration', name: 'total', mutable: true, variableType: types.number(), initializer: num(0) },
+      {
+        kind: 'for-of', variable: 'x', variableType: types.integer(), iterable: id('values', ints),
+        body: [{ kind: 'assignment', target: 'total', value: binary(BinaryOp.Add, total, x, types.number()) }],
+      },
+      { kind: 'return', value: total },
+    ], types.number());
+
+    expect(source).toContain('for (auto x : values) {');
+    expect(source).not.toContain('gs::simd::');
+  });
+});
+
+describe('C++ Codegen - Typed Arrays', () => {
+  const codegen = new CppCodegen();
+  const f64 = types.typedArray('Float64Array');
+  const i32 = types.typedArray('Int32Array');
+  const id = (name: string, type: any): any => ({ kind: 'identifier', name, type });
+  const num = (value: number): any => ({ kind: 'literal', value, type: types.number() });
+  const binary = (operator: BinaryOp, left: any, right: any, type: any): any => ({ kind: 'binary', operator, left, right, type });
+  const length = (array: any): any => ({ kind: 'memberAccess', object: array, member: 'length', type: types.number() });
+  const at = (array: any, index: any): any => ({ kind: 'indexAccess', object: array, index, type: types.number() });
+  const store = (array: any, index: any, value: any): any => ({
+    kind: 'expressionStatement', expression: binary(BinaryOp.Assign, at(array, index), value, types.number()),
+  });
+  const countUp = (array: any, body: any[]): any => {
+    const i = id('i', types.number());
+    return {
+      kind: 'for',
+      init: { kind: 'variableDeclaration', name: 'i', mutable: true, variableType: types.number(), initializer: num(0) },
+      condition: binary(BinaryOp.Lt, i, length(array), types.boolean()),
+      increment: binary(BinaryOp.Assign, i, binary(BinaryOp.Add, i, num(1), types.number()), types.number()),
+      body,
+    };
+  };
+
+  function generate(params: any[], statements: any[], returnType: any, mode: 'gc' | 'ownership' = 'gc') {
+    const func: IRFunctionDecl = { kind: 'function', name: 'run', params, returnType, body: { statements } };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    return codegen.generate(createProgram(module), mode).get('test.cpp')!;
+  }
+
+  it('should map typed arrays to runtime value types in both modes', () => {
+    for (const mode of ['gc', 'ownership'] as const) {
+      const source = generate([{ name: 'samples', type: f64 }], [
+        {
+          kind: 'variableDeclaration', name: 'counts', variableType: i32,
+          initializer: { kind: 'newExpression', className: 'Int32Array', arguments: [length(id('samples', f64))], type: i32 },
+        },
+        { kind: 'return', value: { kind: 'memberAccess', object: id('counts', i32), member: 'byteLength', type: types.number() } },
+      ], types.number(), mode);
+
+      expect(source).toContain('double run(gs::Float64Array samples)');
+      expect(source).toContain('auto counts = gs::Int32Array(samples.length());');
+      expect(source).toContain('return counts.byteLength();');
+    }
+  });
+
+  it('should skip bounds checks on the index of a loop over the array', () => {
+    const a = id('a', f64);
+    const i = id('i', types.number());
+    const source = generate([{ name: 'a', type: f64 }], [
+      countUp(a, [store(a, i, binary(BinaryOp.Mul, at(a, i), num(2), types.number()))]),
+      store(a, num(0), num(1)),
+    ], types.void());
+
+    expect(source).toContain('a.set_unchecked(static_cast<int64_t>(i), (a.at_ref(static_cast<int64_t>(i)) * 2));');
+    expect(source).toContain('a.set(static_cast<int64_t>(0), 1);');
+  });
+
+  it('should keep bounds checks when the loop body writes the index', () => {
+    const a = id('a', i32);
+    const i = id('i', types.number());
+    const source = generate([{ name: 'a', type: i32 }], [
+      countUp(a, [
+        store(a, i, num(0)),
+        { kind: 'assignment', target: 'i', value: binary(BinaryOp.Add, i, num(1), types.number()) },
+      ]),
+    ], types.void());
+
+    expect(source).toContain('a.set(static_cast<int64_t>(i), 0);');
+    expect(source).not.toContain('set_unchecked');
+  });
+
+  it('should run numeric kernels over Float64Array only', () => {
+    const total = id('total', types.number());
+    const loop = (type: any): any => ({
+      kind: 'for-of', variable: 'x', variableType: types.number(), iterable: id('values', type),
+      body: [{ kind: 'assignment', target: 'total', value: binary(BinaryOp.Add, total, id('x', types.number()), types.number()) }],
+    });
+    const declare = { kind: 'variableDeclaration', name: 'total', mutable: true, variableType: types.number(), initializer: num(0) };
+
+    const doubles = generate([{ name: 'values', type: f64 }], [declare, loop(f64), { kind: 'return', value: total }], types.number());
+    expect(doubles).toContain('total = gs::simd::sum(values, total);');
+
+    const ints = generate([{ name: 'values', type: i32 }], [declare, loop(i32), { kind: 'return', value: total }], types.number());
+    expect(ints).not.toContain('gs::simd::');
+  });
+});
+
+describe('C++ Codegen - Key Sorts', () => {
+  const codegen = new CppCodegen();
+  const rec = types.class('Rec', Ownership.Share);
+  const recs = types.array(rec);
+  const strs = types.array(types.string());
+  const id = (name: string, type: any): any => ({ kind: 'identifier', name, type });
+  const param = (name: string, type: any): any => ({ kind: 'variable', name, version: 0, type });
+  const field = (object: any, member: string, type: any): any => ({ kind: 'member', object, member, type });
+  const binary = (op: BinaryOp, left: any, right: any, type: any): any => ({ kind: 'binary', op, left, right, type });
+  const int = (value: number): any => ({ kind: 'literal', value, type: types.number() });
+
+  function sort(array: any, element: any, result: (a: any, b: any) => any): any {
+    return {
+      kind: 'call',
+      callee: { kind: 'memberAccess', object: array, member: 'sort', type: types.void() },
+      arguments: [{
+        kind: 'lambda',
+        params: [{ name: 'a', type: element }, { name: 'b', type: element }],
+        body: createBlock(0, [], { kind: 'return', value: result(param('a', element), param('b', element)) }),
+        captures: [],
+        type: types.function([element, element], types.number()),
+      }],
+      type: array.type,
+    };
+  }
+
+  function generate(params: any[], expression: any, mode: 'gc' | 'ownership' = 'gc') {
+    const statements: any[] = [{ kind: 'expressionStatement', expression }];
+    const func: IRFunctionDecl = { kind: 'function', name: 'order', params, returnType: types.void(), body: { statements } };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    return codegen.generate(createProgram(module), mode).get('test.cpp')!;
+  }
+
+  it('should sort by a numeric field for a - b and b - a comparators', () => {
+    const score = (r: any) => field(r, 'score', types.number());
+    for (const mode of ['gc', 'ownership'] as const) {
+      const up = generate([{ name: 'records', type: recs }],
+        sort(id('records', recs), rec, (a, b) => binary(BinaryOp.Sub, score(a), score(b), types.number())), mode);
+      expect(up).toContain('records.sortByKey([](const auto& a) -> decltype(auto) { return (a->score); });');
+
+      const down = generate([{ name: 'records', type: recs }],
+        sort(id('records', recs), rec, (a, b) => binary(BinaryOp.Sub, score(b), score(a), types.number())), mode);
+      expect(down).toContain('records.sortByKey([](const auto& a) -> decltype(auto) { return (a->score); }, true);');
+    }
+  });
+
+  it('should sort strings by a three-way conditional comparator', () => {
+    const s = types.string();
+    const threeWay = (first: any, second: any, signs: [number, number]): any => ({
+      kind: 'conditional', condition: first, whenTrue: int(signs[0]), type: types.number(),
+      whenFalse: { kind: 'conditional', condition: second, whenTrue: int(signs[1]), whenFalse: int(0), type: types.number() },
+    });
+    const up = generate([{ name: 'names', type: strs }], sort(id('names', strs), s, (a, b) =>
+      threeWay(binary(BinaryOp.Lt, a, b, types.boolean()), binary(BinaryOp.Gt, a, b, types.boolean()), [-1, 1])));
+    expect(up).toContain('names.sortByKey([](const auto& a) -> decltype(auto) { return (a); });');
+
+    const down = generate([{ name: 'names', type: strs }], sort(id('names', strs), s, (a, b) =>
+      threeWay(binary(BinaryOp.Gt, a, b, types.boolean()), binary(BinaryOp.Lt, a, b, types.boolean()), [-1, 1])));
+    expect(down).toContain('names.sortByKey([](const auto& a) -> decltype(auto) { return (a); }, true);');
+  });
+
+  it('should keep comparators that compare different keys', () => {
+    const x = (r: any) => field(r, 'x', types.number());
+    const y = (r: any) => field(r, 'y', types.number());
+    const source = generate([{ name: 'records', type: recs }],
+      sort(id('records', recs), rec, (a, b) => binary(BinaryOp.Sub, x(a), y(b), types.number())));
+    expect(source).not.toContain('sortByKey');
+    expect(source).toContain('records.sort(');
+  });
+});
+
+describe('C++ Codegen - Boolean Arrays', () => {
+  const codegen = new CppCodegen();
+  const flags = types.array(types.boolean());
+  const flagsId: any = { kind: 'identifier', name: 'flags', type: flags };
+  const f: any = { kind: 'variable', name: 'f', version: 0, type: types.boolean() };
+  const notF: any = { kind: 'unary', op: '!', operand: f, type: types.boolean() };
+
+  function call(method: string, result: any, type: any): any {
+    return {
+      kind: 'call',
+      callee: { kind: 'memberAccess', object: flagsId, member: method, type: types.void() },
+      arguments: [{
+        kind: 'lambda',
+        params: [{ name: 'f', type: types.boolean() }],
+        body: createBlock(0, [], { kind: 'return', value: result }),
+        captures: [],
+        type: types.function([types.boolean()], types.boolean()),
+      }],
+      type,
+    };
+  }
+
+  function generate(value: any, returnType: any, mode: 'gc' | 'ownership') {
+    const func: IRFunctionDecl = {
+      kind: 'function', name: 'scan', params: [{ name: 'flags', type: flags }], returnType,
+      body: { statements: [{ kind: 'return', value }] },
+    };
+    const module: IRModule = { path: 'test.gs', declarations: [func], imports: [] };
+    return codegen.generate(createProgram(module), mode).get('test.cpp')!;
+  }
+
+  it('should scan packed boolean arrays for some/every over the element', () => {
+    expect(generate(call('some', f, types.boolean()), types.boolean(), 'ownership'))
+      .toContain('return flags.includes(true);');
+    expect(generate(call('every', f, types.boolean()), types.boolean(), 'ownership'))
+      .toContain('return (!flags.includes(false));');
+    expect(generate(call('every', notF, types.boolean()), types.boolean(), 'ownership'))
+      .toContain('return (!flags.includes(true));');
+    expect(generate(call('some', f, types.boolean()), types.boolean(), 'gc')).toContain('flags.some(');
+  });
+
+  it('should count filtered boolean arrays with a popcount', () => {
+    const length = (object: any): any => ({ kind: 'memberAccess', object, member: 'length', type: types.number() });
+    expect(generate(length(call('filter', notF, flags)), types.number(), 'ownership'))
+      .toContain('return flags.countOf(false);');
+    expect(generate(length(call('filter', f, flags)), types.number(), 'gc')).not.toContain('countOf');
+  });
+});
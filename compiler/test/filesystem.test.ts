@@ -3,10 +3,13 @@
  * Phase 7b.2 Step 1: Built-in FileSystem support
  */
 
-import { describe, it, expect } from 'vitest';
+import { describe, it, expect, beforeAll } from 'vitest';
 import ts from 'typescript';
+import * as fs from 'fs/promises';
+import { execFileSync } from 'child_process';
 import { IRLowering } from '../src/frontend/lowering.js';
 import { CppCodegen } from '../src/backend/cpp/codegen.js';
+import { ZigCompiler } from '../src/backend/cpp/zig-compiler.js';
 
 function createProgram(source: string): ts.Program {
   const sourceFile = ts.createSourceFile(
@@ -123,6 +126,23 @@ describe('FileSystem Built-in', () => {
       expect(code).toContain('gs::FileSystem::readDir');
       expect(code).toContain('gs::String(".")');
     });
+
+    it('should generate code for FileSystem.mapFile()', () => {
+      const source = `
+        const bytes = FileSystem.mapFile('huge.log', 'sequential');
+      `;
+
+      const program = createProgram(source);
+      const lowering = new IRLowering();
+      const ir = lowering.lower(program);
+
+      const codegen = new CppCodegen('gc');
+      const files = codegen.generate(ir);
+      const code = Array.from(files.values()).join('\n');
+
+      expect(code).toContain('gs::FileSystem::mapFile');
+      expect(code).toContain('gs::String("sequential")');
+    });
   });
 
   describe('Async FileSystem methods', () => {
@@ -212,3 +232,140 @@ describe('FileSystem Built-in', () => {
     });
   });
 });
+
+// Maps a file, scans it with indexOf(value, fromIndex) and decodeText, maps
+// a sparse 3 GiB file (lengths and indexes past 2^31), and maps/unmaps in a
+// loop; on Linux the process map count must not grow
+function mapFileSource(runtimeHeader: string): string {
+  return `
+#include "${runtimeHeader}"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace gs;
+
+static int fail(const char* what) {
+  std::cout << "FAIL " << what << std::endl;
+  return 1;
+}
+
+static int mapCount() {
+#ifdef __linux__
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  int count = 0;
+  while (std::getline(maps, line)) count++;
+  return count;
+#else
+  return 0;
+#endif
+}
+
+int main(int argc, char** argv) {
+  String path(argv[1]);
+  {
+    std::ofstream out(argv[1], std::ios::binary);
+    for (int i = 0; i < 1000; ++i) out << "line " << i << (i % 100 == 0 ? " ERROR" : " ok") << "\\n";
+  }
+
+  Uint8Array log = FileSystem::mapFile(path, String("sequential"));
+  int lines = 0, errors = 0, start = 0;
+  String last;
+  for (int end = log.indexOf(10, start); end >= 0; end = log.indexOf(10, start)) {
+    Uint8Array line = log.subarray(start, end);
+    if (line.indexOf(69) >= 0) {
+      errors++;
+      last = FileSystem::decodeText(line);
+    }
+    lines++;
+    start = end + 1;
+  }
+  if (lines != 1000 || errors != 10) return fail("scan");
+  if (!(last == String("line 900 ERROR"))) return fail("decodeText");
+  if (log.indexOf(10, -1) != log.length() - 1 || log.indexOf(108, -3) != -1) return fail("fromIndex");
+#ifdef GS_GC_MODE
+  for (int i = 0; i < 20000; ++i) Array<String> junk{String("junk-padded-well-past-the-inline-buffer")};
+  gc::Allocator::collect();
+#endif
+  if (!(FileSystem::decodeText(log.subarray(0, 6)) == String("line 0"))) return fail("after collect");
+  FileSystem::unmapFile(log);
+
+  // Only the last page is touched
+  std::string bigPath = std::string(argv[1]) + ".big";
+  const int64_t bigSize = int64_t(3) << 30;
+  {
+    std::ofstream out(bigPath, std::ios::binary);
+    out.seekp(bigSize - 2);
+    out << "\\nx";
+  }
+  Uint8Array big = FileSystem::mapFile(String(bigPath.c_str()));
+  if (big.length() != bigSize) return fail("length past 2 GiB");
+  if (big.indexOf(10, static_cast<double>(bigSize - 4096)) != bigSize - 2) return fail("indexOf past 2 GiB");
+  if (big.indexOf(120, -1) != bigSize - 1 || big.get_or_default(bigSize - 1) != 120) return fail("index past 2 GiB");
+  FileSystem::unmapFile(big);
+  std::remove(bigPath.c_str());
+
+  int before = mapCount();
+  for (int i = 0; i < 2000; ++i) {
+    Uint8Array bytes = FileSystem::mapFile(path);
+    if (bytes.indexOf(10, 7) != 12) return fail("remap");
+    FileSystem::unmapFile(bytes);
+  }
+  if (mapCount() > before + 8) return fail("mappings leaked");
+
+  std::cout << "OK" << std::endl;
+  return 0;
+}
+`;
+}
+
+describe('FileSystem.mapFile runtime', () => {
+  let zigAvailable = false;
+
+  beforeAll(async () => {
+    zigAvailable = await ZigCompiler.checkZigAvailable();
+  });
+
+  const modes = [
+    { mode: 'gc', gcPool: 'mvff', header: 'runtime/cpp/gc/gs_gc_runtime.hpp' },
+    { mode: 'gc', gcPool: 'amc', header: 'runtime/cpp/gc/gs_gc_runtime.hpp' },
+    { mode: 'ownership', gcPool: undefined, header: 'runtime/cpp/ownership/gs_runtime.hpp' },
+  ] as const;
+
+  for (const { mode, gcPool, header } of modes) {
+    const name = gcPool ?? mode;
+    it(`should scan, decode and unmap a mapped file (${name})`, async () => {
+      if (!zigAvailable) {
+        console.log('Skipping: Zig not available');
+        return;
+      }
+
+      const buildDir = `build-test-mapfile-${name}`;
+      const sources = new Map<string, string>();
+      sources.set('main.cpp', mapFileSource(header));
+
+      const compiler = new ZigCompiler(buildDir, 'vendor');
+      const result = await compiler.compile({
+        sources,
+        output: `${buildDir}/mapfile`,
+        mode,
+        gcPool,
+        optimize: '2',
+        includePaths: ['.', 'runtime/cpp'], // Same roots the CLI passes
+        enableFileSystem: true,
+      });
+
+      if (!result.success) {
+        console.log('Compilation failed:', result.diagnostics);
+      }
+      expect(result.success).toBe(true);
+
+      const stdout = execFileSync(`${buildDir}/mapfile`, [`${buildDir}/lines.log`], { encoding: 'utf8', timeout: 60000 });
+      expect(stdout.trim()).toBe('OK');
+
+      // Cleanup
+      await fs.rm(buildDir, { recursive: true, force: true });
+    }, 120000);
+  }
+});
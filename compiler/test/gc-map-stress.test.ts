@@ -0,0 +1,142 @@
+/**
+ * GC Container Stress Tests
+ * Map/Set entries must stay visible to the collector: forces
+ * gc::Allocator::collect() during a Map-heavy workload and checks that
+ * keys, values, nested maps and class fields survive (and move) intact.
+ */
+
+import { describe, it, expect, beforeAll } from 'vitest';
+import { ZigCompiler } from '../src/backend/cpp/zig-compiler.js';
+import * as fs from 'fs/promises';
+import { execFileSync } from 'child_process';
+
+const STRESS_SOURCE = `
+#include "runtime/cpp/gc/gs_gc_runtime.hpp"
+using namespace gs;
+
+class Node {
+public:
+  String name;
+  Map<String, Node*> children;
+  Set<String> tags;
+  int id = 0;
+  GS_GC_CLASS(Node)
+};
+
+#ifdef GS_GC_AMC
+const gs::gc::TypeLayout* Node::gc_layout() {
+  static const gs::gc::FieldLayout fields[] = {
+    GS_GC_FIELD(Node, name), GS_GC_FIELD(Node, children), GS_GC_FIELD(Node, tags)
+  };
+  static const gs::gc::TypeLayout layout{fields, 3, nullptr, 0};
+  return &layout;
+}
+#endif
+
+static String long_name(const char* prefix, int i) {
+  return String(prefix) + String::from(i) + String("-padded-well-past-the-inline-buffer");
+}
+
+static int fail(const char* what, int i) {
+  std::cout << "FAIL " << what << " " << i << std::endl;
+  return 1;
+}
+
+int main() {
+  Map<String, Node*> registry;
+  Map<String, Map<String, int>> nested;
+  Set<String> seen;
+  const int N = 4000;
+
+  for (int round = 0; round < 6; ++round) {
+    for (int i = 0; i < N; ++i) {
+      Node* node = new Node();
+      node->id = i;
+      node->name = long_name("node-", i);
+      node->tags.add(long_name("tag-", i % 97));
+      registry.set(long_name("node-", i), node);
+      seen.add(long_name("seen-", i));
+      Map<String, int> inner;
+      inner.set(long_name("inner-", i), i);
+      nested.set(long_name("outer-", i), inner);
+      if (i > 0) {
+        Node* parent = registry.get(long_name("node-", i / 2));
+        if (parent) parent->children.set(long_name("child-", i), node);
+      }
+      // Garbage so the collector has something to reclaim and move
+      for (int g = 0; g < 4; ++g) {
+        String junk = long_name("junk-", i * 4 + g);
+        (void)junk;
+      }
+      if (i % 500 == 0) gc::Allocator::collect();
+    }
+    for (int i = 0; i < N; i += 2) {
+      seen.delete_(long_name("seen-", i));
+    }
+    gc::Allocator::collect();
+
+    for (int i = 0; i < N; ++i) {
+      Node* node = registry.get(long_name("node-", i));
+      if (!node || node->id != i) return fail("registry", i);
+      if (!(node->name == long_name("node-", i))) return fail("name", i);
+      if (!node->tags.has(long_name("tag-", i % 97))) return fail("tags", i);
+      if (seen.has(long_name("seen-", i)) != (i % 2 == 1)) return fail("seen", i);
+      Map<String, int> inner = nested.get(long_name("outer-", i));
+      if (inner.get(long_name("inner-", i)) != i) return fail("nested", i);
+      if (i > 0) {
+        Node* parent = registry.get(long_name("node-", i / 2));
+        if (parent->children.get(long_name("child-", i)) != node) return fail("children", i);
+      }
+    }
+    int order = 0;
+    for (auto& [key, node] : registry) {
+      if (!(key == node->name) || node->id != order++) return fail("order", order);
+    }
+  }
+
+  std::cout << "OK" << std::endl;
+  return 0;
+}
+`;
+
+describe('GC Map/Set stress', () => {
+  let zigAvailable = false;
+
+  beforeAll(async () => {
+    zigAvailable = await ZigCompiler.checkZigAvailable();
+  });
+
+  for (const gcPool of ['mvff', 'amc'] as const) {
+    it(`should keep Map and Set entries alive across collections (${gcPool})`, async () => {
+      if (!zigAvailable) {
+        console.log('Skipping: Zig not available');
+        return;
+      }
+
+      const buildDir = `build-test-gc-map-${gcPool}`;
+      const sources = new Map<string, string>();
+      sources.set('main.cpp', STRESS_SOURCE);
+
+      const compiler = new ZigCompiler(buildDir, 'vendor');
+      const result = await compiler.compile({
+        sources,
+        output: `${buildDir}/stress`,
+        mode: 'gc',
+        gcPool,
+        optimize: '2',
+        includePaths: ['.', 'runtime/cpp'], // Same roots the CLI passes
+      });
+
+      if (!result.success) {
+        console.log('Compilation failed:', result.diagnostics);
+      }
+      expect(result.success).toBe(true);
+
+      const stdout = execFileSync(`${buildDir}/stress`, { encoding: 'utf8', timeout: 60000 });
+      expect(stdout.trim()).toBe('OK');
+
+      // Cleanup
+      await fs.rm(buildDir, { recursive: true, force: true });
+    }, 120000);
+  }
+});
@@ -4,7 +4,7 @@ import { IRLowering } from '../src/frontend/lowering.js';
 import { CppCodegen } from '../src/backend/cpp/codegen.js';
 
 describe('JSON object integration', () => {
-  function compileToCpp(source: string): string {
+  function compileFiles(source: string, mode: 'gc' | 'ownership' = 'gc'): Map<string, string> {
     const sourceFile = ts.createSourceFile('test.ts', source, ts.ScriptTarget.ES2022, true);
     const program = ts.createProgram(['test.ts'], {}, {
       getSourceFile: (fileName) => fileName === 'test.ts' ? sourceFile : undefined,
@@ -21,8 +21,11 @@ describe('JSON object integration', () => {
     const lowering = new IRLowering();
     const program_ir = lowering.lower(program);
     const codegen = new CppCodegen();
-    const files = codegen.generate(program_ir, 'gc');
-    return files.get('test.cpp') || '';
+    return codegen.generate(program_ir, mode);
+  }
+
+  function compileToCpp(source: string): string {
+    return compileFiles(source).get('test.cpp') || '';
   }
 
   it('should compile JSON.stringify() with number', () => {
@@ -82,4 +85,94 @@ describe('JSON object integration', () => {
     const matches = cpp.match(/gs::JSON::stringify/g);
     expect(matches).toHaveLength(2);
   });
+
+  it('should decode JSON.parse() straight into a declared interface type', () => {
+    const source = `
+      interface Tag {
+        label: string;
+        weight: number | null;
+      }
+      interface User {
+        name: string;
+        age: number;
+        tags: Tag[];
+      }
+      function load(text: string): number {
+        const user: User = JSON.parse(text);
+        return user.age;
+      }
+    `;
+    const files = compileFiles(source);
+    const hpp = files.get('test.hpp') || '';
+    const cpp = files.get('test.cpp') || '';
+    expect(cpp).toContain('gs::JSON::parse<User*>(text)');
+    expect(hpp).toContain('inline void gs_json_decode(gs::json::Reader& in, User& out)');
+    expect(hpp).toContain('inline void gs_json_decode(gs::json::Reader& in, Tag& out)');
+    expect(hpp).toContain('if (key == "name") {');
+    expect(hpp).toContain('in.skip_value();');
+    // Decoded instances are allocated in the GC heap
+    expect(hpp).toContain('GS_GC_CLASS(User)');
+    expect(hpp).toContain('GS_GC_CLASS(Tag)');
+  });
+
+  it('should decode JSON.parse() into primitives and arrays', () => {
+    const source = `
+      function sum(text: string): number {
+        const values: number[] = JSON.parse(text);
+        return values.length;
+      }
+    `;
+    const cpp = compileToCpp(source);
+    expect(cpp).toContain('gs::JSON::parse<gs::Array<double>>(text)');
+  });
+
+  it('should use owning pointers for decoded interfaces in ownership mode', () => {
+    const source = `
+      interface Point {
+        x: number;
+        y: number;
+      }
+      function load(text: string): number {
+        const p: Point = JSON.parse(text);
+        return p.x;
+      }
+    `;
+    const files = compileFiles(source, 'ownership');
+    expect(files.get('test.cpp')).toContain('gs::JSON::parse<std::unique_ptr<Point>>(text)');
+    expect(files.get('test.hpp')).not.toContain('GS_GC_CLASS');
+  });
+
+  it('should leave JSON.parse() untyped without a decodable target', () => {
+    const source = `
+      interface Shape {
+        area(): number;
+      }
+      function load(text: string): number {
+        const s: Shape = JSON.parse(text);
+        return s.area();
+      }
+    `;
+    const files = compileFiles(source);
+    expect(files.get('test.cpp')).toContain('gs::JSON::parse(text)');
+    expect(files.get('test.hpp')).not.toContain('gs_json_decode');
+  });
+
+  it('should emit specialized JSON.stringify() encoders for classes', () => {
+    const source = `
+      class Point {
+        x: number = 0;
+        y: number = 0;
+      }
+      function dump(p: Point): string {
+        return JSON.stringify(p);
+      }
+    `;
+    const files = compileFiles(source);
+    const hpp = files.get('test.hpp') || '';
+    expect(files.get('test.cpp')).toContain('gs::JSON::stringify(p)');
+    expect(hpp).toContain('inline void gs_json_encode(gs::StringBuilder& out, const Point& value)');
+    expect(hpp).toContain('out.append("{\\"x\\":");');
+    expect(hpp).toContain('gs_json_encode(out, value.x_);');
+    expect(hpp).toContain('out.append(",\\"y\\":");');
+  });
 });
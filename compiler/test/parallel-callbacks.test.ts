@@ -0,0 +1,99 @@
+/**
+ * Tests for GS306: Parallel callbacks must not capture shared mutable state
+ */
+
+import { describe, it, expect } from 'vitest';
+import ts from 'typescript';
+import { OwnershipAnalyzer } from '../src/frontend/ownership-analyzer.js';
+
+const PRELUDE = `
+declare class Parallel {
+  static map<T, U>(array: T[], callback: (value: T) => U): U[];
+  static filter<T>(array: T[], predicate: (value: T) => boolean): T[];
+  static reduce<T>(array: T[], callback: (accumulator: T, value: T) => T, initialValue: T): T;
+  static sort<T>(array: T[], compareFn?: (a: T, b: T) => number): T[];
+}
+`;
+
+function analyze(source: string) {
+  const fileName = 'test.ts';
+  const options: ts.CompilerOptions = { target: ts.ScriptTarget.ES2022, strict: true };
+  const host = ts.createCompilerHost(options);
+  const getSourceFile = host.getSourceFile;
+  host.getSourceFile = (name, languageVersion, ...rest) =>
+    name === fileName
+      ? ts.createSourceFile(name, PRELUDE + source, languageVersion, true)
+      : getSourceFile.call(host, name, languageVersion, ...rest);
+
+  const program = ts.createProgram([fileName], options, host);
+  const analyzer = new OwnershipAnalyzer();
+  analyzer.analyze(program.getSourceFile(fileName)!, program.getTypeChecker());
+  return analyzer.finalize().filter(d => d.code === 'GS306');
+}
+
+describe('Parallel Callbacks (GS306)', () => {
+  it('should accept callbacks that read parameters, locals and primitive captures', () => {
+    const diagnostics = analyze(`
+      function square(x: number): number { return x * x; }
+      function scaleAll(values: number[], factor: number): number[] {
+        const offset = 1;
+        return Parallel.map(values, (x: number) => {
+          const y = square(x) * factor;
+          return Math.sqrt(y) + offset;
+        });
+      }
+      const total = Parallel.reduce([1, 2, 3], (a: number, b: number) => a + b, 0);
+      const sorted = Parallel.sort(['b', 'a'], (a: string, b: string) => a.length - b.length);
+    `);
+
+    expect(diagnostics).toHaveLength(0);
+  });
+
+  it('should reject capturing an array or object', () => {
+    const diagnostics = analyze(`
+      const seen: number[] = [];
+      const kept = Parallel.filter([1, 2, 3], (x: number) => seen.includes(x));
+    `);
+
+    expect(diagnostics).toHaveLength(1);
+    expect(diagnostics[0].message).toContain("Parallel.filter callback captures 'seen'");
+  });
+
+  it('should reject assigning to a captured variable', () => {
+    const diagnostics = analyze(`
+      let count = 0;
+      const doubled = Parallel.map([1, 2, 3], (x: number) => { count++; return x * 2; });
+    `);
+
+    expect(diagnostics).toHaveLength(1);
+    expect(diagnostics[0].message).toContain("assigns to 'count'");
+  });
+
+  it('should reject this and check called functions', () => {
+    const diagnostics = analyze(`
+      const cache: Map<number, number> = new Map();
+      function lookup(x: number): number { return cache.get(x) ?? x; }
+      class Scaler {
+        factor = 2;
+        run(values: number[]): number[] {
+          return Parallel.map(values, (x: number) => lookup(x) * this.factor);
+        }
+      }
+    `);
+
+    expect(diagnostics).toHaveLength(2);
+    expect(diagnostics.map(d => d.message).join('\n')).toContain("captures 'cache'");
+    expect(diagnostics.map(d => d.message).join('\n')).toContain("uses 'this'");
+  });
+
+  it('should reject callbacks it cannot see', () => {
+    const diagnostics = analyze(`
+      function pick(fn: (x: number) => boolean): number[] {
+        return Parallel.filter([1, 2, 3], fn);
+      }
+    `);
+
+    expect(diagnostics).toHaveLength(1);
+    expect(diagnostics[0].message).toContain('must be a function literal');
+  });
+});
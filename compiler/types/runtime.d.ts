@@ -147,6 +147,47 @@ export declare class JSON {
   static stringify(value: unknown): string;
 }
 
+// =============================================================================
+// Parallel API
+// =============================================================================
+
+/**
+ * Parallel - data-parallel Array operations
+ * 
+ * Same results as the Array methods, computed on all CPU cores for large
+ * arrays. Callbacks must not capture shared mutable state: they may read
+ * parameters, their own locals and primitive values from the enclosing
+ * scope, and call functions that follow the same rule (error GS306).
+ * 
+ * @example
+ * ```typescript
+ * const scale = 2.5;
+ * const scaled = Parallel.map(samples, (x: number) => x * scale);
+ * const total = Parallel.reduce(scaled, (a: number, b: number) => a + b, 0);
+ * ```
+ */
+export declare class Parallel {
+  /**
+   * Like array.map(callback)
+   */
+  static map<T, U>(array: T[], callback: (value: T) => U): U[];
+
+  /**
+   * Like array.filter(predicate)
+   */
+  static filter<T>(array: T[], predicate: (value: T) => boolean): T[];
+
+  /**
+   * Like array.reduce(callback, initialValue); callback must be associative
+   */
+  static reduce<T>(array: T[], callback: (accumulator: T, value: T) => T, initialValue: T): T;
+
+  /**
+   * Stable sort in place, like array.sort(compareFn); returns the array
+   */
+  static sort<T>(array: T[], compareFn?: (a: T, b: T) => number): T[];
+}
+
 // =============================================================================
 // FileSystem API
 // =============================================================================
@@ -202,6 +243,28 @@ export declare class FileSystem {
    */
   static readBytes(path: string): Uint8Array;
 
+  /**
+   * Map file into memory without reading it (private, copy-on-write).
+   * Pages load as the bytes are scanned with indexOf/subarray, so files
+   * larger than memory work. access: "sequential", "random", "willneed"
+   * or "normal" (default).
+   * Ownership mode unmaps with the last view. In GC mode the mapping is
+   * not collected: it stays until unmapFile or exit, so a program that
+   * maps files in a loop must unmap them.
+   */
+  static mapFile(path: string, access?: string): Uint8Array;
+
+  /**
+   * Unmap a mapFile view now (GC mode; ownership mode unmaps with the
+   * last view). The view and its subarrays must not be used afterwards.
+   */
+  static unmapFile(bytes: Uint8Array): void;
+
+  /**
+   * Decode bytes as text (UTF-8 by default), e.g. a slice of a mapFile view
+   */
+  static decodeText(bytes: Uint8Array, encoding?: string): string;
+
   /**
    * Write bytes to file (creates/overwrites)
    */
@@ -288,6 +351,8 @@ export interface HttpResponse {
   statusText: string;
   headers: Map<string, string>;
   body: string;
+  /** Body of syncFetchBytes/fetchBytes responses (body is empty for those) */
+  bytes: Uint8Array;
 }
 
 /**
@@ -308,6 +373,11 @@ export declare class HTTP {
    */
   static syncFetch(url: string): HttpResponse;
 
+  /**
+   * Perform synchronous HTTP GET request for binary content (response.bytes)
+   */
+  static syncFetchBytes(url: string): HttpResponse;
+
   /**
    * Perform synchronous HTTP POST request
    */
@@ -335,6 +405,11 @@ export declare class HTTPAsync {
    */
   static fetch(url: string): Promise<HttpResponse>;
 
+  /**
+   * Perform asynchronous HTTP GET request for binary content (response.bytes)
+   */
+  static fetchBytes(url: string): Promise<HttpResponse>;
+
   /**
    * Perform asynchronous HTTP POST request
    */
@@ -0,0 +1,45 @@
+// Allocation benchmark
+// Tests allocator throughput on millions of small, short-lived String/Array allocations
+//
+// GC mode compares allocation paths: run once normally (per-thread
+// allocation points) and once with GS_GC_ALLOC_POINTS=0 (mps_alloc per call)
+
+function allocateStrings(count: integer): integer {
+  let total: integer = 0;
+  for (let i: integer = 0; i < count; i = i + 1) {
+    // Longer than the 23-char SSO buffer, so every string hits the heap
+    const s: string = `request-handler-key-${i}-with-suffix`;
+    total = total + s.length;
+  }
+  return total;
+}
+
+function allocateArrays(count: integer): integer {
+  let total: integer = 0;
+  for (let i: integer = 0; i < count; i = i + 1) {
+    const pair: integer[] = [i, i + 1];
+    pair.push(i + 2);
+    total = total + pair.length;
+  }
+  return total;
+}
+
+function runBenchmark(): void {
+  const size: integer = 1000000;
+  const iterations: integer = 5;
+  
+  const startTotal: number = Date.now();
+  
+  for (let i: integer = 0; i < iterations; i = i + 1) {
+    const start: number = Date.now();
+    const strings: integer = allocateStrings(size);
+    const arrays: integer = allocateArrays(size);
+    const elapsed: number = Date.now() - start;
+    console.log(`Iteration ${i + 1}: strings = ${strings}, arrays = ${arrays} (${elapsed}ms)`);
+  }
+  
+  const totalTime: number = Date.now() - startTotal;
+  console.log(`Total time: ${totalTime}ms`);
+}
+
+runBenchmark();
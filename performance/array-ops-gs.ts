@@ -31,8 +31,34 @@ function arrayOperations(size: integer): integer53 {
   return sum;
 }
 
+// Queue operations: shift/unshift at the front, push/pop at the back
+function queueOperations(size: integer): integer53 {
+  const queue: number[] = [];
+  for (let i: integer = 0; i < size; i = i + 1) {
+    queue.push(i);
+  }
+  
+  // FIFO: cycle every element through the queue ten times
+  let sum: integer53 = 0;
+  for (let i: integer = 0; i < size * 10; i = i + 1) {
+    const head: number = queue[0];
+    queue.shift();
+    sum = sum + head;
+    queue.push(head + 1);
+  }
+  
+  // Deque: add at the front, drop from the back
+  for (let i: integer = 0; i < size; i = i + 1) {
+    queue.unshift(i);
+    queue.pop();
+  }
+  
+  return sum;
+}
+
 function runBenchmark(): void {
   const size: integer = 100000;
+  const queueSize: integer = 10000;
   const iterations: integer = 10;
   
   const startTotal: number = Date.now();
@@ -42,6 +68,11 @@ function runBenchmark(): void {
     const result: integer53 = arrayOperations(size);
     const elapsed: number = Date.now() - start;
     console.log(`Iteration ${i + 1}: sum = ${result} (${elapsed}ms)`);
+    
+    const queueStart: number = Date.now();
+    const queueResult: integer53 = queueOperations(queueSize);
+    const queueElapsed: number = Date.now() - queueStart;
+    console.log(`Iteration ${i + 1}: queue sum = ${queueResult} (${queueElapsed}ms)`);
   }
   
   const totalTime: number = Date.now() - startTotal;
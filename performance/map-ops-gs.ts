@@ -1,5 +1,6 @@
 // Map operations benchmark
-// Tests Map insert, lookup, and delete performance
+// Tests Map insert, lookup, and delete performance, with short keys and
+// with 30-200 byte URL-like keys (where key hashing dominates lookups)
 
 function mapOperations(size: integer): integer {
   const map: Map<string, integer> = new Map();
@@ -29,6 +30,42 @@ function mapOperations(size: integer): integer {
   return sum;
 }
 
+function urlKey(i: integer): string {
+  const section: string = i % 3 === 0 ? "products" : (i % 3 === 1 ? "users/profile/settings" : "api/v2/search/results");
+  return `https://example.com/${section}/item-${i}?ref=benchmark&session=0123456789abcdef`;
+}
+
+function urlKeyLookups(size: integer, rounds: integer): integer {
+  const map: Map<string, integer> = new Map();
+  const keys: string[] = [];
+  for (let i: integer = 0; i < size; i = i + 1) {
+    const key: string = urlKey(i);
+    keys.push(key);
+    map.set(key, i);
+  }
+
+  // Repeated lookups with the same key strings
+  let sum: integer = 0;
+  for (let r: integer = 0; r < rounds; r = r + 1) {
+    for (let i: integer = 0; i < size; i = i + 1) {
+      const key: string = keys[i];
+      if (map.has(key) === true) {
+        const value: integer = map.get(key);
+        sum = sum + value;
+      }
+    }
+  }
+
+  // Lookups with freshly built key strings
+  for (let i: integer = 0; i < size; i = i + 1) {
+    if (map.has(urlKey(i)) === true) {
+      sum = sum + 1;
+    }
+  }
+
+  return sum;
+}
+
 function runBenchmark(): void {
   const size: integer = 50000;
   const iterations: integer = 10;
@@ -41,6 +78,13 @@ function runBenchmark(): void {
     const elapsed: number = Date.now() - start;
     console.log(`Iteration ${i + 1}: sum = ${result} (${elapsed}ms)`);
   }
+
+  for (let i: integer = 0; i < iterations; i = i + 1) {
+    const start: number = Date.now();
+    const result: integer = urlKeyLookups(size, 4);
+    const elapsed: number = Date.now() - start;
+    console.log(`URL keys ${i + 1}: sum = ${result} (${elapsed}ms)`);
+  }
   
   const totalTime: number = Date.now() - startTotal;
   console.log(`Total time: ${totalTime}ms`);
@@ -0,0 +1,50 @@
+// Split/join benchmark
+// Tests short-lived small arrays: splitting paths into a few segments,
+// editing them and joining them back
+//
+// Arrays of up to a few elements live inline in both C++ runtimes, so
+// the segment arrays here cost no allocation of their own; compare with
+// the longer paths, whose segments outgrow the inline slots
+
+function renamePaths(count: integer, dir: string): integer {
+  let total: integer = 0;
+  for (let i: integer = 0; i < count; i = i + 1) {
+    const segments: string[] = `${dir}/file-${i}.ts`.split('/');
+    segments.pop();
+    segments.push(`file-${i}.js`);
+    total = total + segments.join('/').length;
+  }
+  return total;
+}
+
+function countExtensions(count: integer): integer {
+  let total: integer = 0;
+  for (let i: integer = 0; i < count; i = i + 1) {
+    const parts: string[] = `module-${i}.test.ts`.split('.');
+    if (parts[parts.length - 1] === 'ts') {
+      total = total + parts.length;
+    }
+  }
+  return total;
+}
+
+function runBenchmark(): void {
+  const size: integer = 500000;
+  const iterations: integer = 5;
+
+  const startTotal: number = Date.now();
+
+  for (let i: integer = 0; i < iterations; i = i + 1) {
+    const start: number = Date.now();
+    const short: integer = renamePaths(size, 'src');
+    const long: integer = renamePaths(size, 'home/user/projects/app/src/lib');
+    const extensions: integer = countExtensions(size);
+    const elapsed: number = Date.now() - start;
+    console.log(`Iteration ${i + 1}: short = ${short}, long = ${long}, extensions = ${extensions} (${elapsed}ms)`);
+  }
+
+  const totalTime: number = Date.now() - startTotal;
+  console.log(`Total time: ${totalTime}ms`);
+}
+
+runBenchmark();
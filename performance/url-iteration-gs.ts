@@ -0,0 +1,65 @@
+// URL iteration benchmark
+// Iterates a string[] of long (80-200 byte) URLs with for-of loops and passes
+// the array and its strings to read-only helpers. Every loop variable and
+// parameter here is a candidate for a const reference instead of a copy.
+
+function makeUrl(i: integer): string {
+  const section: string = i % 3 === 0 ? "products/catalog/electronics" : (i % 3 === 1 ? "users/profile/settings/notifications" : "api/v2/search/results");
+  return `https://www.example.com/${section}/item-${i}?ref=benchmark&session=0123456789abcdef0123456789abcdef&utm_source=newsletter`;
+}
+
+function isSecure(url: string): boolean {
+  return url.startsWith("https://");
+}
+
+function totalLength(urls: string[]): integer {
+  let total: integer = 0;
+  for (const url of urls) {
+    total = total + url.length;
+  }
+  return total;
+}
+
+function countMatches(urls: string[], needle: string): integer {
+  let count: integer = 0;
+  for (const url of urls) {
+    if (isSecure(url) && url.includes(needle)) {
+      count = count + 1;
+    }
+  }
+  return count;
+}
+
+function urlIteration(urls: string[], rounds: integer): integer {
+  let sum: integer = 0;
+  for (let r: integer = 0; r < rounds; r = r + 1) {
+    sum = sum + totalLength(urls);
+    sum = sum + countMatches(urls, "search");
+  }
+  return sum;
+}
+
+function runBenchmark(): void {
+  const size: integer = 20000;
+  const rounds: integer = 50;
+  const iterations: integer = 10;
+
+  const urls: string[] = [];
+  for (let i: integer = 0; i < size; i = i + 1) {
+    urls.push(makeUrl(i));
+  }
+
+  const startTotal: number = Date.now();
+
+  for (let i: integer = 0; i < iterations; i = i + 1) {
+    const start: number = Date.now();
+    const result: integer = urlIteration(urls, rounds);
+    const elapsed: number = Date.now() - start;
+    console.log(`Iteration ${i + 1}: sum = ${result} (${elapsed}ms)`);
+  }
+
+  const totalTime: number = Date.now() - startTotal;
+  console.log(`Total time: ${totalTime}ms`);
+}
+
+runBenchmark();